@@ -0,0 +1,20 @@
+#if __VERSION__ >= 300
+uniform sampler2D u_texture_sampler;
+
+in vec4 sf_v_color;
+in vec2 sf_v_texCoord;
+
+layout(location = 0) out vec4 sf_fragColor;
+
+void main()
+{
+   sf_fragColor = texture(u_texture_sampler, sf_v_texCoord) * sf_v_color;
+}
+#else
+uniform sampler2D u_texture_sampler;
+
+void main()
+{
+   gl_FragColor = texture2D(u_texture_sampler, gl_TexCoord[0].xy) * gl_Color;
+}
+#endif
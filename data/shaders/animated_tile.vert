@@ -0,0 +1,100 @@
+// picks the current frame of an animated tile from the tile map's frame table.
+//
+// the vertices carry the first frame's texcoords, their color holds where the tile's animation starts
+// in the frame table (r + g * 256) and how many frames it has (b); alpha is the layer opacity.
+// every frame takes one column of the table across two rows:
+//   row 0: tile column in the tileset (r + g * 256), tile row (b + a * 256)
+//   row 1: time the frame ends within the animation in ms (r + g * 256), animation duration in ms (b + a * 256)
+// the table is 256 frames wide, frames past that continue in the next pair of rows.
+
+const float frame_table_width = 256.0;
+const int max_frames_per_animation = 64;
+
+uniform sampler2D u_frame_table;
+uniform vec2 u_frame_table_size;
+uniform vec2 u_tile_size;
+uniform float u_time_ms;
+
+float decode16(float low, float high)
+{
+   return floor(low * 255.0 + 0.5) + floor(high * 255.0 + 0.5) * 256.0;
+}
+
+vec2 frameTableUv(float frame_index, float row)
+{
+   float column = mod(frame_index, frame_table_width);
+   float band = floor(frame_index / frame_table_width);
+   return vec2((column + 0.5) / u_frame_table_size.x, (band * 2.0 + row + 0.5) / u_frame_table_size.y);
+}
+
+#if __VERSION__ >= 300
+uniform vec3 sf_u_mvpRow0;
+uniform vec3 sf_u_mvpRow1;
+uniform vec2 sf_u_invTextureSize;
+
+layout(location = 0) in vec2 sf_a_position;
+layout(location = 1) in vec4 sf_a_color;
+layout(location = 2) in vec2 sf_a_texCoord;
+
+out vec4 sf_v_color;
+out vec2 sf_v_texCoord;
+
+vec4 fetchFrame(float frame_index, float row)
+{
+   return textureLod(u_frame_table, frameTableUv(frame_index, row), 0.0);
+}
+#else
+vec4 fetchFrame(float frame_index, float row)
+{
+   return texture2DLod(u_frame_table, frameTableUv(frame_index, row), 0.0);
+}
+#endif
+
+vec2 frameOffsetPx(vec4 animation)
+{
+   float first_frame = decode16(animation.r, animation.g);
+   float frame_count = floor(animation.b * 255.0 + 0.5);
+
+   vec4 first_timing = fetchFrame(first_frame, 1.0);
+   float duration_ms = max(decode16(first_timing.b, first_timing.a), 1.0);
+   float elapsed_ms = mod(u_time_ms, duration_ms);
+
+   float frame = first_frame;
+   for (int i = 0; i < max_frames_per_animation; i++)
+   {
+      if (float(i) >= frame_count)
+      {
+         break;
+      }
+
+      frame = first_frame + float(i);
+      vec4 timing = fetchFrame(frame, 1.0);
+      if (elapsed_ms < decode16(timing.r, timing.g))
+      {
+         break;
+      }
+   }
+
+   vec4 first_tile = fetchFrame(first_frame, 0.0);
+   vec4 tile = fetchFrame(frame, 0.0);
+   vec2 first_tile_position = vec2(decode16(first_tile.r, first_tile.g), decode16(first_tile.b, first_tile.a));
+   vec2 tile_position = vec2(decode16(tile.r, tile.g), decode16(tile.b, tile.a));
+   return (tile_position - first_tile_position) * u_tile_size;
+}
+
+#if __VERSION__ >= 300
+void main()
+{
+   vec3 pos = vec3(sf_a_position, 1.0);
+   gl_Position = vec4(dot(sf_u_mvpRow0, pos), dot(sf_u_mvpRow1, pos), 0.0, 1.0);
+   sf_v_color = vec4(1.0, 1.0, 1.0, sf_a_color.a);
+   sf_v_texCoord = (sf_a_texCoord + frameOffsetPx(sf_a_color)) * sf_u_invTextureSize;
+}
+#else
+void main()
+{
+   gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;
+   gl_FrontColor = vec4(1.0, 1.0, 1.0, gl_Color.a);
+   gl_TexCoord[0] = gl_TextureMatrix[0] * vec4(gl_MultiTexCoord0.xy + frameOffsetPx(gl_Color), 0.0, 1.0);
+}
+#endif
@@ -0,0 +1,342 @@
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "framework/tools/boundedqueue.h"
+#include "game/audio/voiceallocator.h"
+
+// fires a few hundred one-shots per second at 50 voices, the way a fight with several guns and a swarm of
+// enemies does, and compares the first-free scan Audio::playSample used to do against the voice allocator.
+// a handful of looped ambience sounds hold on to their voices for the whole run.
+//
+// the second part pushes requests from several threads into the queue Audio::requestSample uses and
+// compares that against pushing into a mutex guarded vector.
+//
+// usage: audio_voice_benchmark [one_shots_per_second] [seconds] [producer_threads]
+
+namespace
+{
+
+constexpr auto voice_count = 50;
+constexpr auto frames_per_second = 60;
+constexpr auto looped_count = 6;
+
+struct ScheduledSound
+{
+   VoiceAllocator::Request _request;
+   double _duration_s = 0.0;
+};
+
+// the same list of sounds for both runs, so drops and steals can be compared directly
+std::vector<std::vector<ScheduledSound>> createSchedule(int32_t one_shots_per_second, int32_t seconds)
+{
+   std::mt19937 rng(1234);
+   std::uniform_int_distribution<int32_t> sample_dist(0, 23);
+   std::uniform_real_distribution<double> duration_dist(0.05, 0.8);
+   std::uniform_real_distribution<float> position_dist(-1500.0f, 1500.0f);
+   std::uniform_int_distribution<int32_t> priority_dist(0, 9);
+   std::poisson_distribution<int32_t> count_dist(static_cast<double>(one_shots_per_second) / frames_per_second);
+
+   std::vector<std::vector<ScheduledSound>> frames(seconds * frames_per_second);
+   for (auto& frame : frames)
+   {
+      const auto count = count_dist(rng);
+      for (auto i = 0; i < count; i++)
+      {
+         ScheduledSound sound;
+         sound._request._sample_name = "sample_" + std::to_string(sample_dist(rng)) + ".ogg";
+
+         // most sounds are background noise, a few (player hits, pickups) matter more
+         const auto priority_roll = priority_dist(rng);
+         sound._request._priority = (priority_roll == 0) ? 2 : (priority_roll < 3) ? 1 : 0;
+         sound._request._positioned = true;
+         sound._request._x = position_dist(rng);
+         sound._request._y = position_dist(rng) * 0.25f;
+         sound._duration_s = duration_dist(rng);
+         frame.push_back(sound);
+      }
+   }
+
+   return frames;
+}
+
+struct RunResult
+{
+   int64_t _requests{0};
+   int64_t _played{0};
+   int64_t _dropped{0};
+   int64_t _stolen{0};
+   int64_t _loops_cut{0};
+   int64_t _active_queries{0};  //!< backend isActive calls, each one takes the device lock in the game
+   std::chrono::steady_clock::duration _duration{};
+};
+
+// what playSample did before: take the first thread that is not playing, drop the sound otherwise
+RunResult runLinearScan(const std::vector<std::vector<ScheduledSound>>& frames)
+{
+   std::array<double, voice_count> end_times_s{};
+   std::array<bool, voice_count> looped{};
+   for (auto i = 0; i < looped_count; i++)
+   {
+      end_times_s[i] = 1e9;
+      looped[i] = true;
+   }
+
+   RunResult result;
+   const auto start = std::chrono::steady_clock::now();
+
+   for (auto frame_index = 0u; frame_index < frames.size(); frame_index++)
+   {
+      const auto now_s = static_cast<double>(frame_index) / frames_per_second;
+      for (const auto& sound : frames[frame_index])
+      {
+         result._requests++;
+
+         auto voice = -1;
+         for (auto i = 0; i < voice_count; i++)
+         {
+            result._active_queries++;
+            if (end_times_s[i] <= now_s)
+            {
+               voice = i;
+               break;
+            }
+         }
+
+         if (voice == -1)
+         {
+            result._dropped++;
+            continue;
+         }
+
+         end_times_s[voice] = now_s + sound._duration_s;
+         result._played++;
+      }
+   }
+
+   result._duration = std::chrono::steady_clock::now() - start;
+   return result;
+}
+
+RunResult runVoiceAllocator(const std::vector<std::vector<ScheduledSound>>& frames)
+{
+   VoiceAllocator allocator(voice_count);
+   std::array<double, voice_count> end_times_s{};
+   std::array<bool, voice_count> looped{};
+   auto now_s = 0.0;
+   RunResult result;
+
+   const auto is_active = [&end_times_s, &now_s, &result](int32_t voice)
+   {
+      result._active_queries++;
+      return end_times_s[voice] > now_s;
+   };
+
+   for (auto i = 0; i < looped_count; i++)
+   {
+      VoiceAllocator::Request request;
+      request._sample_name = "ambience_" + std::to_string(i) + ".ogg";
+      request._looped = true;
+      const auto allocation = allocator.allocate(request, is_active);
+      end_times_s[allocation->_voice] = 1e9;
+      looped[allocation->_voice] = true;
+   }
+
+   const auto start = std::chrono::steady_clock::now();
+
+   for (auto frame_index = 0u; frame_index < frames.size(); frame_index++)
+   {
+      now_s = static_cast<double>(frame_index) / frames_per_second;
+      allocator.beginFrame();
+
+      // the listener walks across the level
+      allocator.setListenerPosition(static_cast<float>(std::sin(now_s * 0.1) * 1000.0), 0.0f);
+
+      for (const auto& sound : frames[frame_index])
+      {
+         result._requests++;
+
+         const auto allocation = allocator.allocate(sound._request, is_active);
+         if (!allocation.has_value())
+         {
+            result._dropped++;
+            continue;
+         }
+
+         if (allocation->_stolen)
+         {
+            result._stolen++;
+            if (looped[allocation->_voice])
+            {
+               result._loops_cut++;
+            }
+         }
+
+         end_times_s[allocation->_voice] = now_s + sound._duration_s;
+         looped[allocation->_voice] = false;
+         result._played++;
+      }
+   }
+
+   result._duration = std::chrono::steady_clock::now() - start;
+   return result;
+}
+
+struct QueuedSound
+{
+   std::string _sample_name;
+   float _volume = 1.0f;
+   int32_t _priority = 0;
+};
+
+template <typename Push, typename Drain>
+std::chrono::steady_clock::duration runProducers(int32_t producer_count, int32_t pushes_per_producer, Push push, Drain drain)
+{
+   std::atomic<bool> done{false};
+   int64_t drained = 0;
+
+   const auto start = std::chrono::steady_clock::now();
+
+   std::thread consumer(
+      [&]()
+      {
+         while (!done.load() || drained < static_cast<int64_t>(producer_count) * pushes_per_producer)
+         {
+            const auto count = drain();
+            drained += count;
+
+            // on a machine with fewer cores than threads, spinning here would starve the producers
+            if (count == 0)
+            {
+               std::this_thread::yield();
+            }
+         }
+      }
+   );
+
+   std::vector<std::thread> producers;
+   for (auto p = 0; p < producer_count; p++)
+   {
+      producers.emplace_back(
+         [&, p]()
+         {
+            QueuedSound sound{"impact_" + std::to_string(p) + ".ogg", 1.0f, 0};
+            for (auto i = 0; i < pushes_per_producer; i++)
+            {
+               while (!push(sound))
+               {
+                  std::this_thread::yield();
+               }
+            }
+         }
+      );
+   }
+
+   for (auto& producer : producers)
+   {
+      producer.join();
+   }
+   done = true;
+   consumer.join();
+
+   return std::chrono::steady_clock::now() - start;
+}
+
+void printRun(const char* name, const RunResult& result)
+{
+   const auto requests = static_cast<double>(result._requests);
+   const auto ns_per_request = std::chrono::duration<double, std::nano>(result._duration).count() / requests;
+   const auto queries_per_request = static_cast<double>(result._active_queries) / requests;
+
+   std::cout << name << ns_per_request << " ns/request, " << result._played << " played, " << result._dropped << " dropped, "
+             << result._stolen << " stolen, " << result._loops_cut << " loops cut, " << queries_per_request << " isActive calls/request"
+             << std::endl;
+}
+
+}  // namespace
+
+int main(int32_t argc, char** argv)
+{
+   const auto one_shots_per_second = (argc > 1) ? std::atoi(argv[1]) : 400;
+   const auto seconds = (argc > 2) ? std::atoi(argv[2]) : 600;
+   const auto producer_count = (argc > 3) ? std::atoi(argv[3]) : 4;
+
+   const auto frames = createSchedule(one_shots_per_second, seconds);
+
+   const auto scan = runLinearScan(frames);
+   const auto allocator = runVoiceAllocator(frames);
+
+   std::cout << std::fixed << std::setprecision(1);
+   std::cout << one_shots_per_second << " one-shots/s over " << seconds << " s, " << voice_count << " voices, " << looped_count
+             << " looped" << std::endl;
+   printRun("first free scan: ", scan);
+   printRun("voice allocator: ", allocator);
+
+   // command queue
+   constexpr auto pushes_per_producer = 200000;
+
+   BoundedQueue<QueuedSound, 256> queue;
+   const auto queue_duration = runProducers(
+      producer_count,
+      pushes_per_producer,
+      [&queue](const QueuedSound& sound) { return queue.push(sound); },
+      [&queue]()
+      {
+         int64_t count = 0;
+         while (queue.pop().has_value())
+         {
+            count++;
+         }
+         return count;
+      }
+   );
+
+   std::mutex mutex;
+   std::vector<QueuedSound> locked;
+   std::vector<QueuedSound> swapped;
+   const auto mutex_duration = runProducers(
+      producer_count,
+      pushes_per_producer,
+      [&](const QueuedSound& sound)
+      {
+         std::lock_guard<std::mutex> guard(mutex);
+         locked.push_back(sound);
+         return true;
+      },
+      [&]()
+      {
+         {
+            std::lock_guard<std::mutex> guard(mutex);
+            swapped.swap(locked);
+         }
+         const auto count = static_cast<int64_t>(swapped.size());
+         swapped.clear();
+         return count;
+      }
+   );
+
+   const auto ns_per_push = [producer_count](auto duration)
+   { return std::chrono::duration<double, std::nano>(duration).count() / (static_cast<double>(producer_count) * pushes_per_producer); };
+
+   std::cout << producer_count << " producers, " << pushes_per_producer << " requests each" << std::endl;
+   std::cout << "bounded queue: " << ns_per_push(queue_duration) << " ns/request" << std::endl;
+   std::cout << "mutex vector:  " << ns_per_push(mutex_duration) << " ns/request" << std::endl;
+
+   if (allocator._loops_cut != 0)
+   {
+      std::cout << "error: the allocator stole a looped voice" << std::endl;
+      return 1;
+   }
+
+   return 0;
+}
@@ -0,0 +1,162 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "game/level/chunk.h"
+#include "game/level/chunkindex.h"
+
+// compares the per step cost of selecting the mechanisms to update: the linear scan Level::update used
+// to do over every mechanism against the chunk index it does now. the player walks from one end of a
+// wide level to the other, so the neighbourhood changes every few hundred steps like it does in game.
+//
+// usage: chunk_index_benchmark [mechanism_count] [step_count]
+
+namespace
+{
+
+struct SyntheticMechanism
+{
+   std::vector<Chunk> _chunks;
+   int64_t _updates{0};
+
+   void update()
+   {
+      _updates++;
+   }
+};
+
+// the check Level::update ran for every mechanism, every step
+bool checkUpdateMechanism(const Chunk& player_chunk, const SyntheticMechanism& mechanism)
+{
+   if (mechanism._chunks.empty())
+   {
+      return true;
+   }
+
+   return std::any_of(
+      mechanism._chunks.cbegin(),
+      mechanism._chunks.cend(),
+      [&player_chunk](const Chunk& other)
+      { return (abs(player_chunk._x - other._x) < CHUNK_ALLOWED_DELTA_X) && (abs(player_chunk._y - other._y) < CHUNK_ALLOWED_DELTA_Y); }
+   );
+}
+
+constexpr auto level_width_px = 200 * 512;
+constexpr auto level_height_px = 40 * 512;
+
+std::vector<SyntheticMechanism> createMechanisms(int32_t count)
+{
+   std::mt19937 rng(1234);
+   std::uniform_int_distribution<int32_t> x_dist(0, level_width_px - 1);
+   std::uniform_int_distribution<int32_t> y_dist(0, level_height_px - 1);
+   std::uniform_int_distribution<int32_t> size_dist(16, 768);
+   std::uniform_int_distribution<int32_t> unchunked_dist(0, 49);
+
+   std::vector<SyntheticMechanism> mechanisms(count);
+   for (auto& mechanism : mechanisms)
+   {
+      // roughly every 50th mechanism opts out of chunk culling, like doors or lasers do
+      if (unchunked_dist(rng) == 0)
+      {
+         continue;
+      }
+
+      const auto x = x_dist(rng);
+      const auto y = y_dist(rng);
+      const auto w = size_dist(rng);
+      const auto h = size_dist(rng);
+      for (auto cy = y; cy <= y + h; cy += 512)
+      {
+         for (auto cx = x; cx <= x + w; cx += 512)
+         {
+            Chunk chunk(cx, cy);
+            if (std::ranges::find(mechanism._chunks, chunk) == mechanism._chunks.end())
+            {
+               mechanism._chunks.push_back(chunk);
+            }
+         }
+      }
+   }
+
+   return mechanisms;
+}
+
+Chunk playerChunkAt(int32_t step, int32_t step_count)
+{
+   const auto x = static_cast<int32_t>(static_cast<int64_t>(level_width_px - 1) * step / step_count);
+   const auto y = level_height_px / 2;
+   return Chunk(x, y);
+}
+
+}  // namespace
+
+int main(int32_t argc, char** argv)
+{
+   const auto mechanism_count = (argc > 1) ? std::atoi(argv[1]) : 10000;
+   const auto step_count = (argc > 2) ? std::atoi(argv[2]) : 20000;
+
+   auto mechanisms = createMechanisms(mechanism_count);
+
+   using Clock = std::chrono::steady_clock;
+
+   // linear scan
+   int64_t scan_updates = 0;
+   const auto scan_start = Clock::now();
+   for (auto step = 0; step < step_count; step++)
+   {
+      const auto player_chunk = playerChunkAt(step, step_count);
+      for (auto& mechanism : mechanisms)
+      {
+         if (checkUpdateMechanism(player_chunk, mechanism))
+         {
+            mechanism.update();
+            scan_updates++;
+         }
+      }
+   }
+   const auto scan_duration = Clock::now() - scan_start;
+
+   // chunk index
+   const auto build_start = Clock::now();
+   ChunkIndex<SyntheticMechanism> index;
+   for (auto& mechanism : mechanisms)
+   {
+      index.add(&mechanism, mechanism._chunks);
+   }
+   const auto build_duration = Clock::now() - build_start;
+
+   int64_t index_updates = 0;
+   const auto index_start = Clock::now();
+   for (auto step = 0; step < step_count; step++)
+   {
+      const auto player_chunk = playerChunkAt(step, step_count);
+      for (auto* mechanism : index.query(player_chunk))
+      {
+         mechanism->update();
+         index_updates++;
+      }
+   }
+   const auto index_duration = Clock::now() - index_start;
+
+   const auto us_per_step = [step_count](auto duration)
+   { return std::chrono::duration<double, std::micro>(duration).count() / static_cast<double>(step_count); };
+
+   std::cout << std::fixed << std::setprecision(3);
+   std::cout << mechanism_count << " mechanisms, " << step_count << " steps" << std::endl;
+   std::cout << "linear scan: " << us_per_step(scan_duration) << " us/step, " << scan_updates << " updates" << std::endl;
+   std::cout << "chunk index: " << us_per_step(index_duration) << " us/step, " << index_updates << " updates" << std::endl;
+   std::cout << "index build: " << std::chrono::duration<double, std::milli>(build_duration).count() << " ms" << std::endl;
+
+   if (scan_updates != index_updates)
+   {
+      std::cout << "error: the index selected a different set of mechanisms than the scan" << std::endl;
+      return 1;
+   }
+
+   return 0;
+}
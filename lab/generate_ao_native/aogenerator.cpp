@@ -0,0 +1,346 @@
+#include "aogenerator.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <thread>
+#include <unordered_map>
+
+namespace
+{
+// the atlas widths packtexture picks from; kept the same so regenerated atlases look like the old ones
+constexpr std::array<int32_t, 5> candidate_texture_widths = {512, 1024, 2048, 4096, 8192};
+
+//! runs function(0) .. function(count - 1) on a small pool of workers that each pull the next index
+template <typename Function>
+void parallelFor(int32_t count, int32_t thread_count, const Function& function)
+{
+   std::atomic<int32_t> next_index{0};
+   const auto work = [&]()
+   {
+      for (auto index = next_index++; index < count; index = next_index++)
+      {
+         function(index);
+      }
+   };
+
+   std::vector<std::jthread> workers;
+   for (auto i = 1; i < std::min(thread_count, count); i++)
+   {
+      workers.emplace_back(work);
+   }
+
+   work();
+}
+
+uint64_t hashTile(const AlphaImage& image, int32_t x0, int32_t y0, int32_t tile_size)
+{
+   auto hash = uint64_t{14695981039346656037ull};
+   for (auto y = y0; y < std::min(y0 + tile_size, image._height); y++)
+   {
+      const auto* row = &image._pixels[static_cast<size_t>(y) * static_cast<size_t>(image._width)];
+      for (auto x = x0; x < std::min(x0 + tile_size, image._width); x++)
+      {
+         hash ^= row[x];
+         hash *= 1099511628211ull;
+      }
+   }
+
+   return hash;
+}
+
+bool isTileEmpty(const AlphaImage& image, int32_t x0, int32_t y0, int32_t tile_size)
+{
+   const auto width = std::min(tile_size, image._width - x0);
+   for (auto y = y0; y < std::min(y0 + tile_size, image._height); y++)
+   {
+      const auto* row = &image._pixels[static_cast<size_t>(y) * static_cast<size_t>(image._width) + static_cast<size_t>(x0)];
+      if (std::any_of(row, row + width, [](auto alpha) { return alpha != 0; }))
+      {
+         return false;
+      }
+   }
+
+   return true;
+}
+
+//! compares two tiles, pixels past the right or bottom edge of the image count as transparent
+bool areTilesEqual(const AlphaImage& image, int32_t tile_size, int32_t a_x0, int32_t a_y0, int32_t b_x0, int32_t b_y0)
+{
+   const auto pixel = [&image](int32_t x, int32_t y) -> uint8_t
+   { return (x < image._width && y < image._height) ? image._pixels[static_cast<size_t>(y) * static_cast<size_t>(image._width) + x] : 0; };
+
+   for (auto y = 0; y < tile_size; y++)
+   {
+      for (auto x = 0; x < tile_size; x++)
+      {
+         if (pixel(a_x0 + x, a_y0 + y) != pixel(b_x0 + x, b_y0 + y))
+         {
+            return false;
+         }
+      }
+   }
+
+   return true;
+}
+}  // namespace
+
+AoGenerator::AoGenerator(const AoSettings& settings) : _settings(settings)
+{
+   _thread_count = (_settings._thread_count > 0) ? _settings._thread_count
+                                                 : static_cast<int32_t>(std::max(std::thread::hardware_concurrency(), 1u));
+
+   // three sigma to either side holds all but a fraction of a percent of the weight
+   const auto sigma = std::max(_settings._blur_radius * 0.5f, 0.1f);
+   _kernel_radius = static_cast<int32_t>(std::ceil(sigma * 3.0f));
+   _kernel.resize(static_cast<size_t>(_kernel_radius) * 2 + 1);
+
+   auto weight_sum = 0.0f;
+   for (auto i = -_kernel_radius; i <= _kernel_radius; i++)
+   {
+      const auto weight = std::exp(-static_cast<float>(i * i) / (2.0f * sigma * sigma));
+      _kernel[i + _kernel_radius] = weight;
+      weight_sum += weight;
+   }
+
+   for (auto& weight : _kernel)
+   {
+      weight /= weight_sum;
+   }
+}
+
+AlphaImage AoGenerator::buildShadow(const AlphaImage& layer) const
+{
+   const auto width = layer._width;
+   const auto height = layer._height;
+   const auto radius = _kernel_radius;
+   const auto tap_count = static_cast<int32_t>(_kernel.size());
+   const auto shadow_alpha = static_cast<float>(_settings._shadow_alpha);
+
+   AlphaImage shadow;
+   shadow._width = width;
+   shadow._height = height;
+   shadow._pixels.assign(static_cast<size_t>(width) * static_cast<size_t>(height), 0);
+
+   const auto rows_per_band = _settings._tile_size;
+   const auto band_count = (height + rows_per_band - 1) / rows_per_band;
+
+   parallelFor(
+      band_count,
+      _thread_count,
+      [&](int32_t band)
+      {
+         const auto first_row = band * rows_per_band;
+         const auto end_row = std::min(first_row + rows_per_band, height);
+         const auto first_source_row = std::max(0, first_row - radius);
+         const auto end_source_row = std::min(height, end_row + radius);
+
+         // most of a level is open space or solid rock; a band without anything opaque in reach
+         // stays transparent
+         const auto* source_begin = &layer._pixels[static_cast<size_t>(first_source_row) * static_cast<size_t>(width)];
+         const auto* source_end = &layer._pixels[static_cast<size_t>(end_source_row) * static_cast<size_t>(width)];
+         if (std::all_of(source_begin, source_end, [](auto alpha) { return alpha == 0; }))
+         {
+            return;
+         }
+
+         // horizontal pass over the band and its halo, from a zero padded copy of each row so the
+         // inner loop needs no bounds checks
+         std::vector<float> padded(static_cast<size_t>(width + 2 * radius), 0.0f);
+         std::vector<float> horizontal(static_cast<size_t>(end_source_row - first_source_row) * static_cast<size_t>(width), 0.0f);
+
+         for (auto y = first_source_row; y < end_source_row; y++)
+         {
+            const auto* source = &layer._pixels[static_cast<size_t>(y) * static_cast<size_t>(width)];
+            for (auto x = 0; x < width; x++)
+            {
+               padded[x + radius] = (source[x] != 0) ? shadow_alpha : 0.0f;
+            }
+
+            auto* out = &horizontal[static_cast<size_t>(y - first_source_row) * static_cast<size_t>(width)];
+            for (auto tap = 0; tap < tap_count; tap++)
+            {
+               const auto weight = _kernel[tap];
+               const auto* in = &padded[tap];
+               for (auto x = 0; x < width; x++)
+               {
+                  out[x] += weight * in[x];
+               }
+            }
+         }
+
+         // vertical pass, then cut the layer back out
+         std::vector<float> vertical(static_cast<size_t>(width));
+         for (auto y = first_row; y < end_row; y++)
+         {
+            std::fill(vertical.begin(), vertical.end(), 0.0f);
+
+            for (auto tap = 0; tap < tap_count; tap++)
+            {
+               const auto source_y = y + tap - radius;
+               if (source_y < first_source_row || source_y >= end_source_row)
+               {
+                  continue;
+               }
+
+               const auto weight = _kernel[tap];
+               const auto* in = &horizontal[static_cast<size_t>(source_y - first_source_row) * static_cast<size_t>(width)];
+               for (auto x = 0; x < width; x++)
+               {
+                  vertical[x] += weight * in[x];
+               }
+            }
+
+            const auto* source = &layer._pixels[static_cast<size_t>(y) * static_cast<size_t>(width)];
+            auto* out = &shadow._pixels[static_cast<size_t>(y) * static_cast<size_t>(width)];
+            for (auto x = 0; x < width; x++)
+            {
+               out[x] = (source[x] != 0) ? 0 : static_cast<uint8_t>(std::min(vertical[x] + 0.5f, 255.0f));
+            }
+         }
+      }
+   );
+
+   return shadow;
+}
+
+AoAtlas AoGenerator::pack(const AlphaImage& shadow) const
+{
+   const auto tile_size = _settings._tile_size;
+   const auto columns = (shadow._width + tile_size - 1) / tile_size;
+   const auto rows = (shadow._height + tile_size - 1) / tile_size;
+
+   // finding the empty tiles and hashing the rest is the expensive part and independent per tile
+   struct TileInfo
+   {
+      bool _empty = true;
+      uint64_t _hash = 0;
+   };
+
+   std::vector<TileInfo> tiles(static_cast<size_t>(columns) * static_cast<size_t>(rows));
+   parallelFor(
+      static_cast<int32_t>(tiles.size()),
+      _thread_count,
+      [&](int32_t tile_index)
+      {
+         const auto x0 = (tile_index % columns) * tile_size;
+         const auto y0 = (tile_index / columns) * tile_size;
+         auto& tile = tiles[tile_index];
+         tile._empty = isTileEmpty(shadow, x0, y0, tile_size);
+         if (!tile._empty)
+         {
+            tile._hash = hashTile(shadow, x0, y0, tile_size);
+         }
+      }
+   );
+
+   // quads are numbered in the order their first tile shows up; tiles are only shared when their
+   // pixels match, not just their hashes
+   std::unordered_map<uint64_t, std::vector<int32_t>> quads_by_hash;
+   std::vector<int32_t> first_tile_of_quad;
+   std::vector<std::vector<AoPlacement>> placements_by_quad;
+
+   for (auto tile_index = 0; tile_index < static_cast<int32_t>(tiles.size()); tile_index++)
+   {
+      const auto& tile = tiles[tile_index];
+      if (tile._empty)
+      {
+         continue;
+      }
+
+      const auto x0 = (tile_index % columns) * tile_size;
+      const auto y0 = (tile_index / columns) * tile_size;
+
+      auto& candidates = quads_by_hash[tile._hash];
+      const auto match = std::find_if(
+         candidates.begin(),
+         candidates.end(),
+         [&](auto quad_index)
+         {
+            const auto other = first_tile_of_quad[quad_index];
+            return areTilesEqual(shadow, tile_size, x0, y0, (other % columns) * tile_size, (other / columns) * tile_size);
+         }
+      );
+
+      auto quad_index = 0;
+      if (match != candidates.end())
+      {
+         quad_index = *match;
+      }
+      else
+      {
+         quad_index = static_cast<int32_t>(first_tile_of_quad.size());
+         first_tile_of_quad.push_back(tile_index);
+         placements_by_quad.emplace_back();
+         candidates.push_back(quad_index);
+      }
+
+      placements_by_quad[quad_index].push_back({quad_index, x0, y0, tile_size, tile_size});
+   }
+
+   AoAtlas atlas;
+   atlas._quad_count = static_cast<int32_t>(first_tile_of_quad.size());
+
+   // same choice as packtexture: the smallest width that would hold every quad as a square, else the
+   // widest one, and only as many rows as are filled
+   const auto quad_count = static_cast<int64_t>(atlas._quad_count);
+   const auto width_it = std::find_if(
+      candidate_texture_widths.begin(),
+      candidate_texture_widths.end(),
+      [&](auto texture_width)
+      {
+         const auto quads_per_row = static_cast<int64_t>(texture_width / tile_size);
+         return quads_per_row * quads_per_row >= quad_count;
+      }
+   );
+
+   const auto texture_width = (width_it != candidate_texture_widths.end()) ? *width_it : candidate_texture_widths.back();
+   const auto quads_per_row = texture_width / tile_size;
+   const auto texture_rows = std::max(static_cast<int32_t>((quad_count + quads_per_row - 1) / quads_per_row), 1);
+
+   atlas._texture._width = texture_width;
+   atlas._texture._height = texture_rows * tile_size;
+   atlas._texture._pixels.assign(static_cast<size_t>(atlas._texture._width) * static_cast<size_t>(atlas._texture._height), 0);
+
+   for (auto quad_index = 0; quad_index < atlas._quad_count; quad_index++)
+   {
+      const auto source_tile = first_tile_of_quad[quad_index];
+      const auto source_x0 = (source_tile % columns) * tile_size;
+      const auto source_y0 = (source_tile / columns) * tile_size;
+      const auto copy_width = std::min(tile_size, shadow._width - source_x0);
+
+      const auto target_x0 = (quad_index % quads_per_row) * tile_size;
+      const auto target_y0 = (quad_index / quads_per_row) * tile_size;
+
+      for (auto y = 0; y < std::min(tile_size, shadow._height - source_y0); y++)
+      {
+         const auto* source = &shadow._pixels[static_cast<size_t>(source_y0 + y) * static_cast<size_t>(shadow._width) + source_x0];
+         auto* target = &atlas._texture._pixels[static_cast<size_t>(target_y0 + y) * static_cast<size_t>(texture_width) + target_x0];
+         std::memcpy(target, source, static_cast<size_t>(copy_width));
+      }
+
+      atlas._placements.insert(atlas._placements.end(), placements_by_quad[quad_index].begin(), placements_by_quad[quad_index].end());
+   }
+
+   return atlas;
+}
+
+bool AoGenerator::writeUvFile(const std::filesystem::path& path, const AoAtlas& atlas)
+{
+   std::ofstream uv_file(path);
+   if (!uv_file.is_open())
+   {
+      return false;
+   }
+
+   for (const auto& placement : atlas._placements)
+   {
+      uv_file << placement._quad_index << ";" << placement._x_px << ";" << placement._y_px << ";" << placement._width_px << ";"
+              << placement._height_px << "\n";
+   }
+
+   return uv_file.good();
+}
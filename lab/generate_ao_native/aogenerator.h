@@ -0,0 +1,74 @@
+#pragma once
+
+#include "pngio.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+/// \brief Settings of one ao generation run.
+struct AoSettings
+{
+   uint8_t _shadow_alpha = 128;  //!< alpha of a fully shadowed pixel before blurring
+   float _blur_radius = 8.0f;    //!< blur radius as given to the old qt tool, the gaussian's sigma is half of it
+   int32_t _tile_size = 64;      //!< edge length of an atlas tile in px
+   int32_t _thread_count = 0;    //!< 0 picks one per hardware thread
+};
+
+/// \brief Where one tile of the level goes; one line of the uv file.
+struct AoPlacement
+{
+   int32_t _quad_index = 0;  //!< index of the tile in the atlas
+   int32_t _x_px = 0;        //!< left edge in the level
+   int32_t _y_px = 0;        //!< top edge in the level
+   int32_t _width_px = 0;
+   int32_t _height_px = 0;
+};
+
+/// \brief The tile atlas and where its tiles are drawn.
+struct AoAtlas
+{
+   AlphaImage _texture;
+   std::vector<AoPlacement> _placements;  //!< ordered by quad index, which is what AmbientOcclusion::load relies on
+   int32_t _quad_count = 0;
+};
+
+/// \brief Turns a rasterized level layer into the ambient occlusion texture and uv file the game loads.
+///
+/// This does in one pass what generate_ao and packtexture did with Qt: every opaque pixel of the
+/// layer casts a shadow, the shadow is blurred, the layer itself is cut back out, and what is left is
+/// cut into tiles. Empty tiles are dropped and identical tiles are stored once.
+///
+/// The image is processed in bands of one tile row. Each band is blurred on its own, with enough
+/// rows above and below to cover the kernel, so the bands can be spread over worker threads and only
+/// a few rows of floats are alive per thread no matter how large the level is. Both blur passes run
+/// along contiguous rows and are left to the compiler to vectorize.
+class AoGenerator
+{
+public:
+   /// \brief Creates a generator.
+   /// \param settings How to generate.
+   explicit AoGenerator(const AoSettings& settings);
+
+   /// \brief Casts, blurs and cuts out the shadow of a level layer.
+   /// \param layer Alpha channel of the rasterized layer; any non-zero alpha casts a shadow.
+   /// \return Shadow alpha, same size as the layer.
+   AlphaImage buildShadow(const AlphaImage& layer) const;
+
+   /// \brief Cuts the shadow into tiles and packs the distinct non-empty ones into an atlas.
+   /// \param shadow Output of buildShadow.
+   /// \return The atlas and the placement of every non-empty tile.
+   AoAtlas pack(const AlphaImage& shadow) const;
+
+   /// \brief Writes the placements in the format AmbientOcclusion::load reads.
+   /// \param path Uv file to write.
+   /// \param atlas Packed atlas.
+   /// \return True if the file was written.
+   static bool writeUvFile(const std::filesystem::path& path, const AoAtlas& atlas);
+
+private:
+   AoSettings _settings;
+   int32_t _thread_count = 1;
+   int32_t _kernel_radius = 0;
+   std::vector<float> _kernel;
+};
@@ -0,0 +1,137 @@
+#include "aogenerator.h"
+#include "pngio.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+// headless replacement for the qt based generate_ao and packtexture tools: reads the png of a level's
+// 'level' layer as written by tmxrasterizer and writes <name>_ao_tiles.png and <name>_ao_tiles.uv,
+// the pair ambient_occlusion.json points to.
+//
+// usage: generate_ao_native <level.png> [--alpha 0..1] [--radius px] [--tile-size px] [--threads n] [--output-dir dir]
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+void printUsage(const char* executable)
+{
+   std::cout << "usage: " << executable << " <level.png> [--alpha 0..1] [--radius px] [--tile-size px] [--threads n] [--output-dir dir]"
+             << std::endl;
+   std::cout << "  --alpha       shadow intensity (default = 0.5)" << std::endl;
+   std::cout << "  --radius      blur radius (default = 8)" << std::endl;
+   std::cout << "  --tile-size   atlas tile size, must divide 512 (default = 64)" << std::endl;
+   std::cout << "  --threads     worker threads, 0 for one per core (default = 0)" << std::endl;
+   std::cout << "  --output-dir  where the texture and uv file go (default = next to the input)" << std::endl;
+}
+
+int64_t getElapsedMs(Clock::time_point start)
+{
+   return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+}
+}  // namespace
+
+int32_t main(int32_t argc, char* argv[])
+{
+   AoSettings settings;
+   std::filesystem::path input_path;
+   std::filesystem::path output_dir;
+
+   for (auto i = 1; i < argc; i++)
+   {
+      const std::string argument = argv[i];
+      const auto has_value = (i + 1 < argc);
+
+      if (argument == "--alpha" && has_value)
+      {
+         const auto alpha = std::strtof(argv[++i], nullptr);
+         settings._shadow_alpha = static_cast<uint8_t>(std::clamp(static_cast<int32_t>(alpha * 255.0f), 0, 255));
+      }
+      else if (argument == "--radius" && has_value)
+      {
+         settings._blur_radius = std::strtof(argv[++i], nullptr);
+      }
+      else if (argument == "--tile-size" && has_value)
+      {
+         settings._tile_size = std::atoi(argv[++i]);
+      }
+      else if (argument == "--threads" && has_value)
+      {
+         settings._thread_count = std::atoi(argv[++i]);
+      }
+      else if (argument == "--output-dir" && has_value)
+      {
+         output_dir = argv[++i];
+      }
+      else if (argument.starts_with("-"))
+      {
+         printUsage(argv[0]);
+         return EXIT_FAILURE;
+      }
+      else
+      {
+         input_path = argument;
+      }
+   }
+
+   // the game finds a quad's column through (index * tile size) % texture width, so every atlas width
+   // has to hold a whole number of tiles
+   if (input_path.empty() || settings._tile_size <= 0 || 512 % settings._tile_size != 0)
+   {
+      printUsage(argv[0]);
+      return EXIT_FAILURE;
+   }
+
+   if (output_dir.empty())
+   {
+      output_dir = input_path.parent_path();
+   }
+
+   const auto base_name = input_path.stem().string() + "_ao_tiles";
+   const auto texture_path = output_dir / (base_name + ".png");
+   const auto uv_path = output_dir / (base_name + ".uv");
+
+   std::cout << "[x] processing texture: " << input_path.string() << std::endl;
+
+   auto start = Clock::now();
+   const auto layer = readPngAlpha(input_path);
+   if (!layer.has_value())
+   {
+      std::cerr << "[!] unable to read file: " << input_path.string() << std::endl;
+      return EXIT_FAILURE;
+   }
+   std::cout << "[x] loaded " << layer->_width << "x" << layer->_height << " px in " << getElapsedMs(start) << "ms" << std::endl;
+
+   AoGenerator generator(settings);
+
+   start = Clock::now();
+   const auto shadow = generator.buildShadow(layer.value());
+   std::cout << "[x] cast and blurred shadow in " << getElapsedMs(start) << "ms" << std::endl;
+
+   start = Clock::now();
+   const auto atlas = generator.pack(shadow);
+   std::cout << "[x] packed " << atlas._placements.size() << " tiles into " << atlas._quad_count << " quads, " << atlas._texture._width
+             << "x" << atlas._texture._height << " px, in " << getElapsedMs(start) << "ms" << std::endl;
+
+   start = Clock::now();
+   if (!writeBlackPng(texture_path, atlas._texture))
+   {
+      std::cerr << "[!] unable to write texture: " << texture_path.string() << std::endl;
+      return EXIT_FAILURE;
+   }
+
+   if (!AoGenerator::writeUvFile(uv_path, atlas))
+   {
+      std::cerr << "[!] unable to write uv file: " << uv_path.string() << std::endl;
+      return EXIT_FAILURE;
+   }
+   std::cout << "[x] written " << texture_path.string() << " and " << uv_path.string() << " in " << getElapsedMs(start) << "ms"
+             << std::endl;
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,138 @@
+#include "pngio.h"
+
+#include <png.h>
+
+#include <csetjmp>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+
+namespace
+{
+struct FileCloser
+{
+   void operator()(FILE* file) const
+   {
+      std::fclose(file);
+   }
+};
+
+using FilePtr = std::unique_ptr<FILE, FileCloser>;
+}  // namespace
+
+std::optional<AlphaImage> readPngAlpha(const std::filesystem::path& path)
+{
+   FilePtr file(std::fopen(path.string().c_str(), "rb"));
+   if (!file)
+   {
+      return std::nullopt;
+   }
+
+   auto* png = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+   auto* info = png ? png_create_info_struct(png) : nullptr;
+   if (!info)
+   {
+      png_destroy_read_struct(&png, nullptr, nullptr);
+      return std::nullopt;
+   }
+
+   AlphaImage image;
+   std::vector<uint8_t> row;
+
+   // libpng reports errors by jumping back here
+   if (setjmp(png_jmpbuf(png)))
+   {
+      png_destroy_read_struct(&png, &info, nullptr);
+      return std::nullopt;
+   }
+
+   png_init_io(png, file.get());
+   png_read_info(png, info);
+
+   if (png_get_interlace_type(png, info) != PNG_INTERLACE_NONE)
+   {
+      std::cerr << "[!] interlaced pngs are not supported" << std::endl;
+      png_destroy_read_struct(&png, &info, nullptr);
+      return std::nullopt;
+   }
+
+   // whatever comes in, convert it to 8 bit rgba
+   png_set_expand(png);
+   png_set_strip_16(png);
+   png_set_gray_to_rgb(png);
+   png_set_filler(png, 0xff, PNG_FILLER_AFTER);
+   png_read_update_info(png, info);
+
+   image._width = static_cast<int32_t>(png_get_image_width(png, info));
+   image._height = static_cast<int32_t>(png_get_image_height(png, info));
+   image._pixels.resize(static_cast<size_t>(image._width) * static_cast<size_t>(image._height));
+   row.resize(png_get_rowbytes(png, info));
+
+   for (auto y = 0; y < image._height; y++)
+   {
+      png_read_row(png, row.data(), nullptr);
+
+      auto* alpha = &image._pixels[static_cast<size_t>(y) * static_cast<size_t>(image._width)];
+      for (auto x = 0; x < image._width; x++)
+      {
+         alpha[x] = row[static_cast<size_t>(x) * 4 + 3];
+      }
+   }
+
+   png_destroy_read_struct(&png, &info, nullptr);
+   return image;
+}
+
+bool writeBlackPng(const std::filesystem::path& path, const AlphaImage& alpha)
+{
+   FilePtr file(std::fopen(path.string().c_str(), "wb"));
+   if (!file)
+   {
+      return false;
+   }
+
+   auto* png = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+   auto* info = png ? png_create_info_struct(png) : nullptr;
+   if (!info)
+   {
+      png_destroy_write_struct(&png, nullptr);
+      return false;
+   }
+
+   std::vector<uint8_t> row(static_cast<size_t>(alpha._width) * 4, 0);
+
+   if (setjmp(png_jmpbuf(png)))
+   {
+      png_destroy_write_struct(&png, &info);
+      return false;
+   }
+
+   png_init_io(png, file.get());
+   png_set_IHDR(
+      png,
+      info,
+      static_cast<png_uint_32>(alpha._width),
+      static_cast<png_uint_32>(alpha._height),
+      8,
+      PNG_COLOR_TYPE_RGB_ALPHA,
+      PNG_INTERLACE_NONE,
+      PNG_COMPRESSION_TYPE_DEFAULT,
+      PNG_FILTER_TYPE_DEFAULT
+   );
+   png_write_info(png, info);
+
+   for (auto y = 0; y < alpha._height; y++)
+   {
+      const auto* source = &alpha._pixels[static_cast<size_t>(y) * static_cast<size_t>(alpha._width)];
+      for (auto x = 0; x < alpha._width; x++)
+      {
+         row[static_cast<size_t>(x) * 4 + 3] = source[x];
+      }
+
+      png_write_row(png, row.data());
+   }
+
+   png_write_end(png, nullptr);
+   png_destroy_write_struct(&png, &info);
+   return true;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+/// \brief A single channel image, one byte per pixel, row by row.
+struct AlphaImage
+{
+   int32_t _width = 0;
+   int32_t _height = 0;
+   std::vector<uint8_t> _pixels;
+};
+
+/// \brief Reads only the alpha channel of a png.
+///
+/// Level layers are rasterized at the full level size, which is easily a few hundred megapixels, so
+/// the rows are converted one at a time instead of decoding the whole image to rgba first. Images
+/// without an alpha channel read as fully opaque.
+///
+/// \param path Png to read.
+/// \return The alpha channel, std::nullopt when the file cannot be read.
+std::optional<AlphaImage> readPngAlpha(const std::filesystem::path& path);
+
+/// \brief Writes a black rgba png whose alpha channel is the given image.
+/// \param path Png to write.
+/// \param alpha Alpha channel of the image.
+/// \return True if the file was written.
+bool writeBlackPng(const std::filesystem::path& path, const AlphaImage& alpha);
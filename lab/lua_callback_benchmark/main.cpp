@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+extern "C"
+{
+#include "lauxlib.h"
+#include "lua.h"
+#include "lualib.h"
+}
+
+// measures what a lua callback pays to find the node it was called for, with 1, 100 and 1000 live nodes.
+// 'scan' is how LuaInterface::getObject used to work (find_if over the node list, returning a shared_ptr),
+// 'extra space' is how it works now (the node pointer stored in the lua_State's extra space). every node
+// runs its own vm and an update function that makes a fixed number of callbacks, like enemy scripts do
+// with their queries and setters.
+//
+// usage: lua_callback_benchmark [step_count]
+
+namespace
+{
+
+struct SyntheticNode
+{
+   lua_State* _lua_state{nullptr};
+   int64_t _callbacks{0};
+};
+
+std::vector<std::shared_ptr<SyntheticNode>> _node_list;
+
+std::shared_ptr<SyntheticNode> getObjectByScan(lua_State* state)
+{
+   const auto it = std::find_if(_node_list.cbegin(), _node_list.cend(), [state](const auto& node) { return node->_lua_state == state; });
+   return (it != _node_list.cend()) ? *it : nullptr;
+}
+
+SyntheticNode* getObjectByExtraSpace(lua_State* state)
+{
+   return *static_cast<SyntheticNode**>(lua_getextraspace(state));
+}
+
+int32_t pingByScan(lua_State* state)
+{
+   auto node = getObjectByScan(state);
+   if (node)
+   {
+      node->_callbacks++;
+   }
+   return 0;
+}
+
+int32_t pingByExtraSpace(lua_State* state)
+{
+   auto node = getObjectByExtraSpace(state);
+   if (node)
+   {
+      node->_callbacks++;
+   }
+   return 0;
+}
+
+constexpr auto callbacks_per_update = 8;
+
+constexpr auto script = R"(
+function update()
+   for i = 1, 8 do
+      ping()
+   end
+end
+)";
+
+void createNodes(int32_t count, lua_CFunction ping)
+{
+   _node_list.clear();
+   for (auto i = 0; i < count; i++)
+   {
+      auto node = std::make_shared<SyntheticNode>();
+      node->_lua_state = luaL_newstate();
+      *static_cast<SyntheticNode**>(lua_getextraspace(node->_lua_state)) = node.get();
+      lua_register(node->_lua_state, "ping", ping);
+      luaL_openlibs(node->_lua_state);
+      if (luaL_dostring(node->_lua_state, script) != LUA_OK)
+      {
+         std::cerr << lua_tostring(node->_lua_state, -1) << std::endl;
+         std::exit(1);
+      }
+      _node_list.push_back(node);
+   }
+}
+
+void destroyNodes()
+{
+   for (auto& node : _node_list)
+   {
+      lua_close(node->_lua_state);
+   }
+   _node_list.clear();
+}
+
+struct Result
+{
+   double _ns_per_callback{0.0};
+   int64_t _callbacks{0};
+};
+
+Result run(int32_t node_count, int32_t step_count, lua_CFunction ping)
+{
+   createNodes(node_count, ping);
+
+   // the same number of callbacks for every node count, so the per callback times are comparable
+   const auto steps = std::max(1, step_count / node_count);
+
+   using Clock = std::chrono::steady_clock;
+   const auto start = Clock::now();
+   for (auto step = 0; step < steps; step++)
+   {
+      for (const auto& node : _node_list)
+      {
+         lua_getglobal(node->_lua_state, "update");
+         lua_pcall(node->_lua_state, 0, 0, 0);
+      }
+   }
+   const auto duration = Clock::now() - start;
+
+   Result result;
+   for (const auto& node : _node_list)
+   {
+      result._callbacks += node->_callbacks;
+   }
+   result._ns_per_callback = std::chrono::duration<double, std::nano>(duration).count() / static_cast<double>(result._callbacks);
+
+   destroyNodes();
+   return result;
+}
+
+}  // namespace
+
+int main(int32_t argc, char** argv)
+{
+   const auto step_count = (argc > 1) ? std::atoi(argv[1]) : 200000;
+
+   std::cout << std::fixed << std::setprecision(1);
+   std::cout << callbacks_per_update << " callbacks per node update, " << step_count << " node updates per run" << std::endl;
+
+   auto failed = false;
+   for (const auto node_count : {1, 100, 1000})
+   {
+      const auto scan = run(node_count, step_count, pingByScan);
+      const auto extra_space = run(node_count, step_count, pingByExtraSpace);
+
+      std::cout << std::setw(5) << node_count << " nodes | scan: " << std::setw(8) << scan._ns_per_callback << " ns/callback | extra space: "
+                << std::setw(8) << extra_space._ns_per_callback << " ns/callback" << std::endl;
+
+      if (scan._callbacks != extra_space._callbacks)
+      {
+         std::cout << "error: both lookups should resolve every callback" << std::endl;
+         failed = true;
+      }
+   }
+
+   return failed ? 1 : 0;
+}
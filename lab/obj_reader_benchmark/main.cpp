@@ -0,0 +1,238 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "game/io/objfile.h"
+
+// writes and reads a collision mesh the size of a very large level - one million vertices in closed
+// loops of four, the shape Physics::dumpObj produces for tile outlines - with the stream based code
+// Mesh used before and with the from_chars parser over a mapped file. the level loader used to read
+// the optimized obj twice, once for the physics chains and once for the level map, so the old
+// column is shown for both a single and a double read.
+//
+// usage: obj_reader_benchmark [vertex_count] [repetitions]
+
+namespace
+{
+
+using Clock = std::chrono::high_resolution_clock;
+
+// Mesh::writeObj before it was moved into objfile.cpp
+void writeObjStream(const std::string& filename, const std::vector<b2Vec2>& vertices, const std::vector<std::vector<uint32_t>>& faces)
+{
+   std::ofstream out(filename);
+
+   out.setf(std::ios::fixed);
+   for (const auto& v : vertices)
+   {
+      out << std::setprecision(3) << "v " << v.x << " " << v.y << " " << 0.0f << std::endl;
+   }
+
+   out << std::endl;
+
+   for (const auto& face : faces)
+   {
+      out << "f ";
+      for (const auto p : face)
+      {
+         out << p << " ";
+      }
+      out << std::endl;
+   }
+
+   out.close();
+}
+
+// Mesh::readObj before it was replaced, the unused triangulation branch left out
+void readObjStream(const std::string& filename, std::vector<b2Vec2>& points, std::vector<std::vector<uint32_t>>& faces)
+{
+   struct Vertex
+   {
+      uint32_t pIndex = 0;
+      uint32_t nIndex = 0;
+      uint32_t tcIndex = 0;
+   };
+
+   std::vector<Vertex> vertices;
+   std::vector<b2Vec2> normals;
+   std::vector<b2Vec2> uvs;
+
+   auto trimString = [](std::string& str)
+   {
+      const char* whitespace = " \t\n\r";
+      size_t location = str.find_first_not_of(whitespace);
+      str.erase(0, location);
+      location = str.find_last_not_of(whitespace);
+      str.erase(location + 1);
+   };
+
+   std::ifstream obj_stream(filename, std::ios::in);
+   std::string line, token;
+
+   getline(obj_stream, line);
+
+   while (!obj_stream.eof())
+   {
+      trimString(line);
+
+      if (line.length() > 0 && line.at(0) != '#')
+      {
+         std::istringstream line_stream(line);
+
+         line_stream >> token;
+
+         if (token == "v")
+         {
+            float x = 0.0f;
+            float y = 0.0f;
+            float z = 0.0f;
+
+            line_stream >> x >> y >> z;
+            points.emplace_back(x, y);
+         }
+         else if (token == "f")
+         {
+            std::vector<uint32_t> face;
+
+            while (line_stream.good())
+            {
+               std::string vert_string;
+               line_stream >> vert_string;
+
+               const auto p_index = static_cast<uint32_t>(atoi(vert_string.c_str()) - 1);
+               face.push_back(p_index);
+               vertices.push_back({p_index, 0, 0});
+            }
+
+            std::vector<uint32_t> face_indices;
+            for (auto i = 0u; i < face.size(); i++)
+            {
+               face_indices.push_back(face[i]);
+               vertices.push_back(vertices[i]);
+            }
+
+            faces.push_back(face_indices);
+         }
+      }
+
+      getline(obj_stream, line);
+   }
+}
+
+template <typename Function>
+double measureMs(int32_t repetitions, Function&& function)
+{
+   auto best_ms = 1e30;
+   for (auto i = 0; i < repetitions; i++)
+   {
+      const auto start = Clock::now();
+      function();
+      best_ms = std::min(best_ms, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+   }
+   return best_ms;
+}
+
+std::string readFile(const std::filesystem::path& path)
+{
+   std::ifstream file(path, std::ios::binary);
+   return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+
+}  // namespace
+
+int32_t main(int32_t argc, char** argv)
+{
+   const auto vertex_count = (argc > 1) ? std::atoi(argv[1]) : 1'000'000;
+   const auto repetitions = (argc > 2) ? std::atoi(argv[2]) : 3;
+
+   // tile sized boxes scattered over a 2000 x 500 tile level, each face closed by repeating its first
+   // index like the optimized outlines are
+   std::mt19937 rng(42);
+   std::uniform_int_distribution<int32_t> x_dist(0, 2000 * 24);
+   std::uniform_int_distribution<int32_t> y_dist(0, 500 * 24);
+   std::uniform_int_distribution<int32_t> fraction_dist(0, 999);
+
+   std::vector<b2Vec2> vertices;
+   std::vector<std::vector<uint32_t>> faces;
+   vertices.reserve(vertex_count);
+   for (auto i = 0; i + 4 <= vertex_count; i += 4)
+   {
+      const auto x = static_cast<float>(x_dist(rng)) + static_cast<float>(fraction_dist(rng)) / 1000.0f;
+      const auto y = static_cast<float>(y_dist(rng)) + static_cast<float>(fraction_dist(rng)) / 1000.0f;
+      vertices.emplace_back(x, y);
+      vertices.emplace_back(x, y + 24.0f);
+      vertices.emplace_back(x + 24.0f, y + 24.0f);
+      vertices.emplace_back(x + 24.0f, y);
+
+      const auto first = static_cast<uint32_t>(i + 1);
+      faces.push_back({first, first + 1, first + 2, first + 3, first});
+   }
+
+   const auto temp_dir = std::filesystem::temp_directory_path();
+   const auto stream_path = temp_dir / "obj_reader_benchmark_stream.obj";
+   const auto fast_path = temp_dir / "obj_reader_benchmark_fast.obj";
+
+   const auto write_stream_ms = measureMs(repetitions, [&]() { writeObjStream(stream_path.string(), vertices, faces); });
+   const auto write_fast_ms = measureMs(repetitions, [&]() { Mesh::writeObj(fast_path.string(), vertices, faces); });
+
+   if (readFile(stream_path) != readFile(fast_path))
+   {
+      std::cerr << "writers disagree" << std::endl;
+      return EXIT_FAILURE;
+   }
+
+   std::vector<b2Vec2> stream_points;
+   std::vector<std::vector<uint32_t>> stream_faces;
+   const auto read_stream_ms = measureMs(
+      repetitions,
+      [&]()
+      {
+         stream_points.clear();
+         stream_faces.clear();
+         readObjStream(stream_path.string(), stream_points, stream_faces);
+      }
+   );
+
+   std::shared_ptr<const Mesh::ObjMesh> mesh;
+   const auto read_fast_ms = measureMs(repetitions, [&]() { mesh = Mesh::loadObj(fast_path); });
+
+   // the two readers have to agree on every point and every face
+   auto identical = mesh && mesh->_points.size() == stream_points.size() && mesh->getFaceCount() == stream_faces.size();
+   for (auto i = 0u; identical && i < stream_points.size(); i++)
+   {
+      identical = mesh->_points[i].x == stream_points[i].x && mesh->_points[i].y == stream_points[i].y;
+   }
+   for (auto i = 0u; identical && i < stream_faces.size(); i++)
+   {
+      identical = std::ranges::equal(mesh->getFace(i), stream_faces[i]);
+   }
+
+   if (!identical)
+   {
+      std::cerr << "readers disagree" << std::endl;
+      return EXIT_FAILURE;
+   }
+
+   std::cout << std::fixed << std::setprecision(1);
+   std::cout << vertex_count << " vertices, " << faces.size() << " faces, " << std::filesystem::file_size(fast_path) / (1024 * 1024)
+             << " MB, best of " << repetitions << std::endl;
+   std::cout << std::endl;
+   std::cout << "                   stream    from_chars" << std::endl;
+   std::cout << "write            " << std::setw(8) << write_stream_ms << " ms " << std::setw(8) << write_fast_ms << " ms" << std::endl;
+   std::cout << "read             " << std::setw(8) << read_stream_ms << " ms " << std::setw(8) << read_fast_ms << " ms" << std::endl;
+   std::cout << "read per load    " << std::setw(8) << 2.0 * read_stream_ms << " ms " << std::setw(8) << read_fast_ms << " ms" << std::endl;
+
+   std::filesystem::remove(stream_path);
+   std::filesystem::remove(fast_path);
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,391 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "framework/tools/binarystream.h"
+#include "game/physics/contourtracer.h"
+
+// traces the outlines of a large generated tile map - solid rock with caves, platforms and pillars -
+// with the contour walk SquareMarcher used to do itself and with ContourTracer on one and on all
+// hardware threads, then writes and reads the outlines in the old text cache format and in the new
+// binary one. the outlines of the single threaded and the banded trace have to be identical.
+//
+// usage: square_marcher_benchmark [map_size]
+
+namespace
+{
+
+using Clock = std::chrono::high_resolution_clock;
+using Direction = ContourTracer::Direction;
+
+double elapsedMs(Clock::time_point start)
+{
+   return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+std::vector<int32_t> makeMap(uint32_t size)
+{
+   std::mt19937 rng(1234);
+   std::vector<int32_t> tiles(static_cast<size_t>(size) * size, 1);
+
+   const auto fill = [&](int32_t x0, int32_t y0, int32_t w, int32_t h, int32_t value)
+   {
+      for (auto y = std::max(y0, 1); y < std::min(y0 + h, static_cast<int32_t>(size) - 1); y++)
+      {
+         for (auto x = std::max(x0, 1); x < std::min(x0 + w, static_cast<int32_t>(size) - 1); x++)
+         {
+            tiles[static_cast<size_t>(y) * size + x] = value;
+         }
+      }
+   };
+
+   // carve caves out of the rock, then put platforms and pillars back in
+   std::uniform_int_distribution<int32_t> pos_dist(0, static_cast<int32_t>(size));
+   std::uniform_int_distribution<int32_t> cave_dist(8, 120);
+   std::uniform_int_distribution<int32_t> block_dist(1, 12);
+   std::uniform_int_distribution<int32_t> tile_dist(2, 5);
+
+   const auto cave_count = static_cast<int32_t>(size) * static_cast<int32_t>(size) / 2000;
+   for (auto i = 0; i < cave_count; i++)
+   {
+      fill(pos_dist(rng), pos_dist(rng), cave_dist(rng), cave_dist(rng) / 2, 0);
+   }
+
+   const auto block_count = cave_count * 6;
+   for (auto i = 0; i < block_count; i++)
+   {
+      fill(pos_dist(rng), pos_dist(rng), block_dist(rng), block_dist(rng), (i % 3 == 0) ? tile_dist(rng) : 1);
+   }
+
+   return tiles;
+}
+
+// the walk SquareMarcher did before: a tile id lookup per test, a std::vector<bool> for the visited
+// cells and the walker state kept between calls
+class PreviousMarcher
+{
+public:
+   PreviousMarcher(uint32_t width, uint32_t height, const std::vector<int32_t>& tiles, const std::vector<int32_t>& colliding_tiles)
+       : _width(width), _height(height), _tiles(tiles), _colliding_tiles(colliding_tiles), _visited(width * height)
+   {
+   }
+
+   std::vector<ContourTracer::Contour> scan()
+   {
+      std::vector<ContourTracer::Contour> contours;
+      for (auto y = 0u; y < _height; y++)
+      {
+         for (auto x = 0u; x < _width; x++)
+         {
+            if (!isVisited(x, y) && isColliding(x, y))
+            {
+               auto contour = march(x, y);
+               if (!contour._points.empty())
+               {
+                  contours.push_back(std::move(contour));
+               }
+            }
+         }
+      }
+      return contours;
+   }
+
+private:
+   bool isColliding(uint32_t x, uint32_t y) const
+   {
+      if (x >= _width || y >= _height)
+      {
+         return false;
+      }
+
+      return std::find(_colliding_tiles.begin(), _colliding_tiles.end(), _tiles[y * _width + x]) != _colliding_tiles.end();
+   }
+
+   bool isVisited(uint32_t x, uint32_t y) const
+   {
+      return x < _width && y < _height && _visited[y * _width + x];
+   }
+
+   void updateDirection()
+   {
+      auto four_pixels = 0;
+      four_pixels |= isColliding(_x - 1, _y - 1) ? 1 : 0;
+      four_pixels |= isColliding(_x, _y - 1) ? 2 : 0;
+      four_pixels |= isColliding(_x - 1, _y) ? 4 : 0;
+      four_pixels |= isColliding(_x, _y) ? 8 : 0;
+
+      _dir_previous = _dir_current;
+
+      switch (four_pixels)
+      {
+         case 1:
+         case 5:
+         case 13:
+            _dir_current = Direction::Up;
+            break;
+         case 2:
+         case 3:
+         case 7:
+            _dir_current = Direction::Right;
+            break;
+         case 4:
+         case 12:
+         case 14:
+            _dir_current = Direction::Left;
+            break;
+         case 8:
+         case 10:
+         case 11:
+            _dir_current = Direction::Down;
+            break;
+         case 6:
+            _dir_current = (_dir_previous == Direction::Up) ? Direction::Left : Direction::Right;
+            break;
+         case 9:
+            _dir_current = (_dir_previous == Direction::Right) ? Direction::Up : Direction::Down;
+            break;
+         default:
+            _dir_current = Direction::None;
+            break;
+      }
+   }
+
+   void updatePosition()
+   {
+      switch (_dir_current)
+      {
+         case Direction::Up:
+            _y -= 1;
+            break;
+         case Direction::Down:
+            _y += 1;
+            break;
+         case Direction::Left:
+            _x -= 1;
+            break;
+         case Direction::Right:
+            _x += 1;
+            break;
+         case Direction::None:
+            break;
+      }
+   }
+
+   ContourTracer::Contour march(uint32_t start_x, uint32_t start_y)
+   {
+      _x = start_x;
+      _y = start_y;
+
+      ContourTracer::Contour contour;
+      while (true)
+      {
+         // the old walk wrote one past the last column into the next row, which never matters here
+         // because the generated maps keep their border clear
+         if (_x < _width && _y < _height)
+         {
+            _visited[_y * _width + _x] = true;
+         }
+
+         updateDirection();
+         updatePosition();
+
+         if (_dir_current != Direction::None)
+         {
+            contour._dirs.push_back(_dir_current);
+            contour._points.push_back({static_cast<int32_t>(_x), static_cast<int32_t>(_y)});
+         }
+
+         if (_x == start_x && _y == start_y)
+         {
+            break;
+         }
+      }
+
+      return contour;
+   }
+
+   uint32_t _width;
+   uint32_t _height;
+   std::vector<int32_t> _tiles;
+   std::vector<int32_t> _colliding_tiles;
+   std::vector<bool> _visited;
+   uint32_t _x = 0;
+   uint32_t _y = 0;
+   Direction _dir_current = Direction::None;
+   Direction _dir_previous = Direction::None;
+};
+
+bool isSame(const std::vector<ContourTracer::Contour>& a, const std::vector<ContourTracer::Contour>& b)
+{
+   return std::ranges::equal(
+      a,
+      b,
+      [](const auto& left, const auto& right)
+      {
+         return left._dirs == right._dirs &&
+                std::ranges::equal(
+                   left._points, right._points, [](const auto& p, const auto& q) { return p._x == q._x && p._y == q._y; }
+                );
+      }
+   );
+}
+
+size_t countPoints(const std::vector<ContourTracer::Contour>& contours)
+{
+   size_t count = 0;
+   for (const auto& contour : contours)
+   {
+      count += contour._points.size();
+   }
+   return count;
+}
+
+// the text format SquareMarcher::serialize wrote
+void writeText(const std::filesystem::path& path, const std::vector<ContourTracer::Contour>& contours)
+{
+   std::ofstream file_out(path);
+   for (const auto& contour : contours)
+   {
+      for (const auto& pos : contour._points)
+      {
+         file_out << std::fixed << std::setprecision(8) << pos._x;
+         file_out << ",";
+         file_out << std::fixed << std::setprecision(3) << pos._y;
+         file_out << ";";
+      }
+      file_out << std::endl;
+   }
+}
+
+size_t readText(const std::filesystem::path& path)
+{
+   size_t point_count = 0;
+   std::string line;
+   std::ifstream file_in(path);
+   while (std::getline(file_in, line))
+   {
+      std::istringstream line_stream(line);
+      std::string item;
+      std::string eat_comma;
+      while (std::getline(line_stream, item, ';'))
+      {
+         std::istringstream pos_stream(item);
+         auto x = 0;
+         auto y = 0;
+         pos_stream >> x;
+         std::getline(pos_stream, eat_comma, ',');
+         pos_stream >> y;
+         point_count++;
+      }
+   }
+   return point_count;
+}
+
+void writeBinary(const std::filesystem::path& path, const std::vector<ContourTracer::Contour>& contours)
+{
+   BinaryWriter writer;
+   writer.write(static_cast<uint32_t>(contours.size()));
+   for (const auto& contour : contours)
+   {
+      writer.writeVector(contour._points);
+   }
+
+   std::ofstream file_out(path, std::ofstream::binary | std::ofstream::trunc);
+   file_out.write(writer.getBuffer().data(), static_cast<std::streamsize>(writer.getBuffer().size()));
+}
+
+size_t readBinary(const std::filesystem::path& path)
+{
+   std::ifstream file_in(path, std::ifstream::binary);
+   const std::vector<char> buffer((std::istreambuf_iterator<char>(file_in)), std::istreambuf_iterator<char>());
+
+   BinaryReader reader(buffer.data(), buffer.size());
+   size_t point_count = 0;
+   const auto contour_count = reader.read<uint32_t>();
+   for (auto i = 0u; i < contour_count && reader.isValid(); i++)
+   {
+      point_count += reader.readVector<ContourTracer::Point>().size();
+   }
+   return point_count;
+}
+
+}  // namespace
+
+int main(int32_t argc, char** argv)
+{
+   const auto size = static_cast<uint32_t>((argc > 1) ? std::atoi(argv[1]) : 4096);
+   const std::vector<int32_t> colliding_tiles = {1, 3};
+
+   auto start = Clock::now();
+   const auto tiles = makeMap(size);
+   const auto generate_ms = elapsedMs(start);
+
+   start = Clock::now();
+   PreviousMarcher previous(size, size, tiles, colliding_tiles);
+   const auto previous_contours = previous.scan();
+   const auto previous_ms = elapsedMs(start);
+
+   start = Clock::now();
+   const ContourTracer tracer(size, size, tiles, colliding_tiles);
+   const auto build_ms = elapsedMs(start);
+
+   start = Clock::now();
+   const auto single_contours = tracer.trace(1);
+   const auto single_ms = elapsedMs(start);
+
+   const auto thread_count = static_cast<int32_t>(std::max(std::thread::hardware_concurrency(), 1u));
+   start = Clock::now();
+   const auto banded_contours = tracer.trace(thread_count);
+   const auto banded_ms = elapsedMs(start);
+
+   const auto banded_8_contours = tracer.trace(8);
+
+   const auto text_path = std::filesystem::temp_directory_path() / "square_marcher_benchmark.txt";
+   const auto binary_path = std::filesystem::temp_directory_path() / "square_marcher_benchmark.bin";
+
+   start = Clock::now();
+   writeText(text_path, single_contours);
+   const auto text_write_ms = elapsedMs(start);
+   start = Clock::now();
+   const auto text_points = readText(text_path);
+   const auto text_read_ms = elapsedMs(start);
+
+   start = Clock::now();
+   writeBinary(binary_path, single_contours);
+   const auto binary_write_ms = elapsedMs(start);
+   start = Clock::now();
+   const auto binary_points = readBinary(binary_path);
+   const auto binary_read_ms = elapsedMs(start);
+
+   std::cout << std::fixed << std::setprecision(1);
+   std::cout << size << "x" << size << " tiles (generated in " << generate_ms << " ms), " << single_contours.size() << " outlines, "
+             << countPoints(single_contours) << " points" << std::endl;
+   std::cout << "previous walk:          " << previous_ms << " ms" << std::endl;
+   std::cout << "bit grid build:         " << build_ms << " ms" << std::endl;
+   std::cout << "trace, 1 band:          " << single_ms << " ms" << std::endl;
+   std::cout << "trace, " << thread_count << " bands:         " << banded_ms << " ms" << std::endl;
+   std::cout << "text cache:   " << std::filesystem::file_size(text_path) / 1024 << " KiB, write " << text_write_ms << " ms, read "
+             << text_read_ms << " ms" << std::endl;
+   std::cout << "binary cache: " << std::filesystem::file_size(binary_path) / 1024 << " KiB, write " << binary_write_ms << " ms, read "
+             << binary_read_ms << " ms" << std::endl;
+
+   std::filesystem::remove(text_path);
+   std::filesystem::remove(binary_path);
+
+   const auto same_as_previous = isSame(previous_contours, single_contours);
+   const auto same_banded = isSame(single_contours, banded_contours) && isSame(single_contours, banded_8_contours);
+   std::cout << "same outlines as the previous walk: " << (same_as_previous ? "yes" : "no") << ", banded same as single: "
+             << (same_banded ? "yes" : "no") << std::endl;
+
+   return (same_banded && text_points == binary_points) ? 0 : 1;
+}
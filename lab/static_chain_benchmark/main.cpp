@@ -0,0 +1,206 @@
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+#include "box2d/box2d.h"
+#include "game/constants.h"
+#include "game/physics/staticchainbake.h"
+
+// builds a large level the way Level::addPhysicsLayer does - thousands of small closed loops, one
+// fixture each - once with a static body per loop as before and once with the loops grouped into a
+// body per chunk. a few hundred dynamic bodies bounce around the level while the world is stepped,
+// then light-sized areas are queried the way LightSystem and WorldQuery resolve fixtures to bodies.
+//
+// usage: static_chain_benchmark [loop_count] [dynamic_body_count]
+
+namespace
+{
+
+using Clock = std::chrono::high_resolution_clock;
+
+constexpr auto level_width_px = 1200.0f * PIXELS_PER_TILE;
+constexpr auto level_height_px = 300.0f * PIXELS_PER_TILE;
+
+std::vector<std::vector<b2Vec2>> makeLoops(int32_t loop_count)
+{
+   std::mt19937 rng(42);
+   std::uniform_real_distribution<float> x_dist(0.0f, level_width_px / PPM);
+   std::uniform_real_distribution<float> y_dist(0.0f, level_height_px / PPM);
+   std::uniform_real_distribution<float> radius_dist(0.5f, 3.0f);
+   std::uniform_int_distribution<int32_t> vertex_dist(4, 12);
+
+   std::vector<std::vector<b2Vec2>> loops;
+   loops.reserve(loop_count);
+   for (auto i = 0; i < loop_count; i++)
+   {
+      const auto center = b2Vec2{x_dist(rng), y_dist(rng)};
+      const auto radius = radius_dist(rng);
+      const auto vertex_count = vertex_dist(rng);
+
+      std::vector<b2Vec2> loop;
+      for (auto v = 0; v < vertex_count; v++)
+      {
+         const auto angle = -2.0f * b2_pi * static_cast<float>(v) / static_cast<float>(vertex_count);
+         loop.push_back(center + radius * b2Vec2{std::cos(angle), std::sin(angle)});
+      }
+
+      loops.push_back(std::move(loop));
+   }
+
+   return loops;
+}
+
+void addLoop(b2Body* body, const std::vector<b2Vec2>& loop)
+{
+   b2ChainShape chain_shape;
+   chain_shape.CreateLoop(loop.data(), static_cast<int32_t>(loop.size()));
+
+   b2FixtureDef fixture_def;
+   fixture_def.friction = 0.2f;
+   fixture_def.shape = &chain_shape;
+   body->CreateFixture(&fixture_def);
+}
+
+void addDynamicBodies(b2World& world, int32_t count)
+{
+   std::mt19937 rng(7);
+   std::uniform_real_distribution<float> x_dist(0.0f, level_width_px / PPM);
+   std::uniform_real_distribution<float> y_dist(0.0f, level_height_px / PPM);
+   std::uniform_real_distribution<float> velocity_dist(-10.0f, 10.0f);
+
+   for (auto i = 0; i < count; i++)
+   {
+      b2BodyDef body_def;
+      body_def.type = b2_dynamicBody;
+      body_def.position.Set(x_dist(rng), y_dist(rng));
+      body_def.linearVelocity.Set(velocity_dist(rng), velocity_dist(rng));
+      auto* body = world.CreateBody(&body_def);
+
+      b2CircleShape circle;
+      circle.m_radius = 0.3f;
+
+      b2FixtureDef fixture_def;
+      fixture_def.density = 1.0f;
+      fixture_def.restitution = 0.9f;
+      fixture_def.shape = &circle;
+      body->CreateFixture(&fixture_def);
+   }
+}
+
+class BodyQuery : public b2QueryCallback
+{
+public:
+   bool ReportFixture(b2Fixture* fixture) override
+   {
+      _reported++;
+      _bodies.insert(fixture->GetBody());
+      return true;
+   }
+
+   std::unordered_set<b2Body*> _bodies;
+   int64_t _reported = 0;
+};
+
+struct Result
+{
+   int32_t _static_bodies = 0;
+   double _create_ms = 0.0;
+   double _step_ms = 0.0;
+   double _query_us = 0.0;
+   double _bodies_per_query = 0.0;
+};
+
+Result run(const std::vector<std::vector<b2Vec2>>& loops, const std::vector<uint32_t>& group_sizes, int32_t dynamic_body_count)
+{
+   constexpr auto step_count = 600;
+   constexpr auto query_count = 20000;
+
+   Result result;
+   b2World world({0.0f, 9.81f});
+
+   const auto create_start = Clock::now();
+   b2BodyDef body_def;
+   body_def.type = b2_staticBody;
+
+   auto loop_index = 0u;
+   for (const auto group_size : group_sizes)
+   {
+      auto* body = world.CreateBody(&body_def);
+      result._static_bodies++;
+      for (auto i = 0u; i < group_size; i++)
+      {
+         addLoop(body, loops[loop_index++]);
+      }
+   }
+   result._create_ms = std::chrono::duration<double, std::milli>(Clock::now() - create_start).count();
+
+   addDynamicBodies(world, dynamic_body_count);
+
+   const auto step_start = Clock::now();
+   for (auto step = 0; step < step_count; step++)
+   {
+      world.Step(1.0f / 60.0f, 8, 3);
+   }
+   result._step_ms = std::chrono::duration<double, std::milli>(Clock::now() - step_start).count() / step_count;
+
+   // light sprites and lua queries cover a few hundred pixels
+   std::mt19937 rng(99);
+   std::uniform_real_distribution<float> x_dist(0.0f, level_width_px / PPM);
+   std::uniform_real_distribution<float> y_dist(0.0f, level_height_px / PPM);
+   constexpr auto half_extent_m = 200.0f / PPM;
+
+   int64_t body_count = 0;
+   BodyQuery query;
+   const auto query_start = Clock::now();
+   for (auto i = 0; i < query_count; i++)
+   {
+      const auto center = b2Vec2{x_dist(rng), y_dist(rng)};
+      b2AABB aabb;
+      aabb.lowerBound = center - b2Vec2{half_extent_m, half_extent_m};
+      aabb.upperBound = center + b2Vec2{half_extent_m, half_extent_m};
+
+      query._bodies.clear();
+      world.QueryAABB(&query, aabb);
+      body_count += static_cast<int64_t>(query._bodies.size());
+   }
+   result._query_us = std::chrono::duration<double, std::micro>(Clock::now() - query_start).count() / query_count;
+   result._bodies_per_query = static_cast<double>(body_count) / query_count;
+
+   return result;
+}
+
+void print(const char* name, const Result& result)
+{
+   std::cout << name << result._static_bodies << " static bodies, create " << result._create_ms << " ms, step " << result._step_ms
+             << " ms, query " << result._query_us << " us (" << result._bodies_per_query << " bodies per query)" << std::endl;
+}
+
+}  // namespace
+
+int main(int32_t argc, char** argv)
+{
+   const auto loop_count = (argc > 1) ? std::atoi(argv[1]) : 20000;
+   const auto dynamic_body_count = (argc > 2) ? std::atoi(argv[2]) : 300;
+
+   auto loops = makeLoops(loop_count);
+   const std::vector<uint32_t> one_body_per_loop(loops.size(), 1);
+   const auto per_loop = run(loops, one_body_per_loop, dynamic_body_count);
+
+   const auto bake_start = Clock::now();
+   const auto group_sizes = StaticChainBake::groupByChunk(loops);
+   const auto bake_ms = std::chrono::duration<double, std::milli>(Clock::now() - bake_start).count();
+   const auto per_chunk = run(loops, group_sizes, dynamic_body_count);
+
+   std::cout << std::fixed << std::setprecision(3);
+   std::cout << loop_count << " loops, " << dynamic_body_count << " dynamic bodies, grouping took " << bake_ms << " ms" << std::endl;
+   print("body per loop:  ", per_loop);
+   print("body per chunk: ", per_chunk);
+
+   return StaticChainBake::isValid(group_sizes, loops.size()) ? 0 : 1;
+}
@@ -0,0 +1,271 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "framework/tools/timer.h"
+
+// schedules a large number of timers the way a level full of lua enemies does - mostly single shots a
+// fraction of a second to a few seconds out, some repeated, all grouped by owner - and then runs both
+// update scopes at 60 frames per second until every single shot has fired. compares the timing wheel
+// Timer keeps now against the list it used to keep, which ran remove_if over every timer in every update.
+// finally every owner drops its timers, as a level does when it is destroyed.
+//
+// usage: timer_benchmark [timer_count] [owner_count]
+
+namespace
+{
+
+using Clock = std::chrono::high_resolution_clock;
+
+// the previous implementation
+struct LinearTimers
+{
+   struct Entry
+   {
+      std::chrono::milliseconds _interval;
+      Timer::Type _type;
+      Timer::Scope _scope;
+      std::function<void()> _callback;
+      Clock::time_point _start_time;
+      const void* _caller;
+   };
+
+   std::vector<std::unique_ptr<Entry>> _timers;
+   std::mutex _mutex;
+
+   void update(Timer::Scope scope)
+   {
+      const auto now = Clock::now();
+      std::lock_guard<std::mutex> guard(_mutex);
+
+      _timers.erase(
+         std::remove_if(
+            _timers.begin(),
+            _timers.end(),
+            [now, scope](auto& timer) -> bool
+            {
+               if (timer->_scope != scope)
+               {
+                  return false;
+               }
+
+               auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - timer->_start_time);
+               auto delta = elapsed - timer->_interval;
+
+               if (delta > std::chrono::milliseconds(0))
+               {
+                  timer->_callback();
+
+                  if (timer->_type == Timer::Type::Singleshot)
+                  {
+                     return true;
+                  }
+
+                  timer->_start_time = now + delta;
+               }
+
+               return false;
+            }
+         ),
+         _timers.end()
+      );
+   }
+
+   void add(std::chrono::milliseconds interval, std::function<void()> callback, Timer::Type type, Timer::Scope scope, const void* caller)
+   {
+      auto timer = std::make_unique<Entry>(Entry{interval, type, scope, std::move(callback), Clock::now(), caller});
+      std::lock_guard<std::mutex> guard(_mutex);
+      _timers.push_back(std::move(timer));
+   }
+
+   void removeByCaller(const void* caller)
+   {
+      std::lock_guard<std::mutex> guard(_mutex);
+      _timers.erase(
+         std::remove_if(_timers.begin(), _timers.end(), [caller](const auto& timer) { return timer->_caller == caller; }), _timers.end()
+      );
+   }
+};
+
+struct PlannedTimer
+{
+   std::chrono::milliseconds _interval;
+   Timer::Type _type;
+   Timer::Scope _scope;
+   int32_t _owner;
+};
+
+std::vector<PlannedTimer> planTimers(int32_t timer_count, int32_t owner_count)
+{
+   std::mt19937 rng(1234);
+   std::uniform_int_distribution<int32_t> interval_dist(10, 1000);
+   std::uniform_int_distribution<int32_t> kind_dist(0, 9);
+   std::uniform_int_distribution<int32_t> owner_dist(0, owner_count - 1);
+
+   std::vector<PlannedTimer> timers;
+   timers.reserve(timer_count);
+   for (auto i = 0; i < timer_count; i++)
+   {
+      const auto kind = kind_dist(rng);
+      timers.push_back(
+         {std::chrono::milliseconds(interval_dist(rng)),
+          (kind == 0) ? Timer::Type::Repeated : Timer::Type::Singleshot,
+          (kind < 3) ? Timer::Scope::UpdateAlways : Timer::Scope::UpdateIngame,
+          owner_dist(rng)}
+      );
+   }
+
+   return timers;
+}
+
+struct RunResult
+{
+   double _add_ms{0.0};
+   double _update_ms{0.0};
+   double _remove_ms{0.0};
+   int32_t _frames{0};
+   int64_t _callbacks{0};
+};
+
+template <typename Add, typename Update, typename Remove>
+RunResult run(const std::vector<PlannedTimer>& planned, int32_t owner_count, Add add, Update update, Remove remove)
+{
+   RunResult result;
+   const auto single_shot_count = std::count_if(
+      planned.cbegin(), planned.cend(), [](const auto& timer) { return timer._type == Timer::Type::Singleshot; }
+   );
+   int64_t single_shots_fired = 0;
+
+   const auto add_start = Clock::now();
+   for (const auto& timer : planned)
+   {
+      const auto single_shot = (timer._type == Timer::Type::Singleshot);
+      add(
+         timer._interval,
+         [&result, &single_shots_fired, single_shot]()
+         {
+            result._callbacks++;
+            single_shots_fired += single_shot ? 1 : 0;
+         },
+         timer._type,
+         timer._scope,
+         reinterpret_cast<const void*>(static_cast<intptr_t>(timer._owner + 1))
+      );
+   }
+   result._add_ms = std::chrono::duration<double, std::milli>(Clock::now() - add_start).count();
+
+   auto next_frame = Clock::now();
+   while (single_shots_fired < single_shot_count)
+   {
+      next_frame += std::chrono::microseconds(16667);
+      std::this_thread::sleep_until(next_frame);
+
+      const auto update_start = Clock::now();
+      update(Timer::Scope::UpdateAlways);
+      update(Timer::Scope::UpdateIngame);
+      result._update_ms += std::chrono::duration<double, std::milli>(Clock::now() - update_start).count();
+      result._frames++;
+   }
+
+   const auto remove_start = Clock::now();
+   for (auto owner = 0; owner < owner_count; owner++)
+   {
+      remove(reinterpret_cast<const void*>(static_cast<intptr_t>(owner + 1)));
+   }
+   result._remove_ms = std::chrono::duration<double, std::milli>(Clock::now() - remove_start).count();
+
+   return result;
+}
+
+// the common case: lots of timers registered, next to none of them due. returns ms per frame
+template <typename Add, typename Update, typename Remove>
+double runIdle(int32_t timer_count, Add add, Update update, Remove remove)
+{
+   constexpr auto frame_count = 30;
+   const auto* caller = reinterpret_cast<const void*>(static_cast<intptr_t>(1));
+
+   for (auto i = 0; i < timer_count; i++)
+   {
+      add(std::chrono::milliseconds(60000 + i % 1000), []() {}, Timer::Type::Singleshot, Timer::Scope::UpdateIngame, caller);
+   }
+
+   auto update_ms = 0.0;
+   auto next_frame = Clock::now();
+   for (auto frame = 0; frame < frame_count; frame++)
+   {
+      next_frame += std::chrono::microseconds(16667);
+      std::this_thread::sleep_until(next_frame);
+
+      const auto update_start = Clock::now();
+      update(Timer::Scope::UpdateAlways);
+      update(Timer::Scope::UpdateIngame);
+      update_ms += std::chrono::duration<double, std::milli>(Clock::now() - update_start).count();
+   }
+
+   remove(caller);
+   return update_ms / frame_count;
+}
+
+void printRun(const char* name, const RunResult& result, double idle_ms)
+{
+   std::cout << name << "add " << result._add_ms << " ms, update " << result._update_ms / result._frames << " ms/frame over "
+             << result._frames << " frames, removeByCaller " << result._remove_ms << " ms, " << result._callbacks << " callbacks, "
+             << "idle update " << idle_ms << " ms/frame" << std::endl;
+}
+
+}  // namespace
+
+int main(int32_t argc, char** argv)
+{
+   const auto timer_count = (argc > 1) ? std::atoi(argv[1]) : 100000;
+   const auto owner_count = (argc > 2) ? std::atoi(argv[2]) : 2000;
+
+   const auto planned = planTimers(timer_count, owner_count);
+
+   LinearTimers linear;
+   const auto linear_add = [&linear](auto interval, auto callback, auto type, auto scope, auto caller)
+   { linear.add(interval, std::move(callback), type, scope, caller); };
+   const auto linear_update = [&linear](auto scope) { linear.update(scope); };
+   const auto linear_remove = [&linear](auto caller) { linear.removeByCaller(caller); };
+
+   const auto wheel_add = [](auto interval, auto callback, auto type, auto scope, auto caller)
+   { Timer::add(interval, std::move(callback), type, scope, nullptr, caller); };
+   const auto wheel_update = [](auto scope) { Timer::update(scope); };
+   const auto wheel_remove = [](auto caller) { Timer::removeByCaller(caller); };
+
+   const auto linear_result = run(planned, owner_count, linear_add, linear_update, linear_remove);
+   const auto linear_idle_ms = runIdle(timer_count, linear_add, linear_update, linear_remove);
+   const auto wheel_result = run(planned, owner_count, wheel_add, wheel_update, wheel_remove);
+   const auto wheel_idle_ms = runIdle(timer_count, wheel_add, wheel_update, wheel_remove);
+
+   std::cout << std::fixed << std::setprecision(3);
+   std::cout << timer_count << " timers, " << owner_count << " owners" << std::endl;
+   printRun("linear list: ", linear_result, linear_idle_ms);
+   printRun("timer wheel: ", wheel_result, wheel_idle_ms);
+
+   // a callback that adds a timer used to deadlock; now it has to fire in a later update
+   auto chained = 0;
+   Timer::add(std::chrono::milliseconds(0), [&chained]() { Timer::add(std::chrono::milliseconds(0), [&chained]() { chained++; }); });
+   for (auto frame = 0; frame < 3 && chained == 0; frame++)
+   {
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      Timer::update(Timer::Scope::UpdateAlways);
+   }
+
+   if (chained != 1 || Timer::getTimerCount() != 0)
+   {
+      std::cout << "error: " << Timer::getTimerCount() << " timers left over, chained timer fired " << chained << " times" << std::endl;
+      return 1;
+   }
+
+   return 0;
+}
@@ -0,0 +1,270 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "game/mechanisms/watersurfacesimulation.h"
+
+// steps a handful of water surfaces of ten thousand segments each, the way WaterSurface::update runs
+// them at 60 fps, with the per segment struct loop WaterSurface used before and with the array per
+// field kernel in WaterSurfaceSimulation. the surfaces are splashed at random every few frames so they
+// never settle, and both have to end on exactly the same heights. the new kernel is then run once with
+// one task per surface like the game does for large surfaces, and once more on calm water to show what
+// a sleeping surface costs.
+//
+// usage: water_surface_benchmark [segment_count] [surface_count] [frame_count]
+
+namespace
+{
+
+using Clock = std::chrono::high_resolution_clock;
+
+constexpr auto elapsed_s = 1.0f / 60.0f;
+constexpr auto splash_interval = 10;
+constexpr auto integration_steps = 8;
+
+// WaterSurface::Segment before the simulation moved out of it
+struct Segment
+{
+   void update(float dampening, float tension)
+   {
+      const auto x = _target_height - _height;
+      _velocity += tension * x - _velocity * dampening;
+      _height += _velocity;
+   }
+
+   void resetDeltas()
+   {
+      _delta_left = 0.0f;
+      _delta_right = 0.0f;
+   }
+
+   float _height{0.0f};
+   float _target_height{0.0f};
+   float _velocity{0.0f};
+
+   float _delta_left{0.0f};
+   float _delta_right{0.0f};
+
+   float _clamp_scale{1.0f};
+};
+
+// the spring part of WaterSurface::update before it was replaced
+void stepSegments(std::vector<Segment>& segments, const WaterSurfaceSimulation::Spring& spring)
+{
+   for (auto& segment : segments)
+   {
+      segment.update(spring._dampening, spring._tension);
+      segment.resetDeltas();
+   }
+
+   for (auto j = 0; j < integration_steps; j++)
+   {
+      for (std::size_t segment_index = 0; segment_index < segments.size(); segment_index++)
+      {
+         if (segment_index > 0)
+         {
+            const auto delta_left = spring._spread * (segments[segment_index]._height - segments[segment_index - 1]._height) *
+                                    elapsed_s * spring._animation_speed;
+
+            segments[segment_index]._delta_left = delta_left;
+            segments[segment_index - 1]._velocity += delta_left;
+         }
+
+         if (segment_index < segments.size() - 1)
+         {
+            const auto delta_right = spring._spread * (segments[segment_index]._height - segments[segment_index + 1]._height) *
+                                     elapsed_s * spring._animation_speed;
+
+            segments[segment_index]._delta_right = delta_right;
+            segments[segment_index + 1]._velocity += delta_right;
+         }
+      }
+
+      for (std::size_t segment_index = 0; segment_index < segments.size(); segment_index++)
+      {
+         if (segment_index > 0)
+         {
+            segments[segment_index - 1]._height += segments[segment_index]._delta_left;
+         }
+
+         if (segment_index < segments.size() - 1)
+         {
+            segments[segment_index + 1]._height += segments[segment_index]._delta_right;
+         }
+      }
+   }
+}
+
+// the same splashes for every run
+struct Splash
+{
+   int32_t _frame = 0;
+   int32_t _surface = 0;
+   int32_t _index = 0;
+   float _velocity = 0.0f;
+};
+
+std::vector<Splash> makeSplashes(int32_t segment_count, int32_t surface_count, int32_t frame_count)
+{
+   std::mt19937 rng(42);
+   std::uniform_int_distribution<int32_t> index_dist(0, segment_count - 2);
+   std::uniform_real_distribution<float> velocity_dist(-40.0f, 40.0f);
+
+   std::vector<Splash> splashes;
+   for (auto frame = 0; frame < frame_count; frame += splash_interval)
+   {
+      for (auto surface = 0; surface < surface_count; surface++)
+      {
+         for (auto i = 0; i < 4; i++)
+         {
+            splashes.push_back({frame, surface, index_dist(rng), velocity_dist(rng)});
+         }
+      }
+   }
+
+   return splashes;
+}
+
+double toMsPerFrame(Clock::duration duration, int32_t frame_count)
+{
+   return std::chrono::duration<double, std::milli>(duration).count() / frame_count;
+}
+
+}  // namespace
+
+int32_t main(int32_t argc, char** argv)
+{
+   const auto segment_count = (argc > 1) ? std::atoi(argv[1]) : 10'000;
+   const auto surface_count = (argc > 2) ? std::atoi(argv[2]) : 8;
+   const auto frame_count = (argc > 3) ? std::atoi(argv[3]) : 600;
+
+   // the defaults a level gets when it sets nothing but the spread
+   const WaterSurfaceSimulation::Spring spring{._spread = 1.2f};
+   const auto splashes = makeSplashes(segment_count, surface_count, frame_count);
+
+   // before: one struct per segment
+   std::vector<std::vector<Segment>> segment_surfaces(surface_count, std::vector<Segment>(segment_count));
+   auto splash_it = splashes.begin();
+   const auto segments_start = Clock::now();
+   for (auto frame = 0; frame < frame_count; frame++)
+   {
+      for (; splash_it != splashes.end() && splash_it->_frame == frame; ++splash_it)
+      {
+         segment_surfaces[splash_it->_surface][splash_it->_index]._velocity = splash_it->_velocity;
+      }
+
+      for (auto& segments : segment_surfaces)
+      {
+         stepSegments(segments, spring);
+      }
+   }
+   const auto segments_ms = toMsPerFrame(Clock::now() - segments_start, frame_count);
+
+   // after: one array per field, first one surface after another, then one task per surface
+   const auto run = [&](bool parallel, std::vector<WaterSurfaceSimulation>& simulations)
+   {
+      simulations.assign(surface_count, {});
+      for (auto& simulation : simulations)
+      {
+         simulation.resize(segment_count);
+      }
+
+      auto it = splashes.begin();
+      const auto start = Clock::now();
+      for (auto frame = 0; frame < frame_count; frame++)
+      {
+         for (; it != splashes.end() && it->_frame == frame; ++it)
+         {
+            simulations[it->_surface].splash(it->_index, it->_velocity);
+         }
+
+         if (parallel)
+         {
+            std::vector<std::future<void>> steps;
+            for (auto& simulation : simulations)
+            {
+               steps.push_back(std::async(std::launch::async, [&simulation, &spring]() { simulation.step(spring, elapsed_s); }));
+            }
+            for (auto& step : steps)
+            {
+               step.get();
+            }
+         }
+         else
+         {
+            for (auto& simulation : simulations)
+            {
+               simulation.step(spring, elapsed_s);
+            }
+         }
+      }
+      return toMsPerFrame(Clock::now() - start, frame_count);
+   };
+
+   std::vector<WaterSurfaceSimulation> sequential;
+   std::vector<WaterSurfaceSimulation> parallel;
+   const auto sequential_ms = run(false, sequential);
+   const auto parallel_ms = run(true, parallel);
+
+   for (auto surface = 0; surface < surface_count; surface++)
+   {
+      for (auto i = 0; i < segment_count; i++)
+      {
+         const auto expected = segment_surfaces[surface][i]._height;
+         if (sequential[surface].getHeight(i) != expected || parallel[surface].getHeight(i) != expected)
+         {
+            std::cerr << "kernels disagree on surface " << surface << ", segment " << i << std::endl;
+            return EXIT_FAILURE;
+         }
+      }
+   }
+
+   // calm water: one splash, then nothing until the surfaces have settled and gone to sleep
+   std::vector<WaterSurfaceSimulation> calm(surface_count);
+   auto frames_until_asleep = 0;
+   for (auto& simulation : calm)
+   {
+      simulation.resize(segment_count);
+      simulation.splash(segment_count / 2, 40.0f);
+   }
+   while (!std::ranges::all_of(calm, [](const auto& simulation) { return simulation.isAsleep(); }) && frames_until_asleep < 100'000)
+   {
+      for (auto& simulation : calm)
+      {
+         simulation.step(spring, elapsed_s);
+      }
+      frames_until_asleep++;
+   }
+
+   const auto asleep_start = Clock::now();
+   for (auto frame = 0; frame < frame_count; frame++)
+   {
+      for (auto& simulation : calm)
+      {
+         simulation.step(spring, elapsed_s);
+      }
+   }
+   const auto asleep_ms = toMsPerFrame(Clock::now() - asleep_start, frame_count);
+
+   std::cout << std::fixed << std::setprecision(3);
+   std::cout << surface_count << " surfaces of " << segment_count << " segments, " << frame_count << " frames, "
+             << std::thread::hardware_concurrency() << " hardware threads" << std::endl;
+   std::cout << std::endl;
+   std::cout << "                              ms per frame" << std::endl;
+   std::cout << "struct per segment          " << std::setw(10) << segments_ms << std::endl;
+   std::cout << "array per field             " << std::setw(10) << sequential_ms << std::endl;
+   std::cout << "array per field, parallel   " << std::setw(10) << parallel_ms << std::endl;
+   std::cout << "asleep                      " << std::setw(10) << asleep_ms << std::endl;
+   std::cout << std::endl;
+   std::cout << "heights identical, calm water went to sleep after " << frames_until_asleep << " frames" << std::endl;
+
+   return EXIT_SUCCESS;
+}
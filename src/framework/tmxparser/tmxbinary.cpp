@@ -0,0 +1,465 @@
+#include "tmxbinary.h"
+
+#include "framework/tools/binarystream.h"
+#include "framework/tools/log.h"
+
+#include "tmxanimation.h"
+#include "tmxframe.h"
+#include "tmximage.h"
+#include "tmximagelayer.h"
+#include "tmxlayer.h"
+#include "tmxobject.h"
+#include "tmxobjectgroup.h"
+#include "tmxparsedata.h"
+#include "tmxpolygon.h"
+#include "tmxpolyline.h"
+#include "tmxproperties.h"
+#include "tmxproperty.h"
+#include "tmxtile.h"
+#include "tmxtileset.h"
+
+namespace
+{
+
+// writing
+
+template <typename T>
+void writeOptional(BinaryWriter& writer, const std::optional<T>& value)
+{
+   writer.write(value.has_value());
+   if (value.has_value())
+   {
+      if constexpr (std::is_same_v<T, std::string>)
+      {
+         writer.writeString(value.value());
+      }
+      else
+      {
+         writer.write(value.value());
+      }
+   }
+}
+
+void writeProperties(BinaryWriter& writer, const std::shared_ptr<TmxProperties>& properties)
+{
+   writer.write(properties != nullptr);
+   if (!properties)
+   {
+      return;
+   }
+
+   writer.writeString(properties->_name);
+   writer.write(static_cast<uint32_t>(properties->_map.size()));
+   for (const auto& [key, property] : properties->_map)
+   {
+      writer.writeString(key);
+      writer.writeString(property->_name);
+      writer.writeString(property->_value_type);
+      writeOptional(writer, property->_value_string);
+      writeOptional(writer, property->_value_float);
+      writeOptional(writer, property->_value_int);
+      writeOptional(writer, property->_value_bool);
+   }
+}
+
+void writeImage(BinaryWriter& writer, const std::shared_ptr<TmxImage>& image)
+{
+   writer.write(image != nullptr);
+   if (!image)
+   {
+      return;
+   }
+
+   writer.writeString(image->_name);
+   writer.writeString(image->_source);
+   writer.write(static_cast<int32_t>(image->_width_px));
+   writer.write(static_cast<int32_t>(image->_height_px));
+}
+
+void writeObject(BinaryWriter& writer, const std::shared_ptr<TmxObject>& object)
+{
+   writer.writeString(object->_name);
+   writer.writeString(object->_id);
+   writer.write(object->_x_px);
+   writer.write(object->_y_px);
+   writer.write(object->_width_px);
+   writer.write(object->_height_px);
+   writeOptional(writer, object->_template_name);
+   writeOptional(writer, object->_template_type);
+   writeOptional(writer, object->_gid);
+
+   writer.write(object->_polygon != nullptr);
+   if (object->_polygon)
+   {
+      writer.writeString(object->_polygon->_name);
+      writer.writeVector(object->_polygon->_polyline);
+   }
+
+   writer.write(object->_polyline != nullptr);
+   if (object->_polyline)
+   {
+      writer.writeString(object->_polyline->_name);
+      writer.writeVector(object->_polyline->_path);
+   }
+
+   writeProperties(writer, object->_properties);
+}
+
+void writeObjectGroup(BinaryWriter& writer, const std::shared_ptr<TmxObjectGroup>& object_group)
+{
+   writer.writeString(object_group->_name);
+   writer.write(static_cast<int32_t>(object_group->_z_index));
+   writer.write(static_cast<uint32_t>(object_group->_objects.size()));
+   for (const auto& [key, object] : object_group->_objects)
+   {
+      writer.writeString(key);
+      writeObject(writer, object);
+   }
+}
+
+void writeTile(BinaryWriter& writer, const std::shared_ptr<TmxTile>& tile)
+{
+   writer.writeString(tile->_name);
+   writer.write(tile->_id);
+
+   writer.write(tile->_animation != nullptr);
+   if (tile->_animation)
+   {
+      writer.writeString(tile->_animation->_name);
+      writer.write(static_cast<uint32_t>(tile->_animation->_frames.size()));
+      for (const auto& frame : tile->_animation->_frames)
+      {
+         writer.writeString(frame->_name);
+         writer.write(frame->_tile_id);
+         writer.write(frame->_duration_ms);
+      }
+   }
+
+   writer.write(tile->_object_group != nullptr);
+   if (tile->_object_group)
+   {
+      writeObjectGroup(writer, tile->_object_group);
+   }
+}
+
+void writeTileSet(BinaryWriter& writer, const std::shared_ptr<TmxTileSet>& tileset)
+{
+   writer.writeString(tileset->_name);
+   writer.writeString(tileset->_source);
+   writer.write(tileset->_first_gid);
+   writer.write(tileset->_tile_width_px);
+   writer.write(tileset->_tile_height_px);
+   writer.write(tileset->_tile_count);
+   writer.write(tileset->_columns);
+   writer.write(tileset->_rows);
+   writer.writeString(tileset->_path.generic_string());
+   writeImage(writer, tileset->_image);
+
+   writer.write(static_cast<uint32_t>(tileset->_tile_map.size()));
+   for (const auto& [key, tile] : tileset->_tile_map)
+   {
+      writer.write(static_cast<int32_t>(key));
+      writeTile(writer, tile);
+   }
+}
+
+void writeLayer(BinaryWriter& writer, const std::shared_ptr<TmxLayer>& layer)
+{
+   writer.writeString(layer->_name);
+   writer.write(layer->_width_tl);
+   writer.write(layer->_height_tl);
+   writer.write(layer->_opacity);
+   writer.write(layer->_visible);
+   writer.write(layer->_z);
+   writer.write(layer->_offset_x_px);
+   writer.write(layer->_offset_y_px);
+   writer.write(layer->_position_x_px);
+   writer.write(layer->_position_y_px);
+   writeProperties(writer, layer->_properties);
+   writer.writeVector(layer->_data);
+}
+
+void writeImageLayer(BinaryWriter& writer, const std::shared_ptr<TmxImageLayer>& image_layer)
+{
+   writer.writeString(image_layer->_name);
+   writer.write(image_layer->_offset_x_px);
+   writer.write(image_layer->_offset_y_px);
+   writer.write(image_layer->_opacity);
+   writer.write(image_layer->_z);
+   writeImage(writer, image_layer->_image);
+   writeProperties(writer, image_layer->_properties);
+}
+
+// reading
+
+template <typename T>
+std::optional<T> readOptional(BinaryReader& reader)
+{
+   if (!reader.read<bool>())
+   {
+      return std::nullopt;
+   }
+
+   if constexpr (std::is_same_v<T, std::string>)
+   {
+      return reader.readString();
+   }
+   else
+   {
+      return reader.read<T>();
+   }
+}
+
+std::shared_ptr<TmxProperties> readProperties(BinaryReader& reader, const std::shared_ptr<TmxParseData>& parse_data)
+{
+   if (!reader.read<bool>())
+   {
+      return nullptr;
+   }
+
+   auto properties = std::make_shared<TmxProperties>();
+   properties->_name = reader.readString();
+   properties->_parse_data = parse_data;
+
+   const auto count = reader.read<uint32_t>();
+   for (auto i = 0u; i < count && reader.isValid(); i++)
+   {
+      auto key = reader.readString();
+      auto property = std::make_shared<TmxProperty>();
+      property->_name = reader.readString();
+      property->_parse_data = parse_data;
+      property->_value_type = reader.readString();
+      property->_value_string = readOptional<std::string>(reader);
+      property->_value_float = readOptional<float>(reader);
+      property->_value_int = readOptional<int32_t>(reader);
+      property->_value_bool = readOptional<bool>(reader);
+      properties->_map[key] = property;
+   }
+
+   return properties;
+}
+
+std::shared_ptr<TmxImage> readImage(BinaryReader& reader, const std::shared_ptr<TmxParseData>& parse_data)
+{
+   if (!reader.read<bool>())
+   {
+      return nullptr;
+   }
+
+   auto image = std::make_shared<TmxImage>();
+   image->_name = reader.readString();
+   image->_parse_data = parse_data;
+   image->_source = reader.readString();
+   image->_width_px = reader.read<int32_t>();
+   image->_height_px = reader.read<int32_t>();
+   return image;
+}
+
+std::shared_ptr<TmxObject> readObject(BinaryReader& reader, const std::shared_ptr<TmxParseData>& parse_data)
+{
+   auto object = std::make_shared<TmxObject>();
+   object->_name = reader.readString();
+   object->_parse_data = parse_data;
+   object->_id = reader.readString();
+   object->_x_px = reader.read<float>();
+   object->_y_px = reader.read<float>();
+   object->_width_px = reader.read<float>();
+   object->_height_px = reader.read<float>();
+   object->_template_name = readOptional<std::string>(reader);
+   object->_template_type = readOptional<std::string>(reader);
+   object->_gid = readOptional<std::string>(reader);
+
+   if (reader.read<bool>())
+   {
+      object->_polygon = std::make_shared<TmxPolygon>();
+      object->_polygon->_name = reader.readString();
+      object->_polygon->_parse_data = parse_data;
+      object->_polygon->_polyline = reader.readVector<sf::Vector2f>();
+   }
+
+   if (reader.read<bool>())
+   {
+      object->_polyline = std::make_shared<TmxPolyLine>();
+      object->_polyline->_name = reader.readString();
+      object->_polyline->_parse_data = parse_data;
+      object->_polyline->_path = reader.readVector<sf::Vector2f>();
+   }
+
+   object->_properties = readProperties(reader, parse_data);
+   return object;
+}
+
+std::shared_ptr<TmxObjectGroup> readObjectGroup(BinaryReader& reader, const std::shared_ptr<TmxParseData>& parse_data)
+{
+   auto object_group = std::make_shared<TmxObjectGroup>();
+   object_group->_name = reader.readString();
+   object_group->_parse_data = parse_data;
+   object_group->_z_index = reader.read<int32_t>();
+
+   const auto count = reader.read<uint32_t>();
+   for (auto i = 0u; i < count && reader.isValid(); i++)
+   {
+      auto key = reader.readString();
+      object_group->_objects[key] = readObject(reader, parse_data);
+   }
+
+   return object_group;
+}
+
+std::shared_ptr<TmxTile> readTile(BinaryReader& reader, const std::shared_ptr<TmxParseData>& parse_data)
+{
+   auto tile = std::make_shared<TmxTile>();
+   tile->_name = reader.readString();
+   tile->_parse_data = parse_data;
+   tile->_id = reader.read<int32_t>();
+
+   if (reader.read<bool>())
+   {
+      tile->_animation = std::make_shared<TmxAnimation>();
+      tile->_animation->_name = reader.readString();
+      tile->_animation->_parse_data = parse_data;
+
+      const auto frame_count = reader.read<uint32_t>();
+      for (auto i = 0u; i < frame_count && reader.isValid(); i++)
+      {
+         auto frame = std::make_shared<TmxFrame>();
+         frame->_name = reader.readString();
+         frame->_parse_data = parse_data;
+         frame->_tile_id = reader.read<int32_t>();
+         frame->_duration_ms = reader.read<int32_t>();
+         tile->_animation->_frames.push_back(frame);
+      }
+   }
+
+   if (reader.read<bool>())
+   {
+      tile->_object_group = readObjectGroup(reader, parse_data);
+   }
+
+   return tile;
+}
+
+std::shared_ptr<TmxTileSet> readTileSet(BinaryReader& reader, const std::shared_ptr<TmxParseData>& parse_data)
+{
+   auto tileset = std::make_shared<TmxTileSet>();
+   tileset->_name = reader.readString();
+   tileset->_parse_data = parse_data;
+   tileset->_source = reader.readString();
+   tileset->_first_gid = reader.read<int32_t>();
+   tileset->_tile_width_px = reader.read<int32_t>();
+   tileset->_tile_height_px = reader.read<int32_t>();
+   tileset->_tile_count = reader.read<int32_t>();
+   tileset->_columns = reader.read<int32_t>();
+   tileset->_rows = reader.read<int32_t>();
+   tileset->_path = reader.readString();
+   tileset->_image = readImage(reader, parse_data);
+
+   const auto count = reader.read<uint32_t>();
+   for (auto i = 0u; i < count && reader.isValid(); i++)
+   {
+      const auto key = reader.read<int32_t>();
+      tileset->_tile_map[key] = readTile(reader, parse_data);
+   }
+
+   return tileset;
+}
+
+std::shared_ptr<TmxLayer> readLayer(BinaryReader& reader, const std::shared_ptr<TmxParseData>& parse_data)
+{
+   auto layer = std::make_shared<TmxLayer>();
+   layer->_name = reader.readString();
+   layer->_parse_data = parse_data;
+   layer->_width_tl = reader.read<uint32_t>();
+   layer->_height_tl = reader.read<uint32_t>();
+   layer->_opacity = reader.read<float>();
+   layer->_visible = reader.read<bool>();
+   layer->_z = reader.read<int32_t>();
+   layer->_offset_x_px = reader.read<int32_t>();
+   layer->_offset_y_px = reader.read<int32_t>();
+   layer->_position_x_px = reader.read<int32_t>();
+   layer->_position_y_px = reader.read<int32_t>();
+   layer->_properties = readProperties(reader, parse_data);
+   layer->_data = reader.readVector<int32_t>();
+   return layer;
+}
+
+std::shared_ptr<TmxImageLayer> readImageLayer(BinaryReader& reader, const std::shared_ptr<TmxParseData>& parse_data)
+{
+   auto image_layer = std::make_shared<TmxImageLayer>();
+   image_layer->_name = reader.readString();
+   image_layer->_parse_data = parse_data;
+   image_layer->_offset_x_px = reader.read<float>();
+   image_layer->_offset_y_px = reader.read<float>();
+   image_layer->_opacity = reader.read<float>();
+   image_layer->_z = reader.read<int32_t>();
+   image_layer->_image = readImage(reader, parse_data);
+   image_layer->_properties = readProperties(reader, parse_data);
+   return image_layer;
+}
+
+}  // namespace
+
+void TmxBinary::write(BinaryWriter& writer, const std::vector<std::shared_ptr<TmxElement>>& elements)
+{
+   writer.write(static_cast<uint32_t>(elements.size()));
+   for (const auto& element : elements)
+   {
+      writer.write(element->_type);
+
+      switch (element->_type)
+      {
+         case TmxElement::Type::TypeTileSet:
+            writeTileSet(writer, std::dynamic_pointer_cast<TmxTileSet>(element));
+            break;
+         case TmxElement::Type::TypeLayer:
+            writeLayer(writer, std::dynamic_pointer_cast<TmxLayer>(element));
+            break;
+         case TmxElement::Type::TypeObjectGroup:
+            writeObjectGroup(writer, std::dynamic_pointer_cast<TmxObjectGroup>(element));
+            break;
+         case TmxElement::Type::TypeImageLayer:
+            writeImageLayer(writer, std::dynamic_pointer_cast<TmxImageLayer>(element));
+            break;
+         case TmxElement::Type::TypeInvalid:
+         case TmxElement::Type::TypeTemplate:
+            break;
+      }
+   }
+}
+
+std::vector<std::shared_ptr<TmxElement>> TmxBinary::read(BinaryReader& reader, const std::shared_ptr<TmxParseData>& parse_data)
+{
+   std::vector<std::shared_ptr<TmxElement>> elements;
+
+   const auto count = reader.read<uint32_t>();
+   for (auto i = 0u; i < count && reader.isValid(); i++)
+   {
+      const auto type = reader.read<TmxElement::Type>();
+      switch (type)
+      {
+         case TmxElement::Type::TypeTileSet:
+            elements.push_back(readTileSet(reader, parse_data));
+            break;
+         case TmxElement::Type::TypeLayer:
+            elements.push_back(readLayer(reader, parse_data));
+            break;
+         case TmxElement::Type::TypeObjectGroup:
+            elements.push_back(readObjectGroup(reader, parse_data));
+            break;
+         case TmxElement::Type::TypeImageLayer:
+            elements.push_back(readImageLayer(reader, parse_data));
+            break;
+         case TmxElement::Type::TypeInvalid:
+         case TmxElement::Type::TypeTemplate:
+            break;
+      }
+   }
+
+   if (!reader.isValid())
+   {
+      Log::Error() << "compiled tmx data is truncated";
+      return {};
+   }
+
+   return elements;
+}
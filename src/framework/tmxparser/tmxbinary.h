@@ -0,0 +1,35 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+class BinaryReader;
+class BinaryWriter;
+struct TmxElement;
+struct TmxParseData;
+
+///
+/// \brief Converts parsed TMX elements to a compact binary form and back.
+///
+/// The binary form holds exactly what the XML parser produced - tilesets with their tiles and animations,
+/// tile layers as raw tile id arrays, object groups, image layers and all properties - so elements read
+/// back from it cannot be told apart from freshly parsed ones. Reading it back skips the XML parser and
+/// the CSV decoding of the tile layers, which is where most of the time of a TMX load goes.
+///
+namespace TmxBinary
+{
+///
+/// \brief Writes the top level elements of a parsed TMX file.
+/// \param writer Writer to append to.
+/// \param elements Elements as returned by TmxParser::getElements().
+///
+void write(BinaryWriter& writer, const std::vector<std::shared_ptr<TmxElement>>& elements);
+
+///
+/// \brief Reads elements written by write().
+/// \param reader Reader positioned at the elements.
+/// \param parse_data Parse data to attach to every element, as the XML parser would.
+/// \return Elements in their original order; empty when the data is malformed.
+///
+std::vector<std::shared_ptr<TmxElement>> read(BinaryReader& reader, const std::shared_ptr<TmxParseData>& parse_data);
+}  // namespace TmxBinary
@@ -2,6 +2,7 @@
 
 #include "framework/tools/log.h"
 
+#include "tmxbinary.h"
 #include "tmximagelayer.h"
 #include "tmxlayer.h"
 #include "tmxobjectgroup.h"
@@ -112,6 +113,20 @@ void TmxParser::parseSubElement(tinyxml2::XMLElement* sub_element, int32_t& z)
    _elements.push_back(sub_element_parsed);
 }
 
+bool TmxParser::readBinary(const std::string& filename, BinaryReader& reader)
+{
+   _parse_data = std::make_shared<TmxParseData>();
+   _parse_data->_filename = filename;
+
+   _elements = TmxBinary::read(reader, _parse_data);
+   return !_elements.empty();
+}
+
+void TmxParser::writeBinary(BinaryWriter& writer) const
+{
+   TmxBinary::write(writer, _elements);
+}
+
 const std::vector<std::shared_ptr<TmxElement>>& TmxParser::getElements() const
 {
    return _elements;
@@ -6,6 +6,8 @@
 
 #include "tinyxml2/tinyxml2.h"
 
+class BinaryReader;
+class BinaryWriter;
 struct TmxElement;
 struct TmxLayer;
 struct TmxObjectGroup;
@@ -26,6 +28,20 @@ public:
    ///
    void parse(const std::string& filename);
 
+   ///
+   /// \brief Restores `_elements` from a binary form written by writeBinary() instead of parsing the TMX file.
+   /// \param filename TMX file path the binary form was created from.
+   /// \param reader Reader positioned at the binary form.
+   /// \return True if the binary form was complete.
+   ///
+   bool readBinary(const std::string& filename, BinaryReader& reader);
+
+   ///
+   /// \brief Writes the parsed elements in a binary form that readBinary() can restore.
+   /// \param writer Writer to append to.
+   ///
+   void writeBinary(BinaryWriter& writer) const;
+
    ///
    /// \brief Returns all parsed top-level and flattened group elements.
    /// \return Parsed TMX elements.
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <future>
+#include <utility>
+
+///
+/// \brief Starts a function on a worker thread and returns the future of its result.
+///
+/// The web build has no threads to spare; there the function is deferred and runs on the thread that
+/// waits for the future, so the work happens in the same order as it would without a worker.
+///
+/// \param function callable without arguments.
+/// \return future holding the function's result.
+///
+template <typename Function>
+auto startAsyncTask(Function&& function)
+{
+#ifdef DECEPTUS_VRSFML
+   return std::async(std::launch::deferred, std::forward<Function>(function));
+#else
+   return std::async(std::launch::async, std::forward<Function>(function));
+#endif
+}
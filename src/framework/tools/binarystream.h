@@ -0,0 +1,187 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+///
+/// \brief Appends plain values, strings and vectors to a byte buffer in native byte order.
+///
+/// Meant for caches the game writes and reads back itself, so there is no byte swapping and no
+/// versioning; callers put a version into their own header.
+///
+class BinaryWriter
+{
+public:
+   ///
+   /// \brief Appends a trivially copyable value.
+   /// \param value Value to append.
+   ///
+   template <typename T>
+   void write(const T& value)
+   {
+      static_assert(std::is_trivially_copyable_v<T>);
+      const auto* bytes = reinterpret_cast<const char*>(&value);
+      _buffer.insert(_buffer.end(), bytes, bytes + sizeof(T));
+   }
+
+   ///
+   /// \brief Appends a string, prefixed by its length.
+   /// \param value String to append.
+   ///
+   void writeString(const std::string& value)
+   {
+      write(static_cast<uint32_t>(value.size()));
+      _buffer.insert(_buffer.end(), value.begin(), value.end());
+   }
+
+   ///
+   /// \brief Appends a vector of trivially copyable values, prefixed by its element count.
+   /// \param values Values to append.
+   ///
+   template <typename T>
+   void writeVector(const std::vector<T>& values)
+   {
+      static_assert(std::is_trivially_copyable_v<T>);
+      write(static_cast<uint32_t>(values.size()));
+      const auto* bytes = reinterpret_cast<const char*>(values.data());
+      _buffer.insert(_buffer.end(), bytes, bytes + values.size() * sizeof(T));
+   }
+
+   ///
+   /// \brief Appends zero bytes until the buffer size is a multiple of `alignment`.
+   /// \param alignment Alignment in bytes.
+   ///
+   void pad(size_t alignment)
+   {
+      _buffer.resize((_buffer.size() + alignment - 1) / alignment * alignment, 0);
+   }
+
+   ///
+   /// \brief Returns the bytes written so far.
+   /// \return Buffer contents.
+   ///
+   const std::vector<char>& getBuffer() const
+   {
+      return _buffer;
+   }
+
+private:
+   std::vector<char> _buffer;
+};
+
+///
+/// \brief Reads what a BinaryWriter wrote from a block of memory, e.g. a memory mapped file.
+///
+/// Reads never go past the end of the block. Once a read would, the reader is marked as failed and
+/// every following read returns default values, so callers only need to check isValid() at the end.
+///
+class BinaryReader
+{
+public:
+   ///
+   /// \brief Creates a reader over a block of memory; the memory must outlive the reader.
+   /// \param data Start of the block.
+   /// \param size Size of the block in bytes.
+   ///
+   BinaryReader(const char* data, size_t size) : _data(data), _size(size)
+   {
+   }
+
+   ///
+   /// \brief Reads a trivially copyable value.
+   /// \return Value read, or a default constructed value when the block is exhausted.
+   ///
+   template <typename T>
+   T read()
+   {
+      static_assert(std::is_trivially_copyable_v<T>);
+      T value{};
+      if (claim(sizeof(T)))
+      {
+         std::memcpy(&value, _data + _position - sizeof(T), sizeof(T));
+      }
+      return value;
+   }
+
+   ///
+   /// \brief Reads a length prefixed string.
+   /// \return String read, or an empty string when the block is exhausted.
+   ///
+   std::string readString()
+   {
+      const auto length = read<uint32_t>();
+      if (!claim(length))
+      {
+         return {};
+      }
+      return std::string(_data + _position - length, length);
+   }
+
+   ///
+   /// \brief Reads a count prefixed vector of trivially copyable values.
+   /// \return Values read, or an empty vector when the block is exhausted.
+   ///
+   template <typename T>
+   std::vector<T> readVector()
+   {
+      static_assert(std::is_trivially_copyable_v<T>);
+      const auto count = read<uint32_t>();
+      const auto byte_count = static_cast<size_t>(count) * sizeof(T);
+      if (!claim(byte_count))
+      {
+         return {};
+      }
+
+      std::vector<T> values(count);
+      std::memcpy(values.data(), _data + _position - byte_count, byte_count);
+      return values;
+   }
+
+   ///
+   /// \brief Checks whether all reads so far stayed within the block.
+   /// \return True if no read ran past the end of the block.
+   ///
+   bool isValid() const
+   {
+      return _valid;
+   }
+
+   ///
+   /// \brief Checks whether the whole block has been read.
+   /// \return True if the read position is at the end of the block.
+   ///
+   bool isAtEnd() const
+   {
+      return _position == _size;
+   }
+
+   ///
+   /// \brief Returns the current read position.
+   /// \return Offset from the start of the block in bytes.
+   ///
+   size_t getPosition() const
+   {
+      return _position;
+   }
+
+private:
+   bool claim(size_t byte_count)
+   {
+      if (!_valid || byte_count > _size - _position)
+      {
+         _valid = false;
+         return false;
+      }
+
+      _position += byte_count;
+      return true;
+   }
+
+   const char* _data{nullptr};
+   size_t _size{0};
+   size_t _position{0};
+   bool _valid{true};
+};
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+///
+/// \brief Fixed-size queue that many threads can push to without taking a lock.
+///
+/// Every cell carries a sequence number that tells producers and the consumer whose turn it is, so a push
+/// only contends on one atomic increment and never waits for another thread to finish. Pushing into a full
+/// queue fails rather than blocking; the caller decides whether to drop the item.
+///
+/// \tparam T element type, copied in and moved out.
+/// \tparam Capacity number of cells, must be a power of two.
+///
+template <typename T, std::size_t Capacity>
+class BoundedQueue
+{
+   static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+
+public:
+   BoundedQueue()
+   {
+      for (std::size_t index = 0; index < Capacity; index++)
+      {
+         _cells[index]._sequence.store(index, std::memory_order_relaxed);
+      }
+   }
+
+   ///
+   /// \brief Appends an element, safe to call from any thread.
+   /// \param value element to copy into the queue.
+   /// \return false if the queue is full.
+   ///
+   bool push(const T& value)
+   {
+      auto position = _enqueue_position.load(std::memory_order_relaxed);
+
+      for (;;)
+      {
+         auto& cell = _cells[position & (Capacity - 1)];
+         const auto sequence = cell._sequence.load(std::memory_order_acquire);
+         const auto difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+         if (difference == 0)
+         {
+            if (_enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+               cell._value = value;
+               cell._sequence.store(position + 1, std::memory_order_release);
+               return true;
+            }
+         }
+         else if (difference < 0)
+         {
+            return false;
+         }
+         else
+         {
+            position = _enqueue_position.load(std::memory_order_relaxed);
+         }
+      }
+   }
+
+   ///
+   /// \brief Takes the oldest element.
+   /// \return the element, nothing if the queue is empty.
+   /// \note safe from several threads as well, though the queues in here have one consumer.
+   ///
+   std::optional<T> pop()
+   {
+      auto position = _dequeue_position.load(std::memory_order_relaxed);
+
+      for (;;)
+      {
+         auto& cell = _cells[position & (Capacity - 1)];
+         const auto sequence = cell._sequence.load(std::memory_order_acquire);
+         const auto difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+
+         if (difference == 0)
+         {
+            if (_dequeue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+               std::optional<T> value{std::move(cell._value)};
+               cell._sequence.store(position + Capacity, std::memory_order_release);
+               return value;
+            }
+         }
+         else if (difference < 0)
+         {
+            return std::nullopt;
+         }
+         else
+         {
+            position = _dequeue_position.load(std::memory_order_relaxed);
+         }
+      }
+   }
+
+private:
+   struct Cell
+   {
+      std::atomic<std::size_t> _sequence{0};
+      T _value{};
+   };
+
+   std::array<Cell, Capacity> _cells;
+   alignas(64) std::atomic<std::size_t> _enqueue_position{0};  //!< on its own cache line, producers hammer it
+   alignas(64) std::atomic<std::size_t> _dequeue_position{0};
+};
@@ -1,6 +1,7 @@
 #include "checksum.h"
 
 #include <cstdint>
+#include <cstring>
 
 uint32_t Checksum::calcChecksum(std::ifstream& file)
 {
@@ -23,6 +24,20 @@ uint32_t Checksum::calcChecksum(const std::filesystem::path& path)
    return sum;
 }
 
+uint32_t Checksum::calcChecksum(const char* data, size_t size)
+{
+   uint32_t sum = 0;
+   uint32_t word = 0;
+
+   for (size_t offset = 0; offset + sizeof(word) <= size; offset += sizeof(word))
+   {
+      std::memcpy(&word, data + offset, sizeof(word));
+      sum += word;
+   }
+
+   return sum;
+}
+
 uint32_t Checksum::readChecksum(std::ifstream& file)
 {
    uint32_t word = 0;
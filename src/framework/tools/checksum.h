@@ -23,6 +23,14 @@ public:
    ///
    static uint32_t calcChecksum(const std::filesystem::path& path);
 
+   ///
+   /// \brief Sums all 32-bit words of a block of memory; trailing bytes that do not fill a word are ignored.
+   /// \param data Start of the block.
+   /// \param size Size of the block in bytes.
+   /// \return Accumulated checksum value.
+   ///
+   static uint32_t calcChecksum(const char* data, size_t size);
+
    ///
    /// \brief Reads one 32-bit checksum word from an open binary stream.
    /// \param file Input stream positioned at the checksum word.
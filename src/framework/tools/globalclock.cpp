@@ -15,15 +15,29 @@ GlobalClock& GlobalClock::getInstance()
 
 int GlobalClock::getElapsedTimeInMs()
 {
-   return _clock.getElapsedTime().asMilliseconds();
+   return getElapsedTime().asMilliseconds();
 }
 
 float GlobalClock::getElapsedTimeInS()
 {
-   return _clock.getElapsedTime().asMilliseconds() * 0.001f;
+   return getElapsedTime().asMilliseconds() * 0.001f;
 }
 
 sf::Time GlobalClock::getElapsedTime()
 {
-   return _clock.getElapsedTime();
+   return _simulated_elapsed.value_or(_clock.getElapsedTime());
+}
+
+void GlobalClock::useSimulatedTime()
+{
+   // carry on from where real time got to, time must not run backwards for anyone holding an earlier reading
+   _simulated_elapsed = _clock.getElapsedTime();
+}
+
+void GlobalClock::advanceSimulatedTime(const sf::Time& dt)
+{
+   if (_simulated_elapsed.has_value())
+   {
+      _simulated_elapsed = _simulated_elapsed.value() + dt;
+   }
 }
@@ -2,6 +2,8 @@
 
 #include <SFML/System/Clock.hpp>
 
+#include <optional>
+
 ///
 /// \brief Provides a singleton clock for global elapsed-time queries.
 ///
@@ -37,6 +39,21 @@ public:
    ///
    sf::Time getElapsedTime();
 
+   ///
+   /// \brief Stops following real time; from now on the clock only moves through advanceSimulatedTime.
+   ///
+   /// Used by the headless simulation, which steps the game as fast as it can and needs every
+   /// run of the same input to see the same times.
+   ///
+   void useSimulatedTime();
+
+   ///
+   /// \brief Moves a simulated clock forward.
+   /// \param dt Time to add.
+   ///
+   void advanceSimulatedTime(const sf::Time& dt);
+
 private:
    sf::Clock _clock;
+   std::optional<sf::Time> _simulated_elapsed;
 };
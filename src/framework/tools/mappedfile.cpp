@@ -0,0 +1,135 @@
+#include "mappedfile.h"
+
+#include <fstream>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MAPPED_FILE_MMAP
+#endif
+
+MappedFile::~MappedFile()
+{
+   close();
+}
+
+bool MappedFile::open(const std::filesystem::path& path)
+{
+   close();
+
+#if defined(_WIN32)
+   const auto file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+   if (file == INVALID_HANDLE_VALUE)
+   {
+      return false;
+   }
+
+   LARGE_INTEGER file_size{};
+   if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0)
+   {
+      CloseHandle(file);
+      return false;
+   }
+
+   // the view keeps the mapping alive and the mapping keeps the file alive, so both handles can go
+   const auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+   CloseHandle(file);
+   if (!mapping)
+   {
+      return false;
+   }
+
+   const auto* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+   CloseHandle(mapping);
+   if (!view)
+   {
+      return false;
+   }
+
+   _mapping = const_cast<void*>(view);
+   _data = static_cast<const char*>(view);
+   _size = static_cast<size_t>(file_size.QuadPart);
+   return true;
+#elif defined(MAPPED_FILE_MMAP)
+   const auto file = ::open(path.c_str(), O_RDONLY);
+   if (file < 0)
+   {
+      return false;
+   }
+
+   struct stat file_stat{};
+   if (fstat(file, &file_stat) != 0 || file_stat.st_size == 0)
+   {
+      ::close(file);
+      return false;
+   }
+
+   // the mapping stays valid after the descriptor is closed
+   auto* mapping = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+   ::close(file);
+   if (mapping == MAP_FAILED)
+   {
+      return false;
+   }
+
+   _mapping = mapping;
+   _data = static_cast<const char*>(mapping);
+   _size = static_cast<size_t>(file_stat.st_size);
+   return true;
+#else
+   std::ifstream file(path, std::ios::binary | std::ios::ate);
+   if (!file)
+   {
+      return false;
+   }
+
+   _fallback.resize(static_cast<size_t>(file.tellg()));
+   file.seekg(0);
+   if (_fallback.empty() || !file.read(_fallback.data(), static_cast<std::streamsize>(_fallback.size())))
+   {
+      _fallback.clear();
+      return false;
+   }
+
+   _data = _fallback.data();
+   _size = _fallback.size();
+   return true;
+#endif
+}
+
+void MappedFile::close()
+{
+#if defined(_WIN32)
+   if (_mapping)
+   {
+      UnmapViewOfFile(_mapping);
+   }
+#elif defined(MAPPED_FILE_MMAP)
+   if (_mapping)
+   {
+      munmap(_mapping, _size);
+   }
+#endif
+
+   _mapping = nullptr;
+   _fallback.clear();
+   _data = nullptr;
+   _size = 0;
+}
+
+const char* MappedFile::getData() const
+{
+   return _data;
+}
+
+size_t MappedFile::getSize() const
+{
+   return _size;
+}
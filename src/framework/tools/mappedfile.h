@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <vector>
+
+///
+/// \brief Maps a file into memory read-only.
+///
+/// Reading a large cache through a stream copies every byte twice, once into the stream buffer and
+/// once into the destination. A mapping lets the OS page the file in on demand and the caller copy
+/// straight out of the page cache. Platforms without a usable mmap fall back to reading the whole
+/// file into memory, so callers do not need to care which one they got.
+///
+class MappedFile
+{
+public:
+   MappedFile() = default;
+   ~MappedFile();
+
+   MappedFile(const MappedFile&) = delete;
+   MappedFile& operator=(const MappedFile&) = delete;
+
+   ///
+   /// \brief Maps a file, unmapping any file mapped before.
+   /// \param path File to map.
+   /// \return True if the file could be mapped.
+   ///
+   bool open(const std::filesystem::path& path);
+
+   ///
+   /// \brief Unmaps the file.
+   ///
+   void close();
+
+   ///
+   /// \brief Returns the start of the mapped file.
+   /// \return Pointer to the first byte, nullptr when nothing is mapped.
+   ///
+   const char* getData() const;
+
+   ///
+   /// \brief Returns the size of the mapped file.
+   /// \return Size in bytes.
+   ///
+   size_t getSize() const;
+
+private:
+   const char* _data{nullptr};
+   size_t _size{0};
+
+   void* _mapping{nullptr};      //!< platform mapping handle, unused with the fallback
+   std::vector<char> _fallback;  //!< file contents when mapping is not available
+};
@@ -0,0 +1,33 @@
+#include "regexcache.h"
+
+RegexCache::RegexCache(size_t capacity) : _capacity(capacity)
+{
+}
+
+const std::regex& RegexCache::get(const std::string& pattern)
+{
+   const auto it = _lookup.find(pattern);
+   if (it != _lookup.end())
+   {
+      _entries.splice(_entries.begin(), _entries, it->second);
+      return it->second->second;
+   }
+
+   // compile before touching the cache so a malformed pattern leaves it unchanged
+   std::regex compiled(pattern);
+
+   if (_entries.size() >= _capacity && !_entries.empty())
+   {
+      _lookup.erase(_entries.back().first);
+      _entries.pop_back();
+   }
+
+   _entries.emplace_front(pattern, std::move(compiled));
+   _lookup[pattern] = _entries.begin();
+   return _entries.front().second;
+}
+
+bool RegexCache::isLiteral(const std::string& pattern)
+{
+   return pattern.find_first_of("\\^$.|?*+()[]{}") == std::string::npos;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <regex>
+#include <string>
+#include <unordered_map>
+
+///
+/// \brief Keeps the most recently used compiled regular expressions.
+///
+/// Constructing a std::regex parses the pattern and builds its automaton, which costs far more than matching
+/// a short id against it. Level scripts search mechanisms and enemies with the same handful of patterns every
+/// frame, so the compiled patterns are kept and the least recently used one is dropped when the cache is full.
+///
+class RegexCache
+{
+public:
+   ///
+   /// \brief Creates an empty cache.
+   /// \param capacity Number of compiled patterns kept at most.
+   ///
+   explicit RegexCache(size_t capacity = 64);
+
+   ///
+   /// \brief Returns the compiled pattern, compiling it on first use.
+   /// \param pattern Regular expression in ECMAScript syntax.
+   /// \return Compiled pattern; the reference stays valid until the next call.
+   /// \throws std::regex_error when the pattern is malformed.
+   ///
+   const std::regex& get(const std::string& pattern);
+
+   ///
+   /// \brief Checks if a pattern has no regex meta characters, i.e. it only matches itself.
+   /// \param pattern Regular expression in ECMAScript syntax.
+   /// \return True if matching the pattern is the same as comparing for equality.
+   ///
+   static bool isLiteral(const std::string& pattern);
+
+private:
+   using Entry = std::pair<std::string, std::regex>;
+
+   size_t _capacity{0};
+   std::list<Entry> _entries;  //!< most recently used first
+   std::unordered_map<std::string, std::list<Entry>::iterator> _lookup;
+};
@@ -74,6 +74,36 @@ public:
 protected:
    ResourcePool() = default;
 
+   ///
+   /// \brief Returns the cached resource for `path`, or builds it with `create` when there is none.
+   ///
+   /// Lets a derived pool offer other ways to create a resource than loading it from `path`, while
+   /// sharing the cache with get().
+   ///
+   /// \param path Resource file path used as cache key.
+   /// \param create Callable returning a shared pointer to the new resource, or nullptr on failure.
+   /// \return Shared pointer to the cached or newly created resource.
+   ///
+   template <typename Create>
+   std::shared_ptr<Resource> getOrCreate(const std::filesystem::path& path, Create&& create)
+   {
+      std::lock_guard<std::mutex> hold(m_mutex);
+
+      const auto key = path.string();
+      auto sp = m_pool[key].lock();
+      if (!sp)
+      {
+         sp = create();
+         if (!sp)
+         {
+            Log::Warning() << "error creating resource: " << path;
+         }
+         m_pool[key] = sp;
+      }
+
+      return sp;
+   }
+
    ///
    /// \brief Loads `resource` from `path`.
    /// \param resource Resource instance to initialize.
@@ -2,87 +2,335 @@
 
 #include <algorithm>
 
-std::vector<std::unique_ptr<Timer>> Timer::__timers;
+struct Timer::Slot
+{
+   Timer _timer;
+   uint32_t _generation = 1;
+   bool _used = false;
+   int64_t _deadline_tick = 0;
+   int32_t _bucket = -1;  //!< -1 while the timer is not on the wheel, i.e. fired and waiting for its callback
+   int32_t _previous_in_bucket = -1;
+   int32_t _next_in_bucket = -1;
+   int32_t _previous_by_caller = -1;
+   int32_t _next_by_caller = -1;
+};
+
+std::vector<Timer::Slot> Timer::__slots;
+std::vector<uint32_t> Timer::__free_slots;
+std::array<Timer::Wheel, 2> Timer::__wheels;
+std::unordered_map<const void*, int32_t> Timer::__first_slot_by_caller;
+size_t Timer::__timer_count = 0;
+std::optional<std::chrono::high_resolution_clock::time_point> Timer::__simulated_now;
 std::mutex Timer::__mutex;
 
-void Timer::update(Scope scope)
+namespace
 {
-   auto now = std::chrono::high_resolution_clock::now();
+// one turn of the wheel is 4 seconds at 1 ms per bucket; timers further out stay in their bucket and are
+// passed over until the turn they are due in, which is rare for the delays used in the game
+constexpr int64_t wheel_size = 4096;
+constexpr int64_t wheel_mask = wheel_size - 1;
+}  // namespace
 
-   std::lock_guard<std::mutex> guard(__mutex);
+std::chrono::high_resolution_clock::time_point Timer::getNow()
+{
+   return __simulated_now.value_or(std::chrono::high_resolution_clock::now());
+}
 
-   // it might be better to
-   // 1) lock
-   // 2) find the timer
-   // 3) unlock
-   // 4) call the update function
-   // 5) lock/cleanup/unlock
-   //
-   // background: if the callback starts another timer, the mutex is locked :/
-
-   __timers.erase(
-      std::remove_if(
-         __timers.begin(),
-         __timers.end(),
-         [now, scope](auto& timer) -> bool
-         {
-            if (timer->_scope != scope)
-            {
-               return false;
-            }
+int64_t Timer::getTick(std::chrono::high_resolution_clock::time_point time_point)
+{
+   static const auto epoch = std::chrono::high_resolution_clock::now();
+   return std::chrono::duration_cast<std::chrono::milliseconds>(time_point - epoch).count();
+}
+
+bool Timer::isValid(Handle handle)
+{
+   return handle._generation != 0 && handle._slot < __slots.size() && __slots[handle._slot]._used &&
+          __slots[handle._slot]._generation == handle._generation;
+}
+
+void Timer::link(uint32_t slot_index)
+{
+   auto& slot = __slots[slot_index];
+   auto& wheel = __wheels[static_cast<size_t>(slot._timer._scope)];
+
+   if (wheel._first_slot_in_bucket.empty())
+   {
+      wheel._first_slot_in_bucket.assign(wheel_size, -1);
+      wheel._last_slot_in_bucket.assign(wheel_size, -1);
+   }
+
+   // a deadline whose bucket has already been walked goes into the next one so the next update sees it
+   const auto tick = std::max(slot._deadline_tick, wheel._processed_tick + 1);
+   const auto bucket = static_cast<int32_t>(tick & wheel_mask);
+
+   // append, so timers sharing a bucket fire in the order they were added
+   slot._bucket = bucket;
+   slot._next_in_bucket = -1;
+   slot._previous_in_bucket = wheel._last_slot_in_bucket[bucket];
+
+   if (slot._previous_in_bucket != -1)
+   {
+      __slots[slot._previous_in_bucket]._next_in_bucket = static_cast<int32_t>(slot_index);
+   }
+   else
+   {
+      wheel._first_slot_in_bucket[bucket] = static_cast<int32_t>(slot_index);
+   }
+
+   wheel._last_slot_in_bucket[bucket] = static_cast<int32_t>(slot_index);
+}
+
+void Timer::unlink(uint32_t slot_index)
+{
+   auto& slot = __slots[slot_index];
+   auto& wheel = __wheels[static_cast<size_t>(slot._timer._scope)];
+
+   if (slot._previous_in_bucket != -1)
+   {
+      __slots[slot._previous_in_bucket]._next_in_bucket = slot._next_in_bucket;
+   }
+   else
+   {
+      wheel._first_slot_in_bucket[slot._bucket] = slot._next_in_bucket;
+   }
+
+   if (slot._next_in_bucket != -1)
+   {
+      __slots[slot._next_in_bucket]._previous_in_bucket = slot._previous_in_bucket;
+   }
+   else
+   {
+      wheel._last_slot_in_bucket[slot._bucket] = slot._previous_in_bucket;
+   }
+
+   slot._bucket = -1;
+   slot._previous_in_bucket = -1;
+   slot._next_in_bucket = -1;
+}
+
+void Timer::release(uint32_t slot_index)
+{
+   auto& slot = __slots[slot_index];
+
+   if (slot._bucket != -1)
+   {
+      unlink(slot_index);
+   }
+
+   // unlink from the caller's chain
+   if (slot._timer._caller != nullptr)
+   {
+      if (slot._previous_by_caller != -1)
+      {
+         __slots[slot._previous_by_caller]._next_by_caller = slot._next_by_caller;
+      }
+      else if (slot._next_by_caller != -1)
+      {
+         __first_slot_by_caller[slot._timer._caller] = slot._next_by_caller;
+      }
+      else
+      {
+         __first_slot_by_caller.erase(slot._timer._caller);
+      }
+
+      if (slot._next_by_caller != -1)
+      {
+         __slots[slot._next_by_caller]._previous_by_caller = slot._previous_by_caller;
+      }
+   }
+
+   slot._timer = {};
+   slot._used = false;
+   slot._generation++;
+   slot._previous_by_caller = -1;
+   slot._next_by_caller = -1;
+
+   __free_slots.push_back(slot_index);
+   __timer_count--;
+}
+
+void Timer::update(Scope scope)
+{
+   std::vector<Handle> due;
+
+   {
+      std::lock_guard<std::mutex> guard(__mutex);
 
-            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - timer->_start_time);
-            auto delta = elapsed - timer->_interval;
+      const auto now = getNow();
+      const auto now_tick = getTick(now);
 
-            if (delta > std::chrono::milliseconds(0))
+      auto& wheel = __wheels[static_cast<size_t>(scope)];
+      if (!wheel._first_slot_in_bucket.empty())
+      {
+         // after a stall longer than a turn, every bucket is walked once
+         const auto first_tick = std::max(wheel._processed_tick + 1, now_tick - wheel_size + 1);
+         for (auto tick = first_tick; tick <= now_tick; tick++)
+         {
+            auto slot_index = wheel._first_slot_in_bucket[tick & wheel_mask];
+            while (slot_index != -1)
             {
-               timer->_callback();
+               auto& slot = __slots[slot_index];
+               const auto next = slot._next_in_bucket;
 
-               if (timer->_type == Type::Singleshot)
+               if (slot._deadline_tick <= now_tick)
                {
-                  return true;
+                  unlink(static_cast<uint32_t>(slot_index));
+                  due.push_back({static_cast<uint32_t>(slot_index), slot._generation});
+
+                  // a repeated timer goes back on the wheel right away; after a long stall it fires
+                  // once rather than once for every interval it missed
+                  auto& timer = slot._timer;
+                  if (timer._type == Type::Repeated)
+                  {
+                     slot._deadline_tick = std::max(slot._deadline_tick + timer._interval.count(), now_tick + 1);
+                     timer._deadline = now + std::chrono::milliseconds(slot._deadline_tick - now_tick);
+                     link(static_cast<uint32_t>(slot_index));
+                  }
                }
 
-               timer->_start_time = now + delta;
-               return false;
+               slot_index = next;
             }
+         }
+      }
+
+      wheel._processed_tick = now_tick;
+   }
+
+   // the lock is only taken again to look up each callback, so callbacks can add and remove timers; one
+   // that removes a timer due in this same update keeps that timer from firing
+   for (const auto handle : due)
+   {
+      std::function<void()> callback;
 
-            return false;
+      {
+         std::lock_guard<std::mutex> guard(__mutex);
+
+         if (!isValid(handle))
+         {
+            continue;
+         }
+
+         auto& timer = __slots[handle._slot]._timer;
+         if (timer._type == Type::Singleshot)
+         {
+            callback = std::move(timer._callback);
+            release(handle._slot);
          }
-      ),
-      __timers.end()
-   );
+         else
+         {
+            callback = timer._callback;
+         }
+      }
+
+      callback();
+   }
 }
 
-void Timer::add(
+Timer::Handle Timer::add(
    std::chrono::milliseconds interval,
    std::function<void()> callback,
    Type type,
    Scope scope,
    const std::shared_ptr<void>& data,
-   const std::shared_ptr<void>& caller
+   const void* caller
 )
 {
-   std::unique_ptr<Timer> timer = std::make_unique<Timer>();
-   timer->_interval = interval;
-   timer->_type = type;
-   timer->_scope = scope;
-   timer->_start_time = std::chrono::high_resolution_clock::now();
-   timer->_callback = callback;
-   timer->_data = data;
-   timer->_caller = caller;
-
-   // don't start another timer from the timed function in your lua code :)
    std::lock_guard<std::mutex> guard(__mutex);
-   __timers.push_back(std::move(timer));
+
+   const auto now = getNow();
+
+   uint32_t slot_index = 0;
+   if (!__free_slots.empty())
+   {
+      slot_index = __free_slots.back();
+      __free_slots.pop_back();
+   }
+   else
+   {
+      slot_index = static_cast<uint32_t>(__slots.size());
+      __slots.emplace_back();
+   }
+
+   auto& slot = __slots[slot_index];
+   slot._used = true;
+   slot._deadline_tick = getTick(now) + interval.count();
+
+   auto& timer = slot._timer;
+   timer._interval = interval;
+   timer._type = type;
+   timer._scope = scope;
+   timer._deadline = now + interval;
+   timer._callback = std::move(callback);
+   timer._data = data;
+   timer._caller = caller;
+
+   // new timers go to the front of their caller's chain
+   if (caller != nullptr)
+   {
+      auto [first_it, inserted] = __first_slot_by_caller.try_emplace(caller, static_cast<int32_t>(slot_index));
+      if (!inserted)
+      {
+         slot._next_by_caller = first_it->second;
+         __slots[first_it->second]._previous_by_caller = static_cast<int32_t>(slot_index);
+         first_it->second = static_cast<int32_t>(slot_index);
+      }
+   }
+
+   link(slot_index);
+   __timer_count++;
+
+   return {slot_index, slot._generation};
 }
 
-void Timer::removeByCaller(const std::shared_ptr<void>& caller)
+void Timer::remove(Handle handle)
 {
    std::lock_guard<std::mutex> guard(__mutex);
 
-   __timers.erase(
-      std::remove_if(__timers.begin(), __timers.end(), [caller](const auto& timer) -> bool { return timer->_caller == caller; }),
-      __timers.end()
-   );
+   if (!isValid(handle))
+   {
+      return;
+   }
+
+   release(handle._slot);
+}
+
+void Timer::removeByCaller(const void* caller)
+{
+   std::lock_guard<std::mutex> guard(__mutex);
+
+   const auto first_it = __first_slot_by_caller.find(caller);
+   if (first_it == __first_slot_by_caller.end())
+   {
+      return;
+   }
+
+   // release unlinks each timer from the chain, and erases the chain once the last one is gone
+   auto slot_index = first_it->second;
+   while (slot_index != -1)
+   {
+      const auto next = __slots[slot_index]._next_by_caller;
+      release(static_cast<uint32_t>(slot_index));
+      slot_index = next;
+   }
+}
+
+size_t Timer::getTimerCount()
+{
+   std::lock_guard<std::mutex> guard(__mutex);
+   return __timer_count;
+}
+
+void Timer::useSimulatedTime()
+{
+   std::lock_guard<std::mutex> guard(__mutex);
+   __simulated_now = std::chrono::high_resolution_clock::now();
+}
+
+void Timer::advanceSimulatedTime(std::chrono::high_resolution_clock::duration dt)
+{
+   std::lock_guard<std::mutex> guard(__mutex);
+   if (__simulated_now.has_value())
+   {
+      __simulated_now = __simulated_now.value() + dt;
+   }
 }
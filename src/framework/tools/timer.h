@@ -1,14 +1,27 @@
 #pragma once
 
+#include <array>
 #include <chrono>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <unordered_map>
 #include <vector>
 
 ///
 /// \brief Manages process-wide timed callbacks for game and global update scopes.
 ///
+/// Each scope keeps its timers on a timing wheel: a ring of one millisecond buckets, each holding the
+/// timers whose deadline falls on it. An update walks the buckets between the last update and now, so it
+/// only looks at timers that are due, plus the few parked in those buckets for a later turn of the ring.
+/// Timers live in reusable slots that are linked into their bucket and into a chain per caller; a handle
+/// names a slot together with the generation it was issued for. That makes add, remove and each timer
+/// removeByCaller drops constant time.
+///
+/// Callbacks run after the lock is released, so they are free to add or remove timers.
+///
 class Timer
 {
 public:
@@ -30,6 +43,15 @@ public:
       UpdateIngame
    };
 
+   ///
+   /// \brief Identifies one registered timer.
+   ///
+   struct Handle
+   {
+      uint32_t _slot = 0;
+      uint32_t _generation = 0;  //!< 0 never names a timer
+   };
+
    Timer() = default;
 
    ///
@@ -38,7 +60,7 @@ public:
    ~Timer() = default;
 
    ///
-   /// \brief Advances all timers matching `scope` and runs due callbacks.
+   /// \brief Runs the callbacks of all timers in `scope` that are due.
    /// \param scope Update scope currently being processed.
    ///
    static void update(Scope scope);
@@ -50,33 +72,81 @@ public:
    /// \param type Single-shot or repeated behavior.
    /// \param scope Update scope required for this timer to advance.
    /// \param data Optional attached user data.
-   /// \param caller Optional owner token for grouped removal.
+   /// \param caller Optional owner token for grouped removal; only compared, never dereferenced.
+   /// \return Handle that can be passed to remove.
    ///
-   static void add(
+   static Handle add(
       std::chrono::milliseconds interval,
       std::function<void()> callback,
       Type type = Type::Singleshot,
       Scope scope = Scope::UpdateAlways,
       const std::shared_ptr<void>& data = nullptr,
-      const std::shared_ptr<void>& caller = nullptr
+      const void* caller = nullptr
    );
 
+   ///
+   /// \brief Removes one timer; does nothing if it has already fired or been removed.
+   /// \param handle Handle returned by add.
+   ///
+   static void remove(Handle handle);
+
    ///
    /// \brief Removes all timers associated with `caller`.
    /// \param caller Owner token used when creating timers.
    ///
-   static void removeByCaller(const std::shared_ptr<void>& caller);
+   static void removeByCaller(const void* caller);
+
+   ///
+   /// \brief Returns the number of registered timers.
+   /// \return Timers that have neither fired (if single-shot) nor been removed.
+   ///
+   static size_t getTimerCount();
+
+   ///
+   /// \brief Stops following real time; from now on timers only move through advanceSimulatedTime.
+   ///
+   static void useSimulatedTime();
+
+   ///
+   /// \brief Moves simulated time forward.
+   /// \param dt Time to add.
+   ///
+   static void advanceSimulatedTime(std::chrono::high_resolution_clock::duration dt);
 
    std::chrono::milliseconds _interval;
    Type _type = Type::Singleshot;
    Scope _scope = Scope::UpdateAlways;
 
    std::function<void()> _callback = nullptr;
-   std::chrono::high_resolution_clock::time_point _start_time;
+   std::chrono::high_resolution_clock::time_point _deadline;
    std::shared_ptr<void> _data;
-   std::shared_ptr<void> _caller;
+   const void* _caller = nullptr;
 
 private:
-   static std::vector<std::unique_ptr<Timer>> __timers;
+   struct Slot;
+
+   ///
+   /// \brief One scope's ring of buckets.
+   ///
+   struct Wheel
+   {
+      std::vector<int32_t> _first_slot_in_bucket;
+      std::vector<int32_t> _last_slot_in_bucket;
+      int64_t _processed_tick = -1;  //!< last tick whose bucket was walked
+   };
+
+   static std::chrono::high_resolution_clock::time_point getNow();
+   static int64_t getTick(std::chrono::high_resolution_clock::time_point time_point);
+   static bool isValid(Handle handle);
+   static void link(uint32_t slot_index);
+   static void unlink(uint32_t slot_index);
+   static void release(uint32_t slot_index);
+
+   static std::vector<Slot> __slots;
+   static std::vector<uint32_t> __free_slots;
+   static std::array<Wheel, 2> __wheels;  //!< one per scope
+   static std::unordered_map<const void*, int32_t> __first_slot_by_caller;
+   static size_t __timer_count;
+   static std::optional<std::chrono::high_resolution_clock::time_point> __simulated_now;
    static std::mutex __mutex;
 };
@@ -150,7 +150,7 @@ const std::vector<float>* Audio::getLoudnessEnvelope(const std::string& sample_n
    return envelope.empty() ? nullptr : &envelope;
 }
 
-std::optional<float> Audio::getSampleLoudness(int32_t thread)
+std::optional<float> Audio::getSampleLoudness(const Playback& playback)
 {
    std::lock_guard<std::mutex> guard(_mutex);
 
@@ -159,19 +159,19 @@ std::optional<float> Audio::getSampleLoudness(int32_t thread)
       return std::nullopt;
    }
 
-   auto& sound_thread = _sound_threads[thread];
-   if (!sound_thread._sound || !_backend->isActive(*sound_thread._sound))
+   auto* sound_thread = getCurrentThread(playback);
+   if (!sound_thread || !sound_thread->_sound || !_backend->isActive(*sound_thread->_sound))
    {
       return std::nullopt;
    }
 
-   const auto* envelope = getLoudnessEnvelope(sound_thread._filename);
+   const auto* envelope = getLoudnessEnvelope(sound_thread->_filename);
    if (envelope == nullptr)
    {
       return std::nullopt;
    }
 
-   const auto playing_offset_s = sound_thread._sound->getPlayingOffset().asSeconds();
+   const auto playing_offset_s = sound_thread->_sound->getPlayingOffset().asSeconds();
    const auto bucket = static_cast<size_t>(playing_offset_s / loudness_bucket_duration_s);
 
    return (*envelope)[std::min(bucket, envelope->size() - 1)];
@@ -210,6 +210,9 @@ void Audio::debug()
 void Audio::updateListenerPosition(const sf::Vector2f& pos)
 {
    _backend->setListenerPosition(pos);
+
+   std::lock_guard<std::mutex> guard(_mutex);
+   _voice_allocator.setListenerPosition(pos.x, pos.y);
 }
 
 void Audio::adjustActiveSampleVolume()
@@ -224,58 +227,105 @@ void Audio::adjustActiveSampleVolume()
    }
 }
 
-std::optional<int32_t> Audio::playSample(const PlayInfo& play_info)
+std::optional<Audio::Playback> Audio::playSample(const PlayInfo& play_info)
 {
    std::lock_guard<std::mutex> guard(_mutex);
 
    // debug();
 
-   // find a free sample thread
-   const auto& thread_it = std::find_if(
-      _sound_threads.begin(),
-      _sound_threads.end(),
-      [this](const auto& thread) { return thread._sound == nullptr || !_backend->isActive(*thread._sound); }
+   // check if we have the sample
+   if (!_backend->hasSample(play_info._sample_name))
+   {
+      Log::Error() << "sample not found: " << play_info._sample_name;
+      return std::nullopt;
+   }
+
+   const auto position = play_info._pos.value_or(sf::Vector3f{0.0f, 0.0f, 0.1f});
+
+   VoiceAllocator::Request request;
+   request._sample_name = play_info._sample_name;
+   request._priority = play_info._priority;
+   request._looped = play_info._looped;
+   request._positioned = play_info._pos.has_value();
+   request._x = position.x;
+   request._y = position.y;
+
+   const auto allocation = _voice_allocator.allocate(
+      request,
+      [this](int32_t voice)
+      {
+         const auto& thread = _sound_threads[voice];
+         return thread._sound != nullptr && _backend->isActive(*thread._sound);
+      }
    );
 
-   if (thread_it == _sound_threads.cend())
+   if (!allocation.has_value())
    {
       Log::Error() << "no free thread to play: " << play_info._sample_name;
       return std::nullopt;
    }
 
-   // check if we have the sample
-   if (!_backend->hasSample(play_info._sample_name))
+   auto& thread = _sound_threads[allocation->_voice];
+   if (allocation->_stolen && thread._sound)
    {
-      Log::Error() << "sample not found: " << play_info._sample_name;
-      return std::nullopt;
+      thread._sound->stop();
    }
 
-   const auto position = play_info._pos.value_or(sf::Vector3f{0.0f, 0.0f, 0.1f});
-
-   auto prepared_sound = _backend->prepareSound(std::move(thread_it->_sound), play_info._sample_name);
+   auto prepared_sound = _backend->prepareSound(std::move(thread._sound), play_info._sample_name);
    if (prepared_sound == nullptr)
    {
+      _voice_allocator.release(allocation->_voice);
       return std::nullopt;
    }
-   thread_it->_sound = std::move(prepared_sound);
-
-   thread_it->_sound->setLooping(play_info._looped);
-   thread_it->_sound->setPosition(position);
-   thread_it->_sound->setMinDistance(10000.0f);
-   thread_it->_sound->setAttenuation(0.0f);
-   thread_it->_generation++;
-   thread_it->_filename = play_info._sample_name;
-   thread_it->_play_info = play_info;
-   thread_it->setVolume(play_info._volume);
-   thread_it->_sound->play();
-
-   return static_cast<int32_t>(std::distance(_sound_threads.begin(), thread_it));
+   thread._sound = std::move(prepared_sound);
+
+   thread._sound->setLooping(play_info._looped);
+   thread._sound->setPosition(position);
+   thread._sound->setMinDistance(10000.0f);
+   thread._sound->setAttenuation(0.0f);
+   thread._generation++;
+   thread._filename = play_info._sample_name;
+   thread._play_info = play_info;
+   thread.setVolume(play_info._volume);
+   thread._sound->play();
+
+   return Playback{allocation->_voice, thread._generation};
+}
+
+bool Audio::requestSample(const PlayInfo& play_info)
+{
+   return _requested_samples.push(play_info);
 }
 
-uint32_t Audio::getPlaybackGeneration(int32_t thread)
+void Audio::update()
+{
+   {
+      std::lock_guard<std::mutex> guard(_mutex);
+      _voice_allocator.beginFrame();
+   }
+
+   while (auto play_info = _requested_samples.pop())
+   {
+      playSample(play_info.value());
+   }
+}
+
+VoiceAllocator::Counters Audio::getVoiceCounters()
+{
+   std::lock_guard<std::mutex> guard(_mutex);
+   return _voice_allocator.getCounters();
+}
+
+bool Audio::isCurrent(const Playback& playback)
 {
    std::lock_guard<std::mutex> guard(_mutex);
-   return _sound_threads[thread]._generation;
+   return getCurrentThread(playback) != nullptr;
+}
+
+Audio::SoundThread* Audio::getCurrentThread(const Playback& playback)
+{
+   auto& thread = _sound_threads[playback._thread];
+   return thread._generation == playback._generation ? &thread : nullptr;
 }
 
 void Audio::stopSample(const std::string& name)
@@ -296,29 +346,44 @@ void Audio::stopSample(const std::string& name)
    }
 }
 
-void Audio::stopSample(int32_t thread_index)
+void Audio::stopSample(const Playback& playback)
 {
    std::lock_guard<std::mutex> guard(_mutex);
    if (_stopped)
    {
       return;
    }
-   if (_sound_threads[thread_index]._sound)
+
+   // the thread may have been stolen by another sound, which then owns the voice as well
+   auto* thread = getCurrentThread(playback);
+   if (!thread)
+   {
+      return;
+   }
+
+   if (thread->_sound)
    {
-      _sound_threads[thread_index]._sound->stop();
+      thread->_sound->stop();
    }
+   _voice_allocator.release(playback._thread);
 }
 
-void Audio::setVolume(int32_t thread, float volume)
+void Audio::setVolume(const Playback& playback, float volume)
 {
    std::lock_guard<std::mutex> guard(_mutex);
-   _sound_threads[thread].setVolume(volume);
+   if (auto* thread = getCurrentThread(playback))
+   {
+      thread->setVolume(volume);
+   }
 }
 
-void Audio::setPosition(int32_t thread, const sf::Vector2f pos)
+void Audio::setPosition(const Playback& playback, const sf::Vector2f pos)
 {
    std::lock_guard<std::mutex> guard(_mutex);
-   _sound_threads[thread].setPosition(pos);
+   if (auto* thread = getCurrentThread(playback))
+   {
+      thread->setPosition(pos);
+   }
 }
 
 void Audio::SoundThread::setVolume(float volume)
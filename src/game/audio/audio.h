@@ -1,6 +1,8 @@
 #pragma once
 
+#include "framework/tools/boundedqueue.h"
 #include "game/audio/audiobackend.h"
+#include "game/audio/voiceallocator.h"
 
 #include <SFML/Audio.hpp>
 #ifdef DECEPTUS_VRSFML
@@ -36,6 +38,10 @@ public:
    /// \brief playback request options used when starting a sound sample.
    struct PlayInfo
    {
+      static constexpr int32_t priority_effect = -1;  //!< frequent one-shots like projectile hits, the first to give way
+      static constexpr int32_t priority_default = 0;
+      static constexpr int32_t priority_loop = 1;  //!< sounds that keep playing while a mechanism is running
+
       /// \brief constructs an empty playback request.
       PlayInfo() = default;
 
@@ -63,7 +69,20 @@ public:
       std::string _sample_name;
       float _volume = 1.0f;
       bool _looped = false;
-      std::optional<sf::Vector3f> _pos;
+      int32_t _priority = priority_default;  //!< decides which sound gives way when every thread is busy, higher wins
+      std::optional<sf::Vector3f> _pos;      //!< world position in pixels, sounds without one play at the listener
+   };
+
+   /// \brief identifies one playback by its sound thread and the generation that thread had when it started.
+   ///
+   /// A thread index alone does not identify a playback: once a sample stops its slot is recycled, and a
+   /// one-shot may be taken over by a more important sound while it still plays. A stale index would let
+   /// one owner re-volume, move or even stop another owner's sound, so the calls taking a Playback do
+   /// nothing once the thread has moved on.
+   struct Playback
+   {
+      int32_t _thread = 0;
+      uint32_t _generation = 0;
    };
 
    /// \brief reusable playback slot containing one sf::Sound instance and its active request metadata.
@@ -103,15 +122,10 @@ public:
    /// \return duration of the sample, or std::nullopt when the sample is not cached.
    std::optional<sf::Time> getSampleDuration(const std::string& sample_name);
 
-   /// \brief returns a counter that changes whenever a sound thread is handed to a new sample.
-   ///
-   /// A thread index alone does not identify a playback: once a sample stops, its slot is recycled and
-   /// handed to the next caller, so a stale index would let one owner read, re-volume or even stop
-   /// another owner's sound. Callers that hold on to a thread index across frames should capture this
-   /// counter right after playSample and compare before acting on the thread again.
-   /// \param thread index of the sound thread to query.
-   /// \return current generation of that thread.
-   uint32_t getPlaybackGeneration(int32_t thread);
+   /// \brief checks whether a playback still owns its sound thread.
+   /// \param playback playback returned by playSample.
+   /// \return false once the thread has been handed to another sample.
+   bool isCurrent(const Playback& playback);
 
    /// \brief returns how loud the sample on one sound thread is at its current playback position.
    ///
@@ -119,32 +133,52 @@ public:
    /// use and normalized to the loudest passage of that sample, so 1.0 is the sample's own peak
    /// rather than an absolute level. Callers can use this to drive gameplay or visuals from what is
    /// actually audible right now.
-   /// \param thread index of the sound thread to sample.
-   /// \return normalized loudness in 0..1, or std::nullopt when the thread plays nothing.
-   std::optional<float> getSampleLoudness(int32_t thread);
+   /// \param playback playback returned by playSample.
+   /// \return normalized loudness in 0..1, or std::nullopt when the playback is over.
+   std::optional<float> getSampleLoudness(const Playback& playback);
 
-   /// \brief starts sample playback on the first free sound thread.
-   /// \param play_info playback request containing sample name, gain, looping, and optional position.
-   /// \return thread index used for playback, or std::nullopt when no slot or sample is available.
-   std::optional<int32_t> playSample(const PlayInfo& play_info);
+   /// \brief starts sample playback on a free sound thread, taking over a less important one if none is free.
+   /// \param play_info playback request containing sample name, gain, looping, priority, and optional position.
+   /// \return the playback started, or std::nullopt when no slot or sample is available.
+   std::optional<Playback> playSample(const PlayInfo& play_info);
+
+   /// \brief queues a fire-and-forget sample without waiting for the audio lock.
+   ///
+   /// Meant for one-shots triggered from gameplay code that has no use for the thread index; the
+   /// request is started by the next call to update. Safe to call from any thread.
+   /// \param play_info playback request containing sample name, gain, looping, priority, and optional position.
+   /// \return false if the queue is full and the request was dropped.
+   bool requestSample(const PlayInfo& play_info);
+
+   /// \brief starts the samples queued by requestSample, called once per frame from the main thread.
+   ///
+   /// Also lets the voice allocator look for finished threads again; it asks the backend about every
+   /// busy thread at most once per frame.
+   void update();
+
+   /// \brief returns what the voice allocator did so far.
+   /// \return allocation, steal, rejection and reclaim counts.
+   VoiceAllocator::Counters getVoiceCounters();
 
    /// \brief stops all currently playing threads whose filename matches the given sample name.
    /// \param name sample filename to stop.
    void stopSample(const std::string& name);
 
-   /// \brief stops playback for one sound thread by index.
-   /// \param thread index of the sound thread to stop.
-   void stopSample(int32_t thread);
+   /// \brief stops one playback, unless its thread has been handed to another sample meanwhile.
+   /// \param playback playback returned by playSample.
+   void stopSample(const Playback& playback);
+
+   static constexpr int32_t sound_thread_count = 50;
 
-   /// \brief updates volume for one sound thread.
-   /// \param thread index of the sound thread to modify.
+   /// \brief updates the volume of one playback, unless its thread has been handed to another sample.
+   /// \param playback playback returned by playSample.
    /// \param volume per-sample volume multiplier in normalized units.
-   void setVolume(int32_t thread, float volume);
+   void setVolume(const Playback& playback, float volume);
 
-   /// \brief updates 2d position for one sound thread.
-   /// \param thread index of the sound thread to modify.
+   /// \brief updates the 2d position of one playback, unless its thread has been handed to another sample.
+   /// \param playback playback returned by playSample.
    /// \param pos world position in pixels.
-   void setPosition(int32_t thread, const sf::Vector2f pos);
+   void setPosition(const Playback& playback, const sf::Vector2f pos);
 
 private:
    /// \brief preloads a fixed set of frequently used game sound effects.
@@ -160,9 +194,18 @@ private:
    /// \return normalized rms buckets, or nullptr when the sample is not cached or carries no data.
    const std::vector<float>* getLoudnessEnvelope(const std::string& sample_name);
 
+   /// \brief returns the sound thread of a playback if it still owns it.
+   ///
+   /// Must be called with _mutex held.
+   /// \param playback playback returned by playSample.
+   /// \return the thread, or nullptr once it has been handed to another sample.
+   SoundThread* getCurrentThread(const Playback& playback);
+
    std::mutex _mutex;
    std::atomic<bool> _stopped = false;
    std::unique_ptr<AudioBackend> _backend;  //!< platform-specific device, buffer cache, and sound plumbing
-   std::array<SoundThread, 50> _sound_threads;
+   std::array<SoundThread, sound_thread_count> _sound_threads;
+   VoiceAllocator _voice_allocator{sound_thread_count};  //!< picks the thread for each sample, guarded by _mutex
+   BoundedQueue<PlayInfo, 256> _requested_samples;  //!< filled by requestSample, drained by update
    std::map<std::string, std::vector<float>> _loudness_envelopes;  //!< lazily built rms buckets keyed by sample filename
 };
@@ -37,7 +37,7 @@ bool SoundRotation::empty() const
 
 bool SoundRotation::ownsThread() const
 {
-   return _thread_id.has_value() && Audio::getInstance().getPlaybackGeneration(_thread_id.value()) == _generation;
+   return _playback.has_value() && Audio::getInstance().isCurrent(_playback.value());
 }
 
 bool SoundRotation::isPlaying() const
@@ -104,20 +104,19 @@ void SoundRotation::playNext(float volume)
    _current_index = next_index;
    _elapsed_in_current_s = 0.0f;
    _current_duration_s = duration.has_value() ? duration->asSeconds() : 0.0f;
-   _thread_id = Audio::getInstance().playSample({sample, volume, looped});
-   _generation = _thread_id.has_value() ? Audio::getInstance().getPlaybackGeneration(_thread_id.value()) : 0;
+   _playback = Audio::getInstance().playSample({sample, volume, looped});
 }
 
 void SoundRotation::stop()
 {
    if (!ownsThread())
    {
-      _thread_id.reset();
+      _playback.reset();
       return;
    }
 
-   Audio::getInstance().stopSample(_thread_id.value());
-   _thread_id.reset();
+   Audio::getInstance().stopSample(_playback.value());
+   _playback.reset();
 }
 
 void SoundRotation::setVolume(float volume)
@@ -127,7 +126,7 @@ void SoundRotation::setVolume(float volume)
       return;
    }
 
-   Audio::getInstance().setVolume(_thread_id.value(), volume);
+   Audio::getInstance().setVolume(_playback.value(), volume);
 }
 
 std::optional<float> SoundRotation::getLoudness() const
@@ -137,5 +136,5 @@ std::optional<float> SoundRotation::getLoudness() const
       return std::nullopt;
    }
 
-   return Audio::getInstance().getSampleLoudness(_thread_id.value());
+   return Audio::getInstance().getSampleLoudness(_playback.value());
 }
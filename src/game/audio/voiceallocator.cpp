@@ -0,0 +1,244 @@
+#include "voiceallocator.h"
+
+#include <numeric>
+
+VoiceAllocator::VoiceAllocator(int32_t voice_count) : _voices(voice_count)
+{
+   _busy_voices.reserve(voice_count);
+
+   // hand out low indices first, purely so a quiet level keeps its sounds on the first few voices
+   _free_voices.resize(voice_count);
+   std::iota(_free_voices.rbegin(), _free_voices.rend(), 0);
+}
+
+std::optional<VoiceAllocator::Allocation> VoiceAllocator::allocate(const Request& request, const IsActive& is_active)
+{
+   // a sample at its limit replaces its own oldest voice rather than taking one from another sample
+   const auto limit = getSampleVoiceLimit(request._sample_name);
+   const auto count_it = _sample_voice_counts.find(request._sample_name);
+   if (count_it != _sample_voice_counts.end() && count_it->second >= limit)
+   {
+      if (!_reclaimed_this_frame)
+      {
+         reclaim(is_active);
+      }
+
+      const auto count = _sample_voice_counts[request._sample_name];
+      if (count >= limit)
+      {
+         const auto oldest = findOldestVoiceOfSample(request._sample_name);
+         if (!oldest.has_value())
+         {
+            _counters._rejections++;
+            return std::nullopt;
+         }
+
+         markFree(oldest.value());
+         markBusy(oldest.value(), request);
+         _counters._allocations++;
+         _counters._steals++;
+         return Allocation{oldest.value(), true};
+      }
+   }
+
+   if (_free_voices.empty() && !_reclaimed_this_frame)
+   {
+      reclaim(is_active);
+   }
+
+   if (!_free_voices.empty())
+   {
+      const auto voice = _free_voices.back();
+      _free_voices.pop_back();
+      markBusy(voice, request);
+      _counters._allocations++;
+      return Allocation{voice, false};
+   }
+
+   const auto victim = findVictim(request);
+   if (!victim.has_value())
+   {
+      _counters._rejections++;
+      return std::nullopt;
+   }
+
+   markFree(victim.value());
+   markBusy(victim.value(), request);
+   _counters._allocations++;
+   _counters._steals++;
+   return Allocation{victim.value(), true};
+}
+
+void VoiceAllocator::beginFrame()
+{
+   _reclaimed_this_frame = false;
+}
+
+void VoiceAllocator::release(int32_t voice)
+{
+   if (!_voices[voice]._busy)
+   {
+      return;
+   }
+
+   markFree(voice);
+   _free_voices.push_back(voice);
+}
+
+void VoiceAllocator::setListenerPosition(float x, float y)
+{
+   _listener_x = x;
+   _listener_y = y;
+}
+
+void VoiceAllocator::setSampleVoiceLimit(const std::string& sample_name, int32_t limit)
+{
+   _sample_voice_limits[sample_name] = limit;
+}
+
+const VoiceAllocator::Counters& VoiceAllocator::getCounters() const
+{
+   return _counters;
+}
+
+int32_t VoiceAllocator::getFreeVoiceCount() const
+{
+   return static_cast<int32_t>(_free_voices.size());
+}
+
+void VoiceAllocator::reclaim(const IsActive& is_active)
+{
+   _reclaimed_this_frame = true;
+
+   // walk backwards so the swap-remove in markFree only moves voices that were already checked
+   for (auto index = static_cast<int32_t>(_busy_voices.size()) - 1; index >= 0; index--)
+   {
+      const auto voice = _busy_voices[index];
+      if (is_active(voice))
+      {
+         continue;
+      }
+
+      markFree(voice);
+      _free_voices.push_back(voice);
+      _counters._reclaims++;
+   }
+}
+
+void VoiceAllocator::markBusy(int32_t voice_index, const Request& request)
+{
+   auto& voice = _voices[voice_index];
+   voice._sample_name = request._sample_name;
+   voice._priority = request._priority;
+   voice._looped = request._looped;
+   voice._positioned = request._positioned;
+   voice._x = request._x;
+   voice._y = request._y;
+   voice._start_sequence = _sequence++;
+   voice._busy = true;
+   voice._busy_index = static_cast<int32_t>(_busy_voices.size());
+
+   _busy_voices.push_back(voice_index);
+   _sample_voice_counts[request._sample_name]++;
+}
+
+void VoiceAllocator::markFree(int32_t voice_index)
+{
+   auto& voice = _voices[voice_index];
+
+   const auto last = _busy_voices.back();
+   _busy_voices[voice._busy_index] = last;
+   _voices[last]._busy_index = voice._busy_index;
+   _busy_voices.pop_back();
+
+   _sample_voice_counts[voice._sample_name]--;
+
+   voice._busy = false;
+   voice._busy_index = -1;
+}
+
+int32_t VoiceAllocator::getSampleVoiceLimit(const std::string& sample_name) const
+{
+   const auto it = _sample_voice_limits.find(sample_name);
+   return (it != _sample_voice_limits.end()) ? it->second : default_sample_voice_limit;
+}
+
+float VoiceAllocator::getDistanceSq(const Voice& voice) const
+{
+   // unpositioned sounds play at the listener
+   if (!voice._positioned)
+   {
+      return 0.0f;
+   }
+
+   const auto dx = voice._x - _listener_x;
+   const auto dy = voice._y - _listener_y;
+   return dx * dx + dy * dy;
+}
+
+std::optional<int32_t> VoiceAllocator::findOldestVoiceOfSample(const std::string& sample_name) const
+{
+   std::optional<int32_t> oldest;
+   for (const auto voice_index : _busy_voices)
+   {
+      const auto& voice = _voices[voice_index];
+      if (voice._looped || voice._sample_name != sample_name)
+      {
+         continue;
+      }
+
+      if (!oldest.has_value() || voice._start_sequence < _voices[oldest.value()]._start_sequence)
+      {
+         oldest = voice_index;
+      }
+   }
+
+   return oldest;
+}
+
+std::optional<int32_t> VoiceAllocator::findVictim(const Request& request) const
+{
+   Voice requested;
+   requested._positioned = request._positioned;
+   requested._x = request._x;
+   requested._y = request._y;
+   const auto requested_distance_sq = getDistanceSq(requested);
+
+   std::optional<int32_t> victim;
+   auto victim_distance_sq = 0.0f;
+
+   for (const auto voice_index : _busy_voices)
+   {
+      const auto& voice = _voices[voice_index];
+      if (voice._looped || voice._priority > request._priority)
+      {
+         continue;
+      }
+
+      // at the same priority, a sound farther away than the one asking is not worth cutting off a closer one
+      const auto distance_sq = getDistanceSq(voice);
+      if (voice._priority == request._priority && distance_sq < requested_distance_sq)
+      {
+         continue;
+      }
+
+      if (!victim.has_value())
+      {
+         victim = voice_index;
+         victim_distance_sq = distance_sq;
+         continue;
+      }
+
+      const auto& current = _voices[victim.value()];
+      const auto better = (voice._priority != current._priority) ? (voice._priority < current._priority)
+                          : (distance_sq != victim_distance_sq)  ? (distance_sq > victim_distance_sq)
+                                                                 : (voice._start_sequence < current._start_sequence);
+      if (better)
+      {
+         victim = voice_index;
+         victim_distance_sq = distance_sq;
+      }
+   }
+
+   return victim;
+}
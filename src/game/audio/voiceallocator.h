@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// \brief decides which of a fixed set of voices a new sound is played on.
+///
+/// Free voices are kept on a stack, so handing one out does not depend on the number of voices. A voice
+/// does not report back when its sound ends; instead, busy voices are checked against the backend only
+/// when the free stack runs dry, and the ones that finished are moved back in one go. That check runs at
+/// most once per frame: in a burst, sounds ending a few milliseconds into the frame are not worth asking
+/// the device about every voice again for each request.
+///
+/// When every voice is busy, a new sound may take over a playing one: the victim is the voice with the
+/// lowest priority, then the one farthest away from the listener, then the oldest. A sound never takes
+/// a voice from one with a higher priority, and looped sounds are never taken over since nobody would
+/// restart them. Each sample can also be limited to a number of voices so a burst of the same one-shot
+/// cannot crowd out everything else; past that limit the sample replaces its own oldest voice.
+///
+/// The allocator only does the bookkeeping, it does not know about sf::Sound and is not thread-safe.
+class VoiceAllocator
+{
+public:
+   /// \brief a sound that wants a voice.
+   struct Request
+   {
+      std::string _sample_name;
+      int32_t _priority = 0;  //!< higher values win when voices are stolen
+      bool _looped = false;
+      bool _positioned = false;  //!< false for sounds that play at the listener
+      float _x = 0.0f;
+      float _y = 0.0f;
+   };
+
+   /// \brief the voice handed out for a request.
+   struct Allocation
+   {
+      int32_t _voice = 0;
+      bool _stolen = false;  //!< the voice was still playing and has to be stopped first
+   };
+
+   /// \brief what the allocator did since it was created.
+   struct Counters
+   {
+      int64_t _allocations = 0;
+      int64_t _steals = 0;
+      int64_t _rejections = 0;  //!< requests that found every voice busy with more important sounds
+      int64_t _reclaims = 0;    //!< voices found finished and moved back to the free stack
+   };
+
+   /// \brief tells whether the sound on a voice is still playing.
+   using IsActive = std::function<bool(int32_t voice)>;
+
+   /// \brief constructs an allocator with all voices free.
+   /// \param voice_count number of voices to manage.
+   explicit VoiceAllocator(int32_t voice_count);
+
+   /// \brief finds a voice for a request.
+   /// \param request the sound to play.
+   /// \param is_active used to find voices whose sound has ended.
+   /// \return the voice to play on, or std::nullopt if the request loses against every playing sound.
+   std::optional<Allocation> allocate(const Request& request, const IsActive& is_active);
+
+   /// \brief allows the next allocation that finds no free voice to look for finished ones again.
+   void beginFrame();
+
+   /// \brief returns a voice to the free stack right away, e.g. after its sound was stopped.
+   /// \param voice index of the voice.
+   void release(int32_t voice);
+
+   /// \brief updates the position used to rank positioned voices by distance.
+   /// \param x listener x position in pixels.
+   /// \param y listener y position in pixels.
+   void setListenerPosition(float x, float y);
+
+   /// \brief limits how many voices one sample may play on at the same time.
+   /// \param sample_name sample to limit.
+   /// \param limit maximum number of voices.
+   void setSampleVoiceLimit(const std::string& sample_name, int32_t limit);
+
+   /// \brief returns the allocator's counters.
+   /// \return counters since construction.
+   const Counters& getCounters() const;
+
+   /// \brief returns the number of voices currently on the free stack.
+   /// \return free voice count; finished voices not yet reclaimed are not included.
+   int32_t getFreeVoiceCount() const;
+
+   static constexpr int32_t default_sample_voice_limit = 8;
+
+private:
+   struct Voice
+   {
+      std::string _sample_name;
+      int32_t _priority = 0;
+      bool _looped = false;
+      bool _busy = false;
+      bool _positioned = false;
+      float _x = 0.0f;
+      float _y = 0.0f;
+      uint64_t _start_sequence = 0;  //!< order the voices were started in, lower is older
+      int32_t _busy_index = -1;      //!< position in _busy_voices
+   };
+
+   void reclaim(const IsActive& is_active);
+   void markBusy(int32_t voice, const Request& request);
+   void markFree(int32_t voice);
+   int32_t getSampleVoiceLimit(const std::string& sample_name) const;
+   float getDistanceSq(const Voice& voice) const;
+   std::optional<int32_t> findOldestVoiceOfSample(const std::string& sample_name) const;
+   std::optional<int32_t> findVictim(const Request& request) const;
+
+   std::vector<Voice> _voices;
+   std::vector<int32_t> _free_voices;
+   std::vector<int32_t> _busy_voices;
+   std::unordered_map<std::string, int32_t> _sample_voice_counts;
+   std::unordered_map<std::string, int32_t> _sample_voice_limits;
+   uint64_t _sequence = 0;
+   bool _reclaimed_this_frame = false;
+   float _listener_x = 0.0f;
+   float _listener_y = 0.0f;
+   Counters _counters;
+};
@@ -135,7 +135,7 @@ void VolumeUpdater::update()
    }
 }
 
-void VolumeUpdater::updateProjectiles(const std::set<Projectile*>& projectiles)
+void VolumeUpdater::updateProjectiles(const std::vector<Projectile*>& projectiles)
 {
    for (auto* projectile : projectiles)
    {
@@ -6,8 +6,8 @@
 #include "game/level/luanode.h"
 #include "game/mechanisms/gamemechanism.h"
 
-#include <set>
 #include <thread>
+#include <vector>
 
 class Projectile;
 
@@ -23,7 +23,7 @@ public:
 
    /// \brief updates projectile audio enablement according to parent audio update behavior metadata.
    /// \param projectiles active projectile pointers to evaluate.
-   void updateProjectiles(const std::set<Projectile*>& projectiles);
+   void updateProjectiles(const std::vector<Projectile*>& projectiles);
 
    /// \brief sets the current player position used for distance-based volume calculations.
    /// \param position player world position in pixels.
@@ -8,11 +8,28 @@ GameClock& GameClock::getInstance()
 
 void GameClock::reset()
 {
-   _start_time = std::chrono::high_resolution_clock::now();
+   _start_time = now();
 }
 
 GameClock::HighResDuration GameClock::durationSinceSpawn() const
 {
-   const auto now = std::chrono::high_resolution_clock::now();
-   return now - _start_time;
+   return now() - _start_time;
+}
+
+void GameClock::useSimulatedTime()
+{
+   _simulated_now = std::chrono::high_resolution_clock::now();
+}
+
+void GameClock::advanceSimulatedTime(const HighResDuration& dt)
+{
+   if (_simulated_now.has_value())
+   {
+      _simulated_now = _simulated_now.value() + dt;
+   }
+}
+
+GameClock::HighResTimePoint GameClock::now() const
+{
+   return _simulated_now.value_or(std::chrono::high_resolution_clock::now());
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chrono>
+#include <optional>
 
 /// \brief tracks elapsed high-resolution time since the game clock was last reset.
 class GameClock
@@ -20,8 +21,20 @@ public:
    /// \return high-resolution duration between now and the stored start time.
    HighResDuration durationSinceSpawn() const;
 
+   /// \brief stops following real time; from now on the clock only moves through advanceSimulatedTime.
+   void useSimulatedTime();
+
+   /// \brief moves a simulated clock forward.
+   /// \param dt time to add.
+   void advanceSimulatedTime(const HighResDuration& dt);
+
 private:
    /// \brief constructs the singleton clock without an initialized start timestamp.
    GameClock() = default;
+
+   /// \brief returns the simulated time when there is one, the real time otherwise.
+   HighResTimePoint now() const;
+
    HighResTimePoint _start_time;
+   std::optional<HighResTimePoint> _simulated_now;
 };
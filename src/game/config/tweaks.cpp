@@ -34,6 +34,7 @@ std::string Tweaks::serialize()
           {"cpan_unlimited", _cpan_unlimited},
           {"enter_portal_threshold", _enter_portal_threshold},
           {"player_stencil_alpha", _player_stencil_alpha},
+          {"lua_shared_vm", _lua_shared_vm},
        }}
    };
 
@@ -93,4 +94,9 @@ void Tweaks::deserialize(const std::string& data)
    {
       _player_stencil_alpha = config.at("player_stencil_alpha").get<uint8_t>();
    }
+
+   if (config.find("lua_shared_vm") != config.end())
+   {
+      _lua_shared_vm = config.at("lua_shared_vm").get<bool>();
+   }
 }
@@ -20,6 +20,7 @@ public:
    bool _cpan_unlimited = false;
    float _enter_portal_threshold = -0.6f;
    uint8_t _player_stencil_alpha = 40;
+   bool _lua_shared_vm = false;  //!< run all scripted enemies on one lua vm, see LuaSharedVm
 
 private:
    /// \brief constructs the tweaks container with built-in fallback values.
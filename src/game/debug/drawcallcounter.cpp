@@ -56,8 +56,7 @@ int64_t visibleArea(const sf::FloatRect& clip_px, float left_px, float top_px, f
 /// \param vertex_count how many vertices the run holds.
 /// \return the visible area of every whole quad in the run.
 /// \note two triangles per quad, so six vertices: top left, top right, bottom right, then top
-///       left, bottom right, bottom left. Both the ao atlas and the animated tiles build them
-///       that way.
+///       left, bottom right, bottom left. The ao atlas builds them that way.
 ///
 int64_t sumVisibleQuadArea(const sf::FloatRect& clip_px, const sf::Vertex* vertices, std::size_t vertex_count)
 {
@@ -167,18 +166,6 @@ sf::FloatRect DrawCallCounter::getClipRectPx(const sf::View& view)
    };
 }
 
-void DrawCallCounter::countAnimatedTilePixels(
-   const sf::RenderTarget& target,
-   const sf::View& view,
-   const sf::Vertex* vertices,
-   std::size_t vertex_count
-)
-{
-   tilemap_pixels_submitted += static_cast<int64_t>(
-      static_cast<double>(sumVisibleQuadArea(getClipRectPx(view), vertices, vertex_count)) * getTargetFillScale(target)
-   );
-}
-
 void DrawCallCounter::countAmbientOcclusionPixels(
    const sf::RenderTarget& target,
    const sf::RenderStates& states,
@@ -31,6 +31,11 @@ inline const void* tilemap_last_target = nullptr;
 //! map put together. That went unnoticed for as long as the counter only described tile maps.
 inline int32_t ambient_occlusion_draw_calls = 0;
 
+//! Draw calls issued by particle systems - dust, fireflies, rain and water bubbles - through a
+//! ParticleBatch. Each system submits one call per frame however many particles it has, so this
+//! should stay at the number of systems on screen; it used to be one call per particle.
+inline int32_t particle_draw_calls = 0;
+
 //! Candidates examined by Level::drawLayers while looking for things to draw at a z index. The loop
 //! runs once per z index and rescans every container each time, so this grows with the z range
 //! multiplied by the level's content rather than with what is actually on screen.
@@ -52,11 +57,21 @@ inline int64_t tilemap_tiles_submitted = 0;
 inline int32_t tilemap_blocks_drawn = 0;
 inline double tilemap_visible_fraction_sum = 0.0;
 
+//! Tile vertex bytes sent to the gpu per frame. The static blocks live in vertex buffers that are
+//! filled once when the level is loaded, animated tiles included, so in a steady frame this is only
+//! whatever hideTile touched; a layer drawn from memory instead shows up here with its whole batch.
+inline int64_t tilemap_bytes_uploaded = 0;
+
 //! Ambient occlusion pixels submitted per frame, each quad clipped to the view. Kept apart from the
 //! tile count because ao is a full screen overlay of thousands of alpha blended quads, so it costs
 //! fill out of proportion to the single draw call it now takes.
 inline int64_t ambient_occlusion_pixels_submitted = 0;
 
+//! Shadow vertices the light system submitted per frame, six per shadow quad, summed over all lights. The
+//! casters are gathered per light from the broadphase, so this follows what is around the lights rather
+//! than the number of bodies in the level.
+inline int64_t shadow_vertices_submitted = 0;
+
 //! Image layer pixels submitted per frame. The parallax backdrops are drawn to fill the view, so
 //! each one that is visible writes roughly a whole screen; the catacombs carry 21 of them.
 inline int64_t image_layer_pixels_submitted = 0;
@@ -132,18 +147,6 @@ double getTargetFillScale(const sf::RenderTarget& target);
 ///
 sf::FloatRect getClipRectPx(const sf::View& view);
 
-///
-/// \brief Adds the on-screen area of the animated tiles submitted with a tile map batch.
-/// \param target render target the batch went to.
-/// \param view the view the batch was drawn through.
-/// \param vertices first vertex of the animated run, two triangles per tile.
-/// \param vertex_count how many vertices the run holds.
-/// \note the animated tiles are gathered around the player block rather than around the view, so
-///       unlike the static blocks they are not culled before submission. Clipping them here is what
-///       keeps the layer totals comparable to each other.
-///
-void countAnimatedTilePixels(const sf::RenderTarget& target, const sf::View& view, const sf::Vertex* vertices, std::size_t vertex_count);
-
 ///
 /// \brief Adds the on-screen area of a batch of ambient occlusion quads.
 /// \param target render target the batch went to.
@@ -0,0 +1,20 @@
+#pragma once
+
+#ifdef DEVELOPMENT_MODE
+
+#include <cstdint>
+
+///
+/// \brief Counts what setting up the scripted enemies of a level costs, so the profiler can compare the vm modes.
+///
+/// A vm per enemy pays for the standard libraries, the callback registration and the script parse once per
+/// enemy, the shared vm once per distinct script. Both counters are reset with the lua interface, i.e. when a
+/// level is loaded, so they always describe the current level.
+///
+namespace LuaCounter
+{
+inline int64_t load_time_us = 0;  //!< time spent in LuaNode::setupLua, summed over all nodes
+inline int32_t nodes_loaded = 0;  //!< nodes set up since the level was loaded
+}  // namespace LuaCounter
+
+#endif  // DEVELOPMENT_MODE
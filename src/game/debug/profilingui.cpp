@@ -1,7 +1,66 @@
 #include "profilingui.h"
 
 #ifdef DEVELOPMENT_MODE
+#include "game/audio/audio.h"
+#include "game/config/tweaks.h"
 #include "game/debug/drawcallcounter.h"
+#include "game/debug/luacounter.h"
+#include "game/io/texturestreamer.h"
+#include "game/level/luainterface.h"
+#include "game/weapons/projectile.h"
+
+#include <iomanip>
+#include <sstream>
+
+namespace
+{
+// one line for the window and the log alike, so the two lua vm modes can be compared from either
+std::string formatLuaCounters()
+{
+   auto& lua_interface = LuaInterface::instance();
+
+   std::ostringstream lua_line;
+   lua_line << std::fixed << std::setprecision(2) << "lua: " << (Tweaks::instance()._lua_shared_vm ? "shared vm" : "vm per node") << " | "
+            << LuaCounter::nodes_loaded << " nodes loaded in " << (static_cast<float>(LuaCounter::load_time_us) / 1000.0f) << " ms | "
+            << lua_interface.getSharedVm().getCompiledScriptCount() << " compiled scripts | "
+            << (static_cast<float>(lua_interface.computeMemoryUsage()) / (1024.0f * 1024.0f)) << " mb resident";
+   return lua_line.str();
+}
+
+std::string formatTextureStreamingCounters()
+{
+   const auto& streamer = TextureStreamer::getInstance();
+
+   std::ostringstream streaming_line;
+   streaming_line << std::fixed << std::setprecision(2) << "textures: " << streamer.getQueueDepth() << " queued | "
+                  << streamer.getDecodingCount() << " decoding | " << streamer.getUploadCount() << " uploads in "
+                  << streamer.getUploadTimeMs() << " ms last step | peak " << streamer.getPeakUploadTimeMs() << " ms";
+   return streaming_line.str();
+}
+
+// occupancy tells how close a bullet pattern gets to the pool capacity, allocations against reuses
+// whether the free lists actually absorb the churn
+std::string formatProjectilePoolCounters()
+{
+   const auto& counters = Projectile::getPoolCounters();
+
+   std::ostringstream pool_line;
+   pool_line << "projectiles: " << counters._live << " live | " << counters._pooled << " pooled | peak " << counters._peak_live << " of "
+             << Projectile::pool_capacity << " | " << counters._allocations << " allocations | " << counters._reuses << " reuses | "
+             << counters._evictions << " evictions | " << counters._rejections << " rejected";
+   return pool_line.str();
+}
+
+std::string formatVoiceCounters()
+{
+   const auto counters = Audio::getInstance().getVoiceCounters();
+
+   std::ostringstream voice_line;
+   voice_line << "voices: " << counters._allocations << " allocations | " << counters._steals << " stolen | " << counters._rejections
+              << " rejected | " << counters._reclaims << " reclaimed";
+   return voice_line.str();
+}
+}  // namespace
 #endif
 
 #if defined(DEVELOPMENT_MODE) && !defined(DECEPTUS_VRSFML)
@@ -95,12 +154,15 @@ void logRenderSections(const std::vector<RenderSectionSample>& samples, int32_t
 void logDrawCounts(
    const float* draw_calls,
    const float* ambient_occlusion_draw_calls,
+   const float* particle_draw_calls,
    const float* target_switches,
    const float* scan_steps,
    const float* tilemap_pixels,
    const float* ambient_occlusion_pixels,
    const float* image_layer_pixels,
    const float* tilemap_normal_pixels,
+   const float* shadow_vertices,
+   const float* tilemap_bytes_uploaded,
    int32_t count
 )
 {
@@ -113,8 +175,10 @@ void logDrawCounts(
 
    std::ostringstream counts_line;
    counts_line << std::fixed << std::setprecision(1) << "profiling: tilemap draw calls per frame " << average(draw_calls)
-               << " | ao draw calls " << average(ambient_occlusion_draw_calls) << " | target switches " << average(target_switches)
-               << " | layer scan steps " << average(scan_steps);
+               << " | ao draw calls " << average(ambient_occlusion_draw_calls) << " | particle draw calls " << average(particle_draw_calls)
+               << " | target switches " << average(target_switches)
+               << " | layer scan steps " << average(scan_steps) << " | shadow vertices " << average(shadow_vertices)
+               << " | tilemap kb uploaded " << (average(tilemap_bytes_uploaded) / 1024.0f);
 
    // a pixel count is machine independent, so the overdraw split reads the same here as on the
    // console. that is what makes a fill cut measurable on a desktop that is not fill bound
@@ -222,6 +286,13 @@ void ProfilingUi::draw()
    ImGui::Text("swap time (window->display)");
    drawTimingGraph("##swap", _window_display_times_ms.data(), sample_count, _write_index, target_swap_ms);
 
+   ImGui::Spacing();
+   ImGui::Separator();
+   ImGui::Text("%s", formatLuaCounters().c_str());
+   ImGui::Text("%s", formatTextureStreamingCounters().c_str());
+   ImGui::Text("%s", formatProjectilePoolCounters().c_str());
+   ImGui::Text("%s", formatVoiceCounters().c_str());
+
    if (!_render_section_timings.empty())
    {
       ImGui::Spacing();
@@ -241,17 +312,24 @@ void ProfilingUi::draw()
          logDrawCounts(
             _tilemap_draw_calls.data(),
             _ambient_occlusion_draw_calls.data(),
+            _particle_draw_calls.data(),
             _tilemap_target_switches.data(),
             _layer_scan_steps.data(),
             _tilemap_pixels_submitted.data(),
             _ambient_occlusion_pixels_submitted.data(),
             _image_layer_pixels_submitted.data(),
             _tilemap_normal_pixels_submitted.data(),
+            _shadow_vertices_submitted.data(),
+            _tilemap_bytes_uploaded.data(),
             _samples_written
          );
          logTileMapLayerFill(
             section_frames, static_cast<float>(GameConfiguration::getInstance()._view_width * GameConfiguration::getInstance()._view_height)
          );
+         Log::Info() << "profiling: " << formatLuaCounters();
+         Log::Info() << "profiling: " << formatTextureStreamingCounters();
+         Log::Info() << "profiling: " << formatProjectilePoolCounters();
+         Log::Info() << "profiling: " << formatVoiceCounters();
          _render_section_timings.clear();
          _render_section_frames = 0;
       }
@@ -342,6 +420,8 @@ void ProfilingUi::recordFrame(sf::Time frame_time, sf::Time update_time, sf::Tim
    _tilemap_draw_calls[_write_index] = static_cast<float>(DrawCallCounter::tilemap_draw_calls);
    _ambient_occlusion_draw_calls[_write_index] = static_cast<float>(DrawCallCounter::ambient_occlusion_draw_calls);
    DrawCallCounter::ambient_occlusion_draw_calls = 0;
+   _particle_draw_calls[_write_index] = static_cast<float>(DrawCallCounter::particle_draw_calls);
+   DrawCallCounter::particle_draw_calls = 0;
    _tilemap_target_switches[_write_index] = static_cast<float>(DrawCallCounter::tilemap_target_switches);
    DrawCallCounter::tilemap_draw_calls = 0;
    _layer_scan_steps[_write_index] = static_cast<float>(DrawCallCounter::layer_scan_steps);
@@ -349,6 +429,8 @@ void ProfilingUi::recordFrame(sf::Time frame_time, sf::Time update_time, sf::Tim
    _ambient_occlusion_pixels_submitted[_write_index] = static_cast<float>(DrawCallCounter::ambient_occlusion_pixels_submitted);
    _tilemap_normal_pixels_submitted[_write_index] = static_cast<float>(DrawCallCounter::tilemap_normal_pixels_submitted);
    _image_layer_pixels_submitted[_write_index] = static_cast<float>(DrawCallCounter::image_layer_pixels_submitted);
+   _shadow_vertices_submitted[_write_index] = static_cast<float>(DrawCallCounter::shadow_vertices_submitted);
+   _tilemap_bytes_uploaded[_write_index] = static_cast<float>(DrawCallCounter::tilemap_bytes_uploaded);
    DrawCallCounter::tilemap_target_switches = 0;
    DrawCallCounter::tilemap_last_target = nullptr;
    DrawCallCounter::layer_scan_steps = 0;
@@ -356,6 +438,8 @@ void ProfilingUi::recordFrame(sf::Time frame_time, sf::Time update_time, sf::Tim
    DrawCallCounter::ambient_occlusion_pixels_submitted = 0;
    DrawCallCounter::tilemap_normal_pixels_submitted = 0;
    DrawCallCounter::image_layer_pixels_submitted = 0;
+   DrawCallCounter::shadow_vertices_submitted = 0;
+   DrawCallCounter::tilemap_bytes_uploaded = 0;
    _write_index = (_write_index + 1) % sample_count;
    _samples_written = std::min(_samples_written + 1, sample_count);
 }
@@ -522,13 +606,16 @@ void ProfilingUi::draw()
    std::ostringstream draw_call_line;
    draw_call_line << std::fixed << std::setprecision(1) << "profiling: tilemap draw calls per frame "
                   << formatSummary("", draw_call_summary) << " | ao draw calls "
-                  << formatSummary("", summarizeSamples(_ambient_occlusion_draw_calls.data(), _samples_written)) << " | target switches "
+                  << formatSummary("", summarizeSamples(_ambient_occlusion_draw_calls.data(), _samples_written))
+                  << " | particle draw calls " << formatSummary("", summarizeSamples(_particle_draw_calls.data(), _samples_written))
+                  << " | target switches "
                   << formatSummary("", summarizeSamples(_tilemap_target_switches.data(), _samples_written)) << " | layer scan steps "
-                  << formatSummary("", summarizeSamples(_layer_scan_steps.data(), _samples_written));
+                  << formatSummary("", summarizeSamples(_layer_scan_steps.data(), _samples_written)) << " | shadow vertices "
+                  << formatSummary("", summarizeSamples(_shadow_vertices_submitted.data(), _samples_written))
+                  << " | tilemap bytes uploaded " << formatSummary("", summarizeSamples(_tilemap_bytes_uploaded.data(), _samples_written));
 
    // tile pixels submitted against the view area. this is an upper bound rather than a measurement:
-   // it sums the colour and the normal target, and the animated tiles are gathered around the
-   // player block rather than the view, so both inflate it. use it to watch a change move the
+   // it sums the colour and the normal target, which inflates it. use it to watch a change move the
    // number, not as an absolute - lab/tile_opacity/analyze_opacity.py computes the real figure
    // offline from the tilesets
    const auto view_area = GameConfiguration::getInstance()._view_width * GameConfiguration::getInstance()._view_height;
@@ -583,6 +670,10 @@ void ProfilingUi::draw()
    }
 
    logTileMapLayerFill(std::max(_render_section_frames, 1), static_cast<float>(view_area));
+   Log::Info() << "profiling: " << formatLuaCounters();
+   Log::Info() << "profiling: " << formatTextureStreamingCounters();
+   Log::Info() << "profiling: " << formatProjectilePoolCounters();
+   Log::Info() << "profiling: " << formatVoiceCounters();
 
    for (const auto& sample : _mechanism_timings)
    {
@@ -624,6 +715,8 @@ void ProfilingUi::recordFrame(sf::Time frame_time, sf::Time update_time, sf::Tim
    _tilemap_draw_calls[_write_index] = static_cast<float>(DrawCallCounter::tilemap_draw_calls);
    _ambient_occlusion_draw_calls[_write_index] = static_cast<float>(DrawCallCounter::ambient_occlusion_draw_calls);
    DrawCallCounter::ambient_occlusion_draw_calls = 0;
+   _particle_draw_calls[_write_index] = static_cast<float>(DrawCallCounter::particle_draw_calls);
+   DrawCallCounter::particle_draw_calls = 0;
    _tilemap_target_switches[_write_index] = static_cast<float>(DrawCallCounter::tilemap_target_switches);
    DrawCallCounter::tilemap_draw_calls = 0;
    _layer_scan_steps[_write_index] = static_cast<float>(DrawCallCounter::layer_scan_steps);
@@ -631,6 +724,8 @@ void ProfilingUi::recordFrame(sf::Time frame_time, sf::Time update_time, sf::Tim
    _ambient_occlusion_pixels_submitted[_write_index] = static_cast<float>(DrawCallCounter::ambient_occlusion_pixels_submitted);
    _tilemap_normal_pixels_submitted[_write_index] = static_cast<float>(DrawCallCounter::tilemap_normal_pixels_submitted);
    _image_layer_pixels_submitted[_write_index] = static_cast<float>(DrawCallCounter::image_layer_pixels_submitted);
+   _shadow_vertices_submitted[_write_index] = static_cast<float>(DrawCallCounter::shadow_vertices_submitted);
+   _tilemap_bytes_uploaded[_write_index] = static_cast<float>(DrawCallCounter::tilemap_bytes_uploaded);
    DrawCallCounter::tilemap_target_switches = 0;
    DrawCallCounter::tilemap_last_target = nullptr;
    DrawCallCounter::layer_scan_steps = 0;
@@ -638,6 +733,8 @@ void ProfilingUi::recordFrame(sf::Time frame_time, sf::Time update_time, sf::Tim
    DrawCallCounter::ambient_occlusion_pixels_submitted = 0;
    DrawCallCounter::tilemap_normal_pixels_submitted = 0;
    DrawCallCounter::image_layer_pixels_submitted = 0;
+   DrawCallCounter::shadow_vertices_submitted = 0;
+   DrawCallCounter::tilemap_bytes_uploaded = 0;
    _write_index = (_write_index + 1) % sample_count;
    _samples_written = std::min(_samples_written + 1, sample_count);
 }
@@ -50,11 +50,14 @@ private:
    std::array<float, sample_count> _tilemap_draw_calls{};                  //!< tile map draw calls issued in that frame
    std::array<float, sample_count> _tilemap_target_switches{};             //!< render target changes between those draws
    std::array<float, sample_count> _ambient_occlusion_draw_calls{};        //!< ao draw calls issued in that frame
+   std::array<float, sample_count> _particle_draw_calls{};                 //!< particle system draw calls issued in that frame
    std::array<float, sample_count> _layer_scan_steps{};                    //!< candidates the z loop examined that frame
    std::array<float, sample_count> _tilemap_pixels_submitted{};            //!< tile pixels submitted that frame, for the overdraw factor
    std::array<float, sample_count> _ambient_occlusion_pixels_submitted{};  //!< ao pixels submitted that frame
    std::array<float, sample_count> _tilemap_normal_pixels_submitted{};     //!< the normal pass share of the tile pixels
    std::array<float, sample_count> _image_layer_pixels_submitted{};        //!< image layer pixels submitted that frame
+   std::array<float, sample_count> _shadow_vertices_submitted{};           //!< shadow vertices the light system submitted that frame
+   std::array<float, sample_count> _tilemap_bytes_uploaded{};              //!< tile vertex bytes sent to the gpu that frame
    sf::Clock _wall_clock;
    bool _wall_clock_primed{false};
    int32_t _write_index{0};
@@ -27,10 +27,68 @@
 #include "game/debug/debugdraw.h"
 #endif
 
+#ifdef DEVELOPMENT_MODE
+#include "game/debug/drawcallcounter.h"
+#endif
+
 namespace
 {
 constexpr auto max_distance_m2 = 400.0f;  // depends on the view dimensions
 
+/// \brief forwards every fixture the broadphase reports to a function taking its body.
+class ShadowCasterQuery : public b2QueryCallback
+{
+public:
+   explicit ShadowCasterQuery(std::function<void(b2Body*)> report) : _report(std::move(report))
+   {
+   }
+
+   bool ReportFixture(b2Fixture* fixture) override
+   {
+      _report(fixture->GetBody());
+      return true;
+   }
+
+private:
+   std::function<void(b2Body*)> _report;
+};
+
+/// \brief checks whether a body is meant to throw shadows at all; enemies and bodies flagged as not casting don't.
+bool castsShadow(const b2Body* body)
+{
+   for (const auto* fixture = body->GetFixtureList(); fixture; fixture = fixture->GetNext())
+   {
+      if (fixture->GetFilterData().categoryBits & CategoryNoCastShadow)
+      {
+         return false;
+      }
+
+      auto* user_data = fixture->GetUserData().pointer;
+      if (user_data && static_cast<FixtureNode*>(user_data)->getType() == ObjectType::ObjectTypeEnemy)
+      {
+         return false;
+      }
+   }
+
+   return true;
+}
+
+/// \brief converts a rectangle in pixels to a box2d aabb in meters.
+b2AABB toAabb(const sf::FloatRect& rect_px)
+{
+   b2AABB aabb;
+   aabb.lowerBound = b2Vec2{rect_px.position.x / PPM, rect_px.position.y / PPM};
+   aabb.upperBound = b2Vec2{(rect_px.position.x + rect_px.size.x) / PPM, (rect_px.position.y + rect_px.size.y) / PPM};
+   return aabb;
+}
+
+/// \brief checks whether the bounding box of an edge overlaps an aabb.
+bool overlaps(const b2AABB& aabb, const b2Vec2& a, const b2Vec2& b)
+{
+   return std::max(a.x, b.x) >= aabb.lowerBound.x && std::min(a.x, b.x) <= aabb.upperBound.x && std::max(a.y, b.y) >= aabb.lowerBound.y &&
+          std::min(a.y, b.y) <= aabb.upperBound.y;
+}
+
 // SFML3 overrides raw glStencilFunc/Op calls with glDisable(GL_STENCIL_TEST) on every draw.
 // All stencil work must go through sf::RenderStates::stencilMode so SFML manages it correctly.
 
@@ -94,179 +152,268 @@ LightSystem::LightSystem()
    }
 }
 
-void LightSystem::drawShadowQuads(
-   sf::RenderTarget& target,
-   std::shared_ptr<LightSystem::LightInstance> light,
-   const std::vector<b2Body*>& candidates
-#ifdef DECEPTUS_VRSFML
-   ,
-   const sf::RenderStates& states
-#endif
+void LightSystem::appendShadowQuads(
+   b2Body* body,
+   const b2Vec2& light_pos_m,
+   const b2AABB& bounds_m,
+   std::vector<sf::Vertex>& vertices
 ) const
 {
-   const auto light_pos_m = light->_shadow_origin_m.value_or(light->_pos_m + light->_center_offset_m);
-
-#ifdef DECEPTUS_VRSFML
-   sf::RenderStates shadow_states = states;
-   shadow_states.stencilMode = stencil_write_mode;
-#else
-   const sf::RenderStates shadow_states{stencil_write_mode};
-#endif
-
-   // every quad used to be a draw call of its own, and the level's solid geometry is one chain
-   // shape, so a light standing next to a wall issued one call per edge in range - times six
-   // lights, every frame. the quads all carry the same state, so they batch into a single call
-   _shadow_vertices.clear();
-
-   for (auto* body : candidates)
+   for (auto* fixture = body->GetFixtureList(); fixture; fixture = fixture->GetNext())
    {
-      // skip bodies that belong to the light's own mechanism
-      // (e.g. rope chain elements) - they produce degenerate
-      // or unwanted shadow quads relative to the light source.
-      if (light->_excluded_bodies.count(body))
+      // if something doesn't collide, it probably shouldn't have any impact on lighting, too.
+      // however, the rest of the body should of course cast a shadow.
+      if (fixture->IsSensor())
       {
          continue;
       }
-      for (auto* fixture = body->GetFixtureList(); fixture; fixture = fixture->GetNext())
+
+      auto* shape = fixture->GetShape();
+
+      auto* shape_polygon = dynamic_cast<b2PolygonShape*>(shape);
+      auto* shape_chain = dynamic_cast<b2ChainShape*>(shape);
+      auto* shape_circle = dynamic_cast<b2CircleShape*>(shape);
+
+      if (shape_circle)
       {
-         // if something doesn't collide, it probably shouldn't have any impact on lighting, too.
-         // however, the rest of the body should of course cast a shadow.
-         if (fixture->IsSensor())
+         // do not draw lights that are too far away
+         const auto center = shape_circle->m_p + body->GetTransform().p;
+         if ((light_pos_m - center).LengthSquared() > max_distance_m2)
          {
             continue;
          }
 
-         auto* shape = fixture->GetShape();
-
-         auto* shape_polygon = dynamic_cast<b2PolygonShape*>(shape);
-         auto* shape_chain = dynamic_cast<b2ChainShape*>(shape);
-         auto* shape_circle = dynamic_cast<b2CircleShape*>(shape);
+         std::array<b2Vec2, segment_count> circle_positions;
+         for (auto i = 0u; i < segment_count; i++)
+         {
+            circle_positions[i] = b2Vec2{
+               center.x + _unit_circle[i].x * shape_circle->m_radius * 1.2f, center.y + _unit_circle[i].y * shape_circle->m_radius * 1.2f
+            };
+         }
 
-         if (shape_circle)
+         for (auto pos_current = 0u; pos_current < circle_positions.size(); pos_current++)
          {
-            // do not draw lights that are too far away
-            const auto center = shape_circle->m_p + body->GetTransform().p;
-            if ((light_pos_m - center).LengthSquared() > max_distance_m2)
+            auto pos_next = pos_current + 1;
+            if (pos_next == circle_positions.size())
             {
-               continue;
+               pos_next = 0;
             }
 
-            std::array<b2Vec2, segment_count> circle_positions;
-            for (auto i = 0u; i < segment_count; i++)
+            // v0      v0_far
+            //  x------x
+            //  |    / |
+            //  |   /  |
+            //  |  /   |
+            //  x------x
+            // v1      v1_far
+
+            const auto& v0 = circle_positions[pos_current];
+            const auto& v1 = circle_positions[pos_next];
+            const auto v0far = 10000.0f * (v0 - light_pos_m);
+            const auto v1far = 10000.0f * (v1 - light_pos_m);
+
+            std::array<sf::Vertex, 6> quad = {
+               sf::Vertex(sf::Vector2f(v0.x, v0.y) * PPM, sf::Color::Black),
+               sf::Vertex(sf::Vector2f(v0far.x, v0far.y) * PPM, sf::Color::Black),
+               sf::Vertex(sf::Vector2f(v1far.x, v1far.y) * PPM, sf::Color::Black),
+
+               sf::Vertex(sf::Vector2f(v0.x, v0.y) * PPM, sf::Color::Black),
+               sf::Vertex(sf::Vector2f(v1far.x, v1far.y) * PPM, sf::Color::Black),
+               sf::Vertex(sf::Vector2f(v1.x, v1.y) * PPM, sf::Color::Black)
+            };
+
+            vertices.insert(vertices.end(), quad.begin(), quad.end());
+         }
+      }
+      else if (shape_chain)
+      {
+         // for now it is assumed that chainshapes are static objects only.
+         // therefore no transform is applied to chainshape based objects.
+         //
+         // iterate m_count - 1 edges: for CreateLoop chains m_vertices[m_count-1] == m_vertices[0]
+         // so the closing edge is naturally covered; for open CreateChain shapes wrapping to 0
+         // would create a phantom closing edge that does not exist.
+         for (auto pos_current = 0; pos_current < shape_chain->m_count - 1; pos_current++)
+         {
+            auto pos_next = pos_current + 1;
+
+            const auto& vertex_0 = shape_chain->m_vertices[pos_current];
+            const auto& vertex_1 = shape_chain->m_vertices[pos_next];
+
+            if ((light_pos_m - vertex_0).LengthSquared() > max_distance_m2 && (light_pos_m - vertex_1).LengthSquared() > max_distance_m2)
             {
-               circle_positions[i] = b2Vec2{
-                  center.x + _unit_circle[i].x * shape_circle->m_radius * 1.2f, center.y + _unit_circle[i].y * shape_circle->m_radius * 1.2f
-               };
+               continue;
             }
 
-            for (auto pos_current = 0u; pos_current < circle_positions.size(); pos_current++)
+            // the level outlines are a handful of chains running through the whole level, so the broadphase
+            // hands them to every light; only the edges that reach into the light sprite can shadow it
+            if (!overlaps(bounds_m, vertex_0, vertex_1))
             {
-               auto pos_next = pos_current + 1;
-               if (pos_next == circle_positions.size())
-               {
-                  pos_next = 0;
-               }
-
-               // v0      v0_far
-               //  x------x
-               //  |    / |
-               //  |   /  |
-               //  |  /   |
-               //  x------x
-               // v1      v1_far
-
-               const auto& v0 = circle_positions[pos_current];
-               const auto& v1 = circle_positions[pos_next];
-               const auto v0far = 10000.0f * (v0 - light_pos_m);
-               const auto v1far = 10000.0f * (v1 - light_pos_m);
-
-               std::array<sf::Vertex, 6> quad = {
-                  sf::Vertex(sf::Vector2f(v0.x, v0.y) * PPM, sf::Color::Black),
-                  sf::Vertex(sf::Vector2f(v0far.x, v0far.y) * PPM, sf::Color::Black),
-                  sf::Vertex(sf::Vector2f(v1far.x, v1far.y) * PPM, sf::Color::Black),
-
-                  sf::Vertex(sf::Vector2f(v0.x, v0.y) * PPM, sf::Color::Black),
-                  sf::Vertex(sf::Vector2f(v1far.x, v1far.y) * PPM, sf::Color::Black),
-                  sf::Vertex(sf::Vector2f(v1.x, v1.y) * PPM, sf::Color::Black)
-               };
-
-               _shadow_vertices.insert(_shadow_vertices.end(), quad.begin(), quad.end());
+               continue;
             }
+
+            const auto v0_far = 10000.0f * (vertex_0 - light_pos_m);
+            const auto v1_far = 10000.0f * (vertex_1 - light_pos_m);
+
+            std::array<sf::Vertex, 6> quad = {
+               sf::Vertex(sf::Vector2f(vertex_0.x, vertex_0.y) * PPM, sf::Color::Black),
+               sf::Vertex(sf::Vector2f(v0_far.x, v0_far.y) * PPM, sf::Color::Black),
+               sf::Vertex(sf::Vector2f(v1_far.x, v1_far.y) * PPM, sf::Color::Black),
+
+               sf::Vertex(sf::Vector2f(vertex_0.x, vertex_0.y) * PPM, sf::Color::Black),
+               sf::Vertex(sf::Vector2f(v1_far.x, v1_far.y) * PPM, sf::Color::Black),
+               sf::Vertex(sf::Vector2f(vertex_1.x, vertex_1.y) * PPM, sf::Color::Black)
+            };
+
+            vertices.insert(vertices.end(), quad.begin(), quad.end());
          }
-         else if (shape_chain)
+      }
+      else if (shape_polygon)
+      {
+         // use m_count (vertex count), NOT GetChildCount() which always returns 1 for polygons.
+         for (auto pos_current = 0; pos_current < shape_polygon->m_count; pos_current++)
          {
-            // for now it is assumed that chainshapes are static objects only.
-            // therefore no transform is applied to chainshape based objects.
-            //
-            // iterate m_count - 1 edges: for CreateLoop chains m_vertices[m_count-1] == m_vertices[0]
-            // so the closing edge is naturally covered; for open CreateChain shapes wrapping to 0
-            // would create a phantom closing edge that does not exist.
-            for (auto pos_current = 0; pos_current < shape_chain->m_count - 1; pos_current++)
+            auto pos_next = pos_current + 1;
+            if (pos_next == shape_polygon->m_count)
             {
-               auto pos_next = pos_current + 1;
+               pos_next = 0;
+            }
 
-               const auto& vertex_0 = shape_chain->m_vertices[pos_current];
-               const auto& vertex_1 = shape_chain->m_vertices[pos_next];
+            const auto v0 = shape_polygon->m_vertices[pos_current] + body->GetTransform().p;
 
-               if ((light_pos_m - vertex_0).LengthSquared() > max_distance_m2 && (light_pos_m - vertex_1).LengthSquared() > max_distance_m2)
-               {
-                  continue;
-               }
+            if ((light_pos_m - v0).LengthSquared() > max_distance_m2)
+            {
+               continue;
+            }
 
-               const auto v0_far = 10000.0f * (vertex_0 - light_pos_m);
-               const auto v1_far = 10000.0f * (vertex_1 - light_pos_m);
+            const auto v1 = shape_polygon->m_vertices[pos_next] + body->GetTransform().p;
+            const auto v0far = 10000.0f * (v0 - light_pos_m);
+            const auto v1far = 10000.0f * (v1 - light_pos_m);
 
-               std::array<sf::Vertex, 6> quad = {
-                  sf::Vertex(sf::Vector2f(vertex_0.x, vertex_0.y) * PPM, sf::Color::Black),
-                  sf::Vertex(sf::Vector2f(v0_far.x, v0_far.y) * PPM, sf::Color::Black),
-                  sf::Vertex(sf::Vector2f(v1_far.x, v1_far.y) * PPM, sf::Color::Black),
+            std::array<sf::Vertex, 6> quad = {
+               sf::Vertex(sf::Vector2f(v0.x, v0.y) * PPM, sf::Color::Black),
+               sf::Vertex(sf::Vector2f(v0far.x, v0far.y) * PPM, sf::Color::Black),
+               sf::Vertex(sf::Vector2f(v1far.x, v1far.y) * PPM, sf::Color::Black),
 
-                  sf::Vertex(sf::Vector2f(vertex_0.x, vertex_0.y) * PPM, sf::Color::Black),
-                  sf::Vertex(sf::Vector2f(v1_far.x, v1_far.y) * PPM, sf::Color::Black),
-                  sf::Vertex(sf::Vector2f(vertex_1.x, vertex_1.y) * PPM, sf::Color::Black)
-               };
+               sf::Vertex(sf::Vector2f(v0.x, v0.y) * PPM, sf::Color::Black),
+               sf::Vertex(sf::Vector2f(v1far.x, v1far.y) * PPM, sf::Color::Black),
+               sf::Vertex(sf::Vector2f(v1.x, v1.y) * PPM, sf::Color::Black)
+            };
 
-               _shadow_vertices.insert(_shadow_vertices.end(), quad.begin(), quad.end());
-            }
+            vertices.insert(vertices.end(), quad.begin(), quad.end());
          }
-         else if (shape_polygon)
+      }
+   }
+}
+
+void LightSystem::gatherShadowCasters(const LightInstance& light, const sf::FloatRect& bounds_px) const
+{
+   _static_casters.clear();
+   _dynamic_casters.clear();
+   _visited_casters.clear();
+
+   auto* player_body = PlayerRegistry::getFirst()->getBody();
+
+   // rays from the light leave its sprite once and never come back, so nothing outside the sprite can
+   // throw a shadow into it. asking the broadphase for that rectangle keeps the candidates bound to what
+   // is around the light instead of growing with everything in the level
+   ShadowCasterQuery query(
+      [&](b2Body* body)
+      {
+         if (body == player_body || !body->IsEnabled() || light._excluded_bodies.contains(body))
          {
-            // use m_count (vertex count), NOT GetChildCount() which always returns 1 for polygons.
-            for (auto pos_current = 0; pos_current < shape_polygon->m_count; pos_current++)
-            {
-               auto pos_next = pos_current + 1;
-               if (pos_next == shape_polygon->m_count)
-               {
-                  pos_next = 0;
-               }
-
-               const auto v0 = shape_polygon->m_vertices[pos_current] + body->GetTransform().p;
-
-               if ((light_pos_m - v0).LengthSquared() > max_distance_m2)
-               {
-                  continue;
-               }
-
-               const auto v1 = shape_polygon->m_vertices[pos_next] + body->GetTransform().p;
-               const auto v0far = 10000.0f * (v0 - light_pos_m);
-               const auto v1far = 10000.0f * (v1 - light_pos_m);
-
-               std::array<sf::Vertex, 6> quad = {
-                  sf::Vertex(sf::Vector2f(v0.x, v0.y) * PPM, sf::Color::Black),
-                  sf::Vertex(sf::Vector2f(v0far.x, v0far.y) * PPM, sf::Color::Black),
-                  sf::Vertex(sf::Vector2f(v1far.x, v1far.y) * PPM, sf::Color::Black),
-
-                  sf::Vertex(sf::Vector2f(v0.x, v0.y) * PPM, sf::Color::Black),
-                  sf::Vertex(sf::Vector2f(v1far.x, v1far.y) * PPM, sf::Color::Black),
-                  sf::Vertex(sf::Vector2f(v1.x, v1.y) * PPM, sf::Color::Black)
-               };
-
-               _shadow_vertices.insert(_shadow_vertices.end(), quad.begin(), quad.end());
-            }
+            return;
+         }
+
+         // chains and bodies with many fixtures are reported once per proxy
+         if (!_visited_casters.insert(body).second)
+         {
+            return;
+         }
+
+         if (!castsShadow(body))
+         {
+            return;
+         }
+
+         if (body->GetType() == b2_staticBody)
+         {
+            _static_casters.push_back(body);
+         }
+         else
+         {
+            _dynamic_casters.push_back(body);
          }
       }
+   );
+
+   LevelRegistry::getCurrent()->getWorld()->QueryAABB(&query, toAabb(bounds_px));
+
+   // the broadphase does not promise any order, the static cache compares the list as a whole
+   std::ranges::sort(_static_casters);
+}
+
+void LightSystem::drawShadowQuads(
+   sf::RenderTarget& target,
+   std::shared_ptr<LightSystem::LightInstance> light,
+   const sf::FloatRect& bounds_px
+#ifdef DECEPTUS_VRSFML
+   ,
+   const sf::RenderStates& states
+#endif
+) const
+{
+   const auto light_pos_m = light->_shadow_origin_m.value_or(light->_pos_m + light->_center_offset_m);
+   const auto bounds_m = toAabb(bounds_px);
+
+#ifdef DECEPTUS_VRSFML
+   sf::RenderStates shadow_states = states;
+   shadow_states.stencilMode = stencil_write_mode;
+#else
+   const sf::RenderStates shadow_states{stencil_write_mode};
+#endif
+
+   gatherShadowCasters(*light, bounds_px);
+
+   // static geometry only needs new quads when the light moves or the static bodies around it change,
+   // e.g. when a door is removed; for most lights that is never after the first frame
+   auto& cache = light->_static_shadow_cache;
+   const auto cache_valid = cache._valid && cache._origin_m == light_pos_m && cache._bounds_px == bounds_px &&
+                            std::ranges::equal(
+                               cache._bodies,
+                               _static_casters,
+                               [](const auto& cached, const auto* body) { return cached.first == body && cached.second == body->GetPosition(); }
+                            );
+
+   if (!cache_valid)
+   {
+      cache._vertices.clear();
+      cache._bodies.clear();
+      for (auto* body : _static_casters)
+      {
+         appendShadowQuads(body, light_pos_m, bounds_m, cache._vertices);
+         cache._bodies.emplace_back(body, body->GetPosition());
+      }
+
+      cache._origin_m = light_pos_m;
+      cache._bounds_px = bounds_px;
+      cache._valid = true;
+   }
+
+   // every quad used to be a draw call of its own, and the level's solid geometry is one chain
+   // shape, so a light standing next to a wall issued one call per edge in range - times six
+   // lights, every frame. the quads all carry the same state, so they batch into a single call
+   _shadow_vertices.assign(cache._vertices.begin(), cache._vertices.end());
+
+   for (auto* body : _dynamic_casters)
+   {
+      appendShadowQuads(body, light_pos_m, bounds_m, _shadow_vertices);
    }
 
+#ifdef DEVELOPMENT_MODE
+   DrawCallCounter::shadow_vertices_submitted += static_cast<int64_t>(_shadow_vertices.size());
+#endif
+
    if (_shadow_vertices.empty())
    {
       return;
@@ -520,39 +667,6 @@ std::optional<sf::View> LightSystem::clipViewToActiveLights(const sf::View& full
 
 void LightSystem::draw(sf::RenderTarget& target1, sf::RenderTarget& target2, sf::RenderStates states)
 {
-   auto* player_body = PlayerRegistry::getFirst()->getBody();
-
-   // pre-build shadow caster candidates once per frame — player, disabled bodies, and
-   // enemies are excluded here so drawShadowQuads only needs to check per-light exclusions.
-   std::vector<b2Body*> shadow_candidates;
-   const auto& world = LevelRegistry::getCurrent()->getWorld();
-   for (auto* body = world->GetBodyList(); body; body = body->GetNext())
-   {
-      if (body == player_body || !body->IsEnabled())
-      {
-         continue;
-      }
-      bool skip = false;
-      for (auto* fixture = body->GetFixtureList(); fixture; fixture = fixture->GetNext())
-      {
-         if (fixture->GetFilterData().categoryBits & CategoryNoCastShadow)
-         {
-            skip = true;
-            break;
-         }
-         auto* user_data = fixture->GetUserData().pointer;
-         if (user_data && static_cast<FixtureNode*>(user_data)->getType() == ObjectType::ObjectTypeEnemy)
-         {
-            skip = true;
-            break;
-         }
-      }
-      if (!skip)
-      {
-         shadow_candidates.push_back(body);
-      }
-   }
-
    // draw sprites to channels (lights 0-2 to target1 RGB, lights 3-5 to target2 RGB)
    // we skip alpha channels because they're harder to work with
    int32_t channel_index = 0;
@@ -588,7 +702,8 @@ void LightSystem::draw(sf::RenderTarget& target1, sf::RenderTarget& target2, sf:
 #else
       const auto& full_view = target.getView();
 #endif
-      const auto clipped_view = clipViewToLight(full_view, light->_sprite->getGlobalBounds());
+      const auto light_bounds_px = light->_sprite->getGlobalBounds();
+      const auto clipped_view = clipViewToLight(full_view, light_bounds_px);
       if (!clipped_view.has_value())
       {
          channel_index++;
@@ -607,10 +722,10 @@ void LightSystem::draw(sf::RenderTarget& target1, sf::RenderTarget& target2, sf:
 #ifdef DECEPTUS_VRSFML
       auto shadow_states = states;
       shadow_states.view = clipped_view.value();
-      drawShadowQuads(target, light, shadow_candidates, shadow_states);
+      drawShadowQuads(target, light, light_bounds_px, shadow_states);
 #else
       target.setView(clipped_view.value());
-      drawShadowQuads(target, light, shadow_candidates);
+      drawShadowQuads(target, light, light_bounds_px);
       target.setView(restore_view);
 #endif
 
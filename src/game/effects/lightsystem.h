@@ -54,6 +54,18 @@ public:
       ///        elements whose positions would produce degenerate or unwanted shadow quads).
       std::unordered_set<b2Body*> _excluded_bodies;
 
+      /// \brief shadow quads of the static bodies around the light, reused until the light or those bodies change.
+      struct StaticShadowCache
+      {
+         bool _valid = false;
+         b2Vec2 _origin_m{0.0f, 0.0f};                       //!< shadow origin the quads were built for
+         sf::FloatRect _bounds_px;                           //!< light sprite bounds the casters were gathered in
+         std::vector<std::pair<b2Body*, b2Vec2>> _bodies;  //!< casters and their positions, sorted by address
+         std::vector<sf::Vertex> _vertices;
+      };
+
+      StaticShadowCache _static_shadow_cache;
+
       using ShaderUpdateCallback = std::function<void(sfcompat::Shader& shader, const LightInstance& light, float elapsed_seconds)>;
       std::shared_ptr<sfcompat::Shader> _shader;     //!< optional per-light shader applied when drawing the light sprite
       ShaderUpdateCallback _shader_update_callback;  //!< called before drawing to let the owner set shader-specific uniforms
@@ -153,15 +165,27 @@ public:
    void setOccluderCallback(OccluderDrawCallback callback);
 
 private:
+   /// \brief collects the bodies that can throw a shadow into a light's sprite, split into static and moving ones.
+   /// \param light light to collect the shadow casters for.
+   /// \param bounds_px light sprite bounds in pixels.
+   void gatherShadowCasters(const LightInstance& light, const sf::FloatRect& bounds_px) const;
+
+   /// \brief appends the shadow extrusion triangles of one body.
+   /// \param body shadow casting body.
+   /// \param light_pos_m shadow origin in meters.
+   /// \param bounds_m light sprite bounds in meters; chain edges outside are skipped.
+   /// \param vertices vertex list the triangles are appended to.
+   void appendShadowQuads(b2Body* body, const b2Vec2& light_pos_m, const b2AABB& bounds_m, std::vector<sf::Vertex>& vertices) const;
+
    /// \brief renders shadow extrusion triangles for geometry that should occlude a given light.
    /// \param target render target.
    /// \param light active light for which occluder shadows are generated.
-   /// \param candidates pre-filtered list of shadow-casting bodies built once per frame.
+   /// \param bounds_px light sprite bounds in pixels, only bodies within them are considered.
    /// \param states render states to apply (carries .view for WASM camera transform).
    void drawShadowQuads(
       sf::RenderTarget& target,
       std::shared_ptr<LightInstance> light,
-      const std::vector<b2Body*>& candidates
+      const sf::FloatRect& bounds_px
 #ifdef DECEPTUS_VRSFML
       ,
       const sf::RenderStates& states
@@ -196,6 +220,11 @@ private:
    //!< kept as a member rather than a local so the frames after the first reuse its capacity
    mutable std::vector<sf::Vertex> _shadow_vertices;
 
+   //!< shadow casters of the light being drawn, kept as members for the same reason
+   mutable std::vector<b2Body*> _static_casters;
+   mutable std::vector<b2Body*> _dynamic_casters;
+   mutable std::unordered_set<b2Body*> _visited_casters;
+
    OccluderDrawCallback _occluder_callback;
    sf::Clock _clock;  //!< tracks elapsed time for per-light shader uniforms
 };
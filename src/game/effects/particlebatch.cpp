@@ -0,0 +1,68 @@
+#include "particlebatch.h"
+
+#include "game/debug/drawcallcounter.h"
+
+#include <span>
+
+void ParticleBatch::clear()
+{
+   _vertices.clear();
+}
+
+void ParticleBatch::reserve(std::size_t quad_count)
+{
+   _vertices.reserve(quad_count * 6);
+}
+
+void ParticleBatch::addQuad(const sf::FloatRect& rect_px, const sf::FloatRect& texture_rect_px, const sf::Color& color)
+{
+   const auto left_px = rect_px.position.x;
+   const auto top_px = rect_px.position.y;
+   const auto right_px = rect_px.position.x + rect_px.size.x;
+   const auto bottom_px = rect_px.position.y + rect_px.size.y;
+
+   const auto u0 = texture_rect_px.position.x;
+   const auto v0 = texture_rect_px.position.y;
+   const auto u1 = texture_rect_px.position.x + texture_rect_px.size.x;
+   const auto v1 = texture_rect_px.position.y + texture_rect_px.size.y;
+
+   // triangle 1: top-left, top-right, bottom-right
+   _vertices.push_back({{left_px, top_px}, color, {u0, v0}});
+   _vertices.push_back({{right_px, top_px}, color, {u1, v0}});
+   _vertices.push_back({{right_px, bottom_px}, color, {u1, v1}});
+
+   // triangle 2: top-left, bottom-right, bottom-left
+   _vertices.push_back({{left_px, top_px}, color, {u0, v0}});
+   _vertices.push_back({{right_px, bottom_px}, color, {u1, v1}});
+   _vertices.push_back({{left_px, bottom_px}, color, {u0, v1}});
+}
+
+void ParticleBatch::addQuad(const sf::FloatRect& rect_px, const sf::Color& color)
+{
+   addQuad(rect_px, {}, color);
+}
+
+void ParticleBatch::draw(sf::RenderTarget& target, sf::RenderStates states, const sf::Texture* texture) const
+{
+   if (_vertices.empty())
+   {
+      return;
+   }
+
+   states.texture = texture;
+
+#ifdef DECEPTUS_VRSFML
+   target.draw(std::span<const sf::Vertex>(_vertices.data(), _vertices.size()), sf::PrimitiveType::Triangles, states);
+#else
+   target.draw(_vertices.data(), _vertices.size(), sf::PrimitiveType::Triangles, states);
+#endif
+
+#ifdef DEVELOPMENT_MODE
+   DrawCallCounter::particle_draw_calls++;
+#endif
+}
+
+std::size_t ParticleBatch::getQuadCount() const
+{
+   return _vertices.size() / 6;
+}
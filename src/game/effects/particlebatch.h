@@ -0,0 +1,49 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <cstdint>
+#include <vector>
+
+/// \brief collects the quads of one particle system into a single vertex stream.
+///
+/// Particle effects used to draw one sprite per particle, so a busy screen spent hundreds of draw calls
+/// on rain alone. A system now keeps its particles in plain arrays, writes one quad per live particle
+/// into a batch while drawing, and submits the whole batch with one call. Everything in a batch shares
+/// one texture, i.e. a system's frames have to sit in one atlas.
+///
+/// Quads go out as two triangles each rather than through an index buffer; SFML has no indexed draw,
+/// and at a few hundred quads the extra two vertices per quad are not worth a custom path.
+class ParticleBatch
+{
+public:
+   /// \brief drops all quads, keeping the allocation for the next frame.
+   void clear();
+
+   /// \brief reserves room for a number of quads.
+   /// \param quad_count number of quads the batch is expected to hold.
+   void reserve(std::size_t quad_count);
+
+   /// \brief appends a textured quad.
+   /// \param rect_px quad rectangle in world pixels.
+   /// \param texture_rect_px source rectangle in texture pixels.
+   /// \param color vertex color, multiplied with the texture.
+   void addQuad(const sf::FloatRect& rect_px, const sf::FloatRect& texture_rect_px, const sf::Color& color = sf::Color::White);
+
+   /// \brief appends an untextured quad.
+   /// \param rect_px quad rectangle in world pixels.
+   /// \param color fill color.
+   void addQuad(const sf::FloatRect& rect_px, const sf::Color& color);
+
+   /// \brief submits all quads with one draw call.
+   /// \param target render target.
+   /// \param states render states to apply; carries the level view under vrsfml.
+   /// \param texture texture the quads sample from, nullptr for untextured quads.
+   void draw(sf::RenderTarget& target, sf::RenderStates states, const sf::Texture* texture = nullptr) const;
+
+   /// \brief returns the number of quads in the batch.
+   std::size_t getQuadCount() const;
+
+private:
+   std::vector<sf::Vertex> _vertices;
+};
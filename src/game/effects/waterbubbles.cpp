@@ -5,6 +5,7 @@
 #include "game/level/atmosphere.h"
 #include "game/level/levelregistry.h"
 
+#include <array>
 #include <iostream>
 
 namespace
@@ -17,6 +18,14 @@ constexpr auto bubble_count_spawn_max = 10;
 constexpr auto bubble_count_dive_max = 10;
 constexpr auto bubble_count_dive_frames = 40;
 
+// bubble frames in the player atlas
+const auto frame_rects = std::array<sf::FloatRect, 3>{
+   // sf::FloatRect{{576.0f, 936.0f}, {24.0f, 24.0f}},
+   sf::FloatRect{{600.0f, 936.0f}, {24.0f, 24.0f}},
+   sf::FloatRect{{624.0f, 936.0f}, {24.0f, 24.0f}},
+   sf::FloatRect{{648.0f, 936.0f}, {24.0f, 24.0f}},
+};
+
 float frand(float min = 0.0f, float max = 1.0f)
 {
    const auto val = static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX);
@@ -30,18 +39,23 @@ WaterBubbles::WaterBubbles() : _texture(TexturePool::getInstance().get("data/spr
    Audio::getInstance().addSample("underwater_bubbles.ogg");
 }
 
-void WaterBubbles::draw(sf::RenderTarget& target, sf::RenderTarget& /*normal*/)
+void WaterBubbles::draw(sf::RenderTarget& target, sf::RenderTarget& /*normal*/, const sf::RenderStates& states)
 {
-   for (const auto& bubble : _bubbles)
+   _batch.clear();
+
+   for (auto bubble_index = 0u; bubble_index < _bubbles._positions.size(); bubble_index++)
    {
       // sleeping bubbles aren't drawn just yet
-      if (bubble->_alive_s < bubble->_delay_s)
+      if (_bubbles._alive_s[bubble_index] < _bubbles._delays_s[bubble_index])
       {
          continue;
       }
 
-      target.draw(*bubble->_sprite);
+      const auto& position_px = _bubbles._positions[bubble_index];
+      _batch.addQuad({{position_px.x - 12.0f, position_px.y - 12.0f}, {24.0f, 24.0f}}, frame_rects[_bubbles._frames[bubble_index]]);
    }
+
+   _batch.draw(target, states, _texture.get());
 }
 
 //
@@ -55,34 +69,11 @@ void WaterBubbles::draw(sf::RenderTarget& target, sf::RenderTarget& /*normal*/)
 
 void WaterBubbles::spawnBubble(const sf::Vector2f pos_px, const sf::Vector2f vel_px)
 {
-#ifdef DECEPTUS_VRSFML
-   static const auto sprite_rects = std::array<sf::FloatRect, 3>{
-      // sf::FloatRect{{576, 936}, {24, 24}},
-      sf::FloatRect{{600.0f, 936.0f}, {24.0f, 24.0f}},
-      sf::FloatRect{{624.0f, 936.0f}, {24.0f, 24.0f}},
-      sf::FloatRect{{648.0f, 936.0f}, {24.0f, 24.0f}},
-   };
-#else
-   static const auto sprite_rects = std::array<sf::IntRect, 3>{
-      // sf::IntRect{576, 936, 24, 24},
-      sf::IntRect{{600, 936}, {24, 24}},
-      sf::IntRect{{624, 936}, {24, 24}},
-      sf::IntRect{{648, 936}, {24, 24}},
-   };
-#endif
-
-   auto bubble = std::make_shared<Bubble>(pos_px, vel_px, _texture);
-
-#ifdef DECEPTUS_VRSFML
-   bubble->_sprite->textureRect = sprite_rects[std::rand() % sprite_rects.size()];
-   bubble->_sprite->origin = {12.0f, 12.0f};
-#else
-   bubble->_sprite->setTextureRect(sprite_rects[std::rand() % sprite_rects.size()]);
-   bubble->_sprite->setOrigin({12.0f, 12.0f});
-#endif
-   bubble->_delay_s = frand(0.0f, 0.3f);
-
-   _bubbles.push_back(bubble);
+   _bubbles._positions.push_back(pos_px);
+   _bubbles._velocities.push_back(vel_px);
+   _bubbles._delays_s.push_back(frand(0.0f, 0.3f));
+   _bubbles._alive_s.push_back(0.0f);
+   _bubbles._frames.push_back(static_cast<uint8_t>(std::rand() % frame_rects.size()));
 }
 
 void WaterBubbles::spawnSplashBubbles(const WaterBubbleInput& input)
@@ -154,40 +145,46 @@ void WaterBubbles::update(const sf::Time& dt, const WaterBubbleInput& input)
       spawnBubblesFromHead(input);
    }
 
-   for (const auto& bubble : _bubbles)
+   // popped bubbles are replaced by the last one right away, so the index only advances past bubbles that stay
+   auto bubble_index = 0u;
+   while (bubble_index < _bubbles._positions.size())
    {
-      bubble->_alive_s += dt.asSeconds();
-      if (bubble->_alive_s < bubble->_delay_s)
+      _bubbles._alive_s[bubble_index] += dt.asSeconds();
+      if (_bubbles._alive_s[bubble_index] < _bubbles._delays_s[bubble_index])
       {
+         bubble_index++;
          continue;
       }
 
-      bubble->_position += dt.asSeconds() * bubble->_velocity;
-#ifdef DECEPTUS_VRSFML
-      bubble->_sprite->position = bubble->_position;
-#else
-      bubble->_sprite->setPosition(bubble->_position);
-#endif
+      auto& position = _bubbles._positions[bubble_index];
+      position += dt.asSeconds() * _bubbles._velocities[bubble_index];
 
-      const auto atmosphere = LevelRegistry::getCurrent()->getAtmosphere().getTileForPosition(bubble->_position);
+      const auto atmosphere = LevelRegistry::getCurrent()->getAtmosphere().getTileForPosition(position);
       if (atmosphere != AtmosphereTileWaterFull)
       {
-         bubble->_pop = true;
+         _bubbles.remove(bubble_index);
+         continue;
       }
-   }
 
-   // remove popped bubbles
-   _bubbles.erase(std::remove_if(_bubbles.begin(), _bubbles.end(), [](const auto& bubble) { return bubble->_pop; }), _bubbles.end());
+      bubble_index++;
+   }
 
    _previous_input = input;
 }
 
-WaterBubbles::Bubble::Bubble(const sf::Vector2f& pos, const sf::Vector2f& vel, const std::shared_ptr<sf::Texture>& texture)
-    : _position(pos), _velocity(vel)
+void WaterBubbles::Bubbles::remove(std::size_t index)
 {
-#ifdef DECEPTUS_VRSFML
-   _sprite = std::make_unique<sf::Sprite>();
-#else
-   _sprite = std::make_unique<sf::Sprite>(*texture);
-#endif
+   const auto last = _positions.size() - 1;
+
+   _positions[index] = _positions[last];
+   _velocities[index] = _velocities[last];
+   _delays_s[index] = _delays_s[last];
+   _alive_s[index] = _alive_s[last];
+   _frames[index] = _frames[last];
+
+   _positions.pop_back();
+   _velocities.pop_back();
+   _delays_s.pop_back();
+   _alive_s.pop_back();
+   _frames.pop_back();
 }
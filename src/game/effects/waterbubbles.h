@@ -3,30 +3,31 @@
 
 #include "SFML/Graphics.hpp"
 
+#include "game/effects/particlebatch.h"
+
+#include <cstdint>
 #include <memory>
 #include <vector>
 
-/// \brief spawns and animates rising bubble sprites around the player while underwater.
+/// \brief spawns and animates rising bubbles around the player while underwater.
 class WaterBubbles
 {
 public:
-   /// \brief loads the shared player texture used for bubble sprite frames.
+   /// \brief loads the shared player texture used for bubble frames.
    WaterBubbles();
 
-   /// \brief runtime state for a single bubble sprite, including motion and delayed spawn.
-   struct Bubble
+   /// \brief motion and delayed spawn of all bubbles, one array per field and one entry per bubble.
+   struct Bubbles
    {
-      /// \brief creates a bubble at a position with a starting velocity.
-      /// \param pos initial bubble position in pixels.
-      /// \param vel initial bubble velocity in pixels per second.
-      /// \param texture shared texture that contains bubble frames.
-      Bubble(const sf::Vector2f& pos, const sf::Vector2f& vel, const std::shared_ptr<sf::Texture>& texture);
-      std::unique_ptr<sf::Sprite> _sprite;
-      sf::Vector2f _position;
-      sf::Vector2f _velocity;
-      bool _pop = false;
-      float _delay_s = 0.0f;
-      float _alive_s = 0.0f;
+      /// \brief removes a bubble by moving the last one into its slot.
+      /// \param index bubble index.
+      void remove(std::size_t index);
+
+      std::vector<sf::Vector2f> _positions;
+      std::vector<sf::Vector2f> _velocities;
+      std::vector<float> _delays_s;
+      std::vector<float> _alive_s;
+      std::vector<uint8_t> _frames;  //!< which of the bubble frames in the player atlas is shown
    };
 
    /// \brief per-frame player context used to decide when and where bubbles should spawn.
@@ -37,10 +38,11 @@ public:
       sf::FloatRect _player_rect;
    };
 
-   /// \brief draws bubbles whose startup delay already elapsed.
+   /// \brief draws bubbles whose startup delay already elapsed as one batch.
    /// \param target render target.
    /// \param normal normal-map render target, currently unused by this effect.
-   void draw(sf::RenderTarget& target, sf::RenderTarget& normal);
+   /// \param states render states to apply (carries .view for WASM camera transform).
+   void draw(sf::RenderTarget& target, sf::RenderTarget& normal, const sf::RenderStates& states = sf::RenderStates{});
 
    /// \brief advances bubble spawning, movement, and removal based on player water state.
    /// \param dt elapsed frame time since the previous update.
@@ -61,7 +63,8 @@ private:
    /// \param input current player water state and bounding rectangle.
    void spawnSplashBubbles(const WaterBubbleInput& input);
 
-   std::vector<std::shared_ptr<Bubble>> _bubbles;
+   Bubbles _bubbles;
+   ParticleBatch _batch;
    std::shared_ptr<sf::Texture> _texture;
    WaterBubbleInput _previous_input;
 
@@ -1129,6 +1129,7 @@ void Game::update()
 
    Timer::update(Timer::Scope::UpdateAlways);
    MusicPlayer::getInstance().update(dt);
+   Audio::getInstance().update();
    MessageBox::update(dt);
    PostProcessing::getInstance().update(dt);
 
@@ -279,8 +279,11 @@ void EventSerializer::update(sf::Time delta_time)
       return;
    }
 
-   const auto now = HighResClock::now();
-   const auto elapsed_duration = now - _playback_start_time;
+   _elapsed_time += delta_time;
+
+   // in simulated time the events follow the steps that were run rather than how long they took
+   const auto elapsed_duration = _simulated_time ? HighResDuration{std::chrono::microseconds(_elapsed_time.asMicroseconds())}
+                                                 : HighResClock::now() - _playback_start_time;
 
    while (_current_event_index < _events.size())
    {
@@ -305,6 +308,11 @@ void EventSerializer::update(sf::Time delta_time)
    }
 }
 
+void EventSerializer::setSimulatedTime(bool enabled)
+{
+   _simulated_time = enabled;
+}
+
 bool EventSerializer::isPlaying() const
 {
    return _playing;
@@ -83,9 +83,16 @@ public:
    void play();
 
    /// \brief dispatches due replay events through the configured callback.
-   /// \param dt elapsed frame time, currently unused because timing is wall-clock based.
+   /// \param dt elapsed frame time; only counted when replaying in simulated time, otherwise playback follows the wall clock.
    void update(sf::Time dt);
 
+   /// \brief makes playback follow the time passed to update rather than the wall clock.
+   ///
+   /// A simulation stepped faster than real time would otherwise see the events arrive early, and at a
+   /// different step each run.
+   /// \param enabled true to replay in simulated time.
+   void setSimulatedTime(bool enabled);
+
    /// \brief sets the callback invoked for each replayed event.
    /// \param callback consumer that handles replayed sf::Event values.
    void setCallback(const EventCallback& callback);
@@ -137,6 +144,9 @@ private:
    size_t _current_event_index = 0;
    bool _enabled = false;
 
+   /// \brief whether playback follows _elapsed_time rather than the wall clock.
+   bool _simulated_time = false;
+
    /// \brief stores the high-resolution timestamp when replay playback began.
    HighResTimePoint _playback_start_time;
 
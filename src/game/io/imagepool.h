@@ -0,0 +1,62 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include "framework/tools/resourcepool.h"
+
+/// \brief singleton cache of decoded images, so loading stages can decode off the thread that owns the gl context.
+///
+/// Nothing in here touches the gpu. A loading stage decodes its images through this pool on a worker thread and
+/// keeps them alive until the thread owning the gl context turns them into textures with TexturePool; images
+/// shared by several layers are decoded once.
+class ImagePool : public ResourcePool<sf::Image>
+{
+public:
+   /// \brief returns the global image pool instance.
+   /// \return shared singleton used for image caching during level loading.
+   static ImagePool& getInstance()
+   {
+      static ImagePool instance;
+      return instance;
+   }
+
+protected:
+   /// \brief decodes an image file into the provided resource instance.
+   /// \param image image object that receives file content.
+   /// \param path image file path.
+   /// \return true when the image file was decoded successfully.
+   bool loadResource(sf::Image& image, const std::filesystem::path& path) const override
+   {
+#ifdef DECEPTUS_VRSFML
+      (void)image;
+      (void)path;
+      return false;
+#else
+      return image.loadFromFile(path.string());
+#endif
+   }
+
+#ifdef DECEPTUS_VRSFML
+   /// \brief creates an image by loading directly from path, bypassing default construction.
+   ///        Required for VRSFML where sf::Image has no default constructor.
+   /// \param path image file path.
+   /// \return shared pointer to the decoded image, or nullptr on failure.
+   std::shared_ptr<sf::Image> createResource(const std::filesystem::path& path) const override
+   {
+      auto loaded_image = sf::Image::loadFromFile(path);
+      if (!loaded_image)
+      {
+         return nullptr;
+      }
+      return std::make_shared<sf::Image>(std::move(loaded_image.value()));
+   }
+#endif
+
+   /// \brief estimates image memory footprint in bytes for cache accounting.
+   /// \param image image whose dimensions are used for estimation.
+   /// \return byte size using rgba8 layout.
+   size_t computeResourceSize(const sf::Image& image) const override
+   {
+      const auto size = image.getSize();
+      return size.x * size.y * 4;  // rgba
+   }
+};
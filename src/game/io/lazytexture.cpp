@@ -1,8 +1,8 @@
 #include "lazytexture.h"
 
 #include <algorithm>
+#include <chrono>
 #include <ranges>
-#include <stop_token>
 #include "framework/tools/log.h"
 
 namespace
@@ -15,34 +15,61 @@ LazyTexture::LazyTexture(const std::filesystem::path& texture_path, std::vector<
 {
 }
 
-void LazyTexture::update(const Chunk& player_chunk)
+LazyTexture::~LazyTexture()
 {
-   const auto should_be_loaded = std::ranges::any_of(
-      _texture_chunks,
-      [&](const auto& chunk)
-      { return std::abs(player_chunk._x - chunk._x) < chunk_load_threshold && std::abs(player_chunk._y - chunk._y) < chunk_load_threshold; }
+   if (_request)
+   {
+      TextureStreamer::getInstance().cancel(_request);
+   }
+}
+
+int32_t LazyTexture::computeChunkDistance(const Chunk& player_chunk) const
+{
+   if (_texture_chunks.empty())
+   {
+      return 0;
+   }
+
+   return std::ranges::min(
+      _texture_chunks |
+      std::views::transform([&](const auto& chunk)
+                            { return std::max(std::abs(player_chunk._x - chunk._x), std::abs(player_chunk._y - chunk._y)); })
    );
+}
 
-   // if the texture does not define any chunks, we always need to load the texture.
+void LazyTexture::update(const Chunk& player_chunk)
+{
+   // if the texture does not define any chunks, its distance is 0 and we always need to load the texture.
    // this defeats the point of the lazy texture a bit but that's what it is.
-   if (should_be_loaded || _texture_chunks.empty())
+   const auto distance = computeChunkDistance(player_chunk);
+   const auto should_be_loaded = distance < chunk_load_threshold;
+
+   if (should_be_loaded)
    {
       // texture is only touched in the main thread, safe to keep unmutexed
-      if (!_texture && !_loading.test_and_set())
+      if (_texture)
       {
-         // load texture from disk (jthread)
-         loadTexture();
+         return;
       }
-      else if (!_texture)
+
+      if (!_request)
+      {
+         // decode texture (texture streamer)
+         loadTexture(distance);
+      }
+      else
       {
-         // shove texture into gpu (main thread)
-         uploadTexture();
+         // the player keeps moving while the request waits for a worker
+         _request->_priority = distance;
       }
+
+      // shove texture into gpu (main thread)
+      uploadTexture();
    }
    else
    {
-      // texture is no longer needed, throw it out
-      if (_texture)
+      // texture is no longer needed, throw it out or stop it from being decoded
+      if (_texture || _request)
       {
          unloadTexture();
       }
@@ -51,112 +78,88 @@ void LazyTexture::update(const Chunk& player_chunk)
 
 void LazyTexture::preload()
 {
-   if (!_texture && !_loading.test_and_set())
+   if (!_texture && !_request)
    {
-      loadTexture();
+      loadTexture(0);
    }
 }
 
 bool LazyTexture::drain()
 {
-   if (_image_ready.load())
-   {
-      uploadTexture();
-   }
-
-   return _loading.test(std::memory_order_relaxed);
+   uploadTexture();
+   return _request != nullptr;
 }
 
-void LazyTexture::loadTexture()
+void LazyTexture::loadTexture(int32_t priority)
 {
-   // Log::Info() << "loading " << _texture_path;
-
-   // Unlike the level loader, the thread below only decodes the image -- the upload happens in
-   // uploadTexture() on the main thread -- so no GL context is involved and nothing here rules
-   // it out on the Switch, which has real pthreads. It stays synchronous there only because it
-   // inherited the guard from the web build, where workers are a different proposition. Worth
-   // revisiting once the Switch target has more runtime on it.
-#ifdef DECEPTUS_VRSFML
-   auto image_result = sf::Image::loadFromFile(_texture_path);
-   if (image_result)
+   if (_load_failed)
    {
-      auto texture_result = sf::Texture::loadFromImage(*image_result);
-      if (texture_result)
-      {
-         _texture = std::make_shared<sf::Texture>(std::move(*texture_result));
-      }
-      else
-      {
-         Log::Warning() << "failed to upload texture " << _texture_path;
-      }
+      return;
    }
-   _loading.clear();
-#else
-   _loading_thread = std::jthread(
-      [this](std::stop_token)
-      {
-         auto image = std::make_unique<sf::Image>();
-         if (image->loadFromFile(_texture_path.string()))
-         {
-            std::lock_guard lock(_mutex);
-            _pending_image = std::move(image);
-            _image_ready = true;
-         }
-      }
-   );
-#endif
+
+   // Log::Info() << "loading " << _texture_path;
+   _request = TextureStreamer::getInstance().request(_texture_path, priority);
 }
 
 void LazyTexture::uploadTexture()
 {
-   if (!_image_ready.load())
+   if (!_request || !_request->isDone())
    {
       return;
    }
 
-   std::lock_guard lock(_mutex);
-   if (_pending_image)
+   auto& streamer = TextureStreamer::getInstance();
+   if (!streamer.tryBeginUpload())
    {
+      // out of upload slots for this frame, try again next frame
+      return;
+   }
+
+   const auto time_start = std::chrono::high_resolution_clock::now();
+
+   auto image = _request->takeImage();
+   _request.reset();
+
+   if (!image)
+   {
+      _load_failed = true;
+      return;
+   }
+
 #ifdef DECEPTUS_VRSFML
-      auto texture_result = sf::Texture::loadFromImage(*_pending_image);
-      if (texture_result)
-      {
-         _texture = std::make_shared<sf::Texture>(std::move(*texture_result));
-         _pending_image.reset();
-         _image_ready = false;
-         // Log::Info() << "uploaded texture " << _texture_path << " (" << _texture->getSize().x << ", " << _texture->getSize().y << ")";
-      }
-      else
-      {
-         Log::Warning() << "failed to upload texture " << _texture_path;
-      }
+   auto texture_result = sf::Texture::loadFromImage(*image);
+   if (texture_result)
+   {
+      _texture = std::make_shared<sf::Texture>(std::move(*texture_result));
+   }
 #else
-      _texture = std::make_shared<sf::Texture>();
-      if (_texture->loadFromImage(*_pending_image))
-      {
-         _pending_image.reset();
-         _image_ready = false;
-         // Log::Info() << "uploaded texture " << _texture_path << " (" << _texture->getSize().x << ", " << _texture->getSize().y << ")";
-      }
-      else
-      {
-         _texture.reset();
-         Log::Warning() << "failed to upload texture " << _texture_path;
-      }
+   _texture = std::make_shared<sf::Texture>();
+   if (!_texture->loadFromImage(*image))
+   {
+      _texture.reset();
+   }
 #endif
 
-      _loading.clear();
+   if (!_texture)
+   {
+      _load_failed = true;
+      Log::Warning() << "failed to upload texture " << _texture_path;
    }
+
+   streamer.endUpload(std::chrono::high_resolution_clock::now() - time_start);
 }
 
 void LazyTexture::unloadTexture()
 {
    // Log::Info() << "unloading " << _texture_path;
 
-   // safe to go without mutex since it'll only unload once the texture was uploaded to gpu
+   if (_request)
+   {
+      TextureStreamer::getInstance().cancel(_request);
+      _request.reset();
+   }
+
    _texture.reset();
-   _pending_image.reset();
-   _image_ready = false;
 }
 
 const std::shared_ptr<sf::Texture>& LazyTexture::getTexture() const
@@ -1,13 +1,11 @@
 #pragma once
 
 #include <SFML/Graphics.hpp>
-#include <atomic>
 #include <filesystem>
 #include <memory>
-#include <mutex>
-#include <thread>
 #include <vector>
 
+#include "game/io/texturestreamer.h"
 #include "game/level/chunk.h"
 
 /// \brief loads and unloads textures on demand based on player chunk proximity.
@@ -19,8 +17,8 @@ public:
    /// \param texture_chunks chunk list in which this texture is considered relevant.
    explicit LazyTexture(const std::filesystem::path& texture_path, std::vector<Chunk>& texture_chunks);
 
-   /// \brief destroys the lazy texture instance and joins any pending loader thread.
-   virtual ~LazyTexture() = default;
+   /// \brief destroys the lazy texture instance and cancels any pending decode request.
+   virtual ~LazyTexture();
 
    /// \brief decides whether texture data should be loaded, uploaded, kept, or released.
    /// \param player_chunk chunk currently occupied by the player.
@@ -30,7 +28,7 @@ public:
    /// call during level load to avoid first-in-range hitches from disk I/O on the render thread.
    void preload();
 
-   /// \brief uploads the texture to GPU if the background load has finished.
+   /// \brief uploads the texture to GPU if the background load has finished and the frame's upload budget allows it.
    /// \return true while a background load is still in flight or waiting to upload.
    bool drain();
 
@@ -39,23 +37,25 @@ public:
    const std::shared_ptr<sf::Texture>& getTexture() const;
 
 private:
-   /// \brief starts background loading of image pixels from disk into a pending buffer.
-   void loadTexture();
+   /// \brief queues the image for decoding on the texture streamer.
+   /// \param priority chunk distance to the player, lower values are decoded first.
+   void loadTexture(int32_t priority);
 
-   /// \brief releases uploaded texture and any pending image data.
+   /// \brief releases uploaded texture and cancels any pending decode request.
    void unloadTexture();
 
-   /// \brief uploads a loaded pending image to GPU texture memory on the main thread.
+   /// \brief uploads the decoded image to GPU texture memory on the main thread.
    void uploadTexture();
 
+   /// \brief computes how many chunks the closest of the texture's chunks is away from the player.
+   /// \param player_chunk chunk currently occupied by the player.
+   /// \return chebyshev distance in chunks, 0 if the texture has no chunks.
+   int32_t computeChunkDistance(const Chunk& player_chunk) const;
+
    std::filesystem::path _texture_path;
    std::shared_ptr<sf::Texture> _texture;
    std::vector<Chunk> _texture_chunks;
 
-   std::unique_ptr<sf::Image> _pending_image;
-   std::atomic<bool> _image_ready = false;
-
-   mutable std::mutex _mutex;
-   std::atomic_flag _loading = ATOMIC_FLAG_INIT;
-   std::jthread _loading_thread;
+   std::shared_ptr<TextureStreamer::Request> _request;
+   bool _load_failed{false};  //!< set when the image could not be decoded or uploaded, so it is not requested again every frame
 };
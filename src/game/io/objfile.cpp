@@ -0,0 +1,174 @@
+#include "objfile.h"
+
+#include "framework/tools/mappedfile.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+bool isBlank(char c)
+{
+   return c == ' ' || c == '\t' || c == '\r';
+}
+
+const char* skipBlanks(const char* pos, const char* end)
+{
+   while (pos < end && isBlank(*pos))
+   {
+      pos++;
+   }
+   return pos;
+}
+
+const char* skipToken(const char* pos, const char* end)
+{
+   while (pos < end && !isBlank(*pos))
+   {
+      pos++;
+   }
+   return pos;
+}
+
+//! true when the line starts with the given record name followed by a blank
+bool isRecord(const char* pos, const char* end, char record)
+{
+   return end - pos >= 2 && pos[0] == record && isBlank(pos[1]);
+}
+
+void appendFixed(std::string& out, float value)
+{
+   // the same digits 'std::fixed << std::setprecision(3)' gave
+   char buffer[64];
+   const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::fixed, 3);
+   out.append(buffer, result.ptr);
+}
+
+void appendIndex(std::string& out, uint32_t value)
+{
+   char buffer[16];
+   const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+   out.append(buffer, result.ptr);
+}
+}  // namespace
+
+size_t Mesh::ObjMesh::getFaceCount() const
+{
+   return _face_offsets.empty() ? 0 : _face_offsets.size() - 1;
+}
+
+std::span<const uint32_t> Mesh::ObjMesh::getFace(size_t face_index) const
+{
+   return {_indices.data() + _face_offsets[face_index], _indices.data() + _face_offsets[face_index + 1]};
+}
+
+bool Mesh::parseObj(std::string_view text, ObjMesh& mesh)
+{
+   mesh._points.clear();
+   mesh._indices.clear();
+   mesh._face_offsets.clear();
+
+   const auto* pos = text.data();
+   const auto* end = text.data() + text.size();
+
+   while (pos < end)
+   {
+      const auto* line_end = static_cast<const char*>(std::memchr(pos, '\n', static_cast<size_t>(end - pos)));
+      if (!line_end)
+      {
+         line_end = end;
+      }
+
+      pos = skipBlanks(pos, line_end);
+
+      if (isRecord(pos, line_end, 'v'))
+      {
+         auto x = 0.0f;
+         auto y = 0.0f;
+
+         pos = skipBlanks(pos + 1, line_end);
+         pos = skipBlanks(std::from_chars(pos, line_end, x).ptr, line_end);
+         std::from_chars(pos, line_end, y);
+
+         mesh._points.emplace_back(x, y);
+      }
+      else if (isRecord(pos, line_end, 'f'))
+      {
+         mesh._face_offsets.push_back(static_cast<uint32_t>(mesh._indices.size()));
+
+         pos = skipBlanks(pos + 1, line_end);
+         while (pos < line_end)
+         {
+            // a vertex is 'position[/texcoord[/normal]]', only the position is of interest
+            auto index = 0u;
+            const auto result = std::from_chars(pos, line_end, index);
+            if (result.ec != std::errc{} || index == 0)
+            {
+               return false;
+            }
+
+            // obj indices start at 1
+            mesh._indices.push_back(index - 1);
+            pos = skipBlanks(skipToken(result.ptr, line_end), line_end);
+         }
+      }
+
+      pos = line_end + 1;
+   }
+
+   mesh._face_offsets.push_back(static_cast<uint32_t>(mesh._indices.size()));
+
+   const auto point_count = mesh._points.size();
+   return std::ranges::all_of(mesh._indices, [point_count](auto index) { return index < point_count; });
+}
+
+std::shared_ptr<const Mesh::ObjMesh> Mesh::loadObj(const std::filesystem::path& path)
+{
+   MappedFile file;
+   if (!file.open(path))
+   {
+      return nullptr;
+   }
+
+   auto mesh = std::make_shared<ObjMesh>();
+   if (!parseObj({file.getData(), file.getSize()}, *mesh))
+   {
+      return nullptr;
+   }
+
+   return mesh;
+}
+
+void Mesh::writeObj(const std::string& filename, const std::vector<b2Vec2>& vertices, const std::vector<std::vector<uint32_t>>& faces)
+{
+   // formatted into one buffer and written at once rather than streamed value by value
+   std::string out;
+   out.reserve(vertices.size() * 32 + faces.size() * 32);
+
+   for (const auto& v : vertices)
+   {
+      out += "v ";
+      appendFixed(out, v.x);
+      out += ' ';
+      appendFixed(out, v.y);
+      out += " 0.000\n";
+   }
+
+   out += '\n';
+
+   for (const auto& face : faces)
+   {
+      out += "f ";
+      for (const auto p : face)
+      {
+         appendIndex(out, p);
+         out += ' ';
+      }
+      out += '\n';
+   }
+
+   std::ofstream file(filename);
+   file.write(out.data(), static_cast<std::streamsize>(out.size()));
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "box2d/b2_math.h"
+
+namespace Mesh
+{
+
+/// \brief 2d geometry of a wavefront obj file, with all faces stored back to back.
+///
+/// a face per vector meant one allocation per face; collision meshes have tens of thousands of them.
+struct ObjMesh
+{
+   std::vector<b2Vec2> _points;
+   std::vector<uint32_t> _indices;       //!< 0-based point indices of every face, one face after the other
+   std::vector<uint32_t> _face_offsets;  //!< where each face starts in _indices, followed by _indices.size()
+
+   /// \brief gets the number of faces.
+   /// \return face count.
+   size_t getFaceCount() const;
+
+   /// \brief gets the point indices of one face.
+   /// \param face_index index of the face, must be below getFaceCount().
+   /// \return 0-based indices into _points.
+   std::span<const uint32_t> getFace(size_t face_index) const;
+};
+
+/// \brief parses obj text in a single pass.
+///
+/// only v and f records are kept, of the face records only the position indices. the z coordinate
+/// and every other record are skipped.
+/// \param text obj file contents.
+/// \param mesh mesh receiving the geometry, cleared first.
+/// \return false when a face references a point that does not exist.
+bool parseObj(std::string_view text, ObjMesh& mesh);
+
+/// \brief maps an obj file into memory and parses it.
+/// \param path source obj file path.
+/// \return the parsed mesh, nullptr when the file cannot be read or parsed.
+std::shared_ptr<const ObjMesh> loadObj(const std::filesystem::path& path);
+
+/// \brief writes 2d vertices and indexed faces to a wavefront obj file.
+/// \param filename destination obj file path.
+/// \param vertices point list written as v records.
+/// \param faces polygon index lists written as f records, already 1-based.
+void writeObj(const std::string& filename, const std::vector<b2Vec2>& vertices, const std::vector<std::vector<uint32_t>>& faces);
+
+}  // namespace Mesh
@@ -15,6 +15,38 @@ public:
       return instance;
    }
 
+   using ResourcePool<sf::Texture>::get;
+
+   /// \brief returns the cached texture for a path, or creates it from an image that was decoded already.
+   /// \note creates a gl texture, so it has to be called on the thread owning the gl context.
+   /// \param path texture file path, used as cache key.
+   /// \param image decoded content of \p path, e.g. from ImagePool.
+   /// \return shared texture pointer, nullptr when the texture could not be created.
+   std::shared_ptr<sf::Texture> get(const std::filesystem::path& path, const sf::Image& image)
+   {
+      return getOrCreate(
+         path,
+         [&image]() -> std::shared_ptr<sf::Texture>
+         {
+#ifdef DECEPTUS_VRSFML
+            auto created_texture = sf::Texture::loadFromImage(image);
+            if (!created_texture)
+            {
+               return nullptr;
+            }
+            return std::make_shared<sf::Texture>(std::move(created_texture.value()));
+#else
+            auto texture = std::make_shared<sf::Texture>();
+            if (!texture->loadFromImage(image))
+            {
+               return nullptr;
+            }
+            return texture;
+#endif
+         }
+      );
+   }
+
 protected:
    /// \brief loads a texture from disk into the provided resource instance.
    /// \param texture texture object that receives file content.
@@ -0,0 +1,209 @@
+#include "texturestreamer.h"
+
+#include <algorithm>
+
+#include "framework/tools/log.h"
+
+namespace
+{
+std::unique_ptr<sf::Image> decode(const std::filesystem::path& path)
+{
+#ifdef DECEPTUS_VRSFML
+   auto image_result = sf::Image::loadFromFile(path);
+   if (!image_result)
+   {
+      return nullptr;
+   }
+
+   return std::make_unique<sf::Image>(std::move(*image_result));
+#else
+   auto image = std::make_unique<sf::Image>();
+   if (!image->loadFromFile(path.string()))
+   {
+      return nullptr;
+   }
+
+   return image;
+#endif
+}
+
+int32_t computeWorkerCount()
+{
+   // decoding is mostly waiting for the disk and inflating pngs; a few workers keep both busy without
+   // taking cores away from the main thread and the level loader
+   const auto hardware_threads = static_cast<int32_t>(std::thread::hardware_concurrency());
+   return std::clamp(hardware_threads / 2, 1, 4);
+}
+}  // namespace
+
+TextureStreamer::Request::Request(const std::filesystem::path& path, int32_t priority) : _path(path), _priority(priority)
+{
+}
+
+bool TextureStreamer::Request::isDone() const
+{
+   return _done.load();
+}
+
+std::unique_ptr<sf::Image> TextureStreamer::Request::takeImage()
+{
+   std::lock_guard lock(_mutex);
+   return std::move(_image);
+}
+
+TextureStreamer& TextureStreamer::getInstance()
+{
+   static TextureStreamer instance;
+   return instance;
+}
+
+TextureStreamer::TextureStreamer()
+{
+   // the web build has no worker threads to spare, requests are decoded right away there, see request()
+#ifndef DECEPTUS_VRSFML
+   const auto worker_count = computeWorkerCount();
+   for (auto i = 0; i < worker_count; i++)
+   {
+      _workers.emplace_back([this](std::stop_token stop_token) { work(stop_token); });
+   }
+#endif
+}
+
+TextureStreamer::~TextureStreamer()
+{
+   for (auto& worker : _workers)
+   {
+      worker.request_stop();
+   }
+
+   _condition.notify_all();
+   _workers.clear();
+}
+
+std::shared_ptr<TextureStreamer::Request> TextureStreamer::request(const std::filesystem::path& path, int32_t priority)
+{
+   auto request = std::make_shared<Request>(path, priority);
+
+#ifdef DECEPTUS_VRSFML
+   request->_image = decode(path);
+   request->_done = true;
+#else
+   {
+      std::lock_guard lock(_mutex);
+      _queue.push_back(request);
+   }
+
+   _condition.notify_one();
+#endif
+
+   return request;
+}
+
+void TextureStreamer::cancel(const std::shared_ptr<Request>& request)
+{
+   request->_cancelled = true;
+
+   std::lock_guard lock(_mutex);
+   std::erase(_queue, request);
+}
+
+std::shared_ptr<TextureStreamer::Request> TextureStreamer::popNextRequest()
+{
+   // the queue rarely holds more than a few dozen requests and their priorities change while they wait
+   // since the player keeps moving, so a scan is simpler than keeping a heap up to date
+   const auto next =
+      std::ranges::min_element(_queue, {}, [](const auto& request) { return request->_priority.load(std::memory_order_relaxed); });
+
+   auto request = *next;
+   _queue.erase(next);
+   return request;
+}
+
+void TextureStreamer::work(std::stop_token stop_token)
+{
+   while (!stop_token.stop_requested())
+   {
+      std::shared_ptr<Request> request;
+
+      {
+         std::unique_lock lock(_mutex);
+         if (!_condition.wait(lock, stop_token, [this] { return !_queue.empty(); }))
+         {
+            return;
+         }
+
+         request = popNextRequest();
+         _decoding_count++;
+      }
+
+      auto image = decode(request->_path);
+      if (!image)
+      {
+         Log::Warning() << "failed to decode texture " << request->_path;
+      }
+
+      // a request cancelled while it was decoded is just dropped, its owner does not wait for it anymore
+      if (!request->_cancelled.load())
+      {
+         std::lock_guard lock(request->_mutex);
+         request->_image = std::move(image);
+      }
+
+      request->_done = true;
+      _decoding_count--;
+   }
+}
+
+void TextureStreamer::beginFrame()
+{
+   _uploads_last_frame = _uploads_this_frame;
+   _upload_time_last_frame = _upload_time_this_frame;
+   _peak_upload_time = std::max(_peak_upload_time, _upload_time_this_frame);
+
+   _uploads_this_frame = 0;
+   _upload_time_this_frame = {};
+   _uploads_left = max_uploads_per_frame;
+}
+
+bool TextureStreamer::tryBeginUpload()
+{
+   if (_uploads_left <= 0)
+   {
+      return false;
+   }
+
+   _uploads_left--;
+   return true;
+}
+
+void TextureStreamer::endUpload(HighResDuration duration)
+{
+   _uploads_this_frame++;
+   _upload_time_this_frame += duration;
+}
+
+int32_t TextureStreamer::getQueueDepth() const
+{
+   std::lock_guard lock(_mutex);
+   return static_cast<int32_t>(_queue.size());
+}
+
+int32_t TextureStreamer::getDecodingCount() const
+{
+   return _decoding_count.load();
+}
+
+int32_t TextureStreamer::getUploadCount() const
+{
+   return _uploads_last_frame;
+}
+
+float TextureStreamer::getUploadTimeMs() const
+{
+   return std::chrono::duration<float, std::milli>(_upload_time_last_frame).count();
+}
+
+float TextureStreamer::getPeakUploadTimeMs() const
+{
+   return std::chrono::duration<float, std::milli>(_peak_upload_time).count();
+}
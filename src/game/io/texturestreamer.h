@@ -0,0 +1,121 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// \brief decodes textures on a small shared pool of worker threads and meters their gpu uploads.
+///
+/// Image layers used to start a thread of their own for every texture they decoded, so walking into an area
+/// with many image layers started dozens of threads at once, all competing for the disk and the cpu. Requests
+/// are now queued and picked up by a fixed number of workers, closest to the player first. A request can be
+/// cancelled while it is still queued or decoding, e.g. when the player has turned around already.
+///
+/// Decoded images are uploaded to the gpu on the main thread by their owner. To keep uploads from piling up in
+/// a single frame, owners ask for an upload slot first; there are only a few per frame.
+class TextureStreamer
+{
+public:
+   using HighResDuration = std::chrono::high_resolution_clock::duration;
+
+   /// \brief one texture to decode.
+   struct Request
+   {
+      /// \brief creates a request for a texture file.
+      /// \param path path of the image file.
+      /// \param priority initial priority, lower values are decoded first.
+      Request(const std::filesystem::path& path, int32_t priority);
+
+      /// \brief checks if the image has been decoded and can be taken.
+      /// \return true when decoding has finished, successful or not.
+      bool isDone() const;
+
+      /// \brief takes the decoded image.
+      /// \return decoded image, nullptr when decoding failed or is not done yet.
+      std::unique_ptr<sf::Image> takeImage();
+
+      std::filesystem::path _path;
+      std::atomic<int32_t> _priority{0};  //!< chunk distance to the player, updated by the owner while queued
+      std::atomic<bool> _cancelled{false};
+      std::atomic<bool> _done{false};
+
+      std::mutex _mutex;
+      std::unique_ptr<sf::Image> _image;
+   };
+
+   /// \brief returns the global texture streamer.
+   /// \return texture streamer singleton.
+   static TextureStreamer& getInstance();
+
+   ~TextureStreamer();
+
+   /// \brief queues a texture for decoding.
+   /// \param path path of the image file.
+   /// \param priority priority of the request, usually the chunk distance to the player; lower values come first.
+   /// \return request handle to poll, reprioritize and cancel.
+   std::shared_ptr<Request> request(const std::filesystem::path& path, int32_t priority);
+
+   /// \brief drops a request; a queued request is removed, a request being decoded is discarded once decoded.
+   /// \param request request to cancel.
+   void cancel(const std::shared_ptr<Request>& request);
+
+   /// \brief starts a new frame and refills the upload budget.
+   void beginFrame();
+
+   /// \brief claims one of the gpu upload slots of the current frame.
+   /// \return true if the caller may upload now, false if it should try again next frame.
+   bool tryBeginUpload();
+
+   /// \brief books the time spent on an upload started with tryBeginUpload.
+   /// \param duration time the upload took.
+   void endUpload(HighResDuration duration);
+
+   /// \brief returns the number of requests waiting for a worker.
+   /// \return queue depth.
+   int32_t getQueueDepth() const;
+
+   /// \brief returns the number of requests currently being decoded.
+   /// \return decode count.
+   int32_t getDecodingCount() const;
+
+   /// \brief returns the uploads made in the previous frame.
+   /// \return upload count.
+   int32_t getUploadCount() const;
+
+   /// \brief returns the time spent on uploads in the previous frame.
+   /// \return upload time in milliseconds.
+   float getUploadTimeMs() const;
+
+   /// \brief returns the longest time a single frame spent on uploads so far.
+   /// \return upload time in milliseconds.
+   float getPeakUploadTimeMs() const;
+
+private:
+   TextureStreamer();
+
+   void work(std::stop_token stop_token);
+   std::shared_ptr<Request> popNextRequest();
+
+   static constexpr int32_t max_uploads_per_frame = 2;
+
+   mutable std::mutex _mutex;
+   std::condition_variable_any _condition;
+   std::vector<std::shared_ptr<Request>> _queue;
+   std::atomic<int32_t> _decoding_count{0};
+   std::vector<std::jthread> _workers;
+
+   // upload metering, main thread only
+   int32_t _uploads_left{max_uploads_per_frame};
+   int32_t _uploads_this_frame{0};
+   HighResDuration _upload_time_this_frame{};
+   int32_t _uploads_last_frame{0};
+   HighResDuration _upload_time_last_frame{};
+   HighResDuration _peak_upload_time{};
+};
@@ -1,12 +1,17 @@
 #include "ambientocclusion.h"
 
 #include <array>
+#include <chrono>
 #include <cstdio>
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <system_error>
 
+#include "framework/tools/binarystream.h"
 #include "framework/tools/log.h"
+#include "framework/tools/mappedfile.h"
+#include "game/io/imagepool.h"
 #include "game/io/texturepool.h"
 #ifdef DEVELOPMENT_MODE
 #include "game/debug/drawcallcounter.h"
@@ -20,6 +25,16 @@ constexpr int32_t chunk_range_x_left = 4;
 constexpr int32_t chunk_range_x_right = 4;
 constexpr int32_t chunk_range_y_left = 3;
 constexpr int32_t chunk_range_y_right = 3;
+
+constexpr uint32_t sidecar_magic = 0x4f415344;  // 'DSAO'
+
+// bump whenever the layout of the sidecar changes
+constexpr uint32_t sidecar_version = 1;
+
+std::filesystem::path getSidecarPath(const std::filesystem::path& uv_path)
+{
+   return uv_path.string() + ".bin";
+}
 }  // namespace
 
 void AmbientOcclusion::load(const std::filesystem::path& path, const std::string& base_filename)
@@ -28,17 +43,64 @@ void AmbientOcclusion::load(const std::filesystem::path& path, const std::string
 
    _config = Config(path, base_filename);
 
+   // load may run on a worker thread, so the texture is only decoded here and created in upload()
    if (_config._valid)
    {
-      _texture = TexturePool::getInstance().get(_config._texture_filename);
+      _image = ImagePool::getInstance().get(_config._texture_filename);
    }
 
-   if (_texture == nullptr || _texture->getSize().x == 0 || _texture->getSize().y == 0)
+   if (_image == nullptr || _image->getSize().x == 0 || _image->getSize().y == 0)
    {
       Log::Error() << "bad ambient occlusion texture";
+      _image.reset();
+      return;
+   }
+
+   const auto start_time = std::chrono::steady_clock::now();
+
+   // the text file stays the authoring format. the first load writes the quads out as ready-made
+   // triangles, bucketed and sorted by chunk, and later loads copy them straight out of a mapping
+   std::error_code size_error;
+   std::error_code time_error;
+   SidecarKey key;
+   key._uv_file_size = static_cast<uint64_t>(std::filesystem::file_size(_config._uv_filename, size_error));
+   key._uv_file_write_time =
+      static_cast<int64_t>(std::filesystem::last_write_time(_config._uv_filename, time_error).time_since_epoch().count());
+   key._texture_width = _image->getSize().x;
+   key._offset_x_px = _config._offset_x_px;
+   key._offset_y_px = _config._offset_y_px;
+
+   const auto sidecar_path = getSidecarPath(_config._uv_filename);
+   const auto has_key = !size_error && !time_error;
+   const auto from_sidecar = has_key && readSidecar(sidecar_path, key);
+
+   if (!from_sidecar)
+   {
+      loadUvFile();
+
+      if (has_key && !_vertex_map.empty())
+      {
+         writeSidecar(sidecar_path, key);
+      }
+   }
+
+   const auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_time).count();
+   Log::Info() << "loaded ao quads from " << (from_sidecar ? sidecar_path.string() : _config._uv_filename) << " in " << elapsed_ms << "ms";
+}
+
+void AmbientOcclusion::upload()
+{
+   if (!_image)
+   {
       return;
    }
 
+   _texture = TexturePool::getInstance().get(_config._texture_filename, *_image);
+   _image.reset();
+}
+
+void AmbientOcclusion::loadUvFile()
+{
    auto x_index_px = 0;
    auto y_index_px = 0;
    auto quad_index = 0;
@@ -64,7 +126,7 @@ void AmbientOcclusion::load(const std::filesystem::path& path, const std::string
       std::sscanf(line.c_str(), "%d;%d;%d;%d;%d", &quad_index, &x_px, &y_px, &width_px, &height_px);
 
       const auto x_index_px_prev = x_index_px;
-      x_index_px = (quad_index * width_px) % _texture->getSize().x;
+      x_index_px = (quad_index * width_px) % _image->getSize().x;
       if (x_index_px == 0 && x_index_px_prev != 0)
       {
          y_index_px += height_px;
@@ -114,6 +176,79 @@ void AmbientOcclusion::load(const std::filesystem::path& path, const std::string
    uv_file.close();
 }
 
+bool AmbientOcclusion::readSidecar(const std::filesystem::path& sidecar_path, const SidecarKey& key)
+{
+   MappedFile file;
+   if (!file.open(sidecar_path))
+   {
+      return false;
+   }
+
+   // the vertices are stored as they sit in memory, so a sidecar written by a build with a different
+   // sf::Vertex layout is regenerated as well
+   BinaryReader reader(file.getData(), file.getSize());
+   if (reader.read<uint32_t>() != sidecar_magic || reader.read<uint32_t>() != sidecar_version ||
+       reader.read<uint32_t>() != static_cast<uint32_t>(sizeof(sf::Vertex)) || reader.read<uint64_t>() != key._uv_file_size ||
+       reader.read<int64_t>() != key._uv_file_write_time || reader.read<uint32_t>() != key._texture_width ||
+       reader.read<int32_t>() != key._offset_x_px || reader.read<int32_t>() != key._offset_y_px)
+   {
+      return false;
+   }
+
+   std::map<int32_t, std::map<int32_t, std::vector<sf::Vertex>>> vertex_map;
+   const auto chunk_count = reader.read<uint32_t>();
+   for (auto i = 0u; i < chunk_count && reader.isValid(); i++)
+   {
+      const auto chunk_y = reader.read<int32_t>();
+      const auto chunk_x = reader.read<int32_t>();
+      vertex_map[chunk_y][chunk_x] = reader.readVector<sf::Vertex>();
+   }
+
+   if (!reader.isValid() || !reader.isAtEnd())
+   {
+      Log::Warning() << "ignoring damaged ao sidecar " << sidecar_path.string();
+      return false;
+   }
+
+   _vertex_map = std::move(vertex_map);
+   return true;
+}
+
+void AmbientOcclusion::writeSidecar(const std::filesystem::path& sidecar_path, const SidecarKey& key) const
+{
+   auto chunk_count = 0u;
+   for (const auto& [chunk_y, row] : _vertex_map)
+   {
+      chunk_count += static_cast<uint32_t>(row.size());
+   }
+
+   BinaryWriter writer;
+   writer.write(sidecar_magic);
+   writer.write(sidecar_version);
+   writer.write(static_cast<uint32_t>(sizeof(sf::Vertex)));
+   writer.write(key._uv_file_size);
+   writer.write(key._uv_file_write_time);
+   writer.write(key._texture_width);
+   writer.write(key._offset_x_px);
+   writer.write(key._offset_y_px);
+   writer.write(chunk_count);
+
+   // both maps are ordered, so the chunks go out sorted by row and then by column
+   for (const auto& [chunk_y, row] : _vertex_map)
+   {
+      for (const auto& [chunk_x, chunk_vertices] : row)
+      {
+         writer.write(chunk_y);
+         writer.write(chunk_x);
+         writer.writeVector(chunk_vertices);
+      }
+   }
+
+   // best effort, the level might live on a read-only filesystem
+   std::ofstream file_out(sidecar_path, std::ofstream::binary | std::ofstream::trunc);
+   file_out.write(writer.getBuffer().data(), static_cast<std::streamsize>(writer.getBuffer().size()));
+}
+
 void AmbientOcclusion::draw(sf::RenderTarget& window, const sf::RenderStates& states)
 {
    const auto& player_pos_px = PlayerRegistry::getFirst()->getPixelPositionInt();
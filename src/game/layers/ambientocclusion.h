@@ -13,10 +13,19 @@ public:
    AmbientOcclusion() = default;
 
    /// \brief loads ao configuration, texture, and per-tile uv sprite placement data.
+   ///
+   /// the uv text file is parsed once and its quads are written to a binary sidecar next to it
+   /// (`<uv file>.bin`); later loads map the sidecar while it still matches the uv file, the texture
+   /// width and the offsets.
+   /// \note does not touch the gl context, so it can run on a worker thread; upload() creates the texture.
    /// \param path directory containing ambient_occlusion.json and referenced assets.
    /// \param ao_base_filename fallback texture base name used when json fields are missing.
    void load(const std::filesystem::path& path, const std::string& ao_base_filename);
 
+   /// \brief creates the texture from the image decoded by load().
+   /// \note needs the gl context.
+   void upload();
+
    /// \brief draws only ao sprite chunks near the player's current chunk.
    /// \param window SFML render target that receives ambient occlusion sprites.
    /// \param states render states to apply (carries .view for WASM camera transform).
@@ -49,8 +58,23 @@ public:
    };
 
 private:
+   /// \brief what the binary sidecar was generated from; a mismatch means it is regenerated.
+   struct SidecarKey
+   {
+      uint64_t _uv_file_size{};
+      int64_t _uv_file_write_time{};
+      uint32_t _texture_width{};
+      int32_t _offset_x_px{};
+      int32_t _offset_y_px{};
+   };
+
+   void loadUvFile();
+   bool readSidecar(const std::filesystem::path& sidecar_path, const SidecarKey& key);
+   void writeSidecar(const std::filesystem::path& sidecar_path, const SidecarKey& key) const;
+
    Config _config;
    std::shared_ptr<sf::Texture> _texture;
+   std::shared_ptr<sf::Image> _image;  //!< decoded by load(), handed over to the texture pool by upload()
 
    //!< two triangles per ao quad, bucketed by chunk. built once at load rather than kept as
    //!< sprites, because every quad shares one texture and one blend mode and so the whole visible
@@ -1,6 +1,5 @@
 #include "rainoverlay.h"
 
-#include "framework/math/sfmlmath.h"
 #include "game/audio/audio.h"
 #include "game/config/gameconfiguration.h"
 #include "game/debug/debugdraw.h"
@@ -10,6 +9,7 @@
 #include "game/player/playerregistry.h"
 
 #include <algorithm>
+#include <cmath>
 #include <cstdlib>
 #include <ctime>
 #include <iostream>
@@ -20,6 +20,8 @@ namespace
 static const auto max_age_s = 1.0f;            // time for raindrop to move through all screens
 static const auto randomize_factor_y = 0.02f;  // randomized to 0..2
 static const auto fixed_direction_y = 1000.0f;
+static const auto surface_search_distance_px = 1000.0f;  // how far below its spawn point a drop can land
+static const auto surface_margin_px = 128.0f;            // surfaces are gathered this far around the screen
 
 sf::Vector2f vecB2S(const b2Vec2& vector)
 {
@@ -64,17 +66,15 @@ const sf::BlendMode rain_blend_mode(
 RainOverlay::RainOverlay() : _texture(TexturePool::getInstance().get("data/sprites/rain.png"))
 {
    std::srand(static_cast<uint32_t>(std::time(nullptr)));  // use current time as seed for random generator
+   createDrops();
+}
 
-   for (auto a = 0; a < _settings._drop_count; a++)
-   {
-      RainDrop drop;
-#ifdef DECEPTUS_VRSFML
-      drop._sprite = std::make_unique<sf::Sprite>();
-#else
-      drop._sprite = std::make_unique<sf::Sprite>(*_texture);
-#endif
-      _drops.push_back(std::move(drop));
-   }
+void RainOverlay::createDrops()
+{
+   _drops.clear();
+   _drops.reserve(static_cast<size_t>(std::max(_settings._drop_count, 0)));
+
+   _drops.resize(static_cast<size_t>(std::max(_settings._drop_count, 0)));
 }
 
 RainOverlay::~RainOverlay()
@@ -94,23 +94,7 @@ void RainOverlay::draw(sf::RenderTarget& target, sf::RenderTarget& normal)
       {screen_view.getSize().x, screen_view.getSize().y}
    };
 
-   for (auto& d : _drops)
-   {
-      if (d._age_s >= 0.0f)
-      {
-         // DebugDraw::drawLine(target, d._origin_px, d._pos_px + sf::Vector2f{0.0f, 96.0f}, {0, 0, 1});
-         target.draw(*d._sprite, rain_blend_mode);
-      }
-   }
-
-   if (_settings._collide)
-   {
-      for (auto& hit : _hits)
-      {
-         // DebugDraw::drawPoint(target, hit._pos_px, {1, 0, 0});
-         target.draw(*hit._sprite);
-      }
-   }
+   drawBatch(target, rain_blend_mode);
 #endif
 }
 
@@ -126,31 +110,42 @@ void RainOverlay::draw(sf::RenderTarget& target, sf::RenderTarget& normal, const
       {screen_view.size.x, screen_view.size.y}
    };
 
-   // the texture has to travel in the render states, vrsfml sprites do not own one
-   const sf::RenderStates drop_states{.blendMode = rain_blend_mode, .view = screen_view, .texture = _texture.get()};
-   const sf::RenderStates hit_states{.view = screen_view, .texture = _texture.get()};
+   drawBatch(target, {.blendMode = rain_blend_mode, .view = screen_view});
+#else
+   (void)states;
+   draw(target, normal);
+#endif
+}
+
+void RainOverlay::drawBatch(sf::RenderTarget& target, const sf::RenderStates& states)
+{
+   _batch.clear();
 
-   for (auto& d : _drops)
+   // streaks are 11x96 px and hang from their position, slightly left of center
+   for (const auto& d : _drops)
    {
       if (d._age_s >= 0.0f)
       {
          // DebugDraw::drawLine(target, d._origin_px, d._pos_px + sf::Vector2f{0.0f, 96.0f}, {0, 0, 1});
-         target.draw(*d._sprite, drop_states);
+         _batch.addQuad({{d._pos_px.x - 6.0f, d._pos_px.y}, {11.0f, 96.0f}}, {{static_cast<float>(d._frame * 11), 0.0f}, {11.0f, 96.0f}});
       }
    }
 
+   // splashes are 11x12 px and sit on the surface they hit. they share the atlas with the streaks,
+   // so they go out in the same batch, after them
    if (_settings._collide)
    {
-      for (auto& hit : _hits)
+      for (const auto& hit : _hits)
       {
          // DebugDraw::drawPoint(target, hit._pos_px, {1, 0, 0});
-         target.draw(*hit._sprite, hit_states);
+         const auto frame = std::min(3, static_cast<int32_t>(hit._age_s * 10.0f));
+         _batch.addQuad(
+            {{hit._pos_px.x - 5.0f, hit._pos_px.y - 11.0f}, {11.0f, 12.0f}}, {{static_cast<float>(frame * 11), 96.0f}, {11.0f, 12.0f}}
+         );
       }
    }
-#else
-   (void)states;
-   draw(target, normal);
-#endif
+
+   _batch.draw(target, states, _texture.get());
 }
 
 // rain tileset
@@ -174,23 +169,8 @@ void RainOverlay::update(const sf::Time& dt)
       return;
    }
 
-   // go through all edges and find the closest intersection; this way we know when the rain drop will hit the floor
-   auto update_colliding_edge = [this](RainDrop& p)
-   {
-      p._intersections.clear();
-
-      for (const auto& edge : _edges)
-      {
-         auto intersection = SfmlMath::intersect(p._origin_px, p._pos_px + sf::Vector2f{0.0f, 1000.0f}, edge._p1_px, edge._p2_px);
-
-         if (intersection.has_value())
-         {
-            p._intersections.push_back(intersection.value().y);
-         }
-      }
-
-      std::sort(p._intersections.begin(), p._intersections.end());
-   };
+   // find the closest surface below the drop; this way we know when the rain drop will hit the floor
+   auto update_colliding_edge = [this](RainDrop& p) { p._surface_y_px = findSurface(p._pos_px); };
 
    // set up the rain area like below:
    //
@@ -218,19 +198,12 @@ void RainOverlay::update(const sf::Time& dt)
    {
       for (auto& p : _drops)
       {
-         const auto sprite_index = std::rand() % 4;
-
-#ifdef DECEPTUS_VRSFML
-         p._sprite->textureRect = sf::FloatRect{{static_cast<float>(static_cast<int32_t>(sprite_index) * 11), 0.0f}, {11.0f, 96.0f}};
-         p._sprite->origin = {6, 0};
-#else
-         p._sprite->setTextureRect(sf::IntRect({static_cast<int32_t>(sprite_index) * 11, 0}, {11, 96}));
-         p._sprite->setOrigin({6, 0});
-#endif
+         p._frame = std::rand() % 4;
          p._pos_px.x = _clip_rect.position.x + std::rand() % static_cast<int32_t>(_clip_rect.size.x);
          p._pos_px.y = _clip_rect.position.y + std::rand() % static_cast<int32_t>(_clip_rect.size.y);
          p._age_s = (std::rand() % (static_cast<int32_t>(max_age_s * 10000))) * 0.0001f;
          p._dir_px.y = (std::rand() % 100) * randomize_factor_y + fixed_direction_y;
+         p._origin_px = p._pos_px;
          update_colliding_edge(p);
       }
 
@@ -246,11 +219,6 @@ void RainOverlay::update(const sf::Time& dt)
       {
          const auto step_width_px = p._dir_px * dt.asSeconds();
          p._pos_px += step_width_px;
-#ifdef DECEPTUS_VRSFML
-         p._sprite->position = p._pos_px;
-#else
-         p._sprite->setPosition(p._pos_px);
-#endif
 
          if (p._age_s > max_age_s)
          {
@@ -262,24 +230,15 @@ void RainOverlay::update(const sf::Time& dt)
             if (_settings._fall_through_rate == 0 || (fallthrough_index % _settings._fall_through_rate) == 0)
             {
                // intersect rain drop with edges
-               if (!p._intersections.empty())
+               if (p._surface_y_px.has_value())
                {
-                  const auto& closest_point = p._intersections.front();
+                  const auto closest_point = p._surface_y_px.value();
 
-                  if (p._pos_px.y + 96 > p._intersections.at(0))
+                  if (p._pos_px.y + 96 > closest_point)
                   {
                      const sf::Vector2f hit_position{p._pos_px.x, closest_point};
 
-                     DropHit hit;
-#ifdef DECEPTUS_VRSFML
-                     hit._sprite = std::make_unique<sf::Sprite>();
-                     hit._sprite->position = hit_position;
-#else
-                     hit._sprite = std::make_unique<sf::Sprite>(*_texture);
-                     hit._sprite->setPosition(hit_position);
-#endif
-                     hit._pos_px = hit_position;
-                     _hits.push_back(std::move(hit));
+                     _hits.push_back({hit_position});
 
                      p.reset(_clip_rect);
 
@@ -295,8 +254,15 @@ void RainOverlay::update(const sf::Time& dt)
 
    if (_settings._collide)
    {
-      // only refresh the box2d information every 30 frames
-      if (_edges.empty() || _refresh_surface_counter == 30)
+      // the surfaces are gathered with a margin around the screen, so they only have to be gathered again
+      // once the screen leaves that margin. apart from that, refresh the box2d information every 30 frames
+      // to pick up bodies that moved
+      const auto screen_covered = _screen.position.x >= _surface_rect.position.x &&
+                                  _screen.position.y >= _surface_rect.position.y &&
+                                  _screen.position.x + _screen.size.x <= _surface_rect.position.x + _surface_rect.size.x &&
+                                  _screen.position.y + _screen.size.y <= _surface_rect.position.y + _surface_rect.size.y;
+
+      if (_edges.empty() || !screen_covered || _refresh_surface_counter == 30)
       {
          determineRainSurfaces();
          _refresh_surface_counter = 0;
@@ -312,14 +278,6 @@ void RainOverlay::update(const sf::Time& dt)
             [dt](auto& hit)
             {
                hit._age_s += dt.asSeconds();
-#ifdef DECEPTUS_VRSFML
-               hit._sprite->origin = {5, 11};
-               hit._sprite->textureRect =
-                  sf::FloatRect{{static_cast<float>(11 * std::min(3, static_cast<int32_t>(hit._age_s * 10.0f))), 96.0f}, {11.0f, 12.0f}};
-#else
-               hit._sprite->setOrigin({5, 11});
-               hit._sprite->setTextureRect(sf::IntRect({11 * std::min(3, static_cast<int32_t>(hit._age_s * 10.0f)), 96}, {11, 12}));
-#endif
                return hit._age_s > 1.0f;
             }
          ),
@@ -344,9 +302,14 @@ void RainOverlay::determineRainSurfaces()
 {
    _edges.clear();
 
+   _surface_rect = {
+      {_screen.position.x - surface_margin_px, _screen.position.y - surface_margin_px},
+      {_screen.size.x + 2.0f * surface_margin_px, _screen.size.y + 2.0f * surface_margin_px}
+   };
+
    auto level = LevelRegistry::getCurrent();
 
-   std::vector<b2Body*> bodies = retrieveBodiesOnScreen(level->getWorld(), _screen);
+   std::vector<b2Body*> bodies = retrieveBodiesOnScreen(level->getWorld(), _surface_rect);
 
    for (auto body : bodies)
    {
@@ -399,12 +362,97 @@ void RainOverlay::determineRainSurfaces()
          }
       }
    }
+
+   buildSurfaceColumns();
+}
+
+void RainOverlay::buildSurfaceColumns()
+{
+   const auto column_count = static_cast<int32_t>(std::max(0.0f, std::ceil(_surface_rect.size.x)));
+
+   _column_offsets.assign(static_cast<size_t>(column_count) + 1, 0);
+   _column_surfaces_px.clear();
+
+   // a column is sampled at its center, and an edge covers every column whose center lies within its x range.
+   // vertical edges are skipped, a falling drop could never cross one
+   const auto for_each_column = [this, column_count](const Edge& edge, const auto& visit)
+   {
+      const auto& left = (edge._p1_px.x < edge._p2_px.x) ? edge._p1_px : edge._p2_px;
+      const auto& right = (edge._p1_px.x < edge._p2_px.x) ? edge._p2_px : edge._p1_px;
+      if (right.x - left.x < 0.0001f)
+      {
+         return;
+      }
+
+      const auto first_column = std::max(0, static_cast<int32_t>(std::ceil(left.x - _surface_rect.position.x - 0.5f)));
+      const auto last_column = std::min(column_count - 1, static_cast<int32_t>(std::floor(right.x - _surface_rect.position.x - 0.5f)));
+      const auto slope = (right.y - left.y) / (right.x - left.x);
+
+      for (auto column = first_column; column <= last_column; column++)
+      {
+         const auto x_px = _surface_rect.position.x + static_cast<float>(column) + 0.5f;
+         visit(column, left.y + (x_px - left.x) * slope);
+      }
+   };
+
+   // count the surfaces per column first so they can go into one flat array, then sort each column
+   for (const auto& edge : _edges)
+   {
+      for_each_column(edge, [this](int32_t column, float /*y_px*/) { _column_offsets[column + 1]++; });
+   }
+
+   for (auto column = 0; column < column_count; column++)
+   {
+      _column_offsets[column + 1] += _column_offsets[column];
+   }
+
+   _column_surfaces_px.resize(_column_offsets.back());
+
+   std::vector<uint32_t> write_positions(_column_offsets.begin(), _column_offsets.end() - 1);
+   for (const auto& edge : _edges)
+   {
+      for_each_column(
+         edge,
+         [this, &write_positions](int32_t column, float y_px) { _column_surfaces_px[write_positions[column]++] = y_px; }
+      );
+   }
+
+   for (auto column = 0; column < column_count; column++)
+   {
+      std::sort(_column_surfaces_px.begin() + _column_offsets[column], _column_surfaces_px.begin() + _column_offsets[column + 1]);
+   }
+}
+
+std::optional<float> RainOverlay::findSurface(const sf::Vector2f& pos_px) const
+{
+   const auto column = static_cast<int64_t>(std::floor(pos_px.x - _surface_rect.position.x));
+   if (column < 0 || column + 1 >= static_cast<int64_t>(_column_offsets.size()))
+   {
+      return std::nullopt;
+   }
+
+   const auto begin = _column_surfaces_px.begin() + _column_offsets[column];
+   const auto end = _column_surfaces_px.begin() + _column_offsets[column + 1];
+   const auto surface = std::lower_bound(begin, end, pos_px.y);
+   if (surface == end || *surface > pos_px.y + surface_search_distance_px)
+   {
+      return std::nullopt;
+   }
+
+   return *surface;
 }
 
 void RainOverlay::setSettings(const RainSettings& settings)
 {
    _settings = settings;
 
+   // the drops are pooled, so a different drop count needs a new pool
+   if (static_cast<int32_t>(_drops.size()) != _settings._drop_count)
+   {
+      createDrops();
+      _initialized = false;
+   }
+
    if (!_settings._sound.empty())
    {
       _sound.setSamples({_settings._sound});
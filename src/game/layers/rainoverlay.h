@@ -2,6 +2,7 @@
 
 #include "constants.h"
 #include "game/audio/soundrotation.h"
+#include "game/effects/particlebatch.h"
 #include "weatheroverlay.h"
 
 #include <cstdint>
@@ -26,7 +27,7 @@ public:
       float _sound_volume = 1.0f;  //!< per-sample volume multiplier applied to the looped rain sample
    };
 
-   /// \brief state for one animated rain streak sprite.
+   /// \brief state for one animated rain streak.
    struct RainDrop
    {
       /// \brief respawns the drop at the top of the clip area with random delay.
@@ -38,8 +39,8 @@ public:
       sf::Vector2f _dir_px;
       float _length = 0.0f;
       float _age_s = 0.0f;
-      std::unique_ptr<sf::Sprite> _sprite;
-      std::vector<float> _intersections;
+      int32_t _frame = 0;                  //!< column of the streak in the rain atlas
+      std::optional<float> _surface_y_px;  //!< closest rain surface below the point the drop was spawned at
    };
 
    /// \brief splash animation state created when a drop collides with a surface.
@@ -47,7 +48,6 @@ public:
    {
       sf::Vector2f _pos_px;
       float _age_s = 0.0f;
-      std::unique_ptr<sf::Sprite> _sprite;
    };
 
    /// \brief one collidable world edge segment used for rain/surface intersection tests.
@@ -57,18 +57,18 @@ public:
       sf::Vector2f _p2_px;
    };
 
-   /// \brief creates rain drop sprites and loads the rain texture atlas.
+   /// \brief creates the rain drops and loads the rain texture atlas.
    RainOverlay();
 
    /// \brief stops the looped rain sample so it does not outlive the overlay.
    ~RainOverlay() override;
 
-   /// \brief draws active rain streaks and optional splash sprites.
+   /// \brief draws active rain streaks and optional splashes.
    /// \param target SFML render target used for rain rendering.
    /// \param normal unused normal-map target required by the weather overlay interface.
    void draw(sf::RenderTarget& target, sf::RenderTarget& /*normal*/) override;
 
-   /// \brief draws active rain streaks and optional splash sprites with explicit render states.
+   /// \brief draws active rain streaks and optional splashes with explicit render states.
    /// \param target SFML render target used for rain rendering.
    /// \param normal unused normal-map target required by the weather overlay interface.
    /// \param states render states carrying the level view and, under vrsfml, the rain texture.
@@ -87,9 +87,25 @@ public:
    void setAudioEnabled(bool audio_enabled) override;
 
 private:
+   /// \brief creates the drop pool with the configured number of drops.
+   void createDrops();
+
    /// \brief rebuilds collidable rain surface segments from nearby box2d chain shapes.
    void determineRainSurfaces();
 
+   /// \brief bakes the rain surface segments into one sorted list of surface heights per pixel column.
+   void buildSurfaceColumns();
+
+   /// \brief looks up the closest rain surface below a point.
+   /// \param pos_px point in pixels, usually where a drop starts falling.
+   /// \return surface y in pixels, nothing if no surface is within reach of the drop.
+   std::optional<float> findSurface(const sf::Vector2f& pos_px) const;
+
+   /// \brief draws rain streaks and splashes as one batch from the rain atlas.
+   /// \param target SFML render target used for rain rendering.
+   /// \param states render states carrying the blend mode and, under vrsfml, the level view.
+   void drawBatch(sf::RenderTarget& target, const sf::RenderStates& states);
+
    /// \brief stops the looped rain sample if it is currently playing.
    void stopPlaying();
 
@@ -103,7 +119,15 @@ private:
    std::shared_ptr<sf::Texture> _texture;
    std::vector<Edge> _edges;
 
+   //!< the surfaces as a heightfield over _surface_rect, one column per pixel. column i owns the range
+   //!< [_column_offsets[i], _column_offsets[i + 1]) of _column_surfaces_px, sorted top to bottom, so finding
+   //!< where a drop lands is a binary search rather than an intersection test against every edge
+   sf::FloatRect _surface_rect;
+   std::vector<uint32_t> _column_offsets;
+   std::vector<float> _column_surfaces_px;
+
    std::vector<DropHit> _hits;
+   ParticleBatch _batch;
    Winding _winding = Winding::Clockwise;
 
    RainSettings _settings;
@@ -0,0 +1,207 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "game/constants.h"
+#include "game/level/chunk.h"
+
+/// \brief persistent chunk-keyed spatial index over level objects.
+///
+/// Culling used to be done by asking every object whether one of its chunks is close to the player's
+/// chunk, every step, for every pass. That is a scan over the whole level before any real work is done.
+/// The index buckets every object by the chunks it covers once, at load time, so a pass only has to look
+/// at the cells around the player. Objects without chunks are never culled, they are kept in a list of
+/// their own and are part of every query.
+///
+/// Queries return the objects in the order they were added, so moving from the linear scan to the index
+/// does not change the order mechanisms are updated in. The last result is cached and reused for as
+/// long as neither the player's chunk nor the index changes, which is the common case by far.
+///
+/// The index does not own anything, the caller keeps the objects alive and removes them before they go.
+///
+/// \tparam T type of the indexed objects.
+template <typename T>
+class ChunkIndex
+{
+public:
+   /// \brief adds an object to the index.
+   /// \param item object to add.
+   /// \param chunks chunks covered by the object; when empty, the object is part of every query.
+   void add(T* item, const std::vector<Chunk>& chunks)
+   {
+      insert(item, chunks, _next_order++);
+   }
+
+   /// \brief re-buckets an object after its chunks changed, keeping its position in the query order.
+   /// \param item object to update; objects not in the index are added.
+   /// \param chunks chunks now covered by the object.
+   void update(T* item, const std::vector<Chunk>& chunks)
+   {
+      const auto it = _entries.find(item);
+      if (it == _entries.end())
+      {
+         add(item, chunks);
+         return;
+      }
+
+      const auto order = it->second._order;
+      erase(item);
+      insert(item, chunks, order);
+   }
+
+   /// \brief removes an object from the index.
+   /// \param item object to remove.
+   void remove(T* item)
+   {
+      erase(item);
+   }
+
+   /// \brief removes all objects from the index.
+   void clear()
+   {
+      _cells.clear();
+      _entries.clear();
+      _unchunked.clear();
+      _result.clear();
+      _result_chunk.reset();
+      _next_order = 0;
+      _revision++;
+   }
+
+   /// \brief returns the number of indexed objects.
+   /// \return object count.
+   size_t size() const
+   {
+      return _entries.size();
+   }
+
+   /// \brief collects all objects within CHUNK_ALLOWED_DELTA_X/Y of a chunk plus all objects without chunks.
+   /// \param center chunk the neighbourhood is centered on, usually the player's.
+   /// \return objects in insertion order; the reference stays valid until the next query or modification.
+   const std::vector<T*>& query(const Chunk& center)
+   {
+      if (_result_chunk.has_value() && _result_chunk.value() == center && _result_revision == _revision)
+      {
+         return _result;
+      }
+
+      _scratch.clear();
+      _scratch.insert(_scratch.end(), _unchunked.begin(), _unchunked.end());
+
+      for (auto y = center._y - CHUNK_ALLOWED_DELTA_Y + 1; y < center._y + CHUNK_ALLOWED_DELTA_Y; y++)
+      {
+         for (auto x = center._x - CHUNK_ALLOWED_DELTA_X + 1; x < center._x + CHUNK_ALLOWED_DELTA_X; x++)
+         {
+            const auto cell = _cells.find(key(x, y));
+            if (cell != _cells.end())
+            {
+               _scratch.insert(_scratch.end(), cell->second.begin(), cell->second.end());
+            }
+         }
+      }
+
+      // objects spanning several cells show up once per cell
+      std::ranges::sort(_scratch, {}, &Slot::_order);
+      const auto duplicates = std::ranges::unique(_scratch, {}, &Slot::_order);
+      _scratch.erase(duplicates.begin(), duplicates.end());
+
+      _result.clear();
+      _result.reserve(_scratch.size());
+      std::ranges::transform(_scratch, std::back_inserter(_result), &Slot::_item);
+
+      _result_chunk = center;
+      _result_revision = _revision;
+      return _result;
+   }
+
+private:
+   struct Slot
+   {
+      int64_t _order{0};
+      T* _item{nullptr};
+   };
+
+   struct Entry
+   {
+      int64_t _order{0};
+      std::vector<int64_t> _cell_keys;
+   };
+
+   static int64_t key(int32_t x, int32_t y)
+   {
+      return (static_cast<int64_t>(x) << 32) | static_cast<uint32_t>(y);
+   }
+
+   void insert(T* item, const std::vector<Chunk>& chunks, int64_t order)
+   {
+      auto& entry = _entries[item];
+      entry._order = order;
+
+      if (chunks.empty())
+      {
+         const auto pos = std::ranges::lower_bound(_unchunked, order, {}, &Slot::_order);
+         _unchunked.insert(pos, {order, item});
+      }
+      else
+      {
+         for (const auto& chunk : chunks)
+         {
+            const auto cell_key = key(chunk._x, chunk._y);
+            if (std::ranges::find(entry._cell_keys, cell_key) != entry._cell_keys.end())
+            {
+               continue;
+            }
+
+            entry._cell_keys.push_back(cell_key);
+            _cells[cell_key].push_back({order, item});
+         }
+      }
+
+      _revision++;
+   }
+
+   void erase(T* item)
+   {
+      const auto it = _entries.find(item);
+      if (it == _entries.end())
+      {
+         return;
+      }
+
+      const auto is_item = [item](const Slot& slot) { return slot._item == item; };
+
+      if (it->second._cell_keys.empty())
+      {
+         std::erase_if(_unchunked, is_item);
+      }
+
+      for (const auto cell_key : it->second._cell_keys)
+      {
+         auto cell = _cells.find(cell_key);
+         std::erase_if(cell->second, is_item);
+         if (cell->second.empty())
+         {
+            _cells.erase(cell);
+         }
+      }
+
+      _entries.erase(it);
+      _revision++;
+   }
+
+   std::unordered_map<int64_t, std::vector<Slot>> _cells;
+   std::unordered_map<T*, Entry> _entries;
+   std::vector<Slot> _unchunked;
+   int64_t _next_order{0};
+   uint64_t _revision{0};
+
+   std::vector<Slot> _scratch;
+   std::vector<T*> _result;
+   std::optional<Chunk> _result_chunk;
+   uint64_t _result_revision{0};
+};
@@ -0,0 +1,312 @@
+#include "compiledlevel.h"
+
+#include "framework/tmxparser/tmxobject.h"
+#include "framework/tmxparser/tmxobjectgroup.h"
+#include "framework/tmxparser/tmxparser.h"
+#include "framework/tmxparser/tmxtileset.h"
+#include "framework/tools/binarystream.h"
+#include "framework/tools/checksum.h"
+#include "framework/tools/log.h"
+#include "framework/tools/mappedfile.h"
+#include "game/physics/staticchainbake.h"
+
+#include <fstream>
+#include <set>
+#include <system_error>
+
+namespace
+{
+constexpr uint32_t compiled_level_magic = 0x564c4344;  // 'DCLV'
+
+// bump whenever the layout of the file or of any serialized tmx element changes
+constexpr uint32_t compiled_level_version = 2;
+
+constexpr size_t payload_alignment = sizeof(uint32_t);
+}  // namespace
+
+std::filesystem::path CompiledLevel::getCompiledPath(const std::filesystem::path& tmx_path)
+{
+   return tmx_path.string() + ".compiled";
+}
+
+bool CompiledLevel::readStamp(const std::filesystem::path& path, SourceStamp& stamp)
+{
+   std::error_code error;
+   const auto size = std::filesystem::file_size(path, error);
+   if (error)
+   {
+      return false;
+   }
+
+   const auto write_time = std::filesystem::last_write_time(path, error);
+   if (error)
+   {
+      return false;
+   }
+
+   stamp._path = path.generic_string();
+   stamp._size = static_cast<uint64_t>(size);
+   stamp._write_time = static_cast<int64_t>(write_time.time_since_epoch().count());
+   return true;
+}
+
+std::vector<std::filesystem::path>
+CompiledLevel::collectSources(const std::filesystem::path& tmx_path, const TmxParser& tmx_parser) const
+{
+   std::set<std::filesystem::path> sources;
+   sources.insert(tmx_path);
+
+   const auto base_path = tmx_path.parent_path();
+   for (const auto& element : tmx_parser.getElements())
+   {
+      if (element->_type == TmxElement::Type::TypeTileSet)
+      {
+         // tilesets embedded into the tmx have no file of their own
+         const auto tileset = std::dynamic_pointer_cast<TmxTileSet>(element);
+         if (!tileset->_source.empty())
+         {
+            sources.insert(tileset->_path);
+         }
+      }
+      else if (element->_type == TmxElement::Type::TypeObjectGroup)
+      {
+         const auto object_group = std::dynamic_pointer_cast<TmxObjectGroup>(element);
+         for (const auto& [key, object] : object_group->_objects)
+         {
+            if (object->_template_name.has_value())
+            {
+               sources.insert((base_path / object->_template_name.value()).lexically_normal());
+            }
+         }
+      }
+   }
+
+   sources.insert(_extra_sources.begin(), _extra_sources.end());
+   return {sources.begin(), sources.end()};
+}
+
+bool CompiledLevel::load(const std::filesystem::path& tmx_path, TmxParser& tmx_parser)
+{
+   clear();
+
+   const auto compiled_path = getCompiledPath(tmx_path);
+   if (!std::filesystem::exists(compiled_path))
+   {
+      return false;
+   }
+
+   MappedFile file;
+   if (!file.open(compiled_path))
+   {
+      return false;
+   }
+
+   BinaryReader header(file.getData(), file.getSize());
+   if (header.read<uint32_t>() != compiled_level_magic || header.read<uint32_t>() != compiled_level_version)
+   {
+      Log::Info() << "compiled level " << compiled_path << " has an outdated format";
+      return false;
+   }
+
+   const auto source_count = header.read<uint32_t>();
+   for (auto i = 0u; i < source_count && header.isValid(); i++)
+   {
+      SourceStamp recorded;
+      recorded._path = header.readString();
+      recorded._size = header.read<uint64_t>();
+      recorded._write_time = header.read<int64_t>();
+
+      SourceStamp current;
+      if (!readStamp(recorded._path, current) || current._size != recorded._size || current._write_time != recorded._write_time)
+      {
+         Log::Info() << "compiled level " << compiled_path << " is outdated, " << recorded._path << " has changed";
+         return false;
+      }
+   }
+
+   const auto payload_size = header.read<uint64_t>();
+   const auto payload_checksum = header.read<uint32_t>();
+
+   if (!header.isValid() || payload_size != file.getSize() - header.getPosition())
+   {
+      Log::Warning() << "compiled level " << compiled_path << " is truncated";
+      return false;
+   }
+
+   const auto* payload = file.getData() + header.getPosition();
+   if (Checksum::calcChecksum(payload, payload_size) != payload_checksum)
+   {
+      Log::Warning() << "compiled level " << compiled_path << " is damaged";
+      return false;
+   }
+
+   BinaryReader reader(payload, payload_size);
+   if (!tmx_parser.readBinary(tmx_path.string(), reader))
+   {
+      return false;
+   }
+
+   const auto layer_count = reader.read<uint32_t>();
+   for (auto i = 0u; i < layer_count && reader.isValid(); i++)
+   {
+      const auto layer_name = reader.readString();
+      auto& chains = _chains[layer_name];
+      const auto chain_count = reader.read<uint32_t>();
+      for (auto j = 0u; j < chain_count && reader.isValid(); j++)
+      {
+         chains.push_back(reader.readVector<b2Vec2>());
+      }
+
+      auto& group_sizes = _chain_groups[layer_name];
+      group_sizes = reader.readVector<uint32_t>();
+      if (reader.isValid() && !StaticChainBake::isValid(group_sizes, chains.size()))
+      {
+         clear();
+         return false;
+      }
+   }
+
+   const auto raster_size = reader.read<uint64_t>();
+   const auto raster_bits = reader.readVector<uint8_t>();
+   if (!reader.isValid() || raster_bits.size() != (raster_size + 7) / 8)
+   {
+      clear();
+      return false;
+   }
+
+   _level_map_raster.resize(raster_size);
+   for (auto i = 0u; i < raster_size; i++)
+   {
+      _level_map_raster[i] = (raster_bits[i / 8] >> (i % 8)) & 1;
+   }
+
+   _loaded = true;
+   return true;
+}
+
+void CompiledLevel::save(const std::filesystem::path& tmx_path, const TmxParser& tmx_parser) const
+{
+   BinaryWriter payload;
+   tmx_parser.writeBinary(payload);
+
+   payload.write(static_cast<uint32_t>(_chains.size()));
+   for (const auto& [layer_name, chains] : _chains)
+   {
+      payload.writeString(layer_name);
+      payload.write(static_cast<uint32_t>(chains.size()));
+      for (const auto& chain : chains)
+      {
+         payload.writeVector(chain);
+      }
+
+      const auto group_it = _chain_groups.find(layer_name);
+      payload.writeVector((group_it != _chain_groups.end()) ? group_it->second : std::vector<uint32_t>{});
+   }
+
+   // the raster has a few hundred thousand cells for large levels, one bit each is plenty
+   std::vector<uint8_t> raster_bits((_level_map_raster.size() + 7) / 8, 0);
+   for (auto i = 0u; i < _level_map_raster.size(); i++)
+   {
+      if (_level_map_raster[i])
+      {
+         raster_bits[i / 8] |= static_cast<uint8_t>(1u << (i % 8));
+      }
+   }
+   payload.write(static_cast<uint64_t>(_level_map_raster.size()));
+   payload.writeVector(raster_bits);
+
+   // the checksum sums whole words, padding makes sure it covers the last bytes as well
+   payload.pad(payload_alignment);
+
+   BinaryWriter header;
+   header.write(compiled_level_magic);
+   header.write(compiled_level_version);
+
+   const auto sources = collectSources(tmx_path, tmx_parser);
+   header.write(static_cast<uint32_t>(sources.size()));
+   for (const auto& source : sources)
+   {
+      SourceStamp stamp;
+      if (!readStamp(source, stamp))
+      {
+         Log::Warning() << "not compiling level, source " << source << " is missing";
+         return;
+      }
+
+      header.writeString(stamp._path);
+      header.write(stamp._size);
+      header.write(stamp._write_time);
+   }
+
+   const auto& payload_buffer = payload.getBuffer();
+   header.write(static_cast<uint64_t>(payload_buffer.size()));
+   header.write(Checksum::calcChecksum(payload_buffer.data(), payload_buffer.size()));
+
+   // like the other generated level files this is best effort, the level might live on a read-only filesystem
+   const auto compiled_path = getCompiledPath(tmx_path);
+   std::ofstream file(compiled_path, std::ofstream::binary | std::ofstream::trunc);
+   file.write(header.getBuffer().data(), static_cast<std::streamsize>(header.getBuffer().size()));
+   file.write(payload_buffer.data(), static_cast<std::streamsize>(payload_buffer.size()));
+   file.close();
+
+   if (!file)
+   {
+      Log::Warning() << "could not write compiled level " << compiled_path;
+      std::error_code remove_error;
+      std::filesystem::remove(compiled_path, remove_error);
+      return;
+   }
+
+   Log::Info() << "wrote compiled level " << compiled_path << " (" << (header.getBuffer().size() + payload_buffer.size()) << " bytes)";
+}
+
+bool CompiledLevel::isLoaded() const
+{
+   return _loaded;
+}
+
+const std::vector<std::vector<b2Vec2>>* CompiledLevel::getChains(const std::string& layer_name) const
+{
+   const auto it = _chains.find(layer_name);
+   return (it != _chains.end()) ? &it->second : nullptr;
+}
+
+void CompiledLevel::addChain(const std::string& layer_name, const std::vector<b2Vec2>& chain)
+{
+   _chains[layer_name].push_back(chain);
+}
+
+const std::vector<uint32_t>* CompiledLevel::getChainGroups(const std::string& layer_name) const
+{
+   const auto it = _chain_groups.find(layer_name);
+   return (it != _chain_groups.end()) ? &it->second : nullptr;
+}
+
+void CompiledLevel::setChainGroups(const std::string& layer_name, const std::vector<uint32_t>& group_sizes)
+{
+   _chain_groups[layer_name] = group_sizes;
+}
+
+void CompiledLevel::addSource(const std::filesystem::path& path)
+{
+   _extra_sources.push_back(path);
+}
+
+const std::vector<bool>& CompiledLevel::getLevelMapRaster() const
+{
+   return _level_map_raster;
+}
+
+void CompiledLevel::setLevelMapRaster(const std::vector<bool>& raster)
+{
+   _level_map_raster = raster;
+}
+
+void CompiledLevel::clear()
+{
+   _loaded = false;
+   _extra_sources.clear();
+   _chains.clear();
+   _chain_groups.clear();
+   _level_map_raster.clear();
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "box2d/box2d.h"
+
+class TmxParser;
+
+/// \brief binary snapshot of everything a level load derives from its tmx file.
+///
+/// parsing the tmx xml, decoding the csv tile layers and reading the optimized physics obj files are the
+/// bulk of a level's load time, and all of it produces the same result as long as the sources do not
+/// change. after a regular load the results are written to '<level>.tmx.compiled': the tmx elements
+/// (tile layers as raw tile id arrays, object groups, tilesets and image layers), the physics chains per
+/// layer as they were added to the world together with how they are grouped into static bodies, and
+/// the raster of the level map. the next load maps that file into memory and restores everything from
+/// it instead.
+///
+/// the file is only used when its format version matches and every source it was built from - the tmx,
+/// external tilesets, object templates and the optimized obj files - still has the recorded size and
+/// modification time. a checksum over the payload catches truncated or otherwise damaged files. in any
+/// other case the level is loaded from its sources and the file is written again.
+class CompiledLevel
+{
+public:
+   /// \brief tries to restore a level from its compiled file.
+   /// \param tmx_path path of the level's tmx file.
+   /// \param tmx_parser parser to restore the tmx elements into.
+   /// \return true when the compiled file was valid and up to date and everything was restored.
+   bool load(const std::filesystem::path& tmx_path, TmxParser& tmx_parser);
+
+   /// \brief writes the compiled file for a level that has just been loaded from its sources.
+   /// \param tmx_path path of the level's tmx file.
+   /// \param tmx_parser parser that parsed the tmx file.
+   void save(const std::filesystem::path& tmx_path, const TmxParser& tmx_parser) const;
+
+   /// \brief returns whether the level was restored from its compiled file.
+   /// \return true after a successful load.
+   bool isLoaded() const;
+
+   /// \brief returns the restored physics chains of a layer.
+   /// \param layer_name name of the physics layer.
+   /// \return chains in box2d units, nullptr when the layer has none.
+   const std::vector<std::vector<b2Vec2>>* getChains(const std::string& layer_name) const;
+
+   /// \brief records a physics chain while loading from the sources.
+   /// \param layer_name name of the physics layer.
+   /// \param chain chain in box2d units, as added to the world.
+   void addChain(const std::string& layer_name, const std::vector<b2Vec2>& chain);
+
+   /// \brief returns how the restored physics chains of a layer are grouped into static bodies.
+   /// \param layer_name name of the physics layer.
+   /// \return number of chains per body in chain order, nullptr when the layer has none.
+   const std::vector<uint32_t>* getChainGroups(const std::string& layer_name) const;
+
+   /// \brief records how the chains of a layer are grouped into static bodies while loading from the sources.
+   /// \param layer_name name of the physics layer.
+   /// \param group_sizes number of chains per body in chain order.
+   void setChainGroups(const std::string& layer_name, const std::vector<uint32_t>& group_sizes);
+
+   /// \brief records a physics source file, e.g. an optimized obj, so changing it invalidates the compiled file.
+   /// \param path path of the source file.
+   void addSource(const std::filesystem::path& path);
+
+   /// \brief returns the restored level map raster.
+   /// \return walkable cells at base resolution, empty when there is none.
+   const std::vector<bool>& getLevelMapRaster() const;
+
+   /// \brief records the level map raster while loading from the sources.
+   /// \param raster walkable cells at base resolution.
+   void setLevelMapRaster(const std::vector<bool>& raster);
+
+   /// \brief drops all restored or recorded data.
+   void clear();
+
+private:
+   struct SourceStamp
+   {
+      std::string _path;
+      uint64_t _size = 0;
+      int64_t _write_time = 0;
+   };
+
+   static std::filesystem::path getCompiledPath(const std::filesystem::path& tmx_path);
+   static bool readStamp(const std::filesystem::path& path, SourceStamp& stamp);
+   std::vector<std::filesystem::path> collectSources(const std::filesystem::path& tmx_path, const TmxParser& tmx_parser) const;
+
+   bool _loaded = false;
+   std::vector<std::filesystem::path> _extra_sources;
+   std::map<std::string, std::vector<std::vector<b2Vec2>>> _chains;
+   std::map<std::string, std::vector<uint32_t>> _chain_groups;
+   std::vector<bool> _level_map_raster;
+};
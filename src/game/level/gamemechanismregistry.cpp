@@ -117,6 +117,10 @@ void GameMechanismRegistry::resetDoors()
    {
       door.reset();
    }
+
+   _search_index_built = false;
+   _search_index.clear();
+   _search_index_by_group.clear();
 }
 
 void GameMechanismRegistry::addImageLayer(const std::shared_ptr<ImageLayer>& image_layer)
@@ -190,12 +194,63 @@ GameMechanismRegistry::MechanismVector GameMechanismRegistry::searchMechanismsIf
           std::views::join | std::ranges::to<GameMechanismRegistry::MechanismVector>();
 }
 
+void GameMechanismRegistry::buildSearchIndex()
+{
+   _search_index.clear();
+   _search_index_by_group.clear();
+
+   // same order as the scan in searchMechanisms so both give the same results
+   for (const auto& [key, mechanism_vector] : _mechanisms_map)
+   {
+      auto& group_index = _search_index_by_group[key];
+      for (const auto& mechanism : *mechanism_vector)
+      {
+         auto* node = dynamic_cast<GameNode*>(mechanism.get());
+         if (!node)
+         {
+            continue;
+         }
+
+         group_index[node->getObjectId()].push_back(mechanism);
+         _search_index[node->getObjectId()].push_back(mechanism);
+      }
+   }
+
+   auto& image_layer_index = _search_index_by_group["imagelayers"];
+   for (const auto& image_layer : _image_layers)
+   {
+      image_layer_index[image_layer->getObjectId()].push_back(image_layer);
+      _search_index[image_layer->getObjectId()].push_back(image_layer);
+   }
+
+   _search_index_built = true;
+}
+
 GameMechanismRegistry::MechanismVector
 GameMechanismRegistry::searchMechanisms(const std::string& regex_pattern, const std::optional<std::string>& group)
 {
+   // level scripts mostly address single mechanisms by their id, those don't need a regex at all
+   if (_search_index_built && RegexCache::isLiteral(regex_pattern))
+   {
+      const SearchIndex* index = &_search_index;
+      if (group.has_value())
+      {
+         const auto group_it = _search_index_by_group.find(group.value());
+         if (group_it == _search_index_by_group.end())
+         {
+            return {};
+         }
+
+         index = &group_it->second;
+      }
+
+      const auto it = index->find(regex_pattern);
+      return (it != index->end()) ? it->second : MechanismVector{};
+   }
+
    GameMechanismRegistry::MechanismVector results;
 
-   std::regex pattern(regex_pattern);
+   const auto& pattern = _regex_cache.get(regex_pattern);
    for (const auto& [key, mechanism_vector] : _mechanisms_map)
    {
       // filter by mechanism group if requested
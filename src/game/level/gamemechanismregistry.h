@@ -2,8 +2,11 @@
 #define GAMEMECHANISMREGISTRY_H
 
 #include <memory>
+#include <optional>
+#include <unordered_map>
 #include <vector>
 
+#include "framework/tools/regexcache.h"
 #include "game/mechanisms/gamemechanism.h"
 #include "game/mechanisms/imagelayer.h"
 
@@ -58,13 +61,20 @@ public:
    std::vector<std::shared_ptr<ImageLayer>> getImageLayers() const;
 
    /// \brief clears all stored door pointers.
+   /// \details drops the search index as well since it still refers to the doors.
    void resetDoors();
 
    /// \brief stores an image layer loaded from TMX.
    /// \param image_layer image layer instance to append.
    void addImageLayer(const std::shared_ptr<ImageLayer>& image_layer);
 
+   /// \brief indexes all mechanisms and image layers by object id, once per group and once overall.
+   /// \details to be called once all mechanisms are loaded; until then, and after resetDoors, searches scan every mechanism.
+   void buildSearchIndex();
+
    /// \brief finds mechanisms by object id regular expression and optional mechanism group.
+   /// \details patterns without regex meta characters are answered from the search index, all others are matched
+   /// against every object id using a cached compiled pattern.
    /// \param regexp regular expression matched against GameNode object ids.
    /// \param group optional group key from the mechanism map, or "imagelayers" for image layers.
    /// \return mechanisms and image layers that match the filter criteria.
@@ -79,6 +89,13 @@ public:
    std::vector<std::shared_ptr<GameMechanism>> searchMechanismsIf(const MechanismPredicate& predicate) const;
 
 private:
+   using SearchIndex = std::unordered_map<std::string, MechanismVector>;
+
+   bool _search_index_built{false};
+   SearchIndex _search_index;                                            //!< object id to mechanisms, over all groups
+   std::unordered_map<std::string, SearchIndex> _search_index_by_group;  //!< group key to object id to mechanisms
+   RegexCache _regex_cache;
+
    MechanismVectorMap _mechanisms_map;
    std::vector<MechanismVector*> _mechanisms_list;
    MechanismVector _mechanism_blocking_rects;
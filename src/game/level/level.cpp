@@ -8,6 +8,7 @@
 #include "framework/tmxparser/tmxobjectgroup.h"
 #include "framework/tmxparser/tmxparser.h"
 #include "framework/tmxparser/tmxtileset.h"
+#include "framework/tools/asynctask.h"
 #include "framework/tools/checksum.h"
 #include "framework/tools/log.h"
 #include "framework/tools/sfmlcompat.h"
@@ -25,10 +26,12 @@
 #include "game/debug/drawcallcounter.h"
 #include "game/ingamemenu/ingamemenumap.h"
 #include "game/io/gamedeserializedata.h"
-#include "game/io/meshtools.h"
+#include "game/io/objfile.h"
+#include "game/io/texturestreamer.h"
 #include "game/level/fixturenode.h"
 #include "game/level/leveldescription.h"
 #include "game/level/levelfiles.h"
+#include "game/level/levelpreloader.h"
 #include "game/level/leveltransitionhandler.h"
 #include "game/level/luainterface.h"
 #include "game/level/parsedata.h"
@@ -48,6 +51,7 @@
 #include "game/physics/physicsconfiguration.h"
 #include "game/physics/renderinterpolation.h"
 #include "game/physics/squaremarcher.h"
+#include "game/physics/staticchainbake.h"
 #include "game/player/player.h"
 #include "game/player/playerfirefly.h"
 #include "game/player/playerregistry.h"
@@ -69,6 +73,7 @@
 #include <cstdlib>
 #include <execution>
 #include <fstream>
+#include <future>
 #include <iomanip>
 #include <iostream>
 #include <ranges>
@@ -94,10 +99,10 @@ struct MechanismTiming
    int32_t update_count{0};
    int32_t draw_count{0};
 
-   void addUpdateTime(HighResDuration duration)
+   void addUpdateTime(HighResDuration duration, int32_t count = 1)
    {
       update_duration += duration;
-      update_count++;
+      update_count += count;
    }
 
    void addDrawTime(HighResDuration duration)
@@ -224,7 +229,7 @@ Level::~Level()
    // stop active timers because their callbacks being called after destruction of the level/world can be nasty
    for (const auto& enemy : LuaInterface::instance().getObjectList())
    {
-      Timer::removeByCaller(enemy);
+      Timer::removeByCaller(enemy.get());
    }
 
 #ifndef DECEPTUS_VRSFML
@@ -262,7 +267,22 @@ void Level::assignMechanismsToRooms()
    }
 }
 
-void Level::loadTmx()
+void Level::buildMechanismChunkIndex()
+{
+   // mechanisms are added group by group, which keeps the update order the linear scan had
+   _mechanism_chunk_index.clear();
+   for (const auto* mechanism_vector : _mechanism_registry.getList())
+   {
+      for (const auto& mechanism : *mechanism_vector)
+      {
+         _mechanism_chunk_index.add(mechanism.get(), mechanism->getChunks());
+      }
+   }
+
+   Log::Info() << "indexed " << _mechanism_chunk_index.size() << " mechanisms by chunk";
+}
+
+void Level::loadTmx(LevelLoadingTimings& timings)
 {
    static const std::string parallax_identifier = "parallax_";
    const auto path = std::filesystem::path(_description->_filename).parent_path();
@@ -280,34 +300,32 @@ void Level::loadTmx()
    }
 #endif
 
-   sf::Clock elapsed;
-
-   // parse tmx
+   // parse tmx, or restore it along with the physics chains and the level map from the compiled level
    TmxParser tmx_parser;
-   Log::Info() << "parsing tmx: " << _description->_filename;
-   tmx_parser.parse(_description->_filename);
-   Log::Info() << "parsing tmx, done within " << elapsed.getElapsedTime().asSeconds() << "s";
-
-   Log::info("loading tmx... ");
-   elapsed.restart();
-
-   GameDeserializeData data;
-   data._world = _world;
-   data._base_path = path;
-
-   GameMechanismDeserializer::deserialize(tmx_parser, this, data, _mechanism_registry.getMap());
-
-   // preload mechanism data in parallel
-   for (auto& [vec_key, vec_values] : _mechanism_registry.getMap())
-   {
-#if defined(__APPLE__) || defined(DECEPTUS_VRSFML)
-      std::for_each(vec_values->begin(), vec_values->end(), [](auto& val) { val->preload(); });
-#else
-      std::for_each(std::execution::par, vec_values->begin(), vec_values->end(), [](auto& val) { val->preload(); });
-#endif
-   }
+   timings.measure(
+      "parse tmx",
+      [&]()
+      {
+         // a level entered through a level transition has usually been parsed in the background already
+         auto preloaded = LevelPreloader::getInstance().take(_description_filename, _description->_filename);
+         if (preloaded && _loading_mode != LoadingMode::Clean)
+         {
+            Log::Info() << "using preloaded tmx: " << _description->_filename;
+            tmx_parser = std::move(preloaded->_tmx_parser);
+            _compiled_level = std::move(preloaded->_compiled_level);
+         }
+         else if (_loading_mode != LoadingMode::Clean && _compiled_level.load(_description->_filename, tmx_parser))
+         {
+            Log::Info() << "restored compiled tmx: " << _description->_filename;
+         }
+         else
+         {
+            Log::Info() << "parsing tmx: " << _description->_filename;
+            tmx_parser.parse(_description->_filename);
+         }
+      }
+   );
 
-   // process everything that's not considered a mechanism
    const auto& tmx_elements = tmx_parser.getElements();
 
    // collect all layer data first for parallel loading
@@ -322,151 +340,251 @@ void Level::loadTmx()
 
    for (const auto& element : tmx_elements)
    {
-      data._tmx_layer = nullptr;
-      data._tmx_tileset = nullptr;
-      data._tmx_object = nullptr;
-      data._tmx_object_group = nullptr;
+      if (element->_type != TmxElement::Type::TypeLayer)
+      {
+         continue;
+      }
 
-      // parse sprites
-      if (element->_type == TmxElement::Type::TypeLayer)
+      auto layer = std::dynamic_pointer_cast<TmxLayer>(element);
+      if (GameMechanismDeserializer::isLayerNameReserved(layer->_name))
       {
-         auto layer = std::dynamic_pointer_cast<TmxLayer>(element);
-         if (GameMechanismDeserializer::isLayerNameReserved(layer->_name))
-         {
-            continue;
-         }
+         continue;
+      }
+
+      const auto tileset = tmx_parser.getTileSet(layer);
+      auto tile_map = TileMapFactory::makeTileMap(layer);
+      layer_load_data.push_back({layer, tileset, tile_map, true});
+   }
 
-         const auto tileset = tmx_parser.getTileSet(layer);
+   // tile maps and physics outlines only depend on the tmx data, so both are built on worker threads while
+   // the main thread deserializes the mechanisms. the workers only decode images; textures are created in
+   // TileMap::upload, and everything that touches the box2d world stays on the main thread
+   auto tile_map_stage = startAsyncTask(
+      [&timings, &layer_load_data, &path]()
+      {
+         timings.measure(
+            "tile maps",
+            [&]()
+            {
+#if defined(__APPLE__) || defined(DECEPTUS_VRSFML)
+               std::for_each(
+                  layer_load_data.begin(),
+                  layer_load_data.end(),
+                  [&path](auto& layer_data) { layer_data.tile_map->load(layer_data.layer, layer_data.tileset, path); }
+               );
+#else
+               std::for_each(
+                  std::execution::par,
+                  layer_load_data.begin(),
+                  layer_load_data.end(),
+                  [&path](auto& layer_data) { layer_data.tile_map->load(layer_data.layer, layer_data.tileset, path); }
+               );
+#endif
+            }
+         );
+      }
+   );
 
-         data._tmx_layer = layer;
-         data._tmx_tileset = tileset;
+   std::vector<std::pair<std::shared_ptr<TmxLayer>, std::shared_ptr<TmxTileSet>>> physics_sources;
+   for (const auto& layer_data : layer_load_data)
+   {
+      physics_sources.emplace_back(layer_data.layer, layer_data.tileset);
+   }
 
-         auto tile_map = TileMapFactory::makeTileMap(layer);
-         layer_load_data.push_back({layer, tileset, tile_map, true});
+   auto physics_stage = startAsyncTask(
+      [this, &timings, physics_sources, &path]()
+      {
+         return timings.measure(
+            "physics paths",
+            [&]()
+            {
+               std::vector<PhysicsLayer> physics_layers;
+               for (const auto& [layer, tileset] : physics_sources)
+               {
+                  auto physics_layer = preparePhysicsLayer(layer, tileset, path);
+                  if (physics_layer.has_value())
+                  {
+                     physics_layers.push_back(std::move(physics_layer.value()));
+                  }
+               }
+               return physics_layers;
+            }
+         );
       }
+   );
+
+   GameDeserializeData data;
+   data._world = _world;
+   data._base_path = path;
 
-      // parse objects
-      else if (element->_type == TmxElement::Type::TypeObjectGroup)
+   timings.measure("mechanisms", [&]() { GameMechanismDeserializer::deserialize(tmx_parser, this, data, _mechanism_registry.getMap()); });
+
+   // preload mechanism data in parallel
+   timings.measure(
+      "mechanism preload",
+      [&]()
       {
-         const auto object_group = std::dynamic_pointer_cast<TmxObjectGroup>(element);
+         for (auto& [vec_key, vec_values] : _mechanism_registry.getMap())
+         {
+#if defined(__APPLE__) || defined(DECEPTUS_VRSFML)
+            std::for_each(vec_values->begin(), vec_values->end(), [](auto& val) { val->preload(); });
+#else
+            std::for_each(std::execution::par, vec_values->begin(), vec_values->end(), [](auto& val) { val->preload(); });
+#endif
+         }
+      }
+   );
 
-         for (const auto& object : object_group->_objects)
+   // process everything that's not considered a mechanism
+   timings.measure(
+      "objects and image layers",
+      [&]()
+      {
+         for (const auto& element : tmx_elements)
          {
-            const auto tmx_object = object.second;
-            data._tmx_object = tmx_object;
-            data._tmx_object_group = object_group;
+            data._tmx_layer = nullptr;
+            data._tmx_tileset = nullptr;
+            data._tmx_object = nullptr;
+            data._tmx_object_group = nullptr;
 
-            if (object_group->_name == "enemies")
+            // parse objects
+            if (element->_type == TmxElement::Type::TypeObjectGroup)
             {
-               TmxEnemy enemy;
-               enemy.parse(tmx_object);
-               _enemy_data_from_tmx_layer[enemy._id] = enemy;
+               const auto object_group = std::dynamic_pointer_cast<TmxObjectGroup>(element);
+
+               for (const auto& object : object_group->_objects)
+               {
+                  const auto tmx_object = object.second;
+                  data._tmx_object = tmx_object;
+                  data._tmx_object_group = object_group;
+
+                  if (object_group->_name == "enemies")
+                  {
+                     TmxEnemy enemy;
+                     enemy.parse(tmx_object);
+                     _enemy_data_from_tmx_layer[enemy._id] = enemy;
+                  }
+                  else if (object_group->_name == "rooms")
+                  {
+                     Room::deserialize(this, data, _rooms);
+                  }
+                  else if (object_group->_name == "lights")
+                  {
+                     const auto light = LightSystem::createLightInstance(this, data);
+                     _light_system->_lights.push_back(light);
+                  }
+               }
             }
-            else if (object_group->_name == "rooms")
-            {
-               Room::deserialize(this, data, _rooms);
-            }
-            else if (object_group->_name == "lights")
+
+            // parse images
+            else if (element->_type == TmxElement::Type::TypeImageLayer)
             {
-               const auto light = LightSystem::createLightInstance(this, data);
-               _light_system->_lights.push_back(light);
+               const auto image = ImageLayer::deserialize(element, path);
+               _mechanism_registry.addImageLayer(image);
             }
          }
-      }
 
-      // parse images
-      else if (element->_type == TmxElement::Type::TypeImageLayer)
-      {
-         const auto image = ImageLayer::deserialize(element, path);
-         _mechanism_registry.addImageLayer(image);
+         // kick off background disk loads for all image layer textures so they are in RAM
+         // by the time the drain loop runs at the end of this function
+         for (auto& image_layer : _mechanism_registry.getImageLayers())
+         {
+            image_layer->preload();
+         }
       }
-   }
-
-   // kick off background disk loads for all image layer textures so they are in RAM
-   // by the time the drain loop runs at the end of this function
-   for (auto& image_layer : _mechanism_registry.getImageLayers())
-   {
-      image_layer->preload();
-   }
-
-   // load tilemaps in parallel
-#if defined(__APPLE__) || defined(DECEPTUS_VRSFML)
-   std::for_each(
-      layer_load_data.begin(),
-      layer_load_data.end(),
-      [&path](auto& layer_data) { layer_data.tile_map->load(layer_data.layer, layer_data.tileset, path); }
    );
-#else
-   std::for_each(
-      std::execution::par,
-      layer_load_data.begin(),
-      layer_load_data.end(),
-      [&path](auto& layer_data) { layer_data.tile_map->load(layer_data.layer, layer_data.tileset, path); }
-   );
-#endif
 
-   // process loaded tilemaps sequentially
-   for (auto& layer_data : layer_load_data)
-   {
-      const auto& layer = layer_data.layer;
-      const auto& tileset = layer_data.tileset;
-      const auto& tile_map = layer_data.tile_map;
+   timings.measure("wait: tile maps", [&]() { tile_map_stage.get(); });
 
-      if (layer->_name == "atmosphere")
-      {
-         _atmosphere._tile_map = tile_map;
-         _atmosphere.parse(layer, tileset);
-      }
-      else if (layer->_name.compare(0, parallax_identifier.length(), parallax_identifier) == 0)
-      {
-         auto parallax_layer = ParallaxLayer::deserialize(layer, tile_map);
-         _parallax_layers.push_back(std::move(parallax_layer));
-         layer_data.push_tile_map = false;
-      }
-      else if (layer->_name == "level" || layer->_name == "level_solid_onesided" || layer->_name == "level_deadly")
+   // process loaded tilemaps sequentially
+   timings.measure(
+      "tile map setup",
+      [&]()
       {
-         parsePhysicsTiles(layer, tileset, path);
-      }
+         for (auto& layer_data : layer_load_data)
+         {
+            const auto& layer = layer_data.layer;
+            const auto& tileset = layer_data.tileset;
+            const auto& tile_map = layer_data.tile_map;
 
-      if (layer_data.push_tile_map)
-      {
-         _tile_maps.push_back(tile_map);
-      }
-   }
+            // the tile maps were built on workers, textures and vertex buffers can only be created where the
+            // gl context is
+            tile_map->upload();
+
+            if (layer->_name == "atmosphere")
+            {
+               _atmosphere._tile_map = tile_map;
+               _atmosphere.parse(layer, tileset);
+            }
+            else if (layer->_name.compare(0, parallax_identifier.length(), parallax_identifier) == 0)
+            {
+               auto parallax_layer = ParallaxLayer::deserialize(layer, tile_map);
+               _parallax_layers.push_back(std::move(parallax_layer));
+               layer_data.push_tile_map = false;
+            }
 
-   TileMapFactory::merge(_tile_maps);
-   Room::mergeEnterAreas(_rooms);
-   Room::warnAboutAmbiguousObjectIds(_rooms);
+            if (layer_data.push_tile_map)
+            {
+               _tile_maps.push_back(tile_map);
+            }
+         }
+
+         TileMapFactory::merge(_tile_maps);
+         Room::mergeEnterAreas(_rooms);
+         Room::warnAboutAmbiguousObjectIds(_rooms);
+      }
+   );
 
    if (!_atmosphere._tile_map)
    {
       Log::Error() << "fatal: no physics layer (called 'physics') found!";
    }
 
+   const auto physics_layers = timings.measure("wait: physics paths", [&]() { return physics_stage.get(); });
+
+   timings.measure(
+      "physics world",
+      [&]()
+      {
+         for (const auto& physics_layer : physics_layers)
+         {
+            addPhysicsLayer(physics_layer);
+         }
+      }
+   );
+
    // upload all pending image layer textures to GPU before gameplay begins —
-   // background threads have been running disk I/O since the preload call above,
+   // the texture streamer has been running disk I/O since the preload call above,
    // so this loop typically only waits for GPU transfers, not disk reads
-   {
-      const auto image_layers = _mechanism_registry.getImageLayers();
-      bool any_pending = true;
-      while (any_pending)
+   timings.measure(
+      "image layer uploads",
+      [&]()
       {
-         any_pending = false;
-         for (auto& image_layer : image_layers)
+         const auto image_layers = _mechanism_registry.getImageLayers();
+         bool any_pending = true;
+         while (any_pending)
          {
-            if (image_layer->drainTextures())
+            any_pending = false;
+            TextureStreamer::getInstance().beginFrame();
+            for (auto& image_layer : image_layers)
             {
-               any_pending = true;
+               if (image_layer->drainTextures())
+               {
+                  any_pending = true;
+               }
+            }
+            if (any_pending)
+            {
+               std::this_thread::sleep_for(std::chrono::milliseconds(1));
             }
-         }
-         if (any_pending)
-         {
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
          }
       }
-   }
+   );
 
-   Log::Info() << "loading tmx, done within " << elapsed.getElapsedTime().asSeconds() << "s";
+   if (!_compiled_level.isLoaded())
+   {
+      timings.measure("write compiled level", [&]() { _compiled_level.save(_description->_filename, tmx_parser); });
+   }
+   _compiled_level.clear();
 }
 
 BoomEffect& Level::getBoomEffect()
@@ -485,9 +603,24 @@ bool Level::load()
       return false;
    }
 
-   loadTmx();
+   LevelLoadingTimings timings;
+
+   // the ambient occlusion does not depend on the tmx at all, it is loaded while the tmx is processed
+   auto ambient_occlusion_stage = startAsyncTask(
+      [this, &timings, &level_json_path]()
+      {
+         timings.measure(
+            "ambient occlusion",
+            [&]() { _ambient_occlusion->load(level_json_path.parent_path(), level_json_path.stem().string()); }
+         );
+      }
+   );
+
+   loadTmx(timings);
 
-   _ambient_occlusion->load(level_json_path.parent_path(), std::filesystem::path(_description->_filename).stem().string());
+   timings.measure("wait: ambient occlusion", [&]() { ambient_occlusion_stage.get(); });
+   timings.measure("ambient occlusion upload", [&]() { _ambient_occlusion->upload(); });
+   timings.log();
 
    Log::Info() << "level loading complete";
 
@@ -549,6 +682,8 @@ void Level::initialize()
    _mechanism_registry.getMap()[std::string{layer_name_fireflies}]->push_back(player_firefly);
 
    assignMechanismsToRooms();
+   buildMechanismChunkIndex();
+   _mechanism_registry.buildSearchIndex();
    _volume_updater->setMechanisms(_mechanism_registry.getList());
 
    loadLevelScript();
@@ -843,23 +978,14 @@ void Level::updateSpritePositions()
    // spline. Unfiltered, an uncapped frame rate would rebuild all of them several times per step
    const auto& player_chunk = PlayerRegistry::getFirst()->getChunk();
 
-   for (auto& mechanism_vector : _mechanism_registry.getList())
+   for (auto* mechanism : _mechanism_chunk_index.query(player_chunk))
    {
-      for (auto& mechanism : *mechanism_vector)
-      {
-         if (checkUpdateMechanism(player_chunk, mechanism))
-         {
-            mechanism->updateSpritePositions();
-         }
-      }
+      mechanism->updateSpritePositions();
    }
 
-   for (const auto& enemy : LuaInterface::instance().getObjectList())
+   for (auto* enemy : LuaInterface::instance().getObjectsNear(player_chunk))
    {
-      if (checkUpdateMechanism(player_chunk, enemy))
-      {
-         enemy->updateSpritePositions();
-      }
+      enemy->updateSpritePositions();
    }
 }
 
@@ -1960,31 +2086,28 @@ void Level::update(const sf::Time& dt)
    }
 #endif
 
-   for (auto* mechanism_vector : _mechanism_registry.getList())
+   // only the mechanisms in the chunks around the player, the index has done the culling already
+   for (auto* mechanism : _mechanism_chunk_index.query(player_chunk))
    {
-      for (const auto& mechanism : *mechanism_vector)
-      {
-         if (checkUpdateMechanism(player_chunk, mechanism))
-         {
 #ifdef DEVELOPMENT_MODE
-            if (_mechanism_profiling_enabled)
-            {
-               const auto mechanism_name = std::string{mechanism->objectName()};
-               const auto time_start = std::chrono::high_resolution_clock::now();
-               mechanism->update(dt);
-               timing_data[mechanism_name].addUpdateTime(std::chrono::high_resolution_clock::now() - time_start);
-            }
-            else
-            {
-               mechanism->update(dt);
-            }
+      if (_mechanism_profiling_enabled)
+      {
+         const auto mechanism_name = std::string{mechanism->objectName()};
+         const auto time_start = std::chrono::high_resolution_clock::now();
+         mechanism->update(dt);
+         timing_data[mechanism_name].addUpdateTime(std::chrono::high_resolution_clock::now() - time_start);
+      }
+      else
+      {
+         mechanism->update(dt);
+      }
 #else
-            mechanism->update(dt);
+      mechanism->update(dt);
 #endif
-         }
-      }
    }
 
+   // image layers upload their textures as they come in, a few per step
+   TextureStreamer::getInstance().beginFrame();
    for (auto& layer : _mechanism_registry.getImageLayers())
    {
       layer->update(dt);
@@ -1992,9 +2115,25 @@ void Level::update(const sf::Time& dt)
 
    _level_script.update(dt);
 
-   LuaInterface::instance().update(
-      dt, [&player_chunk](const std::shared_ptr<GameMechanism>& mechanism) { return checkUpdateMechanism(player_chunk, mechanism); }
-   );
+#ifdef DEVELOPMENT_MODE
+   if (_mechanism_profiling_enabled)
+   {
+      // the scripted enemies are stepped as a batch, so their entry shows the average cost per enemy
+      const auto enemy_count = static_cast<int32_t>(LuaInterface::instance().getObjectsNear(player_chunk).size());
+      const auto time_start = std::chrono::high_resolution_clock::now();
+      LuaInterface::instance().update(dt, player_chunk);
+      if (enemy_count > 0)
+      {
+         timing_data["LuaNode"].addUpdateTime(std::chrono::high_resolution_clock::now() - time_start, enemy_count);
+      }
+   }
+   else
+   {
+      LuaInterface::instance().update(dt, player_chunk);
+   }
+#else
+   LuaInterface::instance().update(dt, player_chunk);
+#endif
 
    updatePlayerLight();
 
@@ -2008,7 +2147,26 @@ const std::shared_ptr<b2World>& Level::getWorld() const
    return _world;
 }
 
-void Level::addChainToWorld(const std::vector<b2Vec2>& chain, ObjectType object_type)
+void Level::addChainsToWorld(const std::vector<std::vector<b2Vec2>>& chains, const std::vector<uint32_t>& group_sizes, ObjectType behavior)
+{
+   // the chains of one chunk share a static body; box2d walks every body in every step, and queries
+   // that resolve fixtures to bodies would otherwise report each small loop as a body of its own
+   b2BodyDef body_def;
+   body_def.position.Set(0, 0);
+   body_def.type = b2_staticBody;
+
+   auto chain_index = 0u;
+   for (const auto group_size : group_sizes)
+   {
+      auto body = _world->CreateBody(&body_def);
+      for (auto i = 0u; i < group_size; i++)
+      {
+         addChainToWorld(body, chains[chain_index++], behavior);
+      }
+   }
+}
+
+void Level::addChainToWorld(b2Body* body, const std::vector<b2Vec2>& chain, ObjectType object_type)
 {
    if (fabs(chain[0].x - chain[chain.size() - 1].x) < 0.001f && fabs(chain[0].y - chain[chain.size() - 1].y) < 0.001f)
    {
@@ -2028,11 +2186,6 @@ void Level::addChainToWorld(const std::vector<b2Vec2>& chain, ObjectType object_
    fixture_def.friction = 0.2f;
    fixture_def.shape = &chain_shape;
 
-   b2BodyDef body_def;
-   body_def.position.Set(0, 0);
-   body_def.type = b2_staticBody;
-
-   auto body = _world->CreateBody(&body_def);
    auto fixture = body->CreateFixture(&fixture_def);
    auto object_data = new FixtureNode(this);
    object_data->setObjectId(std::format("world_chain_{}", _world_chains.size() - 1));
@@ -2042,7 +2195,9 @@ void Level::addChainToWorld(const std::vector<b2Vec2>& chain, ObjectType object_
 
 void Level::addPathsToWorld(int32_t offset_x, int32_t offset_y, const std::vector<SquareMarcher::Path>& paths, ObjectType behavior)
 {
-   // create the physical chain with 1 body per chain
+   std::vector<std::vector<b2Vec2>> chains;
+   chains.reserve(paths.size());
+
    for (const auto& path : paths)
    {
       std::vector<b2Vec2> chain(path._scaled.size());
@@ -2054,22 +2209,24 @@ void Level::addPathsToWorld(int32_t offset_x, int32_t offset_y, const std::vecto
          [&](const auto& pos) { return b2Vec2((pos.x + offset_x) * PIXELS_PER_TILE / PPM, (pos.y + offset_y) * PIXELS_PER_TILE / PPM); }
       );
 
-      addChainToWorld(chain, behavior);
+      chains.push_back(std::move(chain));
    }
+
+   const auto group_sizes = StaticChainBake::groupByChunk(chains);
+   addChainsToWorld(chains, group_sizes, behavior);
 }
 
-void Level::parseObj(const std::shared_ptr<TmxLayer>& layer, ObjectType behavior, const std::filesystem::path& path)
+std::vector<std::vector<b2Vec2>> Level::parseObj(const std::shared_ptr<TmxLayer>& layer, const Mesh::ObjMesh& mesh) const
 {
-   std::vector<b2Vec2> points;
-   std::vector<std::vector<uint32_t>> faces;
-   Mesh::readObj(path.string(), points, faces);
-   for (const auto& face : faces)
+   std::vector<std::vector<b2Vec2>> chains;
+   chains.reserve(mesh.getFaceCount());
+
+   for (auto face_index = 0u; face_index < mesh.getFaceCount(); face_index++)
    {
       std::vector<b2Vec2> chain;
-      std::vector<sf::Vector2f> debug_path;
-      for (auto index : face)
+      for (auto index : mesh.getFace(face_index))
       {
-         const auto& p = points[index];
+         const auto& p = mesh._points[index];
          const auto v = b2Vec2{(p.x + layer->_offset_x_px) / PPM, (p.y + layer->_offset_y_px) / PPM};
 
          if (_winding == Winding::Clockwise)
@@ -2081,26 +2238,14 @@ void Level::parseObj(const std::shared_ptr<TmxLayer>& layer, ObjectType behavior
          {
             chain.push_back(v);
          }
-
-         debug_path.emplace_back(p.x / PIXELS_PER_TILE, p.y / PIXELS_PER_TILE);
       }
 
       // creating a box2d loop is automatically closing the path
       chain.pop_back();
-      addChainToWorld(chain, behavior);
-
-      // this should become a function callable from the console
-      if (false)
-      {
-         Mesh::writeVerticesToImage(
-            points,
-            faces,
-            {static_cast<int32_t>(layer->_width_tl * PIXELS_PER_TILE) / 4, static_cast<int32_t>(layer->_height_tl * PIXELS_PER_TILE) / 4},
-            path.filename().string() + "_dump.png",
-            0.25f
-         );
-      }
+      chains.push_back(std::move(chain));
    }
+
+   return chains;
 }
 
 void Level::regenerateLevelPaths(
@@ -2129,11 +2274,9 @@ void Level::regenerateLevelPaths(
    {
       Log::Error() << "dumping unoptimized obj (" << path_solid_not_optimized << ") failed";
    }
-
-   parseObj(layer, parse_data->object_type, path_solid_optimized);
 }
 
-void Level::parsePhysicsTiles(
+std::optional<Level::PhysicsLayer> Level::preparePhysicsLayer(
    const std::shared_ptr<TmxLayer>& layer,
    const std::shared_ptr<TmxTileSet>& tileset,
    const std::filesystem::path& base_path
@@ -2170,26 +2313,82 @@ void Level::parsePhysicsTiles(
 
    if (!parse_data)
    {
-      return;
+      return std::nullopt;
    }
 
-   auto path_solid_optimized = base_path / std::filesystem::path(parse_data->filename_obj_optimized);
+   PhysicsLayer physics_layer;
+   physics_layer._layer = layer;
+   physics_layer._object_type = parse_data->object_type;
+   physics_layer._obj_path = base_path / std::filesystem::path(parse_data->filename_obj_optimized);
 
-   Log::Info() << "loading: " << path_solid_optimized.make_preferred().generic_string();
+   const auto* compiled_chains = _compiled_level.getChains(layer->_name);
+   if (compiled_chains)
+   {
+      const auto* compiled_groups = _compiled_level.getChainGroups(layer->_name);
+      physics_layer._chains = *compiled_chains;
+      physics_layer._group_sizes = compiled_groups ? *compiled_groups : std::vector<uint32_t>(compiled_chains->size(), 1);
+      physics_layer._from_compiled_level = true;
+      return physics_layer;
+   }
 
-   if (std::filesystem::exists(path_solid_optimized))
+   Log::Info() << "loading: " << physics_layer._obj_path.make_preferred().generic_string();
+
+   if (!std::filesystem::exists(physics_layer._obj_path))
    {
-      parseObj(layer, parse_data->object_type, path_solid_optimized);
+      regenerateLevelPaths(layer, tileset, base_path, parse_data, physics_layer._obj_path);
    }
-   else
+
+   // the outlines feed both the physics chains and the level map, so the file is parsed once for both
+   const auto mesh = Mesh::loadObj(physics_layer._obj_path);
+   if (!mesh)
    {
-      regenerateLevelPaths(layer, tileset, base_path, parse_data, path_solid_optimized);
+      Log::Error() << "unable to read " << physics_layer._obj_path.string();
+      return physics_layer;
+   }
+
+   physics_layer._chains = parseObj(layer, *mesh);
+   physics_layer._group_sizes = StaticChainBake::groupByChunk(physics_layer._chains);
+
+   // the ingame map is derived from the solid level outlines, the one-sided platforms are not part of it.
+   // rasterizing is the expensive part and does not need the gpu, only the textures are left to the main thread
+   if (layer->_name == "level" && !_compiled_level.isLoaded())
+   {
+      physics_layer._level_map_rasterized = _level_map.buildRaster(*mesh, layer->_width_tl, layer->_height_tl, PIXELS_PER_TILE);
+   }
+
+   return physics_layer;
+}
+
+void Level::addPhysicsLayer(const PhysicsLayer& physics_layer)
+{
+   const auto& layer = physics_layer._layer;
+
+   addChainsToWorld(physics_layer._chains, physics_layer._group_sizes, physics_layer._object_type);
+
+   if (!physics_layer._from_compiled_level)
+   {
+      for (const auto& chain : physics_layer._chains)
+      {
+         _compiled_level.addChain(layer->_name, chain);
+      }
+
+      _compiled_level.setChainGroups(layer->_name, physics_layer._group_sizes);
+
+      // editing the optimized outlines by hand has to invalidate the compiled level as well
+      _compiled_level.addSource(physics_layer._obj_path);
    }
 
-   // the ingame map is derived from the solid level outlines, the one-sided platforms are not part of it
    if (layer->_name == "level")
    {
-      _level_map.build(path_solid_optimized, layer->_width_tl, layer->_height_tl, PIXELS_PER_TILE);
+      if (_compiled_level.isLoaded())
+      {
+         _level_map.buildFromRaster(_compiled_level.getLevelMapRaster(), layer->_width_tl, layer->_height_tl, PIXELS_PER_TILE);
+      }
+      else if (physics_layer._level_map_rasterized)
+      {
+         _level_map.buildDetailLevels();
+         _compiled_level.setLevelMapRaster(_level_map.getRaster());
+      }
    }
 
    ChainShapeAnalyzer::analyze(_world);
@@ -10,10 +10,13 @@
 #include "game/layers/ambientocclusion.h"
 #include "game/layers/parallaxlayer.h"
 #include "game/level/atmosphere.h"
+#include "game/level/chunkindex.h"
+#include "game/level/compiledlevel.h"
 #include "game/level/gamemechanismregistry.h"
 #include "game/level/gamenode.h"
 #include "game/level/leveldescription.h"
 #include "game/level/levelinterface.h"
+#include "game/level/levelloadingtimings.h"
 #include "game/level/levelmap.h"
 #include "game/level/levelscript.h"
 #include "game/level/room.h"
@@ -60,6 +63,11 @@ class TmxParser;
 struct ParseData;
 struct PostProcessingMechanism;
 
+namespace Mesh
+{
+struct ObjMesh;
+}
+
 /// \brief manages a playable level including tmx loading, physics, mechanisms, camera, and rendering.
 class Level : public GameNode, public LevelInterface
 {
@@ -241,16 +249,35 @@ public:
    void setMapRevealed(bool revealed) override;
 
 protected:
-   /// \brief loads or regenerates physics paths for a collision tile layer and adds chains to box2d.
+   /// \brief physics outlines of one collision layer, prepared off the main thread while the level loads.
+   struct PhysicsLayer
+   {
+      std::shared_ptr<TmxLayer> _layer;
+      ObjectType _object_type = ObjectTypeSolid;
+      std::filesystem::path _obj_path;            //!< optimized outlines the chains were read from
+      std::vector<std::vector<b2Vec2>> _chains;  //!< closed loops in box2d world coordinates, ordered by body
+      std::vector<uint32_t> _group_sizes;         //!< number of chains per static body
+      bool _from_compiled_level = false;          //!< chains were restored from the compiled level
+      bool _level_map_rasterized = false;         //!< the level map raster was built from this layer
+   };
+
+   /// \brief loads or regenerates physics paths for a collision tile layer without touching the box2d world.
+   ///
+   /// safe to run on a worker thread; the result is handed to addPhysicsLayer on the main thread.
    /// \param layer tmx tile layer that defines physics collision tiles.
-   /// \param tileSet tileset used for tile-to-collision conversion.
-   /// \param basePath directory where generated physics files are read or written.
-   void parsePhysicsTiles(
+   /// \param tileset tileset used for tile-to-collision conversion.
+   /// \param base_path directory where generated physics files are read or written.
+   /// \return prepared physics layer, empty when the layer does not carry physics.
+   std::optional<PhysicsLayer> preparePhysicsLayer(
       const std::shared_ptr<TmxLayer>& layer,
-      const std::shared_ptr<TmxTileSet>& tileSet,
-      const std::filesystem::path& basePath
+      const std::shared_ptr<TmxTileSet>& tileset,
+      const std::filesystem::path& base_path
    );
 
+   /// \brief adds the chains of a prepared physics layer to the box2d world and finishes the level map.
+   /// \param physics_layer layer prepared by preparePhysicsLayer.
+   void addPhysicsLayer(const PhysicsLayer& physics_layer);
+
    /// \brief converts tile-space paths to box2d loops and registers each as a world fixture.
    /// \param offsetX horizontal tile offset added to every path point.
    /// \param offsetY vertical tile offset added to every path point.
@@ -258,23 +285,31 @@ protected:
    /// \param behavior object type assigned to created fixtures.
    void addPathsToWorld(int32_t offsetX, int32_t offsetY, const std::vector<SquareMarcher::Path>& paths, ObjectType behavior);
 
-   /// \brief creates a static box2d chain loop and attaches fixturenode metadata.
+   /// \brief creates one static body per group and adds each chain of the group to it as a loop fixture.
+   /// \param chains loop vertices in box2d world coordinates, ordered by group.
+   /// \param group_sizes number of chains per body, see StaticChainBake.
+   /// \param behavior object type stored in fixture user data.
+   void addChainsToWorld(const std::vector<std::vector<b2Vec2>>& chains, const std::vector<uint32_t>& group_sizes, ObjectType behavior);
+
+   /// \brief adds a box2d chain loop to a static body and attaches fixturenode metadata.
+   /// \param body static body that receives the fixture.
    /// \param chain loop vertices in box2d world coordinates.
    /// \param behavior object type stored in fixture user data.
-   void addChainToWorld(const std::vector<b2Vec2>& chain, ObjectType behavior);
+   void addChainToWorld(b2Body* body, const std::vector<b2Vec2>& chain, ObjectType behavior);
 
-   /// \brief reads an obj mesh, converts faces to chain loops, and adds them as physics fixtures.
+   /// \brief converts the faces of a parsed obj mesh to chain loops.
    /// \param layer tmx layer used for pixel offset and winding handling.
-   /// \param behavior object type assigned to created fixtures.
-   /// \param path path to the obj file containing optimized physics outlines.
-   void parseObj(const std::shared_ptr<TmxLayer>& layer, ObjectType behavior, const std::filesystem::path& path);
+   /// \param mesh obj mesh holding the optimized physics outlines, in pixels.
+   /// \return chain loops in box2d world coordinates.
+   std::vector<std::vector<b2Vec2>> parseObj(const std::shared_ptr<TmxLayer>& layer, const Mesh::ObjMesh& mesh) const;
 
    /// \brief loads tmx data, ambient occlusion data, and starts file watching for hot-reload detection.
    /// \return true when loading succeeds and required files are available.
    bool load();
 
    /// \brief parses tmx content, deserializes mechanisms, tile maps, rooms, lights, and physics layers.
-   void loadTmx();
+   /// \param timings receives the duration of every loading stage.
+   void loadTmx(LevelLoadingTimings& timings);
 
    /// \brief restores checkpoint spawn position and deserializes saved mechanism state.
    void loadSaveState();
@@ -282,7 +317,7 @@ protected:
    /// \brief initializes level.lua and binds mechanism lookup callbacks.
    void loadLevelScript();
 
-   /// \brief generates unoptimized physics geometry, merges and optimizes paths, then loads them.
+   /// \brief generates unoptimized physics geometry, then merges and optimizes its paths into an obj file.
    /// \param layer tmx layer used to generate collision geometry.
    /// \param tileset tileset used by physics geometry extraction.
    /// \param base_path base directory for generated intermediate and output files.
@@ -299,6 +334,9 @@ protected:
    /// \brief assigns overlapping room ids to mechanisms and lua enemies using their bounding boxes.
    void assignMechanismsToRooms();
 
+   /// \brief buckets all registered mechanisms by chunk so update passes only visit those near the player.
+   void buildMechanismChunkIndex();
+
    /// \brief saves a render texture to disk when screenshot capture is enabled.
    /// \param basename filename prefix used for generated screenshot files.
    /// \param texture render texture to save.
@@ -385,6 +423,7 @@ protected:
 
    std::vector<std::shared_ptr<Room>> _rooms;
    LevelMap _level_map;
+   CompiledLevel _compiled_level;  //!< restored from or recorded for '<level>.tmx.compiled' while loadTmx runs
    bool _map_revealed{false};  //!< whole level map visible, set by a map item and persisted in the save state
 
    std::unique_ptr<
@@ -420,6 +459,7 @@ protected:
    std::vector<std::unique_ptr<ParallaxLayer>> _parallax_layers;
 
    GameMechanismRegistry _mechanism_registry;
+   ChunkIndex<GameMechanism> _mechanism_chunk_index;  //!< the registry's mechanisms bucketed by chunk, built once at load
    std::unique_ptr<VolumeUpdater> _volume_updater;
 
    // graphic effects
@@ -7,6 +7,7 @@ void LevelFiles::clean(const LevelDescription& level_description)
 {
    const auto path = std::filesystem::path(level_description._filename).parent_path();
    const auto crc_path = level_description._filename + ".crc";
+   const auto compiled_path = level_description._filename + ".compiled";
 
    const auto filenames = {
       {"physics_grid_solid.png"},
@@ -20,6 +21,7 @@ void LevelFiles::clean(const LevelDescription& level_description)
       {"layer_level_solid_onesided_solid_onesided.obj"},
       {"layer_level_solid_onesided_solid_onesided_not_optimised.obj"},
       crc_path,
+      compiled_path,
    };
 
    // the error_code overload rather than the throwing one: on the switch and in the browser the
@@ -5,7 +5,7 @@
 
 namespace LevelFiles
 {
-/// \brief removes generated physics and checksum files for a level directory.
+/// \brief removes generated physics, checksum and compiled level files for a level directory.
 /// \param level_description level metadata containing the source filename used to resolve the folder.
 void clean(const LevelDescription& level_description);
 
@@ -0,0 +1,50 @@
+#include "levelloadingtimings.h"
+
+#include <algorithm>
+#include <format>
+
+#include "framework/tools/log.h"
+
+namespace
+{
+float toMs(LevelLoadingTimings::Clock::duration duration)
+{
+   return std::chrono::duration<float, std::milli>(duration).count();
+}
+}  // namespace
+
+LevelLoadingTimings::LevelLoadingTimings() : _start(Clock::now()), _main_thread_id(std::this_thread::get_id())
+{
+}
+
+void LevelLoadingTimings::record(const std::string& name, Clock::time_point start, Clock::time_point end)
+{
+   std::lock_guard lock(_mutex);
+   _stages.push_back({name, start - _start, end - _start, std::this_thread::get_id() == _main_thread_id});
+}
+
+void LevelLoadingTimings::log() const
+{
+   std::vector<Stage> stages;
+   {
+      std::lock_guard lock(_mutex);
+      stages = _stages;
+   }
+
+   std::ranges::sort(stages, {}, &Stage::_start);
+
+   const auto total = Clock::now() - _start;
+   Log::Info() << std::format("level loading stages, {:.1f}ms in total", toMs(total));
+
+   for (const auto& stage : stages)
+   {
+      Log::Info() << std::format(
+         "   {:<24} {:8.1f}ms - {:8.1f}ms {:8.1f}ms  {}",
+         stage._name,
+         toMs(stage._start),
+         toMs(stage._end),
+         toMs(stage._end - stage._start),
+         stage._main_thread ? "main" : "worker"
+      );
+   }
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/// \brief records when each stage of a level load ran, how long it took and on which thread.
+///
+/// the level load runs some of its stages on worker threads while the main thread goes on with others,
+/// so the sum of all stages says little about the time the player waits. every stage is therefore
+/// recorded with its start and end relative to the start of the load; together with the time the main
+/// thread spent waiting for a worker stage this shows which stages are on the critical path.
+class LevelLoadingTimings
+{
+public:
+   using Clock = std::chrono::steady_clock;
+
+   LevelLoadingTimings();
+
+   /// \brief runs a stage and records its timing; may be called from any thread.
+   /// \param name name of the stage as written to the log.
+   /// \param function work of the stage.
+   /// \return whatever the stage returns.
+   template <typename Function>
+   auto measure(const std::string& name, Function&& function)
+   {
+      const auto start = Clock::now();
+
+      if constexpr (std::is_void_v<decltype(function())>)
+      {
+         function();
+         record(name, start, Clock::now());
+      }
+      else
+      {
+         auto result = function();
+         record(name, start, Clock::now());
+         return result;
+      }
+   }
+
+   /// \brief writes all stages to the log, ordered by their start time.
+   void log() const;
+
+private:
+   struct Stage
+   {
+      std::string _name;
+      Clock::duration _start{};
+      Clock::duration _end{};
+      bool _main_thread = true;
+   };
+
+   void record(const std::string& name, Clock::time_point start, Clock::time_point end);
+
+   Clock::time_point _start;
+   std::thread::id _main_thread_id;
+
+   mutable std::mutex _mutex;
+   std::vector<Stage> _stages;
+};
@@ -1,11 +1,16 @@
 #include "levelmap.h"
 
+#include "framework/tools/asynctask.h"
 #include "framework/tools/log.h"
-#include "game/io/meshtools.h"
+#include "game/io/objfile.h"
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <cmath>
+#include <cstring>
+#include <future>
+#include <thread>
 
 namespace
 {
@@ -17,6 +22,9 @@ constexpr auto base_map_px_per_tile = 3;
 //! four entries, matching the zoom_level_* indicator layers of the map page.
 constexpr std::array<int32_t, 4> detail_level_block_sizes = {1, 2, 3, 4};
 
+//! fewest rows worth handing to a worker of their own
+constexpr auto min_rows_per_band = 64;
+
 /// \brief one mesh edge prepared for scanline traversal.
 struct ScanlineEdge
 {
@@ -24,11 +32,160 @@ struct ScanlineEdge
    float _y_max = 0.0f;
    float _x_at_y_min = 0.0f;
    float _slope = 0.0f;
+   int32_t _first_row = 0;  //!< first row whose scanline crosses the edge
+   int32_t _end_row = 0;    //!< first row below the edge
+};
+
+/// \brief an edge on the active edge table and where it crosses the current scanline.
+struct ActiveEdge
+{
+   uint32_t _edge = 0;
+   float _x = 0.0f;
 };
 
+/// \brief the edges of a mesh, bucketed by the row they start on.
+struct EdgeTable
+{
+   std::vector<ScanlineEdge> _edges;
+   std::vector<uint32_t> _edges_by_first_row;  //!< edge indices sorted by their first row
+   std::vector<uint32_t> _bucket_offsets;      //!< where each row's edges start in _edges_by_first_row
+};
+
+float getScanlineY(int32_t row, float world_px_per_map_px)
+{
+   return (static_cast<float>(row) + 0.5f) * world_px_per_map_px;
+}
+
+//! returns the first row whose scanline is at or below y. the estimate is corrected against the exact
+//! scanline positions, so an edge covers precisely the rows it would cover when tested row by row
+int32_t getFirstRowAtOrBelow(float y, int32_t height, float world_px_per_map_px)
+{
+   auto row = std::clamp(static_cast<int32_t>(std::ceil(y / world_px_per_map_px - 0.5f)), 0, height);
+
+   while (row > 0 && getScanlineY(row - 1, world_px_per_map_px) >= y)
+   {
+      row--;
+   }
+
+   while (row < height && getScanlineY(row, world_px_per_map_px) < y)
+   {
+      row++;
+   }
+
+   return row;
+}
+
+//! fills the rows [first_row, end_row) of the raster, 0 marks a solid cell
+void rasterizeRows(const EdgeTable& table, int32_t first_row, int32_t end_row, int32_t width, float world_px_per_map_px, uint8_t* cells)
+{
+   // edges that started above the band and are still going
+   std::vector<ActiveEdge> active;
+   for (auto edge_index = 0u; edge_index < table._edges.size(); edge_index++)
+   {
+      const auto& edge = table._edges[edge_index];
+      if (edge._first_row < first_row && edge._end_row > first_row)
+      {
+         active.push_back({edge_index});
+      }
+   }
+
+   for (auto row = first_row; row < end_row; row++)
+   {
+      std::erase_if(active, [&table, row](const auto& active_edge) { return table._edges[active_edge._edge]._end_row <= row; });
+
+      for (auto i = table._bucket_offsets[row]; i < table._bucket_offsets[row + 1]; i++)
+      {
+         active.push_back({table._edges_by_first_row[i]});
+      }
+
+      if (active.empty())
+      {
+         continue;
+      }
+
+      const auto scanline_y_px = getScanlineY(row, world_px_per_map_px);
+      for (auto& active_edge : active)
+      {
+         const auto& edge = table._edges[active_edge._edge];
+         active_edge._x = edge._x_at_y_min + (scanline_y_px - edge._y_min) * edge._slope;
+      }
+
+      // the crossings barely change order from one row to the next, so an insertion sort on last row's
+      // order is close to linear
+      for (auto i = 1u; i < active.size(); i++)
+      {
+         const auto current = active[i];
+         auto j = i;
+         for (; j > 0 && active[j - 1]._x > current._x; j--)
+         {
+            active[j] = active[j - 1];
+         }
+         active[j] = current;
+      }
+
+      // even-odd rule: everything between crossing 0 and 1, 2 and 3, ... is inside the mesh
+      auto* row_cells = cells + static_cast<size_t>(row) * static_cast<size_t>(width);
+      for (auto crossing_index = 0u; crossing_index + 1 < active.size(); crossing_index += 2)
+      {
+         const auto span_start = static_cast<int32_t>(std::ceil(active[crossing_index]._x / world_px_per_map_px - 0.5f));
+         const auto span_end = static_cast<int32_t>(std::ceil(active[crossing_index + 1]._x / world_px_per_map_px - 0.5f));
+
+         const auto clamped_start = std::max(0, span_start);
+         const auto clamped_end = std::min(width, span_end);
+
+         if (clamped_start < clamped_end)
+         {
+            std::memset(row_cells + clamped_start, 0, static_cast<size_t>(clamped_end - clamped_start));
+         }
+      }
+   }
+}
+
 }  // namespace
 
-bool LevelMap::build(const std::filesystem::path& obj_path, int32_t width_tl, int32_t height_tl, int32_t tile_size_px)
+bool LevelMap::build(const Mesh::ObjMesh& mesh, int32_t width_tl, int32_t height_tl, int32_t tile_size_px)
+{
+   if (!buildRaster(mesh, width_tl, height_tl, tile_size_px))
+   {
+      return false;
+   }
+
+   return buildDetailLevels();
+}
+
+bool LevelMap::buildRaster(const Mesh::ObjMesh& mesh, int32_t width_tl, int32_t height_tl, int32_t tile_size_px)
+{
+   if (!setDimensions(width_tl, height_tl, tile_size_px))
+   {
+      return false;
+   }
+
+   return rasterize(mesh);
+}
+
+bool LevelMap::buildFromRaster(const std::vector<bool>& interior, int32_t width_tl, int32_t height_tl, int32_t tile_size_px)
+{
+   if (!setDimensions(width_tl, height_tl, tile_size_px))
+   {
+      return false;
+   }
+
+   if (interior.size() != static_cast<size_t>(_base_width) * static_cast<size_t>(_base_height))
+   {
+      Log::Error() << "map raster does not match the level dimensions";
+      return false;
+   }
+
+   _interior.assign(interior.begin(), interior.end());
+   return buildDetailLevels();
+}
+
+std::vector<bool> LevelMap::getRaster() const
+{
+   return {_interior.begin(), _interior.end()};
+}
+
+bool LevelMap::setDimensions(int32_t width_tl, int32_t height_tl, int32_t tile_size_px)
 {
    if (width_tl <= 0 || height_tl <= 0 || tile_size_px <= 0)
    {
@@ -39,12 +196,11 @@ bool LevelMap::build(const std::filesystem::path& obj_path, int32_t width_tl, in
    _base_width = width_tl * base_map_px_per_tile;
    _base_height = height_tl * base_map_px_per_tile;
    _base_world_px_per_map_px = static_cast<float>(tile_size_px) / static_cast<float>(base_map_px_per_tile);
+   return true;
+}
 
-   if (!rasterize(obj_path))
-   {
-      return false;
-   }
-
+bool LevelMap::buildDetailLevels()
+{
    const auto maximum_size = static_cast<int32_t>(sf::Texture::getMaximumSize());
 
    for (const auto block_size : detail_level_block_sizes)
@@ -62,27 +218,26 @@ bool LevelMap::build(const std::filesystem::path& obj_path, int32_t width_tl, in
    return !_detail_levels.empty();
 }
 
-bool LevelMap::rasterize(const std::filesystem::path& obj_path)
+bool LevelMap::rasterize(const Mesh::ObjMesh& mesh)
 {
-   std::vector<b2Vec2> points;
-   std::vector<std::vector<uint32_t>> faces;
-   Mesh::readObj(obj_path.string(), points, faces);
-
-   if (points.empty() || faces.empty())
+   if (mesh._points.empty() || mesh.getFaceCount() == 0)
    {
-      Log::Error() << "no mesh data in " << obj_path.string() << ", map will not be generated";
+      Log::Error() << "level outlines have no mesh data, map will not be generated";
       return false;
    }
 
-   std::vector<ScanlineEdge> edges;
-   for (const auto& face : faces)
+   const auto start_time = std::chrono::steady_clock::now();
+
+   EdgeTable table;
+   for (auto face_index = 0u; face_index < mesh.getFaceCount(); face_index++)
    {
+      const auto face = mesh.getFace(face_index);
       const auto point_count = face.size();
       for (auto index = 0u; index < point_count; index++)
       {
-         // readObj already converts the wavefront 1-based indices to 0-based ones
-         const auto& start = points[face[index]];
-         const auto& end = points[face[(index + 1) % point_count]];
+         // the parser already converts the wavefront 1-based indices to 0-based ones
+         const auto& start = mesh._points[face[index]];
+         const auto& end = mesh._points[face[(index + 1) % point_count]];
 
          // horizontal edges never cross a scanline
          if (start.y == end.y)
@@ -93,59 +248,79 @@ bool LevelMap::rasterize(const std::filesystem::path& obj_path)
          const auto& upper = (start.y < end.y) ? start : end;
          const auto& lower = (start.y < end.y) ? end : start;
 
-         edges.push_back(ScanlineEdge{upper.y, lower.y, upper.x, (lower.x - upper.x) / (lower.y - upper.y)});
+         table._edges.push_back(
+            ScanlineEdge{
+               upper.y,
+               lower.y,
+               upper.x,
+               (lower.x - upper.x) / (lower.y - upper.y),
+               getFirstRowAtOrBelow(upper.y, _base_height, _base_world_px_per_map_px),
+               getFirstRowAtOrBelow(lower.y, _base_height, _base_world_px_per_map_px)
+            }
+         );
       }
    }
 
-   if (edges.empty())
+   if (table._edges.empty())
    {
-      Log::Error() << "mesh in " << obj_path.string() << " has no usable edges";
+      Log::Error() << "level outlines have no usable edges, map will not be generated";
       return false;
    }
 
-   // everything the mesh does not enclose is walkable
-   _interior.assign(static_cast<size_t>(_base_width) * static_cast<size_t>(_base_height), true);
-
-   std::vector<float> crossings;
-   crossings.reserve(64);
-
-   for (auto row = 0; row < _base_height; row++)
+   // bucket the edges by the row they start on, so each row only looks at the edges crossing it instead
+   // of testing the whole mesh
+   table._bucket_offsets.assign(static_cast<size_t>(_base_height) + 1, 0);
+   for (const auto& edge : table._edges)
    {
-      const auto scanline_y_px = (static_cast<float>(row) + 0.5f) * _base_world_px_per_map_px;
-
-      crossings.clear();
-      for (const auto& edge : edges)
+      if (edge._first_row < edge._end_row)
       {
-         if (edge._y_min <= scanline_y_px && edge._y_max > scanline_y_px)
-         {
-            crossings.push_back(edge._x_at_y_min + (scanline_y_px - edge._y_min) * edge._slope);
-         }
+         table._bucket_offsets[edge._first_row + 1]++;
       }
+   }
+
+   for (auto row = 0; row < _base_height; row++)
+   {
+      table._bucket_offsets[row + 1] += table._bucket_offsets[row];
+   }
 
-      if (crossings.empty())
+   table._edges_by_first_row.resize(table._bucket_offsets.back());
+   auto bucket_ends = table._bucket_offsets;
+   for (auto edge_index = 0u; edge_index < table._edges.size(); edge_index++)
+   {
+      const auto& edge = table._edges[edge_index];
+      if (edge._first_row < edge._end_row)
       {
-         continue;
+         table._edges_by_first_row[bucket_ends[edge._first_row]++] = edge_index;
       }
+   }
 
-      std::sort(crossings.begin(), crossings.end());
+   // everything the mesh does not enclose is walkable
+   _interior.assign(static_cast<size_t>(_base_width) * static_cast<size_t>(_base_height), 1);
 
-      // even-odd rule: everything between crossing 0 and 1, 2 and 3, ... is inside the mesh
-      const auto row_offset = static_cast<size_t>(row) * static_cast<size_t>(_base_width);
-      for (auto crossing_index = 0u; crossing_index + 1 < crossings.size(); crossing_index += 2)
-      {
-         const auto span_start = static_cast<int32_t>(std::ceil(crossings[crossing_index] / _base_world_px_per_map_px - 0.5f));
-         const auto span_end = static_cast<int32_t>(std::ceil(crossings[crossing_index + 1] / _base_world_px_per_map_px - 0.5f));
+   // the rows are independent of each other, so they are split into bands and filled in parallel
+   const auto hardware_threads = static_cast<int32_t>(std::max(std::thread::hardware_concurrency(), 1u));
+   const auto band_count = std::clamp(_base_height / min_rows_per_band, 1, hardware_threads);
+   const auto rows_per_band = (_base_height + band_count - 1) / band_count;
 
-         const auto clamped_start = std::max(0, span_start);
-         const auto clamped_end = std::min(_base_width, span_end);
+   std::vector<std::future<void>> bands;
+   for (auto first_row = 0; first_row < _base_height; first_row += rows_per_band)
+   {
+      const auto end_row = std::min(first_row + rows_per_band, _base_height);
+      bands.push_back(
+         startAsyncTask([this, &table, first_row, end_row]()
+                        { rasterizeRows(table, first_row, end_row, _base_width, _base_world_px_per_map_px, _interior.data()); })
+      );
+   }
 
-         for (auto column = clamped_start; column < clamped_end; column++)
-         {
-            _interior[row_offset + static_cast<size_t>(column)] = false;
-         }
-      }
+   for (auto& band : bands)
+   {
+      band.get();
    }
 
+   const auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_time).count();
+   Log::Info() << "rasterized level map: " << _base_width << "x" << _base_height << " px, " << table._edges.size() << " edges, "
+               << bands.size() << " bands in " << elapsed_ms << "ms";
+
    return true;
 }
 
@@ -159,32 +334,40 @@ void LevelMap::addDetailLevel(int32_t block_size)
       return;
    }
 
+   const auto start_time = std::chrono::steady_clock::now();
+
    // a merged cell counts as walkable when any of its base cells is. that way a one tile wide
    // corridor stays on the map no matter how far the view is zoomed out, and walls between two
    // chambers collapse into the single pixel line that separates them.
-   std::vector<bool> interior(static_cast<size_t>(width) * static_cast<size_t>(height), false);
+   //
+   // the box filter first ors the block's base rows together and then each run of block_size cells
+   // of that row; both loops run over plain bytes, which the compiler turns into vector instructions
+   std::vector<uint8_t> interior(static_cast<size_t>(width) * static_cast<size_t>(height), 0);
+   std::vector<uint8_t> merged_rows(static_cast<size_t>(_base_width), 0);
 
    for (auto y = 0; y < height; y++)
    {
-      for (auto x = 0; x < width; x++)
-      {
-         auto walkable = false;
+      const auto* first_base_row = &_interior[static_cast<size_t>(y * block_size) * static_cast<size_t>(_base_width)];
+      std::copy_n(first_base_row, _base_width, merged_rows.begin());
 
-         for (auto block_y = 0; block_y < block_size && !walkable; block_y++)
+      for (auto block_y = 1; block_y < block_size; block_y++)
+      {
+         const auto* base_row = &_interior[static_cast<size_t>(y * block_size + block_y) * static_cast<size_t>(_base_width)];
+         for (auto base_x = 0; base_x < _base_width; base_x++)
          {
-            const auto base_y = y * block_size + block_y;
-            for (auto block_x = 0; block_x < block_size; block_x++)
-            {
-               const auto base_x = x * block_size + block_x;
-               if (_interior[static_cast<size_t>(base_y) * static_cast<size_t>(_base_width) + static_cast<size_t>(base_x)])
-               {
-                  walkable = true;
-                  break;
-               }
-            }
+            merged_rows[base_x] |= base_row[base_x];
          }
+      }
 
-         interior[static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(x)] = walkable;
+      auto* row = &interior[static_cast<size_t>(y) * static_cast<size_t>(width)];
+      for (auto x = 0; x < width; x++)
+      {
+         uint8_t walkable = 0;
+         for (auto block_x = 0; block_x < block_size; block_x++)
+         {
+            walkable |= merged_rows[x * block_size + block_x];
+         }
+         row[x] = walkable;
       }
    }
 
@@ -243,8 +426,9 @@ void LevelMap::addDetailLevel(int32_t block_size)
 
    _detail_levels.push_back(DetailLevel{texture, _base_world_px_per_map_px * static_cast<float>(block_size)});
 
+   const auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_time).count();
    Log::Info() << "generated level map detail level " << _detail_levels.size() - 1 << ": " << width << "x" << height << " px ("
-               << static_cast<float>(base_map_px_per_tile) / static_cast<float>(block_size) << " px per tile)";
+               << static_cast<float>(base_map_px_per_tile) / static_cast<float>(block_size) << " px per tile) in " << elapsed_ms << "ms";
 }
 
 bool LevelMap::isValid() const
@@ -7,6 +7,11 @@
 #include <memory>
 #include <vector>
 
+namespace Mesh
+{
+struct ObjMesh;
+}
+
 /// \brief pixel art overview of a level, rasterized from its collision mesh.
 ///
 /// the whole level is painted once at load time, exploration is not baked in. the map page
@@ -36,12 +41,39 @@ public:
    };
 
    /// \brief rasterizes a collision mesh into the map textures.
-   /// \param obj_path wavefront obj holding the optimized level outlines in world pixels.
+   /// \param mesh optimized level outlines in world pixels.
+   /// \param width_tl level width in tiles.
+   /// \param height_tl level height in tiles.
+   /// \param tile_size_px edge length of one tile in world pixels.
+   /// \return true when the mesh had geometry and at least one texture was created.
+   bool build(const Mesh::ObjMesh& mesh, int32_t width_tl, int32_t height_tl, int32_t tile_size_px);
+
+   /// \brief rasterizes a collision mesh without creating any textures yet.
+   ///
+   /// this is the cpu heavy half of build and does not need a gl context, so the level loader runs it on a
+   /// worker thread and calls buildDetailLevels on the main thread afterwards.
+   /// \param mesh optimized level outlines in world pixels.
+   /// \param width_tl level width in tiles.
+   /// \param height_tl level height in tiles.
+   /// \param tile_size_px edge length of one tile in world pixels.
+   /// \return true when the mesh had geometry.
+   bool buildRaster(const Mesh::ObjMesh& mesh, int32_t width_tl, int32_t height_tl, int32_t tile_size_px);
+
+   /// \brief creates all detail levels the maximum texture size allows from the base raster.
+   /// \return true when at least one detail level was created.
+   bool buildDetailLevels();
+
+   /// \brief creates the map textures from a raster kept from an earlier build, e.g. by the compiled level cache.
+   /// \param interior walkable cells at base resolution as returned by getRaster.
    /// \param width_tl level width in tiles.
    /// \param height_tl level height in tiles.
    /// \param tile_size_px edge length of one tile in world pixels.
-   /// \return true when the mesh could be read and at least one texture was created.
-   bool build(const std::filesystem::path& obj_path, int32_t width_tl, int32_t height_tl, int32_t tile_size_px);
+   /// \return true when the raster matches the level dimensions and at least one texture was created.
+   bool buildFromRaster(const std::vector<bool>& interior, int32_t width_tl, int32_t height_tl, int32_t tile_size_px);
+
+   /// \brief returns the walkable cells at base resolution, row by row.
+   /// \return base raster, empty when the map has not been built.
+   std::vector<bool> getRaster() const;
 
    /// \brief returns whether usable map textures are available.
    /// \return true when build succeeded.
@@ -81,10 +113,18 @@ public:
    Style _style;
 
 private:
+   /// \brief derives the base map size from the level size.
+   /// \return false when the level size is invalid.
+   bool setDimensions(int32_t width_tl, int32_t height_tl, int32_t tile_size_px);
+
    /// \brief fills the base walkable grid from the mesh faces using the even-odd rule.
-   /// \param obj_path wavefront obj holding the level outlines.
+   ///
+   /// the mesh edges are bucketed by the first row they cross and walked with an active edge table, so
+   /// each row only computes the crossings of the edges that span it. the rows are filled in parallel
+   /// bands.
+   /// \param mesh level outlines in world pixels.
    /// \return true when the mesh contained geometry.
-   bool rasterize(const std::filesystem::path& obj_path);
+   bool rasterize(const Mesh::ObjMesh& mesh);
 
    /// \brief builds one detail level by merging blocks of base cells and painting the result.
    /// \param block_size how many base cells along each axis collapse into one map pixel.
@@ -92,7 +132,7 @@ private:
 
    std::vector<DetailLevel> _detail_levels;
 
-   std::vector<bool> _interior;  //!< walkable cells at base resolution
+   std::vector<uint8_t> _interior;  //!< walkable cells at base resolution, 1 for walkable
 
    int32_t _base_width = 0;   //!< base map width in map pixels
    int32_t _base_height = 0;  //!< base map height in map pixels
@@ -0,0 +1,110 @@
+#include "levelpreloader.h"
+
+#include <chrono>
+
+#include "framework/tools/asynctask.h"
+#include "framework/tools/log.h"
+#include "game/level/leveldescription.h"
+
+namespace
+{
+std::unique_ptr<LevelPreloader::PreloadedLevel> preloadLevel(const std::string& level_description_filename)
+{
+   const auto start = std::chrono::steady_clock::now();
+
+   const auto description = LevelDescription::load(level_description_filename);
+   if (!description)
+   {
+      return nullptr;
+   }
+
+   auto preloaded = std::make_unique<LevelPreloader::PreloadedLevel>();
+   preloaded->_tmx_filename = description->_filename;
+
+   if (!preloaded->_compiled_level.load(description->_filename, preloaded->_tmx_parser))
+   {
+      preloaded->_tmx_parser.parse(description->_filename);
+   }
+
+   Log::Info() << "preloaded " << description->_filename << " within "
+               << std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count() << "ms";
+
+   return preloaded;
+}
+}  // namespace
+
+LevelPreloader& LevelPreloader::getInstance()
+{
+   static LevelPreloader __instance;
+   return __instance;
+}
+
+LevelPreloader::~LevelPreloader()
+{
+   // futures from std::async wait for their task when destroyed, so nothing outlives the preloader
+   _abandoned_preloads.clear();
+}
+
+void LevelPreloader::preload(const std::string& level_description_filename)
+{
+   std::lock_guard lock(_mutex);
+
+   if (_preload.valid() && _level_description_filename == level_description_filename)
+   {
+      return;
+   }
+
+   dropFinishedPreloads();
+
+   // destroying a running preload's future would block until it is done, so it is parked instead
+   if (_preload.valid())
+   {
+      _abandoned_preloads.push_back(std::move(_preload));
+   }
+
+   Log::Info() << "preloading " << level_description_filename;
+   _level_description_filename = level_description_filename;
+
+   _preload = startAsyncTask([level_description_filename]() { return preloadLevel(level_description_filename); });
+}
+
+std::unique_ptr<LevelPreloader::PreloadedLevel>
+LevelPreloader::take(const std::string& level_description_filename, const std::string& tmx_filename)
+{
+   std::lock_guard lock(_mutex);
+
+   dropFinishedPreloads();
+
+   if (!_preload.valid())
+   {
+      return nullptr;
+   }
+
+   // a preload of another level is of no use here; waiting for it would hold up this load, and in the
+   // web build it would even parse that level right now
+   if (_level_description_filename != level_description_filename)
+   {
+      _abandoned_preloads.push_back(std::move(_preload));
+      _level_description_filename.clear();
+      return nullptr;
+   }
+
+   auto preloaded = _preload.get();
+   _level_description_filename.clear();
+
+   if (!preloaded || preloaded->_tmx_filename != tmx_filename)
+   {
+      return nullptr;
+   }
+
+   return preloaded;
+}
+
+void LevelPreloader::dropFinishedPreloads()
+{
+   // deferred preloads of the web build never run unless waited for, they can go right away
+   std::erase_if(
+      _abandoned_preloads,
+      [](const auto& preload) { return preload.wait_for(std::chrono::seconds{0}) != std::future_status::timeout; }
+   );
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "framework/tmxparser/tmxparser.h"
+#include "game/level/compiledlevel.h"
+
+/// \brief prepares the cpu side of a level in the background before the player actually enters it.
+///
+/// a level transition used to start from nothing once the screen had faded out: the tmx was parsed, or
+/// restored from its compiled level, while the player looked at a black screen. the preloader does that
+/// part ahead of time, as soon as a transition comes into reach, and Level::loadTmx picks up the result.
+///
+/// only data without ties to the running level is prepared here. constructing a whole Level in the
+/// background is not an option since a level resets shared state such as the lua interface and the
+/// mechanism registries that the running level still uses.
+class LevelPreloader
+{
+public:
+   /// \brief cpu side data of a preloaded level.
+   struct PreloadedLevel
+   {
+      std::string _tmx_filename;
+      TmxParser _tmx_parser;
+      CompiledLevel _compiled_level;
+   };
+
+   /// \brief returns the process-wide level preloader.
+   /// \return reference to the shared preloader instance.
+   static LevelPreloader& getInstance();
+
+   ~LevelPreloader();
+
+   /// \brief starts preloading a level in the background.
+   /// \details a preload of the same level that is already running or done is kept, a preload of another level
+   ///          is abandoned.
+   /// \param level_description_filename path of the level's description json, as listed in levels.json.
+   void preload(const std::string& level_description_filename);
+
+   /// \brief takes the preloaded data of a level, waiting for the preload to finish if it is still running.
+   /// \details a preload of another level is abandoned without waiting for it.
+   /// \param level_description_filename path of the description json of the level that is being loaded.
+   /// \param tmx_filename tmx file of the level that is being loaded.
+   /// \return preloaded data, nullptr when that level has not been preloaded.
+   std::unique_ptr<PreloadedLevel> take(const std::string& level_description_filename, const std::string& tmx_filename);
+
+private:
+   LevelPreloader() = default;
+
+   void dropFinishedPreloads();
+
+   std::mutex _mutex;
+   std::string _level_description_filename;
+   std::future<std::unique_ptr<PreloadedLevel>> _preload;
+   std::vector<std::future<std::unique_ptr<PreloadedLevel>>> _abandoned_preloads;  //!< finish on their own, never waited for
+};
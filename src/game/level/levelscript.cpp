@@ -32,8 +32,10 @@
 #include "game/weapons/weaponfactory.h"
 #include "json/json.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <fstream>
+#include <iterator>
 #include <mutex>
 #include <regex>
 
@@ -738,13 +740,22 @@ std::vector<std::shared_ptr<LuaNode>> LevelScript::findLuaNodes(const std::strin
    std::vector<std::shared_ptr<LuaNode>> results;
 
    const auto& object_list = LuaInterface::instance().getObjectList();
-   std::regex pattern(search_pattern);
+
+   // enemies come and go, so there's no index to look literal names up in; comparing them is still much cheaper than a regex
+   if (RegexCache::isLiteral(search_pattern))
+   {
+      std::ranges::copy_if(
+         object_list, std::back_inserter(results), [&search_pattern](const auto& node) { return node->_name == search_pattern; }
+      );
+      return results;
+   }
+
+   const auto& pattern = _regex_cache.get(search_pattern);
    for (const auto& node : object_list)
    {
-      auto lua_node = std::dynamic_pointer_cast<LuaNode>(node);
-      if (std::regex_match(lua_node->_name, pattern))
+      if (std::regex_match(node->_name, pattern))
       {
-         results.push_back(lua_node);
+         results.push_back(node);
       }
    }
 
@@ -9,6 +9,7 @@
 #include <variant>
 #include <vector>
 
+#include "framework/tools/regexcache.h"
 #include "game/animation/animationpool.h"
 #include "game/audio/musicplayertypes.h"
 #include "game/level/scriptproperty.h"
@@ -404,6 +405,7 @@ private:
    bool _initialized{false};
 
    SearchMechanismCallback _search_mechanism_callback{nullptr};
+   RegexCache _regex_cache;
 
    using ItemAddedCallback = std::function<void(const std::string&)>;
    using ItemUsedCallback = std::function<bool(const std::string&)>;
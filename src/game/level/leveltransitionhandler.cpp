@@ -9,6 +9,7 @@
 #include "game/constants.h"
 #include "game/effects/fadetransitioneffect.h"
 #include "game/effects/screentransition.h"
+#include "game/level/levelpreloader.h"
 #include "game/level/levelregistry.h"
 #include "game/level/levels.h"
 #include "game/player/playerregistry.h"
@@ -51,6 +52,10 @@ void LevelTransitionHandler::request(const std::string& level_description_filena
    }
 
    _pending_request = Request{._level_description_filename = level_description_filename, ._spawn_position_px = spawn_position_px};
+
+   // usually started already when the player came close to the transition; scripted transitions start it here,
+   // which still leaves the fade out to get it done
+   LevelPreloader::getInstance().preload(level_description_filename);
 }
 
 void LevelTransitionHandler::update()
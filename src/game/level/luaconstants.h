@@ -34,6 +34,8 @@
 #define FUNCTION_TIMEOUT "timeout"
 /// \brief lua callback name used every frame to update scripted behavior.
 #define FUNCTION_UPDATE "update"
+/// \brief lua callback name used every frame instead of movedTo, playerMovedTo and update when a script defines it.
+#define FUNCTION_STEP "step"
 /// \brief lua callback name used to forward key-value properties to scripts.
 #define FUNCTION_WRITE_PROPERTY "writeProperty"
 /// \brief lua callback name used when a LuaNode is smashed.
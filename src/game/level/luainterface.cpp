@@ -5,6 +5,8 @@
 
 // game
 #include "framework/tools/log.h"
+#include "game/debug/luacounter.h"
+#include "game/level/chunkindex.h"
 
 // stl
 #include <iostream>
@@ -12,18 +14,29 @@
 
 namespace
 {
+// declared ahead of the node list so it is destroyed after it: nodes release their thread on the shared vm when they go
+LuaSharedVm _shared_vm;
+
 std::vector<std::shared_ptr<LuaNode>> _object_list;
+ChunkIndex<LuaNode> _chunk_index;
+std::vector<LuaNode*> _nearby_objects;
 
-std::vector<std::shared_ptr<LuaNode>>::iterator removeObject(const std::shared_ptr<LuaNode>& node)
+void removeObject(LuaNode* node)
 {
-   const auto it = _object_list.erase(std::remove(_object_list.begin(), _object_list.end(), node), _object_list.end());
+   _chunk_index.remove(node);
+
+   const auto it = std::ranges::find(_object_list, node, &std::shared_ptr<LuaNode>::get);
+   if (it == _object_list.end())
+   {
+      return;
+   }
 
-   if (node.use_count() > 1)
+   if (it->use_count() > 1)
    {
-      Log::Warning() << node->_script_name << " use count is: " << node.use_count() << " address: " << node.get();
+      Log::Warning() << node->_script_name << " use count is: " << it->use_count() << " address: " << node;
    }
 
-   return it;
+   _object_list.erase(it);
 }
 
 }  // namespace
@@ -38,54 +51,48 @@ std::shared_ptr<LuaNode> LuaInterface::addObject(GameNode* parent, const std::st
 {
    std::shared_ptr<LuaNode> object = std::make_shared<LuaNode>(parent, filename);
    _object_list.push_back(object);
+   _chunk_index.add(object.get(), object->getChunks());
    return object;
 }
 
-void LuaInterface::update(const sf::Time& dt, const ChunkFilter& filter)
+void LuaInterface::update(const sf::Time& dt, const Chunk& player_chunk)
 {
-   for (auto it = _object_list.begin(); it != _object_list.end();)
+   // a copy, nodes die during this loop and scripts may spawn new ones, both of which change the index
+   _nearby_objects = _chunk_index.query(player_chunk);
+
+   for (auto* object : _nearby_objects)
    {
-      {
-         const auto& object = *it;
-
-         if (!filter(object))
-         {
-            ++it;
-            continue;
-         }
-
-         object->luaMovedTo();
-         object->luaPlayerMovedTo();
-         object->luaUpdate(dt);
-         object->updateVelocity();
-         object->updatePosition();
-         object->updateWeapons(dt);
-      }
+      object->luaStep(dt);
+      object->updateVelocity();
+      object->updatePosition();
+      object->updateWeapons(dt);
 
-      if ((*it)->_dead)
+      if (object->_dead)
       {
-         it = removeObject(*it);
-      }
-      else
-      {
-         ++it;
+         removeObject(object);
       }
    }
 }
 
-std::shared_ptr<LuaNode> LuaInterface::getObject(lua_State* state)
+const std::vector<LuaNode*>& LuaInterface::getObjectsNear(const Chunk& chunk)
 {
-   auto obj = std::shared_ptr<LuaNode>{nullptr};
+   return _chunk_index.query(chunk);
+}
 
-   const auto it =
-      std::find_if(_object_list.cbegin(), _object_list.cend(), [state](const auto& node) { return node->_lua_state == state; });
+void LuaInterface::updateChunks(LuaNode* node)
+{
+   _chunk_index.update(node, node->getChunks());
+}
 
-   if (it != _object_list.cend())
-   {
-      obj = *it;
-   }
+LuaNode* LuaInterface::getObject(lua_State* state)
+{
+   // every callback starts here, so this used to be a scan over all nodes per callback
+   return *static_cast<LuaNode**>(lua_getextraspace(state));
+}
 
-   return obj;
+void LuaInterface::bindObject(lua_State* state, LuaNode* node)
+{
+   *static_cast<LuaNode**>(lua_getextraspace(state)) = node;
 }
 
 const std::vector<std::shared_ptr<LuaNode>>& LuaInterface::getObjectList()
@@ -93,7 +100,34 @@ const std::vector<std::shared_ptr<LuaNode>>& LuaInterface::getObjectList()
    return _object_list;
 }
 
+LuaSharedVm& LuaInterface::getSharedVm()
+{
+   return _shared_vm;
+}
+
+int64_t LuaInterface::computeMemoryUsage() const
+{
+   // threads on the shared vm report the whole vm, so it is counted once rather than per node
+   auto memory_usage = _shared_vm.computeMemoryUsage();
+   for (const auto& node : _object_list)
+   {
+      if (!node->_shared_vm_instance.has_value() && node->_lua_state)
+      {
+         memory_usage += static_cast<int64_t>(lua_gc(node->_lua_state, LUA_GCCOUNT)) * 1024 + lua_gc(node->_lua_state, LUA_GCCOUNTB);
+      }
+   }
+
+   return memory_usage;
+}
+
 void LuaInterface::reset()
 {
+   _chunk_index.clear();
    _object_list.clear();
+   _shared_vm.reset();
+
+#ifdef DEVELOPMENT_MODE
+   LuaCounter::load_time_us = 0;
+   LuaCounter::nodes_loaded = 0;
+#endif
 }
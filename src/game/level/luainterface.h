@@ -7,7 +7,9 @@
 
 #include "SFML/Graphics.hpp"
 
+#include "game/level/chunk.h"
 #include "game/level/luanode.h"
+#include "game/level/luasharedvm.h"
 
 /// \brief singleton that owns and updates all active LuaNode instances.
 class LuaInterface
@@ -17,16 +19,14 @@ public:
    /// \return singleton instance.
    static LuaInterface& instance();
 
-   using ChunkFilter = std::function<bool(const std::shared_ptr<GameMechanism>&)>;
-
    /// \brief initializes Lua interface state.
    /// \details currently a no-op placeholder for future setup.
    void initialize();
 
-   /// \brief updates all scripted nodes that pass the chunk filter.
+   /// \brief updates all scripted nodes near the player's chunk.
    /// \param dt frame time passed to each LuaNode update.
-   /// \param filter predicate that decides whether a node is processed this frame.
-   void update(const sf::Time& dt, const ChunkFilter& filter);
+   /// \param player_chunk chunk the update neighbourhood is centered on.
+   void update(const sf::Time& dt, const Chunk& player_chunk);
 
    /// \brief removes all registered LuaNode instances.
    void reset();
@@ -38,9 +38,32 @@ public:
    std::shared_ptr<LuaNode> addObject(GameNode* parent, const std::string& filename);
 
    /// \brief finds the LuaNode that owns a given lua state pointer.
+   /// \details constant time, the node is read from the state's extra space, see bindObject.
    /// \param state lua state associated with a LuaNode instance.
    /// \return matching LuaNode, or nullptr when no node owns the state.
-   std::shared_ptr<LuaNode> getObject(lua_State*);
+   LuaNode* getObject(lua_State* state);
+
+   /// \brief ties a lua state to the LuaNode running on it by storing the node in the state's extra space.
+   /// \param state lua state or thread the node's script runs on.
+   /// \param node owning node, nullptr to unbind.
+   void bindObject(lua_State* state, LuaNode* node);
+
+   /// \brief collects the nodes within the chunk neighbourhood of a chunk, plus all nodes without chunks.
+   /// \param chunk chunk the neighbourhood is centered on.
+   /// \return nodes in creation order; valid until the next node is added, removed or re-chunked.
+   const std::vector<LuaNode*>& getObjectsNear(const Chunk& chunk);
+
+   /// \brief re-buckets a node in the chunk index after its chunks changed.
+   /// \param node node whose chunks changed.
+   void updateChunks(LuaNode* node);
+
+   /// \brief gets the lua vm shared by all nodes when the 'lua_shared_vm' tweak is enabled.
+   /// \return shared vm, created on first use.
+   LuaSharedVm& getSharedVm();
+
+   /// \brief sums the memory held by the lua vms of all nodes.
+   /// \return size in bytes.
+   int64_t computeMemoryUsage() const;
 
    /// \brief gets the internal list of all active LuaNode objects.
    /// \return constant reference to the internal LuaNode list.
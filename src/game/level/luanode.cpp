@@ -17,11 +17,13 @@
 #include "framework/tools/log.h"
 #include "framework/tools/sfmlcompat.h"
 #include "framework/tools/timer.h"
+#include "game/config/tweaks.h"
 #include "game/animation/animationplayer.h"
 #include "game/animation/detonationanimation.h"
 #include "game/audio/audio.h"
 #include "game/constants.h"
 #include "game/debug/debugdraw.h"
+#include "game/debug/luacounter.h"
 #include "game/io/texturepool.h"
 #include "game/level/levelregistry.h"
 #include "game/level/luaconstants.h"
@@ -146,71 +148,34 @@ void LuaNode::initialize()
 
 void LuaNode::setupLua()
 {
-   _lua_state = luaL_newstate();
-
-   // register callbacks
-   lua_register(_lua_state, "addAudioRange", LuaNodeCallbacks::addAudioRange);
-   lua_register(_lua_state, "addDebugRect", LuaNodeCallbacks::addDebugRect);
-   lua_register(_lua_state, "addHitbox", LuaNodeCallbacks::addHitbox);
-   lua_register(_lua_state, "addPlayerSkill", LuaNodeCallbacks::addPlayerSkill);
-   lua_register(_lua_state, "addSample", LuaNodeCallbacks::addSample);
-   lua_register(_lua_state, "addShapeCircle", LuaNodeCallbacks::addShapeCircle);
-   lua_register(_lua_state, "addShapeRect", LuaNodeCallbacks::addShapeRect);
-   lua_register(_lua_state, "addShapeRectBevel", LuaNodeCallbacks::addShapeRectBevel);
-   lua_register(_lua_state, "addShapePoly", LuaNodeCallbacks::addShapePoly);
-   lua_register(_lua_state, "addSprite", LuaNodeCallbacks::addSprite);
-   lua_register(_lua_state, "addWeapon", LuaNodeCallbacks::addWeapon);
-   lua_register(_lua_state, "applyForce", LuaNodeCallbacks::applyForce);
-   lua_register(_lua_state, "applyLinearImpulse", LuaNodeCallbacks::applyLinearImpulse);
-   lua_register(_lua_state, "boom", LuaNodeCallbacks::boom);
-   lua_register(_lua_state, "damage", LuaNodeCallbacks::damage);
-   lua_register(_lua_state, "damageRadius", LuaNodeCallbacks::damageRadius);
-   lua_register(_lua_state, "die", LuaNodeCallbacks::die);
-   lua_register(_lua_state, "getLinearVelocity", LuaNodeCallbacks::getLinearVelocity);
-   lua_register(_lua_state, "getGravity", LuaNodeCallbacks::getGravity);
-   lua_register(_lua_state, "intersectsWithPlayer", LuaNodeCallbacks::intersectsWithPlayer);
-   lua_register(_lua_state, "isPhsyicsPathClear", LuaNodeCallbacks::isPhsyicsPathClear);
-   lua_register(_lua_state, "isPlayerDead", LuaNodeCallbacks::isPlayerDead);
-   lua_register(_lua_state, "log", LuaNodeCallbacks::debug);
-   lua_register(_lua_state, "makeDynamic", LuaNodeCallbacks::makeDynamic);
-   lua_register(_lua_state, "makeStatic", LuaNodeCallbacks::makeStatic);
-   lua_register(_lua_state, "playDetonationAnimation", LuaNodeCallbacks::playDetonationAnimation);
-   lua_register(_lua_state, "playSample", LuaNodeCallbacks::playSample);
-   lua_register(_lua_state, "queryAABB", LuaNodeCallbacks::queryAABB);
-   lua_register(_lua_state, "queryRayCast", LuaNodeCallbacks::queryRayCast);
-   lua_register(_lua_state, "registerHitAnimation", LuaNodeCallbacks::registerHitAnimation);
-   lua_register(_lua_state, "registerHitSamples", LuaNodeCallbacks::registerHitSamples);
-   lua_register(_lua_state, "removePlayerSkill", LuaNodeCallbacks::removePlayerSkill);
-   lua_register(_lua_state, "setActive", LuaNodeCallbacks::setActive);
-   lua_register(_lua_state, "setAudioUpdateBehavior", LuaNodeCallbacks::setAudioUpdateBehavior);
-   lua_register(_lua_state, "setDamage", LuaNodeCallbacks::setDamageToPlayer);
-   lua_register(_lua_state, "setGravityScale", LuaNodeCallbacks::setGravityScale);
-   lua_register(_lua_state, "setLinearVelocity", LuaNodeCallbacks::setLinearVelocity);
-   lua_register(_lua_state, "setProjectileZ", LuaNodeCallbacks::setProjectileZIndex);
-   lua_register(_lua_state, "setReferenceVolume", LuaNodeCallbacks::setReferenceVolume);
-   lua_register(_lua_state, "setSpriteColor", LuaNodeCallbacks::setSpriteColor);
-   lua_register(_lua_state, "setSpriteOffset", LuaNodeCallbacks::setSpriteOffset);
-   lua_register(_lua_state, "setSpriteOrigin", LuaNodeCallbacks::setSpriteOrigin);
-   lua_register(_lua_state, "setSpriteScale", LuaNodeCallbacks::setSpriteScale);
-   lua_register(_lua_state, "setSpriteVisible", LuaNodeCallbacks::setSpriteVisible);
-   lua_register(_lua_state, "setSpriteZ", LuaNodeCallbacks::setSpriteZIndex);
-   lua_register(_lua_state, "setTransform", LuaNodeCallbacks::setTransform);
-   lua_register(_lua_state, "setVisible", LuaNodeCallbacks::setVisible);
-   lua_register(_lua_state, "setZ", LuaNodeCallbacks::setZIndex);
-   lua_register(_lua_state, "timer", LuaNodeCallbacks::timer);
-   lua_register(_lua_state, "updateDebugRect", LuaNodeCallbacks::updateDebugRect);
-   lua_register(_lua_state, "updateKeysPressed", LuaNodeCallbacks::updateKeysPressed);
-   lua_register(_lua_state, "updateProjectileAnimation", LuaNodeCallbacks::updateProjectileAnimation);
-   lua_register(_lua_state, "updateProjectileTexture", LuaNodeCallbacks::updateProjectileTexture);
-   lua_register(_lua_state, "updateProperties", LuaNodeCallbacks::updateProperties);
-   lua_register(_lua_state, "updateSpriteRect", LuaNodeCallbacks::updateSpriteRect);
-   lua_register(_lua_state, "useWeapon", LuaNodeCallbacks::useWeapon);
-
-   // make standard libraries available in the Lua object
-   luaL_openlibs(_lua_state);
-
-   // load program
-   auto result = luaL_loadfile(_lua_state, _script_name.c_str());
+#ifdef DEVELOPMENT_MODE
+   const auto time_start = std::chrono::high_resolution_clock::now();
+#endif
+
+   // load program, either into a vm of its own or as an instance of the compiled chunk on the shared vm
+   auto result = LUA_OK;
+   if (Tweaks::instance()._lua_shared_vm)
+   {
+      _shared_vm_instance = LuaInterface::instance().getSharedVm().createInstance(_script_name);
+      _lua_state = _shared_vm_instance->_thread;
+      LuaInterface::instance().bindObject(_lua_state, this);
+   }
+   else
+   {
+      _lua_state = luaL_newstate();
+
+      // threads created by the script inherit the main thread's extra space, so coroutines resolve to this node, too
+      LuaInterface::instance().bindObject(_lua_state, this);
+
+      // register callbacks
+      LuaNodeCallbacks::registerCallbacks(_lua_state);
+
+      // make standard libraries available in the Lua object
+      luaL_openlibs(_lua_state);
+
+      result = luaL_loadfile(_lua_state, _script_name.c_str());
+   }
+
    if (result == LUA_OK)
    {
       // execute program
@@ -222,6 +187,7 @@ void LuaNode::setupLua()
       }
       else
       {
+         resolveHooks();
          luaSetStartPosition();
          luaMovedTo();
          luaRetrieveProperties();
@@ -239,6 +205,73 @@ void LuaNode::setupLua()
    {
       luaWriteProperty(prop._name, prop._value);
    }
+
+#ifdef DEVELOPMENT_MODE
+   LuaCounter::load_time_us += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - time_start).count();
+   LuaCounter::nodes_loaded++;
+#endif
+}
+
+int32_t LuaNode::getScriptGlobal(const char* name)
+{
+   // on the shared vm the script's globals live in its environment table, not in the global table
+   if (_shared_vm_instance.has_value())
+   {
+      return LuaInterface::instance().getSharedVm().getGlobal(_shared_vm_instance.value(), name);
+   }
+
+   return lua_getglobal(_lua_state, name);
+}
+
+void LuaNode::resolveHooks()
+{
+   // the hooks are called for every enemy on every frame; looking them up by name each time means a string hash and a
+   // table lookup per call, through the environment's __index on the shared vm. scripts define their hooks when their
+   // main chunk runs and never reassign them, so the functions are taken once
+   const auto resolve = [this](const char* name) -> std::optional<int32_t>
+   {
+      if (getScriptGlobal(name) != LUA_TFUNCTION)
+      {
+         lua_pop(_lua_state, 1);
+         return std::nullopt;
+      }
+
+      return luaL_ref(_lua_state, LUA_REGISTRYINDEX);
+   };
+
+   _hook_references._step = resolve(FUNCTION_STEP);
+   _hook_references._update = resolve(FUNCTION_UPDATE);
+   _hook_references._moved_to = resolve(FUNCTION_MOVED_TO);
+   _hook_references._player_moved_to = resolve(FUNCTION_PLAYER_MOVED_TO);
+}
+
+void LuaNode::releaseHooks()
+{
+   // only needed on the shared vm, a vm of its own takes the registry with it when it is closed
+   if (_shared_vm_instance.has_value())
+   {
+      for (const auto& reference :
+           {_hook_references._step, _hook_references._update, _hook_references._moved_to, _hook_references._player_moved_to})
+      {
+         if (reference.has_value())
+         {
+            luaL_unref(_lua_state, LUA_REGISTRYINDEX, reference.value());
+         }
+      }
+   }
+
+   _hook_references = {};
+}
+
+bool LuaNode::pushHook(const std::optional<int32_t>& reference)
+{
+   if (!reference.has_value())
+   {
+      return false;
+   }
+
+   lua_rawgeti(_lua_state, LUA_REGISTRYINDEX, reference.value());
+   return true;
 }
 
 void LuaNode::synchronizeProperties()
@@ -259,7 +292,7 @@ void LuaNode::synchronizeProperties()
  */
 void LuaNode::luaInitialize()
 {
-   lua_getglobal(_lua_state, FUNCTION_INITIALIZE);
+   getScriptGlobal(FUNCTION_INITIALIZE);
    const auto result = lua_pcall(_lua_state, 0, 0, 0);
 
    if (result != LUA_OK)
@@ -275,7 +308,11 @@ void LuaNode::luaInitialize()
  */
 void LuaNode::luaUpdate(const sf::Time& dt)
 {
-   lua_getglobal(_lua_state, FUNCTION_UPDATE);
+   if (!pushHook(_hook_references._update))
+   {
+      return;
+   }
+
    lua_pushnumber(_lua_state, dt.asSeconds());
 
    const auto result = lua_pcall(_lua_state, 1, 0, 0);
@@ -294,7 +331,7 @@ void LuaNode::luaUpdate(const sf::Time& dt)
  */
 void LuaNode::luaWriteProperty(const std::string& key, const std::string& value)
 {
-   lua_getglobal(_lua_state, FUNCTION_WRITE_PROPERTY);
+   getScriptGlobal(FUNCTION_WRITE_PROPERTY);
    if (lua_isfunction(_lua_state, -1))
    {
       lua_pushstring(_lua_state, key.c_str());
@@ -320,7 +357,7 @@ void LuaNode::luaHit(int32_t damage)
    _hit_time = std::chrono::high_resolution_clock::now();
    _damage_from_player = damage;
 
-   lua_getglobal(_lua_state, FUNCTION_HIT);
+   getScriptGlobal(FUNCTION_HIT);
    if (lua_isfunction(_lua_state, -1))
    {
       lua_pushinteger(_lua_state, damage);
@@ -339,7 +376,7 @@ void LuaNode::luaHit(int32_t damage)
  */
 void LuaNode::luaCollisionWithPlayer()
 {
-   lua_getglobal(_lua_state, FUNCTION_COLLISION_WITH_PLAYER);
+   getScriptGlobal(FUNCTION_COLLISION_WITH_PLAYER);
    if (lua_isfunction(_lua_state, -1))
    {
       const auto result = lua_pcall(_lua_state, 0, 0, 0);
@@ -354,7 +391,7 @@ void LuaNode::luaSmashed()
 {
    _smashed = true;
 
-   lua_getglobal(_lua_state, FUNCTION_SMASHED);
+   getScriptGlobal(FUNCTION_SMASHED);
    const auto result = lua_pcall(_lua_state, 0, 0, 0);
 
    if (result != LUA_OK)
@@ -374,7 +411,7 @@ void LuaNode::luaSendPatrolPath()
       return;
    }
 
-   lua_getglobal(_lua_state, FUNCTION_SET_PATH);
+   getScriptGlobal(FUNCTION_SET_PATH);
 
    lua_pushstring(_lua_state, "path");
    luaSendPath(_movement_path_px);
@@ -526,9 +563,7 @@ void LuaNode::luaMovedTo()
    const auto x = _position_px.x;
    const auto y = _position_px.y;
 
-   lua_getglobal(_lua_state, FUNCTION_MOVED_TO);
-
-   if (lua_isfunction(_lua_state, -1))
+   if (pushHook(_hook_references._moved_to))
    {
       lua_pushnumber(_lua_state, static_cast<double>(x));
       lua_pushnumber(_lua_state, static_cast<double>(y));
@@ -553,7 +588,7 @@ void LuaNode::luaSetStartPosition()
    const auto x = _start_position_px.x;
    const auto y = _start_position_px.y;
 
-   lua_getglobal(_lua_state, FUNCTION_SET_START_POSITION);
+   getScriptGlobal(FUNCTION_SET_START_POSITION);
 
    if (lua_isfunction(_lua_state, -1))
    {
@@ -579,9 +614,7 @@ void LuaNode::luaPlayerMovedTo()
 {
    const auto& pos = PlayerRegistry::getFirst()->getPixelPositionFloat();
 
-   lua_getglobal(_lua_state, FUNCTION_PLAYER_MOVED_TO);
-
-   if (lua_isfunction(_lua_state, -1))
+   if (pushHook(_hook_references._player_moved_to))
    {
       lua_pushnumber(_lua_state, pos.x);
       lua_pushnumber(_lua_state, pos.y);
@@ -595,13 +628,51 @@ void LuaNode::luaPlayerMovedTo()
    }
 }
 
+/**
+ * @brief LuaNode::luaStep runs the per-frame hooks of the script
+ * @param dt delta time, passed to luanode in seconds
+ * callback name: step
+ * lua param x: x position (double)
+ * lua param y: y position (double)
+ * lua param player_x: x position of player position (double)
+ * lua param player_y: y position of player position (double)
+ * lua param dt: delta time in seconds (double)
+ * scripts that do not define step get movedTo, playerMovedTo and update called instead, in that order
+ */
+void LuaNode::luaStep(const sf::Time& dt)
+{
+   if (!pushHook(_hook_references._step))
+   {
+      luaMovedTo();
+      luaPlayerMovedTo();
+      luaUpdate(dt);
+      return;
+   }
+
+   const auto& player_pos = PlayerRegistry::getFirst()->getPixelPositionFloat();
+
+   lua_pushnumber(_lua_state, static_cast<double>(_position_px.x));
+   lua_pushnumber(_lua_state, static_cast<double>(_position_px.y));
+   lua_pushnumber(_lua_state, player_pos.x);
+   lua_pushnumber(_lua_state, player_pos.y);
+   lua_pushnumber(_lua_state, dt.asSeconds());
+
+   // 5 args, 0 result
+   const auto result = lua_pcall(_lua_state, 5, 0, 0);
+
+   if (result != LUA_OK)
+   {
+      LuaNodeCallbacks::error(_lua_state, FUNCTION_STEP);
+   }
+}
+
 /**
  * @brief LuaNode::luaRetrieveProperties instruct lua node to retrieve properties now
  * callback name: retrieveProperties
  */
 void LuaNode::luaRetrieveProperties()
 {
-   lua_getglobal(_lua_state, FUNCTION_RETRIEVE_PROPERTIES);
+   getScriptGlobal(FUNCTION_RETRIEVE_PROPERTIES);
 
    // 0 args, 0 result
    const auto result = lua_pcall(_lua_state, 0, 0, 0);
@@ -620,7 +691,7 @@ void LuaNode::luaRetrieveProperties()
  */
 void LuaNode::luaTimeout(int32_t timerId)
 {
-   lua_getglobal(_lua_state, FUNCTION_TIMEOUT);
+   getScriptGlobal(FUNCTION_TIMEOUT);
    lua_pushinteger(_lua_state, timerId);
 
    const auto result = lua_pcall(_lua_state, 1, 0, 0);
@@ -987,7 +1058,17 @@ void LuaNode::removePlayerSkill(int32_t skill_type)
 
 void LuaNode::stopScript()
 {
-   if (_lua_state)
+   releaseHooks();
+
+   if (_shared_vm_instance.has_value())
+   {
+      // the thread may outlive this node until the shared vm collects it
+      LuaInterface::instance().bindObject(_lua_state, nullptr);
+      LuaInterface::instance().getSharedVm().releaseInstance(_shared_vm_instance.value());
+      _shared_vm_instance.reset();
+      _lua_state = nullptr;
+   }
+   else if (_lua_state)
    {
       lua_close(_lua_state);
       _lua_state = nullptr;
@@ -1201,6 +1282,7 @@ void LuaNode::addHitbox(int32_t left_px, int32_t top_px, int32_t width_px, int32
    // even though the node might probably be moving, it's safe to used a fixed chunk with the current bounding box
    _chunks.clear();
    addChunks(bounding_box);
+   LuaInterface::instance().updateChunks(this);
 }
 
 void LuaNode::addAudioRange(float far_distance, float far_volume, float near_distance, float near_volume)
@@ -1349,8 +1431,14 @@ void LuaNode::setProjectileZ(uint32_t weapon_index, int32_t z_index)
 
 void LuaNode::startTimer(int32_t delay, int32_t timer_id)
 {
+   // registered with this node as the caller so the level can drop them when it goes away
    Timer::add(
-      std::chrono::milliseconds(delay), [this, timer_id]() { luaTimeout(timer_id); }, Timer::Type::Singleshot, Timer::Scope::UpdateIngame
+      std::chrono::milliseconds(delay),
+      [this, timer_id]() { luaTimeout(timer_id); },
+      Timer::Type::Singleshot,
+      Timer::Scope::UpdateIngame,
+      nullptr,
+      this
    );
 }
 
@@ -19,6 +19,7 @@
 #include "game/level/enemydescription.h"
 #include "game/level/gamenode.h"
 #include "game/level/hitbox.h"
+#include "game/level/luasharedvm.h"
 #include "game/mechanisms/gamemechanism.h"
 #include "game/weapons/weapon.h"
 
@@ -488,6 +489,10 @@ struct LuaNode : public GameMechanism, public GameNode
    /// \param dt elapsed frame time.
    void luaUpdate(const sf::Time& dt);
 
+   /// \brief runs the per-frame script hooks: step when the script defines it, otherwise movedTo, playerMovedTo and update.
+   /// \param dt elapsed frame time.
+   void luaStep(const sf::Time& dt);
+
    /// \brief calls writeProperty callback with one key-value pair.
    /// \param key property key.
    /// \param value property value.
@@ -528,11 +533,39 @@ struct LuaNode : public GameMechanism, public GameNode
    /// \brief closes lua state and frees owned native resources.
    void stopScript();
 
+   /// \brief pushes a global of this node's script onto its lua stack.
+   /// \param name global name.
+   /// \return lua type of the pushed value.
+   int32_t getScriptGlobal(const char* name);
+
+   /// \brief takes registry references to the per-frame hooks so they are not looked up by name every frame.
+   void resolveHooks();
+
+   /// \brief drops the hook references taken by resolveHooks.
+   void releaseHooks();
+
+   /// \brief pushes a hook taken by resolveHooks onto the lua stack.
+   /// \param reference registry reference of the hook.
+   /// \return true if the script defines the hook and it was pushed.
+   bool pushHook(const std::optional<int32_t>& reference);
+
    // members
    int32_t _keys_pressed{0};
    std::string _script_name;
    std::string _name;
    lua_State* _lua_state{nullptr};
+   std::optional<LuaSharedVm::Instance> _shared_vm_instance;  //!< set when the script runs on the shared vm
+
+   //!< registry references to the hooks called every frame, unset when the script does not define them
+   struct HookReferences
+   {
+      std::optional<int32_t> _step;
+      std::optional<int32_t> _update;
+      std::optional<int32_t> _moved_to;
+      std::optional<int32_t> _player_moved_to;
+   };
+
+   HookReferences _hook_references;
    EnemyDescription _enemy_description;
    bool _visible{true};
 
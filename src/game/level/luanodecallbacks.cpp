@@ -1761,6 +1761,66 @@ int32_t removePlayerSkill(lua_State* state)
    return 0;
 }
 
+void registerCallbacks(lua_State* state)
+{
+   lua_register(state, "addAudioRange", addAudioRange);
+   lua_register(state, "addDebugRect", addDebugRect);
+   lua_register(state, "addHitbox", addHitbox);
+   lua_register(state, "addPlayerSkill", addPlayerSkill);
+   lua_register(state, "addSample", addSample);
+   lua_register(state, "addShapeCircle", addShapeCircle);
+   lua_register(state, "addShapeRect", addShapeRect);
+   lua_register(state, "addShapeRectBevel", addShapeRectBevel);
+   lua_register(state, "addShapePoly", addShapePoly);
+   lua_register(state, "addSprite", addSprite);
+   lua_register(state, "addWeapon", addWeapon);
+   lua_register(state, "applyForce", applyForce);
+   lua_register(state, "applyLinearImpulse", applyLinearImpulse);
+   lua_register(state, "boom", boom);
+   lua_register(state, "damage", damage);
+   lua_register(state, "damageRadius", damageRadius);
+   lua_register(state, "die", die);
+   lua_register(state, "getLinearVelocity", getLinearVelocity);
+   lua_register(state, "getGravity", getGravity);
+   lua_register(state, "intersectsWithPlayer", intersectsWithPlayer);
+   lua_register(state, "isPhsyicsPathClear", isPhsyicsPathClear);
+   lua_register(state, "isPlayerDead", isPlayerDead);
+   lua_register(state, "log", debug);
+   lua_register(state, "makeDynamic", makeDynamic);
+   lua_register(state, "makeStatic", makeStatic);
+   lua_register(state, "playDetonationAnimation", playDetonationAnimation);
+   lua_register(state, "playSample", playSample);
+   lua_register(state, "queryAABB", queryAABB);
+   lua_register(state, "queryRayCast", queryRayCast);
+   lua_register(state, "registerHitAnimation", registerHitAnimation);
+   lua_register(state, "registerHitSamples", registerHitSamples);
+   lua_register(state, "removePlayerSkill", removePlayerSkill);
+   lua_register(state, "setActive", setActive);
+   lua_register(state, "setAudioUpdateBehavior", setAudioUpdateBehavior);
+   lua_register(state, "setDamage", setDamageToPlayer);
+   lua_register(state, "setGravityScale", setGravityScale);
+   lua_register(state, "setLinearVelocity", setLinearVelocity);
+   lua_register(state, "setProjectileZ", setProjectileZIndex);
+   lua_register(state, "setReferenceVolume", setReferenceVolume);
+   lua_register(state, "setSpriteColor", setSpriteColor);
+   lua_register(state, "setSpriteOffset", setSpriteOffset);
+   lua_register(state, "setSpriteOrigin", setSpriteOrigin);
+   lua_register(state, "setSpriteScale", setSpriteScale);
+   lua_register(state, "setSpriteVisible", setSpriteVisible);
+   lua_register(state, "setSpriteZ", setSpriteZIndex);
+   lua_register(state, "setTransform", setTransform);
+   lua_register(state, "setVisible", setVisible);
+   lua_register(state, "setZ", setZIndex);
+   lua_register(state, "timer", timer);
+   lua_register(state, "updateDebugRect", updateDebugRect);
+   lua_register(state, "updateKeysPressed", updateKeysPressed);
+   lua_register(state, "updateProjectileAnimation", updateProjectileAnimation);
+   lua_register(state, "updateProjectileTexture", updateProjectileTexture);
+   lua_register(state, "updateProperties", updateProperties);
+   lua_register(state, "updateSpriteRect", updateSpriteRect);
+   lua_register(state, "useWeapon", useWeapon);
+}
+
 [[noreturn]] void error(lua_State* state, const char* /*scope*/)
 {
    // the error message is on top of the stack.
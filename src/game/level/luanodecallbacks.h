@@ -300,6 +300,11 @@ int32_t addPlayerSkill(lua_State* state);
 /// \return number of lua return values pushed to the stack.
 int32_t removePlayerSkill(lua_State* state);
 
+// registration
+/// \brief registers all callbacks above as lua globals.
+/// \param state lua state to register the callbacks with.
+void registerCallbacks(lua_State* state);
+
 // error handling
 /// \brief logs lua error text and terminates execution.
 /// \param state active lua state containing error message on top of the stack.
@@ -0,0 +1,144 @@
+#include "luasharedvm.h"
+
+#include <lua.hpp>
+
+#include "framework/tools/log.h"
+#include "game/level/luanodecallbacks.h"
+
+namespace
+{
+int32_t writeChunk(lua_State* /*state*/, const void* data, size_t size, void* user_data)
+{
+   static_cast<std::string*>(user_data)->append(static_cast<const char*>(data), size);
+   return 0;
+}
+}  // namespace
+
+LuaSharedVm::~LuaSharedVm()
+{
+   if (_state)
+   {
+      lua_close(_state);
+      _state = nullptr;
+   }
+}
+
+lua_State* LuaSharedVm::getState()
+{
+   if (!_state)
+   {
+      _state = luaL_newstate();
+
+      // threads copy the main thread's extra space, which is where LuaInterface keeps a thread's owning node;
+      // lua leaves it uninitialized, so coroutines started by a script would resolve to garbage otherwise
+      *static_cast<void**>(lua_getextraspace(_state)) = nullptr;
+
+      LuaNodeCallbacks::registerCallbacks(_state);
+      luaL_openlibs(_state);
+   }
+
+   return _state;
+}
+
+const std::string& LuaSharedVm::compile(const std::string& script_name)
+{
+   const auto it = _compiled_scripts.find(script_name);
+   if (it != _compiled_scripts.end())
+   {
+      return it->second;
+   }
+
+   auto* state = getState();
+   if (luaL_loadfile(state, script_name.c_str()) != LUA_OK)
+   {
+      LuaNodeCallbacks::error(state);
+   }
+
+   // debug info is kept so errors still carry file and line
+   std::string chunk;
+   lua_dump(state, writeChunk, &chunk, 0);
+   lua_pop(state, 1);
+
+   Log::Info() << "compiled " << script_name << " for the shared lua vm (" << chunk.size() << " bytes)";
+   return _compiled_scripts.emplace(script_name, std::move(chunk)).first->second;
+}
+
+LuaSharedVm::Instance LuaSharedVm::createInstance(const std::string& script_name)
+{
+   const auto& chunk = compile(script_name);
+   auto* state = getState();
+
+   Instance instance;
+
+   // the thread is what the callbacks get to see as lua_State, so it identifies the enemy
+   instance._thread = lua_newthread(state);
+   instance._thread_ref = luaL_ref(state, LUA_REGISTRYINDEX);
+
+   auto* thread = instance._thread;
+
+   // the environment keeps the script's own globals, everything else is looked up in the shared globals
+   lua_newtable(thread);
+   lua_newtable(thread);
+   lua_pushglobaltable(thread);
+   lua_setfield(thread, -2, "__index");
+   lua_setmetatable(thread, -2);
+   lua_pushvalue(thread, -1);
+   instance._environment_ref = luaL_ref(thread, LUA_REGISTRYINDEX);
+
+   // undumping a compiled chunk is much cheaper than parsing the source again; each instance needs a
+   // closure of its own anyway since the environment is the closure's first upvalue
+   if (luaL_loadbufferx(thread, chunk.data(), chunk.size(), script_name.c_str(), "b") != LUA_OK)
+   {
+      LuaNodeCallbacks::error(thread);
+   }
+
+   lua_rotate(thread, -2, 1);
+   lua_setupvalue(thread, -2, 1);
+
+   return instance;
+}
+
+void LuaSharedVm::releaseInstance(const Instance& instance)
+{
+   if (!_state)
+   {
+      return;
+   }
+
+   luaL_unref(_state, LUA_REGISTRYINDEX, instance._environment_ref);
+   luaL_unref(_state, LUA_REGISTRYINDEX, instance._thread_ref);
+}
+
+int32_t LuaSharedVm::getGlobal(const Instance& instance, const char* name)
+{
+   auto* thread = instance._thread;
+   lua_rawgeti(thread, LUA_REGISTRYINDEX, instance._environment_ref);
+   const auto type = lua_getfield(thread, -1, name);
+   lua_remove(thread, -2);
+   return type;
+}
+
+void LuaSharedVm::reset()
+{
+   _compiled_scripts.clear();
+
+   if (_state)
+   {
+      lua_gc(_state, LUA_GCCOLLECT);
+   }
+}
+
+int64_t LuaSharedVm::computeMemoryUsage() const
+{
+   if (!_state)
+   {
+      return 0;
+   }
+
+   return static_cast<int64_t>(lua_gc(_state, LUA_GCCOUNT)) * 1024 + lua_gc(_state, LUA_GCCOUNTB);
+}
+
+int32_t LuaSharedVm::getCompiledScriptCount() const
+{
+   return static_cast<int32_t>(_compiled_scripts.size());
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+struct lua_State;
+
+/// \brief one lua vm shared by all scripted enemies, as an alternative to a vm per LuaNode.
+///
+/// A vm per enemy means every enemy opens the standard libraries, registers every callback and
+/// parses its script file from scratch, so load time and memory grow with the enemy count. On the
+/// shared vm each distinct script is parsed once and kept as a compiled chunk. Every enemy then gets
+/// a thread of its own, so callbacks can still tell enemies apart by their lua_State, and an
+/// environment table of its own that holds the script's globals. Lookups the environment cannot
+/// answer fall through to the shared global table, which is where the libraries, the callbacks and
+/// the modules pulled in with require live.
+///
+/// Enabled through the 'lua_shared_vm' tweak.
+class LuaSharedVm
+{
+public:
+   LuaSharedVm() = default;
+   ~LuaSharedVm();
+
+   LuaSharedVm(const LuaSharedVm&) = delete;
+   LuaSharedVm& operator=(const LuaSharedVm&) = delete;
+
+   /// \brief one script instance living on the shared vm.
+   struct Instance
+   {
+      lua_State* _thread{nullptr};  //!< the instance's own thread, used for every call into its script
+      int32_t _thread_ref{0};       //!< registry reference that keeps the thread alive
+      int32_t _environment_ref{0};  //!< registry reference to the instance's environment table
+   };
+
+   /// \brief creates a script instance and leaves its main chunk on the instance's thread, ready to be called.
+   /// \param script_name path of the lua script; compiled on first use, then taken from the cache.
+   /// \return the new instance.
+   Instance createInstance(const std::string& script_name);
+
+   /// \brief releases the thread and the environment of a script instance.
+   /// \param instance instance to release.
+   void releaseInstance(const Instance& instance);
+
+   /// \brief pushes a global of a script instance, i.e. a field of its environment table.
+   /// \param instance instance to read from.
+   /// \param name global name.
+   /// \return lua type of the pushed value.
+   int32_t getGlobal(const Instance& instance, const char* name);
+
+   /// \brief drops all compiled chunks so scripts edited in the meantime are picked up, and collects garbage.
+   void reset();
+
+   /// \brief returns the memory currently held by the shared vm.
+   /// \return size in bytes, zero when the vm has not been created yet.
+   int64_t computeMemoryUsage() const;
+
+   /// \brief returns how many distinct scripts are held as compiled chunks.
+   /// \return compiled chunk count.
+   int32_t getCompiledScriptCount() const;
+
+private:
+   lua_State* getState();
+   const std::string& compile(const std::string& script_name);
+
+   lua_State* _state{nullptr};
+   std::unordered_map<std::string, std::string> _compiled_scripts;  //!< script name to lua_dump output
+};
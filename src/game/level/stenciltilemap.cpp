@@ -37,13 +37,18 @@ bool StencilTileMap::load(
       return false;
    }
 
+   return true;
+}
+
+void StencilTileMap::upload()
+{
+   TileMap::upload();
+
    if (!_stencil_shader.loadFromFile("data/shaders/stencil_write.vert", "data/shaders/stencil_write.frag"))
    {
       Log::Error() << "failed to load stencil_write shader";
    }
    _stencil_shader.setUniform("u_alpha_threshold", _alpha_threshold);
-
-   return true;
 }
 
 void StencilTileMap::draw(
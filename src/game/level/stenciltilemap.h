@@ -33,6 +33,9 @@ public:
    bool load(const std::shared_ptr<TmxLayer>& layer, const std::shared_ptr<TmxTileSet>& tileset, const std::filesystem::path& base_path)
       override;
 
+   /// \brief uploads the base tilemap and loads the stencil shader.
+   void upload() override;
+
    /// \brief draws this layer using stencil mask data from the referenced tilemap.
    /// \param color color render target.
    /// \param normal normal render target.
@@ -5,7 +5,10 @@
 #include <math.h>
 #include <algorithm>
 #include <iostream>
+#include <iterator>
+#include <limits>
 #include <map>
+#include <numeric>
 
 // tmx
 #include "framework/tmxparser/tmxanimation.h"
@@ -18,44 +21,59 @@
 #include "framework/tmxparser/tmxtileset.h"
 #include "framework/tools/log.h"
 #include "framework/tools/sfmlcompat.h"
+#include "framework/tools/sfmlshader.h"
 #include "game/debug/drawcallcounter.h"
+#include "game/io/imagepool.h"
 #include "game/io/texturepool.h"
 #include "game/level/blendmodedeserializer.h"
-#include "game/player/playerregistry.h"
 
 namespace
 {
 constexpr auto tile_count_per_block = 16;
-constexpr auto block_range_half_x = 3;
-constexpr auto block_range_half_y = 2;
 
 //! slack added around the view before the block window is derived from it, in pixels. the view used
 //! for culling is the very one being rendered, so this only has to absorb rounding rather than any
 //! camera movement, and is deliberately far smaller than the block size
 constexpr auto block_margin_px = 48.0f;
 
-std::array<int32_t, 2> getPlayerBlock()
-{
-   // draw the vertex arrays
-   const auto& player_pos_px = PlayerRegistry::getFirst()->getPixelPositionInt();
-   return {(player_pos_px.x / PIXELS_PER_TILE) / tile_count_per_block, (player_pos_px.y / PIXELS_PER_TILE) / tile_count_per_block};
-}
+// these have to match animated_tile.vert
+constexpr auto frame_table_width = 256u;
+constexpr auto max_frames_per_animation = 64u;
+constexpr auto max_frame_table_frames = 0xffffu;
 
-}  // namespace
+//! the animation clock is handed to the shader as a float, which has run out of millisecond precision
+//! after about four and a half hours. it is wrapped well before that when the animations of a layer do
+//! not line up again any sooner
+constexpr auto max_animation_period_ms = 1 << 22;
 
-TileMap::~TileMap()
+sfcompat::Shader* getAnimatedTileShader()
 {
-   _vertices_animated.clear();
+   static sfcompat::Shader shader;
+   static auto loaded = false;
+   static auto attempted = false;
 
-   for (auto& [k1, v1] : _vertices_static_blocks)
+   if (!attempted)
    {
-      for (auto& [k2, v2] : v1)
+      attempted = true;
+      loaded = shader.loadFromFile("data/shaders/animated_tile.vert", "data/shaders/animated_tile.frag");
+      if (!loaded)
       {
-         v2.clear();
+         Log::Error() << "failed to load animated_tile shader, animated tiles will not animate";
       }
    }
+
+   return loaded ? &shader : nullptr;
 }
 
+void writeFrameTableValue(std::vector<uint8_t>& pixels, size_t offset, uint32_t value)
+{
+   const auto clamped = std::min(value, 0xffffu);
+   pixels[offset] = static_cast<uint8_t>(clamped & 0xff);
+   pixels[offset + 1] = static_cast<uint8_t>(clamped >> 8);
+}
+
+}  // namespace
+
 bool TileMap::isVisible() const
 {
    return _visible;
@@ -66,63 +84,251 @@ void TileMap::setVisible(bool visible)
    _visible = visible;
 }
 
-void TileMap::storeAnimation(const std::array<sf::Vertex, 4>& quad, int32_t tx, int32_t ty, const std::shared_ptr<TmxAnimation>& animation)
+void TileMap::storeAnimation(std::array<sf::Vertex, 4> quad, float parallax_scale, const std::shared_ptr<TmxAnimation>& animation)
 {
    const auto& frames = animation->_frames;
+   const auto tiles_per_row = _texture_image->getSize().x / _tile_size_px.x;
 
-   auto animated_tile = new AnimatedTile();
-   animated_tile->_x_tl = tx;
-   animated_tile->_y_tl = ty;
-   animated_tile->_animation = animation;
-
-   auto duration = 0.0f;
-   for (const auto& frame : frames)
+   // every tile showing the same tile id shares its animation, so each animation is put into the table once
+   auto entry_it = _animation_entries.find(animation.get());
+   if (entry_it == _animation_entries.end())
    {
-      auto offset_frame = new AnimatedTileFrame();
-      offset_frame->_x_px = frame->_tile_id % (_texture_map->getSize().x / _tile_size_px.x);
-      offset_frame->_y_px = frame->_tile_id / (_texture_map->getSize().x / _tile_size_px.x);
-      offset_frame->_duration_ms = frame->_duration_ms;
-      animated_tile->_frames.push_back(offset_frame);
-      duration += frame->_duration_ms;
-   }
+      const auto first_frame = _frame_table_frame_count;
+      const auto frame_count = static_cast<uint32_t>(std::min<size_t>(frames.size(), max_frames_per_animation));
+      if (frame_count == 0 || first_frame + frame_count > max_frame_table_frames)
+      {
+         storeStaticVertices(quad, parallax_scale);
+         return;
+      }
 
-   animated_tile->_duration = duration;
+      if (frames.size() > max_frames_per_animation)
+      {
+         Log::Warning() << "layer " << _layer_name << " has an animation with " << frames.size() << " frames, only the first "
+                         << max_frames_per_animation << " are played";
+      }
 
-   animated_tile->_vertices[0] = quad[0];
-   animated_tile->_vertices[1] = quad[1];
-   animated_tile->_vertices[2] = quad[2];
-   animated_tile->_vertices[3] = quad[3];
+      // every frame is one column across two rows, see animated_tile.vert
+      auto duration_ms = 0u;
+      for (auto i = 0u; i < frame_count; i++)
+      {
+         duration_ms += static_cast<uint32_t>(frames[i]->_duration_ms);
+      }
+
+      auto frame_end_ms = 0u;
+      for (auto i = 0u; i < frame_count; i++)
+      {
+         const auto frame_index = first_frame + i;
+         const auto band_rows = (frame_index / frame_table_width + 1) * 2;
+         if (band_rows > _frame_table_size.y)
+         {
+            _frame_table_size = {frame_table_width, band_rows};
+            _frame_table_pixels.resize(static_cast<size_t>(_frame_table_size.x) * _frame_table_size.y * 4, 0);
+         }
+
+         const auto& frame = frames[i];
+         frame_end_ms += static_cast<uint32_t>(frame->_duration_ms);
 
-   _animations.push_back(animated_tile);
+         const auto column = frame_index % frame_table_width;
+         const auto tile_row = band_rows - 2;
+         const auto tile_offset = (static_cast<size_t>(tile_row) * frame_table_width + column) * 4;
+         const auto timing_offset = tile_offset + frame_table_width * 4;
+         writeFrameTableValue(_frame_table_pixels, tile_offset, static_cast<uint32_t>(frame->_tile_id) % tiles_per_row);
+         writeFrameTableValue(_frame_table_pixels, tile_offset + 2, static_cast<uint32_t>(frame->_tile_id) / tiles_per_row);
+         writeFrameTableValue(_frame_table_pixels, timing_offset, frame_end_ms);
+         writeFrameTableValue(_frame_table_pixels, timing_offset + 2, duration_ms);
+
+         const auto tile_id = static_cast<uint32_t>(frame->_tile_id);
+         _animation_frames.push_back({tile_id % tiles_per_row, tile_id / tiles_per_row, frame_end_ms, duration_ms});
+      }
+
+      if (duration_ms > 0)
+      {
+         const auto period_ms = _animation_period_ms > 0.0 ? std::lcm(static_cast<int64_t>(_animation_period_ms), int64_t{duration_ms})
+                                                            : int64_t{duration_ms};
+         _animation_period_ms = static_cast<double>(std::min<int64_t>(period_ms, max_animation_period_ms));
+      }
+
+      _frame_table_frame_count += frame_count;
+      entry_it = _animation_entries.emplace(animation.get(), AnimationEntry{first_frame, frame_count}).first;
+   }
+
+   // the quad starts on the first frame in white; upload() decides whether the shader or update() animates it
+   const auto& entry = entry_it->second;
+   const auto first_frame_tile = static_cast<uint32_t>(frames.front()->_tile_id);
+   const auto tu = first_frame_tile % tiles_per_row;
+   const auto tv = first_frame_tile / tiles_per_row;
+   quad[0].texCoords = sf::Vector2f(static_cast<float>(tu * _tile_size_px.x), static_cast<float>(tv * _tile_size_px.y));
+   quad[1].texCoords = sf::Vector2f(static_cast<float>((tu + 1) * _tile_size_px.x), static_cast<float>(tv * _tile_size_px.y));
+   quad[2].texCoords = sf::Vector2f(static_cast<float>((tu + 1) * _tile_size_px.x), static_cast<float>((tv + 1) * _tile_size_px.y));
+   quad[3].texCoords = sf::Vector2f(static_cast<float>(tu * _tile_size_px.x), static_cast<float>((tv + 1) * _tile_size_px.y));
+
+   storeStaticVertices(quad, parallax_scale, entry);
 }
 
-void TileMap::storeStaticVertices(const std::array<sf::Vertex, 4>& quad, float parallax_scale)
+void TileMap::storeStaticVertices(const std::array<sf::Vertex, 4>& quad, float parallax_scale, std::optional<AnimationEntry> animation)
 {
-   // if no animation is available, just store the tile in the static buffer
    const auto bx = static_cast<int32_t>((quad[0].position.x / static_cast<float>(_tile_size_px.x) / parallax_scale) / tile_count_per_block);
    const auto by = static_cast<int32_t>((quad[0].position.y / static_cast<float>(_tile_size_px.y) / parallax_scale) / tile_count_per_block);
 
-   auto y_it = _vertices_static_blocks.find(by);
-   if (y_it == _vertices_static_blocks.end())
+   _staged_quads.push_back({bx, by, animation, quad});
+}
+
+void TileMap::buildStaticBlocks()
+{
+   _static_vertices.clear();
+   _static_blocks.clear();
+   _block_origin = {};
+   _block_count = {};
+   _static_vertex_count = 0;
+
+   if (_staged_quads.empty())
+   {
+      return;
+   }
+
+   const auto [min_x, max_x] = std::ranges::minmax(_staged_quads | std::views::transform(&StagedQuad::_block_x));
+   const auto [min_y, max_y] = std::ranges::minmax(_staged_quads | std::views::transform(&StagedQuad::_block_y));
+
+   _block_origin = {min_x, min_y};
+   _block_count = {max_x - min_x + 1, max_y - min_y + 1};
+   _static_blocks.resize(static_cast<size_t>(_block_count.x) * static_cast<size_t>(_block_count.y));
+
+   const auto block_index = [this](const StagedQuad& staged)
+   {
+      const auto column = static_cast<size_t>(staged._block_x - _block_origin.x);
+      const auto row = static_cast<size_t>(staged._block_y - _block_origin.y);
+      return row * _block_count.x + column;
+   };
+
+   // count first so every block gets its ranges, then fill the ranges in the order the tiles were stored.
+   // the animated ranges come after all static ones since they are drawn with a shader of their own
+   for (const auto& staged : _staged_quads)
+   {
+      auto& block = _static_blocks[block_index(staged)];
+      (staged._animation ? block._animated_vertex_count : block._vertex_count) += 6;
+   }
+
+   auto vertex_offset = 0u;
+   for (auto& block : _static_blocks)
+   {
+      block._first_vertex = vertex_offset;
+      vertex_offset += block._vertex_count;
+   }
+
+   _static_vertex_count = vertex_offset;
+
+   for (auto& block : _static_blocks)
+   {
+      block._first_animated_vertex = vertex_offset;
+      vertex_offset += block._animated_vertex_count;
+   }
+
+   _static_vertices.resize(vertex_offset);
+   _animated_tile_entries.resize((vertex_offset - _static_vertex_count) / 6);
+   _animated_tile_frames.assign(_animated_tile_entries.size(), 0);
+
+   std::vector<uint32_t> write_positions;
+   std::vector<uint32_t> animated_write_positions;
+   write_positions.reserve(_static_blocks.size());
+   animated_write_positions.reserve(_static_blocks.size());
+   std::ranges::transform(_static_blocks, std::back_inserter(write_positions), &StaticBlock::_first_vertex);
+   std::ranges::transform(_static_blocks, std::back_inserter(animated_write_positions), &StaticBlock::_first_animated_vertex);
+
+   for (const auto& staged : _staged_quads)
+   {
+      auto& write_position = (staged._animation ? animated_write_positions : write_positions)[block_index(staged)];
+      if (staged._animation)
+      {
+         const auto tile_index = (write_position - _static_vertex_count) / 6;
+         _animated_tile_entries[tile_index] = staged._animation.value();
+         _animated_tile_frames[tile_index] = staged._animation->_first_frame;
+      }
+
+      const auto& quad = staged._quad;
+      for (const auto corner : {0, 1, 2, 0, 2, 3})
+      {
+         _static_vertices[write_position++] = quad[corner];
+      }
+   }
+
+   _staged_quads.clear();
+   _staged_quads.shrink_to_fit();
+}
+
+const TileMap::StaticBlock* TileMap::getStaticBlock(int32_t bx, int32_t by) const
+{
+   const auto column = bx - _block_origin.x;
+   const auto row = by - _block_origin.y;
+   if (column < 0 || row < 0 || column >= _block_count.x || row >= _block_count.y)
    {
-      std::map<int32_t, sf::VertexArray> map;
-      _vertices_static_blocks.insert(std::make_pair(by, map));
+      return nullptr;
    }
 
-   const auto x_it = _vertices_static_blocks[by].find(bx);
-   if (x_it == _vertices_static_blocks[by].end())
+   return &_static_blocks[static_cast<size_t>(row) * _block_count.x + static_cast<size_t>(column)];
+}
+
+void TileMap::upload()
+{
+   if (_texture_image)
    {
-      _vertices_static_blocks[by][bx].setPrimitiveType(sf::PrimitiveType::Triangles);
+      _texture_map = TexturePool::getInstance().get(_texture_path, *_texture_image);
+      _texture_image.reset();
    }
 
-   sf::VertexArray& vertex_array = _vertices_static_blocks[by][bx];
-   vertex_array.append(quad[0]);
-   vertex_array.append(quad[1]);
-   vertex_array.append(quad[2]);
+   if (_normal_map_image)
+   {
+      _normal_map = TexturePool::getInstance().get(_normal_map_path, *_normal_map_image);
+      _normal_map_image.reset();
+   }
 
-   vertex_array.append(quad[0]);
-   vertex_array.append(quad[2]);
-   vertex_array.append(quad[3]);
+   if (!_frame_table_pixels.empty() && !_frame_table)
+   {
+#ifdef DECEPTUS_VRSFML
+      auto created_texture = sf::Texture::create(_frame_table_size);
+      if (created_texture.hasValue())
+      {
+         _frame_table = std::make_unique<sf::Texture>(std::move(*created_texture));
+      }
+#else
+      _frame_table = std::make_unique<sf::Texture>(_frame_table_size);
+#endif
+
+      if (_frame_table)
+      {
+         _frame_table->update(_frame_table_pixels.data());
+      }
+      else
+      {
+         Log::Error() << "failed to create the animation frame table of layer " << _layer_name;
+      }
+
+      // the vertex colors only turn into frame table entries when there is something to read them; without
+      // the table or the shader the tiles stay white and update() animates them on the cpu
+      if (_frame_table && getAnimatedTileShader())
+      {
+         encodeAnimationEntries();
+         _shader_animation = true;
+      }
+   }
+
+#ifndef DECEPTUS_VRSFML
+   if (_static_vertices_uploaded || _static_vertices.empty() || !sf::VertexBuffer::isAvailable())
+   {
+      return;
+   }
+
+   if (!_static_vertex_buffer.create(_static_vertices.size()) || !_static_vertex_buffer.update(_static_vertices.data()))
+   {
+      Log::Warning() << "failed to upload the tiles of layer " << _layer_name << ", they are drawn from memory instead";
+      return;
+   }
+
+   _static_vertices_uploaded = true;
+
+#ifdef DEVELOPMENT_MODE
+   DrawCallCounter::tilemap_bytes_uploaded += static_cast<int64_t>(_static_vertices.size() * sizeof(sf::Vertex));
+#endif
+#endif
 }
 
 bool TileMap::load(
@@ -139,17 +345,25 @@ bool TileMap::load(
    _layer_name = layer->_name;
    _tileset_name = tileset->_name;
 
-   auto path = (base_path / tileset->_image->_source);
+   // load runs on a worker thread, so the images are only decoded here; upload() turns them into textures
+   _texture_path = (base_path / tileset->_image->_source);
+   _texture_image = ImagePool::getInstance().get(_texture_path);
 
-   _texture_map = TexturePool::getInstance().get(path);
+   if (!_texture_image || _texture_image->getSize().x < static_cast<uint32_t>(tileset->_tile_width_px))
+   {
+      Log::Error() << "failed to load tileset texture " << _texture_path.string() << " of layer " << _layer_name;
+      _texture_image.reset();
+      return false;
+   }
 
    // check if we have a bumpmap and, if so, load it
-   const auto normal_map_filename = (path.stem().string() + "_normals" + path.extension().string());
-   const auto normal_map_path = (path.parent_path() / normal_map_filename);
+   const auto normal_map_filename = (_texture_path.stem().string() + "_normals" + _texture_path.extension().string());
+   const auto normal_map_path = (_texture_path.parent_path() / normal_map_filename);
    if (std::filesystem::exists(normal_map_path))
    {
       // Log::Info() << "found normal map for " << path.string();
-      _normal_map = TexturePool::getInstance().get(normal_map_path);
+      _normal_map_path = normal_map_path;
+      _normal_map_image = ImagePool::getInstance().get(normal_map_path);
    }
 
    auto parallax_scale = 1.0f;
@@ -178,8 +392,6 @@ bool TileMap::load(
    _visible = layer->_visible;
    _z_index = layer->_z;
 
-   _vertices_animated.setPrimitiveType(sf::PrimitiveType::Triangles);
-
    auto& tile_map = tileset->_tile_map;
 
    // populate the vertex array, with one quad per tile
@@ -196,8 +408,8 @@ bool TileMap::load(
          }
 
          // find its position in the tileset texture
-         const auto tu = (tile_number - tileset->_first_gid) % (_texture_map->getSize().x / _tile_size_px.x);
-         const auto tv = (tile_number - tileset->_first_gid) / (_texture_map->getSize().x / _tile_size_px.x);
+         const auto tu = (tile_number - tileset->_first_gid) % (_texture_image->getSize().x / _tile_size_px.x);
+         const auto tv = (tile_number - tileset->_first_gid) / (_texture_image->getSize().x / _tile_size_px.x);
          const auto tx = static_cast<int32_t>(pos_x);
          const auto ty = static_cast<int32_t>(pos_y);
          const auto tile_x_px = tx * static_cast<int32_t>(_tile_size_px.x) + layer->_position_x_px;
@@ -232,7 +444,7 @@ bool TileMap::load(
          auto it = tile_map.find(tile_number - tileset->_first_gid);
          if (it != tile_map.end() && it->second->_animation)
          {
-            storeAnimation(quad, tx, ty, it->second->_animation);
+            storeAnimation(quad, parallax_scale, it->second->_animation);
          }
          else
          {
@@ -241,67 +453,104 @@ bool TileMap::load(
       }
    }
 
+   buildStaticBlocks();
+
    return true;
 }
 
 void TileMap::update(const sf::Time& dt)
 {
-   _vertices_animated.clear();
+   if (_animation_period_ms <= 0.0)
+   {
+      return;
+   }
 
-   const auto player_block = getPlayerBlock();
+   _animation_time_ms = std::fmod(_animation_time_ms + static_cast<double>(dt.asMilliseconds()), _animation_period_ms);
 
-   for (auto& anim : _animations)
+   if (!_shader_animation)
    {
-      if (!anim->_visible)
-      {
-         continue;
-      }
+      updateAnimatedTexCoords();
+   }
+}
 
-      // only add those that are close enough to the player
-      const auto bx = static_cast<int32_t>((anim->_x_tl) / tile_count_per_block);
-      const auto by = static_cast<int32_t>((anim->_y_tl) / tile_count_per_block);
-      if (std::abs(player_block[0] - bx) > block_range_half_x || std::abs(player_block[1] - by) > block_range_half_y)
+void TileMap::encodeAnimationEntries()
+{
+   for (auto tile_index = 0u; tile_index < _animated_tile_entries.size(); tile_index++)
+   {
+      const auto& entry = _animated_tile_entries[tile_index];
+      const auto first_vertex = _static_vertex_count + tile_index * 6;
+      for (auto vertex_index = first_vertex; vertex_index < first_vertex + 6; vertex_index++)
       {
-         continue;
+         auto& color = _static_vertices[vertex_index].color;
+         color.r = static_cast<uint8_t>(entry._first_frame & 0xff);
+         color.g = static_cast<uint8_t>(entry._first_frame >> 8);
+         color.b = static_cast<uint8_t>(entry._frame_count);
       }
+   }
+}
 
-      anim->_elapsed_ms += dt.asMilliseconds();
-      anim->_elapsed_ms = fmod(anim->_elapsed_ms, anim->_duration);
+void TileMap::updateAnimatedTexCoords()
+{
+   // the same frame lookup as animated_tile.vert, only the tiles whose frame changed are rewritten
+   auto first_changed = std::numeric_limits<uint32_t>::max();
+   auto end_changed = 0u;
 
-      auto index = 0u;
-      float frame_duration = 0.0f;
-      for (auto* frame : anim->_frames)
-      {
-         frame_duration += frame->_duration_ms;
+   for (auto tile_index = 0u; tile_index < _animated_tile_entries.size(); tile_index++)
+   {
+      const auto& entry = _animated_tile_entries[tile_index];
+      const auto duration_ms = _animation_frames[entry._first_frame]._duration_ms;
+      const auto time_ms = duration_ms > 0 ? std::fmod(_animation_time_ms, static_cast<double>(duration_ms)) : 0.0;
 
-         if (frame_duration > anim->_elapsed_ms)
-         {
-            break;
-         }
+      auto frame_index = entry._first_frame;
+      const auto last_frame_index = entry._first_frame + entry._frame_count - 1;
+      while (frame_index < last_frame_index && time_ms >= static_cast<double>(_animation_frames[frame_index]._end_ms))
+      {
+         frame_index++;
+      }
 
-         index++;
+      if (_animated_tile_frames[tile_index] == frame_index)
+      {
+         continue;
       }
 
-      auto frame = anim->_frames.at(index);
+      _animated_tile_frames[tile_index] = frame_index;
 
-      const auto tu = static_cast<uint32_t>(frame->_x_px);
-      const auto tv = static_cast<uint32_t>(frame->_y_px);
+      const auto& frame = _animation_frames[frame_index];
+      const auto left = static_cast<float>(frame._tu * _tile_size_px.x);
+      const auto top = static_cast<float>(frame._tv * _tile_size_px.y);
+      const auto right = static_cast<float>((frame._tu + 1) * _tile_size_px.x);
+      const auto bottom = static_cast<float>((frame._tv + 1) * _tile_size_px.y);
 
-      // re-define its 4 texture coordinates
-      anim->_vertices[0].texCoords = sf::Vector2f(static_cast<float>(tu * _tile_size_px.x), static_cast<float>(tv * _tile_size_px.y));
-      anim->_vertices[1].texCoords = sf::Vector2f(static_cast<float>((tu + 1) * _tile_size_px.x), static_cast<float>(tv * _tile_size_px.y));
-      anim->_vertices[2].texCoords =
-         sf::Vector2f(static_cast<float>((tu + 1) * _tile_size_px.x), static_cast<float>((tv + 1) * _tile_size_px.y));
-      anim->_vertices[3].texCoords = sf::Vector2f(static_cast<float>(tu * _tile_size_px.x), static_cast<float>((tv + 1) * _tile_size_px.y));
+      // the corners of the two triangles, see buildStaticBlocks
+      const std::array<sf::Vector2f, 6> tex_coords{
+         {{left, top}, {right, top}, {right, bottom}, {left, top}, {right, bottom}, {left, bottom}}
+      };
 
-      _vertices_animated.append(anim->_vertices[0]);
-      _vertices_animated.append(anim->_vertices[1]);
-      _vertices_animated.append(anim->_vertices[2]);
+      const auto first_vertex = _static_vertex_count + tile_index * 6;
+      for (auto corner = 0u; corner < 6; corner++)
+      {
+         _static_vertices[first_vertex + corner].texCoords = tex_coords[corner];
+      }
 
-      _vertices_animated.append(anim->_vertices[0]);
-      _vertices_animated.append(anim->_vertices[2]);
-      _vertices_animated.append(anim->_vertices[3]);
+      first_changed = std::min(first_changed, first_vertex);
+      end_changed = first_vertex + 6;
    }
+
+#ifndef DECEPTUS_VRSFML
+   if (_static_vertices_uploaded && end_changed > 0)
+   {
+      if (!_static_vertex_buffer.update(&_static_vertices[first_changed], end_changed - first_changed, first_changed))
+      {
+         Log::Warning() << "failed to update the animated tiles of layer " << _layer_name;
+      }
+#ifdef DEVELOPMENT_MODE
+      DrawCallCounter::tilemap_bytes_uploaded += static_cast<int64_t>((end_changed - first_changed) * sizeof(sf::Vertex));
+#endif
+   }
+#else
+   (void)first_changed;
+   (void)end_changed;
+#endif
 }
 
 void TileMap::drawVertices(sf::RenderTarget& target, sf::RenderStates states, const std::vector<sf::FloatRect>& clip_rects_px) const
@@ -368,20 +617,27 @@ void TileMap::drawVertices(sf::RenderTarget& target, sf::RenderStates states, co
    const auto first_block_y = static_cast<int32_t>(std::floor(view_top_px / block_height_px));
    const auto last_block_y = static_cast<int32_t>(std::floor(view_bottom_px / block_height_px));
 
-   // walking the blocks that exist inside the range, rather than probing every index in it, keeps
-   // the work proportional to what is on screen instead of to the size of the range. that also makes
-   // the loop immune to a nonsensical range: a degenerate view or tile size can produce bounds
-   // spanning the whole int32 domain, and probing those index by index takes billions of lookups,
-   // which is indistinguishable from a hang
-   const auto row_end = _vertices_static_blocks.upper_bound(last_block_y);
-   for (auto row_it = _vertices_static_blocks.lower_bound(first_block_y); row_it != row_end; ++row_it)
-   {
-      auto& row = row_it->second;
-      const auto column_end = row.upper_bound(last_block_x);
-      for (auto column_it = row.lower_bound(first_block_x); column_it != column_end; ++column_it)
+   // only the part of the window that overlaps the block grid is walked. that also makes the loop
+   // immune to a nonsensical range: a degenerate view or tile size can produce bounds spanning the
+   // whole int32 domain, and probing those index by index takes billions of lookups, which is
+   // indistinguishable from a hang
+   const auto grid_first_x = std::max(first_block_x, _block_origin.x);
+   const auto grid_last_x = std::min(last_block_x, _block_origin.x + _block_count.x - 1);
+   const auto grid_first_y = std::max(first_block_y, _block_origin.y);
+   const auto grid_last_y = std::min(last_block_y, _block_origin.y + _block_count.y - 1);
+
+   _visible_blocks.clear();
+
+   for (auto by = grid_first_y; by <= grid_last_y; by++)
+   {
+      for (auto bx = grid_first_x; bx <= grid_last_x; bx++)
       {
-         const auto& block_vertices = column_it->second;
-         const auto block_vertex_count = block_vertices.getVertexCount();
+         const auto& block = *getStaticBlock(bx, by);
+         const auto block_vertex_count = block._vertex_count + block._animated_vertex_count;
+         if (block_vertex_count == 0)
+         {
+            continue;
+         }
 
          // a block the caller cannot use is dropped before it is copied into the batch, so it costs
          // neither the copy nor the fill. the normal pass uses this: a block no light reaches
@@ -389,8 +645,7 @@ void TileMap::drawVertices(sf::RenderTarget& target, sf::RenderStates states, co
          if (!clip_rects_px.empty())
          {
             const auto block_rect_px = sf::FloatRect{
-               {static_cast<float>(column_it->first) * block_width_px, static_cast<float>(row_it->first) * block_height_px},
-               {block_width_px, block_height_px}
+               {static_cast<float>(bx) * block_width_px, static_cast<float>(by) * block_height_px}, {block_width_px, block_height_px}
             };
 
             const auto touches_clip_rect = std::ranges::any_of(
@@ -410,16 +665,13 @@ void TileMap::drawVertices(sf::RenderTarget& target, sf::RenderStates states, co
             }
          }
 
-         if (block_vertex_count > 0)
-         {
-            _batched_vertices.insert(_batched_vertices.end(), &block_vertices[0], &block_vertices[0] + block_vertex_count);
-         }
+         _visible_blocks.push_back(&block);
 #ifdef DEVELOPMENT_MODE
          // blocks are drawn whole but only partly on screen, so scale the block's tile area by how
          // much of the block the view actually covers. counting the whole block would report fill
          // that the rasteriser never pays for
-         const auto block_left_px = static_cast<float>(column_it->first) * block_width_px;
-         const auto block_top_px = static_cast<float>(row_it->first) * block_height_px;
+         const auto block_left_px = static_cast<float>(bx) * block_width_px;
+         const auto block_top_px = static_cast<float>(by) * block_height_px;
          const auto visible_width_px = std::max(
             0.0f,
             std::min(block_left_px + block_width_px, view_center.x + view_size.x * 0.5f) -
@@ -456,14 +708,99 @@ void TileMap::drawVertices(sf::RenderTarget& target, sf::RenderStates states, co
       }
    }
 
-   // the animated tiles carry the same texture and blend mode as the static blocks, so they join
-   // the same batch rather than paying for a call of their own
-   const auto animated_vertex_count = _vertices_animated.getVertexCount();
-   if (animated_vertex_count > 0)
+   submitVisibleBlocks(target, states, &StaticBlock::_first_vertex, &StaticBlock::_vertex_count);
+   flushBatch(target, states);
+
+   // the animated tiles go second. when the shader picks their frames, a caller that brings a shader of its
+   // own, like the stencil pass, gets the first frame of every animation, drawn from a copy with the frame
+   // table entries in the vertex colors reset to white. without the shader update() has set their texcoords
+   if (_shader_animation && states.shader)
+   {
+      drawAnimatedTilesWithoutShader(target, states);
+      return;
+   }
+
+   if (_shader_animation)
+   {
+      auto* animated_tile_shader = getAnimatedTileShader();
+      animated_tile_shader->setUniform("u_texture_sampler", sf::Shader::CurrentTexture);
+      animated_tile_shader->setUniform("u_frame_table", *_frame_table);
+      animated_tile_shader->setUniform(
+         "u_frame_table_size", sf::Glsl::Vec2(static_cast<float>(_frame_table_size.x), static_cast<float>(_frame_table_size.y))
+      );
+      animated_tile_shader->setUniform(
+         "u_tile_size", sf::Glsl::Vec2(static_cast<float>(_tile_size_px.x), static_cast<float>(_tile_size_px.y))
+      );
+      animated_tile_shader->setUniform("u_time_ms", static_cast<float>(_animation_time_ms));
+      states.shader = &animated_tile_shader->native();
+   }
+
+   submitVisibleBlocks(target, states, &StaticBlock::_first_animated_vertex, &StaticBlock::_animated_vertex_count);
+   flushBatch(target, states);
+}
+
+void TileMap::drawAnimatedTilesWithoutShader(sf::RenderTarget& target, const sf::RenderStates& states) const
+{
+   for (const auto* block : _visible_blocks)
+   {
+      const auto first = _static_vertices.begin() + block->_first_animated_vertex;
+      _batched_vertices.insert(_batched_vertices.end(), first, first + block->_animated_vertex_count);
+   }
+
+   for (auto& vertex : _batched_vertices)
+   {
+      vertex.color.r = 255;
+      vertex.color.g = 255;
+      vertex.color.b = 255;
+   }
+
+   flushBatch(target, states);
+}
+
+void TileMap::submitVisibleBlocks(
+   sf::RenderTarget& target,
+   const sf::RenderStates& states,
+   uint32_t StaticBlock::* first_vertex,
+   uint32_t StaticBlock::* vertex_count
+) const
+{
+   // the blocks of a row are neighbours in the vertex buffer, so a run of visible blocks is
+   // submitted as one range. a run is only broken by a block the clip rects drop, or by a row end
+   // when the window is narrower than the grid
+   auto range_first_vertex = 0u;
+   auto range_vertex_count = 0u;
+
+   for (const auto* block : _visible_blocks)
+   {
+      const auto block_first_vertex = block->*first_vertex;
+      const auto block_vertex_count = block->*vertex_count;
+      if (block_vertex_count == 0)
+      {
+         continue;
+      }
+
+      if (range_vertex_count > 0 && range_first_vertex + range_vertex_count != block_first_vertex)
+      {
+         submitStaticRange(target, states, range_first_vertex, range_vertex_count);
+         range_vertex_count = 0;
+      }
+
+      if (range_vertex_count == 0)
+      {
+         range_first_vertex = block_first_vertex;
+      }
+
+      range_vertex_count += block_vertex_count;
+   }
+
+   if (range_vertex_count > 0)
    {
-      _batched_vertices.insert(_batched_vertices.end(), &_vertices_animated[0], &_vertices_animated[0] + animated_vertex_count);
+      submitStaticRange(target, states, range_first_vertex, range_vertex_count);
    }
+}
 
+void TileMap::flushBatch(sf::RenderTarget& target, const sf::RenderStates& states) const
+{
    if (_batched_vertices.empty())
    {
       return;
@@ -477,11 +814,32 @@ void TileMap::drawVertices(sf::RenderTarget& target, sf::RenderStates states, co
 
 #ifdef DEVELOPMENT_MODE
    DrawCallCounter::tilemap_draw_calls++;
-   if (animated_vertex_count > 0)
+   DrawCallCounter::tilemap_bytes_uploaded += static_cast<int64_t>(_batched_vertices.size() * sizeof(sf::Vertex));
+#endif
+
+   _batched_vertices.clear();
+}
+
+void TileMap::submitStaticRange(
+   sf::RenderTarget& target,
+   const sf::RenderStates& states,
+   uint32_t first_vertex,
+   uint32_t vertex_count
+) const
+{
+#ifndef DECEPTUS_VRSFML
+   if (_static_vertices_uploaded)
    {
-      DrawCallCounter::countAnimatedTilePixels(target, view, &_vertices_animated[0], animated_vertex_count);
+      target.draw(_static_vertex_buffer, first_vertex, vertex_count, states);
+#ifdef DEVELOPMENT_MODE
+      DrawCallCounter::tilemap_draw_calls++;
+#endif
+      return;
    }
 #endif
+
+   const auto first = _static_vertices.begin() + first_vertex;
+   _batched_vertices.insert(_batched_vertices.end(), first, first + vertex_count);
 }
 
 const std::string& TileMap::getLayerName() const
@@ -513,7 +871,7 @@ void TileMap::draw(sf::RenderTarget& target, sf::RenderStates states) const
 
 bool TileMap::dumpToPng(const std::filesystem::path& output_path) const
 {
-   if (!_texture_map || _vertices_static_blocks.empty())
+   if (!_texture_map || _static_vertices.empty())
    {
       std::cerr << "TileMap::dumpToPng - no texture or vertex data.\n";
       return false;
@@ -523,27 +881,21 @@ bool TileMap::dumpToPng(const std::filesystem::path& output_path) const
    sf::FloatRect bounds;
    bool first = true;
 
-   for (const auto& [by, row] : _vertices_static_blocks)
+   for (const auto& vertex : _static_vertices)
    {
-      for (const auto& [bx, vertex_array] : row)
+      const auto& pos = vertex.position;
+      if (first)
       {
-         for (std::size_t i = 0; i < vertex_array.getVertexCount(); ++i)
-         {
-            const auto& pos = vertex_array[i].position;
-            if (first)
-            {
-               bounds.position = pos;
-               bounds.size = {pos.x, pos.y};
-               first = false;
-            }
-            else
-            {
-               bounds.position.x = std::min(bounds.position.x, pos.x);
-               bounds.position.y = std::min(bounds.position.y, pos.y);
-               bounds.size.x = std::max(bounds.size.x, pos.x);
-               bounds.size.y = std::max(bounds.size.y, pos.y);
-            }
-         }
+         bounds.position = pos;
+         bounds.size = {pos.x, pos.y};
+         first = false;
+      }
+      else
+      {
+         bounds.position.x = std::min(bounds.position.x, pos.x);
+         bounds.position.y = std::min(bounds.position.y, pos.y);
+         bounds.size.x = std::max(bounds.size.x, pos.x);
+         bounds.size.y = std::max(bounds.size.y, pos.y);
       }
    }
 
@@ -570,19 +922,7 @@ bool TileMap::dumpToPng(const std::filesystem::path& output_path) const
    states.transform.translate(-bounds.position);  // align top-left to (0, 0)
 
    // draw static tiles
-   for (const auto& [by, row] : _vertices_static_blocks)
-   {
-      for (const auto& [bx, vertex_array] : row)
-      {
-         render_texture.draw(vertex_array, states);
-      }
-   }
-
-   // draw animated tiles
-   if (_vertices_animated.getVertexCount() > 0)
-   {
-      render_texture.draw(_vertices_animated, states);
-   }
+   render_texture.draw(_static_vertices.data(), _static_vertex_count, sf::PrimitiveType::Triangles, states);
 
    render_texture.display();
 
@@ -680,42 +1020,45 @@ void TileMap::setZ(int32_t z)
 
 void TileMap::hideTile(int32_t x, int32_t y)
 {
-   const auto& it =
-      std::find_if(std::begin(_animations), std::end(_animations), [x, y](auto* tile) { return (tile->_x_tl == x && tile->_y_tl == y); });
+   const auto bx = static_cast<int32_t>(x / tile_count_per_block);
+   const auto by = static_cast<int32_t>(y / tile_count_per_block);
 
-   if (it != _animations.end())
+   const auto* block = getStaticBlock(bx, by);
+   if (!block)
    {
-      (*it)->_visible = false;
+      return;
    }
-   else
-   {
-      const auto bx = static_cast<int32_t>(x / tile_count_per_block);
-      const auto by = static_cast<int32_t>(y / tile_count_per_block);
 
-      const auto& y_it = _vertices_static_blocks.find(by);
-      if (y_it != _vertices_static_blocks.end())
+   // tiles are stored as two triangles, so a tile is six vertices and its first one is the top left corner.
+   // animated tiles are hidden the same way, the shader keeps their alpha
+   for (const auto& [first_vertex, vertex_count] :
+        {std::pair{block->_first_vertex, block->_vertex_count}, std::pair{block->_first_animated_vertex, block->_animated_vertex_count}})
+   {
+      for (auto i = first_vertex; i < first_vertex + vertex_count; i += 6)
       {
-         const auto& x_it = _vertices_static_blocks[by].find(bx);
-         if (x_it != _vertices_static_blocks[by].end())
+         if (static_cast<int32_t>(_static_vertices[i].position.x) / PIXELS_PER_TILE != x ||
+             static_cast<int32_t>(_static_vertices[i].position.y) / PIXELS_PER_TILE != y)
+         {
+            continue;
+         }
+
+         for (auto vertex_index = i; vertex_index < i + 6; vertex_index++)
          {
-            auto& vertices = x_it->second;
-            for (auto i = 0u; i < vertices.getVertexCount(); i += 4)
+            _static_vertices[vertex_index].color.a = 0;
+         }
+
+#ifndef DECEPTUS_VRSFML
+         if (_static_vertices_uploaded)
+         {
+            if (!_static_vertex_buffer.update(&_static_vertices[i], 6, i))
             {
-               if (static_cast<int32_t>(vertices[i].position.x) / PIXELS_PER_TILE == x &&
-                   static_cast<int32_t>(vertices[i].position.y) / PIXELS_PER_TILE == y)
-               {
-                  vertices[i].color.a = 0;
-                  vertices[i + 1].color.a = 0;
-                  vertices[i + 2].color.a = 0;
-                  vertices[i + 3].color.a = 0;
-               }
+               Log::Warning() << "failed to hide tile " << x << ", " << y << " of layer " << _layer_name;
             }
+#ifdef DEVELOPMENT_MODE
+            DrawCallCounter::tilemap_bytes_uploaded += static_cast<int64_t>(6 * sizeof(sf::Vertex));
+#endif
          }
+#endif
       }
    }
 }
-
-TileMap::AnimatedTile::~AnimatedTile()
-{
-   _frames.clear();
-}
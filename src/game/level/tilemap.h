@@ -8,7 +8,9 @@
 #include <cstdint>
 #include <filesystem>
 #include <map>
+#include <memory>
 #include <optional>
+#include <string>
 #include <vector>
 
 #include "constants.h"
@@ -24,10 +26,8 @@ class TileMap : public sf::Drawable, public sf::Transformable
 public:
    TileMap() = default;
 
-   /// \brief releases dynamic animation frame storage.
-   ~TileMap() override;
-
-   /// \brief loads tile geometry, textures, and animation metadata from TMX layer data.
+   /// \brief loads tile geometry, texture images, and animation metadata from TMX layer data.
+   /// \note does not touch the gl context, so it can run on a worker thread; upload() creates the textures.
    /// \param layer source TMX layer with tile indices and properties.
    /// \param tileSet TMX tileset referenced by \p layer.
    /// \param basePath base path used to resolve tileset textures.
@@ -35,7 +35,7 @@ public:
    virtual bool
    load(const std::shared_ptr<TmxLayer>& layer, const std::shared_ptr<TmxTileSet>& tileSet, const std::filesystem::path& basePath);
 
-   /// \brief advances visible animated tiles and rebuilds animated vertex data.
+   /// \brief advances the clock the animated tile shader picks its frames from.
    /// \param dt elapsed frame time.
    virtual void update(const sf::Time& dt);
 
@@ -90,12 +90,14 @@ public:
    /// \return reference to layer name.
    const std::string& getLayerName() const;
 
+   /// \brief creates the textures from the images decoded by load(), uploads the block geometry into a vertex
+   ///        buffer and the animation frame table into a texture.
+   /// \note needs the gl context, so unlike load() this has to run on the main thread.
+   virtual void upload();
+
 protected:
-   /// \brief draws static and animated vertex buffers near the player.
-   /// \param target render target.
-   /// \param states render states forwarded to draw calls.
    ///
-   /// \brief submits the visible blocks of this layer as one batch.
+   /// \brief submits the visible blocks of this layer, the static tiles first and then the animated ones.
    /// \param target render target.
    /// \param states render states for the batch.
    /// \param clip_rects_px blocks touching none of these are dropped; empty means keep everything.
@@ -103,57 +105,147 @@ protected:
    void drawVertices(sf::RenderTarget& target, sf::RenderStates states, const std::vector<sf::FloatRect>& clip_rects_px = {}) const;
 
 private:
-   /// \brief stores one tile quad as an animated tile entry.
-   /// \param quad tile quad geometry and initial uv data.
-   /// \param tx tile x index in tile coordinates.
-   /// \param ty tile y index in tile coordinates.
+   /// \brief stores one tile quad as an animated tile, registering its animation in the frame table.
+   /// \param quad tile quad geometry and uv data of the animation's first frame.
+   /// \param parallax_scale layer parallax factor used for block lookup.
    /// \param animation TMX animation description for this tile.
-   void storeAnimation(const std::array<sf::Vertex, 4>& quad, int32_t tx, int32_t ty, const std::shared_ptr<TmxAnimation>& animation);
+   void storeAnimation(std::array<sf::Vertex, 4> quad, float parallax_scale, const std::shared_ptr<TmxAnimation>& animation);
+
+   /// \brief where an animation's frames start in the frame table.
+   struct AnimationEntry
+   {
+      uint32_t _first_frame = 0;
+      uint32_t _frame_count = 0;
+   };
+
+   /// \brief one frame of an animation as written to the frame table, kept for animating on the cpu.
+   struct AnimationFrame
+   {
+      uint32_t _tu = 0;
+      uint32_t _tv = 0;
+      uint32_t _end_ms = 0;       //!< time within the animation at which this frame ends
+      uint32_t _duration_ms = 0;  //!< length of the whole animation
+   };
 
    /// \brief stores one tile quad inside the static block vertex cache.
    /// \param quad tile quad geometry and uv data.
    /// \param parallax_scale layer parallax factor used for block lookup.
-   void storeStaticVertices(const std::array<sf::Vertex, 4>& quad, float parallax_scale);
+   /// \param animation frame table entry if the quad carries an animated tile.
+   void storeStaticVertices(const std::array<sf::Vertex, 4>& quad, float parallax_scale, std::optional<AnimationEntry> animation = {});
 
-   /// \brief one animation frame entry inside an animated tile.
-   struct AnimatedTileFrame
+   /// \brief sorts the stored quads into the block grid, one contiguous vertex range per block and kind of tile.
+   void buildStaticBlocks();
+
+   /// \brief one quad waiting for buildStaticBlocks to sort it into its block.
+   struct StagedQuad
    {
-      int32_t _x_px = 0;
-      int32_t _y_px = 0;
-      int32_t _duration_ms = 0;
+      int32_t _block_x = 0;
+      int32_t _block_y = 0;
+      std::optional<AnimationEntry> _animation;
+      std::array<sf::Vertex, 4> _quad;
    };
 
-   /// \brief runtime state for one animated tile instance.
-   struct AnimatedTile
+   /// \brief where the vertices of one block of the block grid live.
+   struct StaticBlock
    {
-      /// \brief releases owned animation frame pointers.
-      virtual ~AnimatedTile();
-
-      int32_t _x_tl = 0;
-      int32_t _y_tl = 0;
-      std::vector<AnimatedTileFrame*> _frames;
-      int32_t _current_frame = 0;
-      float _elapsed_ms = 0.0f;
-      float _duration = 0.0f;
-      sf::Vertex _vertices[4];
-      bool _visible = true;
-      std::shared_ptr<TmxAnimation> _animation;
+      uint32_t _first_vertex = 0;           //!< offset into _static_vertices and the vertex buffer
+      uint32_t _vertex_count = 0;           //!< two triangles per tile
+      uint32_t _first_animated_vertex = 0;  //!< the same for the block's animated tiles
+      uint32_t _animated_vertex_count = 0;
    };
 
+   /// \brief looks up a block of the block grid.
+   /// \param bx block x index.
+   /// \param by block y index.
+   /// \return the block, nullptr when the index lies outside the grid.
+   const StaticBlock* getStaticBlock(int32_t bx, int32_t by) const;
+
+   /// \brief submits one vertex range of each visible block, merging ranges that follow each other.
+   /// \param target render target.
+   /// \param states render states for the ranges.
+   /// \param first_vertex block member holding the start of the range.
+   /// \param vertex_count block member holding the length of the range.
+   void submitVisibleBlocks(
+      sf::RenderTarget& target,
+      const sf::RenderStates& states,
+      uint32_t StaticBlock::* first_vertex,
+      uint32_t StaticBlock::* vertex_count
+   ) const;
+
+   /// \brief hands a contiguous range of block vertices to the target, or to the cpu batch when there is no vertex buffer.
+   /// \param target render target.
+   /// \param states render states for the range.
+   /// \param first_vertex first vertex of the range.
+   /// \param vertex_count number of vertices in the range.
+   void submitStaticRange(sf::RenderTarget& target, const sf::RenderStates& states, uint32_t first_vertex, uint32_t vertex_count) const;
+
+   /// \brief draws whatever submitStaticRange gathered in the cpu batch.
+   /// \param target render target.
+   /// \param states render states for the batch.
+   void flushBatch(sf::RenderTarget& target, const sf::RenderStates& states) const;
+
+   /// \brief draws the animated tiles of the visible blocks with white vertex colors, for a caller bringing its
+   ///        own shader while the vertex colors hold frame table entries.
+   /// \param target render target.
+   /// \param states render states for the batch.
+   void drawAnimatedTilesWithoutShader(sf::RenderTarget& target, const sf::RenderStates& states) const;
+
+   /// \brief writes each animated tile's frame table entry into its vertex color, for animated_tile.vert.
+   void encodeAnimationEntries();
+
+   /// \brief moves the texcoords of every animated tile to its current frame, used when the shader is not available.
+   void updateAnimatedTexCoords();
+
    sf::Vector2u _tile_size_px;
 
-   mutable std::map<int32_t, std::map<int32_t, sf::VertexArray>> _vertices_static_blocks;
-   sf::VertexArray _vertices_animated;
+   //!< tiles are binned into blocks of tile_count_per_block x tile_count_per_block tiles. the blocks form a
+   //!< dense row-major grid starting at _block_origin, and each block owns one contiguous range of
+   //!< _static_vertices for its static tiles and one for its animated tiles. all static ranges come first, so
+   //!< neighbouring blocks of a row are neighbouring ranges and draw as one
+   std::vector<StagedQuad> _staged_quads;
+   std::vector<sf::Vertex> _static_vertices;
+   std::vector<StaticBlock> _static_blocks;
+   sf::Vector2i _block_origin;
+   sf::Vector2i _block_count;
+   uint32_t _static_vertex_count = 0;  //!< vertices of the static tiles, the animated ones follow
+
+#ifndef DECEPTUS_VRSFML
+   //!< _static_vertices as uploaded to the gpu once at load time; drawing a block range from it costs no
+   //!< vertex copy and no upload
+   sf::VertexBuffer _static_vertex_buffer{sf::PrimitiveType::Triangles, sf::VertexBuffer::Usage::Static};
+   bool _static_vertices_uploaded = false;
+#endif
 
-   //!< every visible block plus the animated tiles of one draw, gathered so the lot goes out as a
-   //!< single call. all of it shares one texture and one blend mode, and concatenating in draw
-   //!< order keeps the result identical to drawing the blocks one by one
+   //!< without a vertex buffer the visible blocks of one draw are gathered here so they go out as a single
+   //!< call. all of it shares one texture and one blend mode, and concatenating in draw order keeps the
+   //!< result identical to drawing the blocks one by one
    mutable std::vector<sf::Vertex> _batched_vertices;
+   mutable std::vector<const StaticBlock*> _visible_blocks;  //!< blocks that passed the cull in the current draw
+
+   //!< animated tiles are static geometry, built showing their first frame in white. once upload has created
+   //!< the frame table texture and the animated_tile shader, their vertex color holds where their animation
+   //!< sits in the frame table and animated_tile.vert moves the texcoords to the current frame, see there for
+   //!< the table layout. without either, update() moves the texcoords on the cpu instead
+   std::map<const TmxAnimation*, AnimationEntry> _animation_entries;
+   std::vector<AnimationFrame> _animation_frames;       //!< the frame table's content, indexed the same way
+   std::vector<AnimationEntry> _animated_tile_entries;  //!< one per animated tile, in vertex order
+   std::vector<uint32_t> _animated_tile_frames;         //!< frame each animated tile shows, when animating on the cpu
+   bool _shader_animation = false;
+   std::vector<uint8_t> _frame_table_pixels;
+   uint32_t _frame_table_frame_count = 0;
+   sf::Vector2u _frame_table_size;
+   std::unique_ptr<sf::Texture> _frame_table;
+   double _animation_time_ms = 0.0;
+   double _animation_period_ms = 0.0;  //!< all animations of the layer line up again after this long
 
    std::shared_ptr<sf::Texture> _texture_map;
    std::shared_ptr<sf::Texture> _normal_map;
 
-   std::vector<AnimatedTile*> _animations;
+   //!< decoded by load() and handed over to the texture pool by upload()
+   std::filesystem::path _texture_path;
+   std::filesystem::path _normal_map_path;
+   std::shared_ptr<sf::Image> _texture_image;
+   std::shared_ptr<sf::Image> _normal_map_image;
 
    int32_t _z_index = 0;
    bool _visible = true;
@@ -10,6 +10,7 @@
 #include "game/mechanisms/flowfieldtexturechangeevent.h"
 #include "game/mechanisms/gamemechanismdeserializerregistry.h"
 
+#include <algorithm>
 #include <array>
 
 namespace
@@ -54,7 +55,6 @@ const auto registered_dust = []
 Dust::Dust(GameNode* parent) : GameNode(parent)
 {
    setClassName(typeid(Dust).name());
-   _vertices.setPrimitiveType(sf::PrimitiveType::Triangles);
 }
 
 Dust::~Dust()
@@ -107,16 +107,19 @@ void Dust::rebuildFlowFieldCache()
 void Dust::update(const sf::Time& dt)
 {
    const auto delta_s = dt.asSeconds();
+   const auto particle_count = _particles._positions.size();
 
-   for (auto& particle : _particles)
+   for (auto particle_index = 0u; particle_index < particle_count; particle_index++)
    {
-      const auto clip_relative_x_px = particle._position.x - _clip_rect.position.x;
-      const auto clip_relative_y_px = particle._position.y - _clip_rect.position.y;
+      auto& position = _particles._positions[particle_index];
+
+      const auto clip_relative_x_px = position.x - _clip_rect.position.x;
+      const auto clip_relative_y_px = position.y - _clip_rect.position.y;
 
       if (clip_relative_x_px < 0 || clip_relative_x_px >= _clip_rect.size.x || clip_relative_y_px < 0 ||
           clip_relative_y_px >= _clip_rect.size.y)
       {
-         particle.spawn(_clip_rect);
+         spawnParticle(particle_index);
          continue;
       }
 
@@ -124,14 +127,13 @@ void Dust::update(const sf::Time& dt)
       const auto flow_field_pixel_y = static_cast<uint32_t>(clip_relative_y_px * _flow_field_scale_factor_y);
       const auto flow_direction = _flow_field_cache[flow_field_pixel_y * _flow_field_image_width + flow_field_pixel_x];
 
-      particle._position =
-         particle._position + flow_direction * delta_s * _particle_velocity + _wind_direction * delta_s * _particle_velocity;
-      particle._z = flow_direction.z;
-      particle._age += delta_s;
+      position = position + flow_direction * delta_s * _particle_velocity + _wind_direction * delta_s * _particle_velocity;
+      _particles._z[particle_index] = flow_direction.z;
+      _particles._ages[particle_index] += delta_s;
 
-      if (particle._age > particle._lifetime)
+      if (_particles._ages[particle_index] > _particles._lifetimes[particle_index])
       {
-         particle.spawn(_clip_rect);
+         spawnParticle(particle_index);
          continue;
       }
 
@@ -143,14 +145,14 @@ void Dust::update(const sf::Time& dt)
 #else
          const sf::Vector2f center = _clip_rect.getCenter();
 #endif
-         const auto center_delta_x = particle._position.x - center.x;
-         const auto center_delta_y = particle._position.y - center.y;
+         const auto center_delta_x = position.x - center.x;
+         const auto center_delta_y = position.y - center.y;
          const auto center_distance_sq = center_delta_x * center_delta_x + center_delta_y * center_delta_y;
-         const auto too_close_to_center = center_distance_sq < particle._center_reset_radius_sq;
+         const auto too_close_to_center = center_distance_sq < _particles._center_reset_radii_sq[particle_index];
 
          if (too_close_to_center)
          {
-            particle.spawn(_clip_rect);
+            spawnParticle(particle_index);
             continue;
          }
       }
@@ -169,69 +171,38 @@ void Dust::draw(sf::RenderTarget& target, sf::RenderTarget& /*normal*/, const sf
    sf::RenderStates states = incoming_states;
    states.blendMode = sf::BlendAlpha;
 
-   std::size_t vertex_index = 0;
+   const auto particle_count = _particles._positions.size();
+   const auto particle_size_px = static_cast<float>(_particle_size_px);
+
+   _batch.clear();
 
-   sf::Vertex quad[4];
-   for (const auto& particle : _particles)
+   for (auto particle_index = 0u; particle_index < particle_count; particle_index++)
    {
-      const auto particle_position_px = particle._position;
+      const auto& particle_position_px = _particles._positions[particle_index];
+      const auto age = _particles._ages[particle_index];
+      const auto lifetime = _particles._lifetimes[particle_index];
       auto particle_alpha = 0.0f;
 
-      if (particle._age > particle._lifetime - 1.0f)
+      if (age > lifetime - 1.0f)
       {
-         particle_alpha = (particle._lifetime - particle._age) * alpha_default;
+         particle_alpha = (lifetime - age) * alpha_default;
       }
-      else if (particle._age < 1.0f)
+      else if (age < 1.0f)
       {
-         particle_alpha = particle._age * alpha_default;
+         particle_alpha = age * alpha_default;
       }
       else
       {
-         particle_alpha = alpha_default + particle._z * 50.0f;
+         particle_alpha = alpha_default + _particles._z[particle_index] * 50.0f;
       }
 
       const auto color =
          sf::Color{_particle_color.r, _particle_color.g, _particle_color.b, static_cast<uint8_t>(std::clamp(particle_alpha, 0.0f, 255.0f))};
 
-      if (vertex_index + 6 > _vertices.getVertexCount())
-      {
-         break;
-      }
-
-      // triangle 1: top-left, top-right, bottom-right
-      _vertices[vertex_index + 0] = sf::Vertex({particle_position_px.x, particle_position_px.y}, color);
-      _vertices[vertex_index + 1] = sf::Vertex({particle_position_px.x + _particle_size_px, particle_position_px.y}, color);
-      _vertices[vertex_index + 2] =
-         sf::Vertex({particle_position_px.x + _particle_size_px, particle_position_px.y + _particle_size_px}, color);
-
-      // triangle 2: top-left, bottom-right, bottom-left
-      _vertices[vertex_index + 3] = sf::Vertex({particle_position_px.x, particle_position_px.y}, color);
-      _vertices[vertex_index + 4] =
-         sf::Vertex({particle_position_px.x + _particle_size_px, particle_position_px.y + _particle_size_px}, color);
-      _vertices[vertex_index + 5] = sf::Vertex({particle_position_px.x, particle_position_px.y + _particle_size_px}, color);
-
-      vertex_index += 6;
-
-      // old approach where each dust particle was drawn individually
-      //
-      // quad[0].position = {pos.x, pos.y};                                          // bottom-left
-      // quad[1].position = {pos.x, pos.y + _particle_size_px};                      // top-left
-      // quad[2].position = {pos.x + _particle_size_px, pos.y};                      // bottom-right
-      // quad[3].position = {pos.x + _particle_size_px, pos.y + _particle_size_px};  // top-right
-      //
-      // for (auto& v : quad)
-      // {
-      //    v.color = color;
-      // }
-      //
-      // target.draw(quad, 4, sf::PrimitiveType::TriangleStrip, states);
+      _batch.addQuad({{particle_position_px.x, particle_position_px.y}, {particle_size_px, particle_size_px}}, color);
    }
 
-#ifdef DECEPTUS_VRSFML
-   target.draw(std::span<const sf::Vertex>(&_vertices[0], vertex_index), sf::PrimitiveType::Triangles, states);
-#else
-   target.draw(&_vertices[0], vertex_index, sf::PrimitiveType::Triangles, states);
-#endif
+   _batch.draw(target, states);
 }
 
 std::optional<sf::FloatRect> Dust::getBoundingBoxPx()
@@ -327,15 +298,14 @@ std::shared_ptr<Dust> Dust::deserialize(GameNode* parent, const GameDeserializeD
       }
    }
 
-   // generate dust vertices
-   for (auto particle_index = 0; particle_index < particle_count; particle_index++)
+   // generate dust particles
+   dust->_particles.resize(static_cast<std::size_t>(std::max(particle_count, 0)));
+   for (auto particle_index = 0u; particle_index < dust->_particles._positions.size(); particle_index++)
    {
-      Particle new_particle;
-      new_particle.spawn(dust->_clip_rect);
-      dust->_particles.push_back(new_particle);
+      dust->spawnParticle(particle_index);
    }
 
-   dust->_vertices.resize(6 * particle_count);
+   dust->_batch.reserve(dust->_particles._positions.size());
 
    // remember the instance so it's not instantly removed from the cache and each
    // dust instance has to reload the texture
@@ -346,15 +316,24 @@ std::shared_ptr<Dust> Dust::deserialize(GameNode* parent, const GameDeserializeD
    return dust;
 }
 
-void Dust::Particle::spawn(sf::FloatRect& rect)
+void Dust::Particles::resize(std::size_t count)
+{
+   _positions.resize(count);
+   _ages.resize(count);
+   _lifetimes.resize(count);
+   _z.resize(count);
+   _center_reset_radii_sq.resize(count);
+}
+
+void Dust::spawnParticle(std::size_t index)
 {
-   _position.x = rect.position.x + std::rand() % static_cast<int32_t>(rect.size.x);
-   _position.y = rect.position.y + std::rand() % static_cast<int32_t>(rect.size.y);
-   _age = 0.0f;
-   _lifetime = 5.0f + (std::rand() % 100) * 0.1f;
+   _particles._positions[index].x = _clip_rect.position.x + std::rand() % static_cast<int32_t>(_clip_rect.size.x);
+   _particles._positions[index].y = _clip_rect.position.y + std::rand() % static_cast<int32_t>(_clip_rect.size.y);
+   _particles._ages[index] = 0.0f;
+   _particles._lifetimes[index] = 5.0f + (std::rand() % 100) * 0.1f;
 
    constexpr auto radius_min = 1.0f;
    constexpr auto radius_max = 4.0f;
    const auto radius = radius_min + (std::rand() % 1000 / 1000.0f) * (radius_max - radius_min);
-   _center_reset_radius_sq = radius * radius;
+   _particles._center_reset_radii_sq[index] = radius * radius;
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "game/effects/particlebatch.h"
 #include "game/io/gamedeserializedata.h"
 #include "game/level/gamenode.h"
 #include "game/mechanisms/gamemechanism.h"
@@ -12,18 +13,18 @@ struct TmxObject;
 /// \brief simulates and renders ambient dust guided by a flow-field texture.
 class Dust : public GameMechanism, public GameNode
 {
-   /// \brief stores runtime data for one simulated dust particle.
-   struct Particle
+   /// \brief runtime data of all simulated dust particles, one array per field and one entry per particle.
+   struct Particles
    {
-      /// \brief respawns the particle at a random position inside the clip rectangle.
-      /// \param rect spawn area in pixels.
-      void spawn(sf::FloatRect& rect);
-      sf::Vector3f _position;
-      sf::Vector3f _direction;
-      float _age = 0.0f;
-      float _lifetime = 0.0f;
-      float _z = 0.0f;
-      float _center_reset_radius_sq = 0.0f;
+      /// \brief resizes every array to the given particle count.
+      /// \param count number of particles.
+      void resize(std::size_t count);
+
+      std::vector<sf::Vector3f> _positions;
+      std::vector<float> _ages;
+      std::vector<float> _lifetimes;
+      std::vector<float> _z;
+      std::vector<float> _center_reset_radii_sq;
    };
 
 public:
@@ -42,7 +43,7 @@ public:
    /// \param dt elapsed frame time.
    void update(const sf::Time& dt) override;
 
-   /// \brief draws all particles as batched triangle quads with age-based alpha.
+   /// \brief draws all particles as one batch of quads with age-based alpha.
    /// \param target render target.
    /// \param normal normal-map render target (unused).
    void draw(sf::RenderTarget& target, sf::RenderTarget& normal) override;
@@ -67,7 +68,11 @@ public:
 private:
    void rebuildFlowFieldCache();
 
-   std::vector<Particle> _particles;
+   /// \brief respawns a particle at a random position inside the clip rectangle.
+   /// \param index particle index.
+   void spawnParticle(std::size_t index);
+
+   Particles _particles;
    sf::FloatRect _clip_rect;
    std::shared_ptr<sf::Texture> _flow_field_texture;
 #ifdef DECEPTUS_VRSFML
@@ -83,7 +88,7 @@ private:
    sf::Color _particle_color = {255, 255, 255, 255};
    float _particle_velocity = 100.0f;
    uint8_t _particle_size_px = 2;
-   sf::VertexArray _vertices;
+   ParticleBatch _batch;
    bool _respawn_when_center_reached{false};
    std::optional<int32_t> _flowfield_listener_id;
 };
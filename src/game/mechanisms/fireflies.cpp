@@ -3,11 +3,11 @@
 #include "framework/tmxparser/tmxobject.h"
 #include "framework/tmxparser/tmxproperties.h"
 #include "framework/tmxparser/tmxproperty.h"
-#include "framework/tools/sfmlcompat.h"
 #include "game/debug/debugdraw.h"
 #include "game/io/texturepool.h"
 #include "game/mechanisms/gamemechanismdeserializerregistry.h"
 
+#include <algorithm>
 #include <array>
 
 namespace
@@ -79,20 +79,21 @@ void Fireflies::draw(sf::RenderTarget& target, sf::RenderTarget& /*normal*/, con
    DebugDraw::drawRect(target, _rect_px, sf::Color::Magenta);
 #endif
 
-   sf::RenderStates draw_states = states;
-   draw_states.texture = _texture.get();
+   constexpr auto half_size_px = PIXELS_PER_TILE / 2.0f;
+   constexpr auto size_px = static_cast<float>(PIXELS_PER_TILE);
+
+   _batch.clear();
+
    for (const auto& firefly : _fireflies)
    {
-      target.draw(*firefly._sprite, draw_states);
+      const auto position_px = firefly._interpolated_position.getPositionPx();
+      _batch.addQuad(
+         {{position_px.x - half_size_px, position_px.y - half_size_px}, {size_px, size_px}},
+         {{static_cast<float>(firefly._current_frame) * size_px, 0.0f}, {size_px, size_px}}
+      );
    }
-}
 
-void Fireflies::updateSpritePositions()
-{
-   for (auto& firefly : _fireflies)
-   {
-      firefly.updateSpritePosition();
-   }
+   _batch.draw(target, states, _texture.get());
 }
 
 void Fireflies::update(const sf::Time& dt)
@@ -183,10 +184,8 @@ void Fireflies::deserialize(const GameDeserializeData& data)
 
    _texture = TexturePool::getInstance().get("data/sprites/firefly.png");
 
-   for (auto i = 0; i < count; i++)
-   {
-      _fireflies.push_back({*_texture});
-   }
+   _fireflies.resize(static_cast<std::size_t>(std::max(count, 0)));
+   _batch.reserve(_fireflies.size());
 
    auto frand = [](float min, float max)
    {
@@ -198,11 +197,6 @@ void Fireflies::deserialize(const GameDeserializeData& data)
    {
       firefly._instance_number = _instance_counter++;
       firefly._rect_px = _rect_px;
-#ifdef DECEPTUS_VRSFML
-      firefly._sprite->textureRect = {{0, 0}, {PIXELS_PER_TILE, PIXELS_PER_TILE}};
-#else
-      firefly._sprite->setTextureRect({{0, 0}, {PIXELS_PER_TILE, PIXELS_PER_TILE}});
-#endif
       firefly._elapsed += sf::seconds(static_cast<float>(std::rand() % 999));
       firefly._angle_x = frand(30.0, 360.0) * FACTOR_DEG_TO_RAD;
       firefly._angle_y = frand(30.0, 360.0) * FACTOR_DEG_TO_RAD;
@@ -229,15 +223,6 @@ void rotate(float& x, float& y, float& z, float angle_x, float angle_y)
    z = -temp_x * sin(angle_y) + temp_z * cos(angle_y);
 }
 
-Fireflies::Firefly::Firefly(const sf::Texture& texture)
-{
-#ifdef DECEPTUS_VRSFML
-   _sprite = std::make_unique<sf::Sprite>();
-#else
-   _sprite = std::make_unique<sf::Sprite>(texture);
-#endif
-}
-
 void Fireflies::Firefly::update(const sf::Time& dt)
 {
    _elapsed += dt;
@@ -260,35 +245,11 @@ void Fireflies::Firefly::update(const sf::Time& dt)
 
    _interpolated_position.step(_position.x, _position.y);
 
-#ifdef DECEPTUS_VRSFML
-   _sprite->origin = {PIXELS_PER_TILE / 2, PIXELS_PER_TILE / 2};
-#else
-   _sprite->setOrigin({PIXELS_PER_TILE / 2, PIXELS_PER_TILE / 2});
-#endif
-
-   updateTextureRect();
+   updateFrame();
 }
 
-void Fireflies::Firefly::updateSpritePosition()
-{
-   sfcompat::setPosition(*_sprite, _interpolated_position.getPositionPx());
-}
-
-void Fireflies::Firefly::updateTextureRect()
+void Fireflies::Firefly::updateFrame()
 {
    const auto elapsed_s = _elapsed.asSeconds();
-   const auto frame = static_cast<int32_t>(elapsed_s * _animation_speed) % FRAME_COUNT;
-
-   if (frame != _current_frame)
-   {
-      _current_frame = frame;
-#ifdef DECEPTUS_VRSFML
-      _sprite->textureRect = {
-         {static_cast<float>(_current_frame * PIXELS_PER_TILE), 0.0f},
-         {static_cast<float>(PIXELS_PER_TILE), static_cast<float>(PIXELS_PER_TILE)}
-      };
-#else
-      _sprite->setTextureRect({{_current_frame * PIXELS_PER_TILE, 0}, {PIXELS_PER_TILE, PIXELS_PER_TILE}});
-#endif
-   }
+   _current_frame = static_cast<int32_t>(elapsed_s * _animation_speed) % FRAME_COUNT;
 }
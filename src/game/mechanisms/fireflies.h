@@ -2,6 +2,7 @@
 #ifndef FIREFLIES_H
 #define FIREFLIES_H
 
+#include "game/effects/particlebatch.h"
 #include "game/io/gamedeserializedata.h"
 #include "game/level/gamenode.h"
 #include "game/mechanisms/gamemechanism.h"
@@ -14,19 +15,12 @@ public:
    /// \brief stores per-firefly animation and movement parameters.
    struct Firefly
    {
-      /// \brief creates one firefly sprite using the shared firefly texture.
-      /// \param texture source texture containing firefly animation frames.
-      Firefly(const sf::Texture& texture);
-
       /// \brief updates motion on a rotated lemniscate path and advances animation frames.
       /// \param dt elapsed frame time.
       void update(const sf::Time& dt);
 
-      /// \brief updates the sprite texture rectangle for the current animation frame.
-      void updateTextureRect();
-
-      /// \brief places this firefly's sprite for the frame about to be drawn.
-      void updateSpritePosition();
+      /// \brief updates the animation frame from the elapsed time.
+      void updateFrame();
 
       sf::Vector3f _position_3d;
       sf::Vector2f _position;
@@ -34,7 +28,6 @@ public:
       //!< where this firefly was before the last simulation step. It flies a path driven by
       //!< simulated time rather than by a body, but it still only advances once per step
       InterpolatedPosition _interpolated_position;
-      std::unique_ptr<sf::Sprite> _sprite;
       sf::Time _elapsed;
       sf::FloatRect _rect_px;
       int32_t _current_frame{0};
@@ -56,12 +49,12 @@ public:
    /// \return string view containing `Fireflies`.
    std::string_view objectName() const override;
 
-   /// \brief draws all firefly sprites.
+   /// \brief draws all fireflies as one batch.
    /// \param target render target.
    /// \param normal normal-map render target (unused).
    void draw(sf::RenderTarget& target, sf::RenderTarget& normal) override;
 
-   /// \brief draws all firefly sprites with explicit render states (used in WASM to carry the level view).
+   /// \brief draws all fireflies as one batch with explicit render states (used in WASM to carry the level view).
    /// \param target render target.
    /// \param normal normal-map render target (unused).
    /// \param states render states to apply.
@@ -71,7 +64,6 @@ public:
    /// \brief updates all firefly instances.
    /// \param dt elapsed frame time.
    void update(const sf::Time& dt) override;
-   void updateSpritePositions() override;
 
    /// \brief returns bounds for mechanism queries.
    /// \return `std::nullopt` because this mechanism does not expose collision bounds.
@@ -85,6 +77,7 @@ private:
    sf::FloatRect _rect_px;
    std::vector<Firefly> _fireflies;
    std::shared_ptr<sf::Texture> _texture;
+   ParticleBatch _batch;
    int32_t _instance_counter = 0;
 };
 
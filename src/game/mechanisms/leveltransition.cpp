@@ -8,12 +8,18 @@
 #include "framework/tools/log.h"
 #include "framework/tools/sfmlcompat.h"
 #include "game/io/valuereader.h"
+#include "game/constants.h"
+#include "game/level/levelpreloader.h"
 #include "game/level/leveltransitionhandler.h"
 #include "game/mechanisms/gamemechanismdeserializerregistry.h"
 #include "game/player/playerregistry.h"
 
 namespace
 {
+//! how close the player has to come to the transition before the target level is preloaded; a couple of
+//! seconds of walking leave enough time to parse even large levels
+constexpr auto preload_distance_px = 20.0f * PIXELS_PER_TILE;
+
 static constexpr std::string_view default_level_transition_level = "";
 static constexpr std::array level_transition_properties{
    PropertyInfo{.name = "level", .type = "string", .default_value = default_level_transition_level},
@@ -104,7 +110,22 @@ void LevelTransition::update(const sf::Time& /*dt*/)
       return;
    }
 
-   const auto player_intersects = sfcompat::findIntersection(PlayerRegistry::getFirst()->getPixelRectFloat(), _rect_px).has_value();
+   const auto& player_rect_px = PlayerRegistry::getFirst()->getPixelRectFloat();
+   const auto player_intersects = sfcompat::findIntersection(player_rect_px, _rect_px).has_value();
+
+   if (!_preload_requested)
+   {
+      const sf::FloatRect preload_rect_px{
+         {_rect_px.position.x - preload_distance_px, _rect_px.position.y - preload_distance_px},
+         {_rect_px.size.x + 2.0f * preload_distance_px, _rect_px.size.y + 2.0f * preload_distance_px}
+      };
+
+      if (sfcompat::findIntersection(player_rect_px, preload_rect_px).has_value())
+      {
+         _preload_requested = true;
+         LevelPreloader::getInstance().preload(_level_description_filename);
+      }
+   }
 
    // fire once when the player enters the rect; the level stays alive while the screen fades out,
    // so without the guard the request would be filed again on every frame the player keeps standing inside
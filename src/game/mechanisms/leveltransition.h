@@ -23,7 +23,8 @@ public:
    /// \return constant string view containing "LevelTransition".
    std::string_view objectName() const override;
 
-   /// \brief checks whether the player entered the rectangle and requests the level switch.
+   /// \brief starts preloading the target level once the player comes close, and requests the level switch
+   ///        when the player enters the rectangle.
    /// \param dt elapsed frame time, unused by this mechanism.
    void update(const sf::Time& dt) override;
 
@@ -41,4 +42,5 @@ private:
    std::optional<sf::Vector2f> _spawn_position_px;
    bool _player_intersects{false};
    bool _requested{false};
+   bool _preload_requested{false};
 };
@@ -103,7 +103,9 @@ void MoveableBox::update(const sf::Time& /*dt*/)
    {
       if (!_pushing_sample.has_value())
       {
-         _pushing_sample = Audio::getInstance().playSample({"mechanism_moveable_object_01.ogg", 1.0, true});
+         Audio::PlayInfo play_info{"mechanism_moveable_object_01.ogg", 1.0, true};
+         play_info._priority = Audio::PlayInfo::priority_loop;
+         _pushing_sample = Audio::getInstance().playSample(play_info);
       }
    }
    else
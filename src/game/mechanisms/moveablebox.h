@@ -4,6 +4,7 @@
 #include <optional>
 #include "box2d/box2d.h"
 
+#include "game/audio/audio.h"
 #include "game/io/gamedeserializedata.h"
 #include "game/level/gamenode.h"
 #include "game/mechanisms/gamemechanism.h"
@@ -83,6 +84,6 @@ private:
    InterpolatedPosition _interpolated_position;
    sf::Vector2f _size;
    b2Body* _body = nullptr;
-   std::optional<int32_t> _pushing_sample;
+   std::optional<Audio::Playback> _pushing_sample;
    Settings _settings;
 };
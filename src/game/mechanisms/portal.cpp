@@ -8,6 +8,7 @@
 #include "framework/tmxparser/tmxproperties.h"
 #include "framework/tmxparser/tmxproperty.h"
 #include "framework/tmxparser/tmxtileset.h"
+#include "framework/tools/globalclock.h"
 #include "framework/tools/log.h"
 #include "framework/tools/sfmlcompat.h"
 #include "game/camera/camerasystem.h"
@@ -26,6 +27,7 @@ std::atomic<bool> Portal::_portal_lock = false;
 Portal::Portal(GameNode* parent) : GameNode(parent)
 {
    setClassName(typeid(Portal).name());
+   _use_time = GlobalClock::getInstance().getElapsedTime();
 }
 
 std::string_view Portal::objectName() const
@@ -118,14 +120,14 @@ void Portal::use()
       return;
    }
 
-   if (_portal_clock.getElapsedTime().asSeconds() > 1.0f)
+   if ((GlobalClock::getInstance().getElapsedTime() - _use_time).asSeconds() > 1.0f)
    {
       if (PlayerRegistry::getFirst()->getControls()->isButtonBPressed())
       {
          if (getDestination())
          {
             Portal::lock();
-            _portal_clock.restart();
+            _use_time = GlobalClock::getInstance().getElapsedTime();
 
             auto screen_transition = makeFadeTransition();
             screen_transition->_callbacks_effect_1_ended.emplace_back([this]() { goToPortal(_destination); });
@@ -97,7 +97,7 @@ protected:
    /// \brief starts the portal transition and teleports to the linked destination.
    void use();
 
-   sf::Clock _portal_clock;
+   sf::Time _use_time;  //!< global clock time the portal was last used
    sf::FloatRect _rect;
    sf::Vector2u _tile_size;
    std::shared_ptr<sf::Texture> _texture;
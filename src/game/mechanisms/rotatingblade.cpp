@@ -215,7 +215,10 @@ void RotatingBlade::updateAudio()
          // play regular sample
          if (!_sample_enabled.has_value())
          {
-            _sample_enabled = Audio::getInstance().playSample({"mechanism_rotating_blade_enabled.ogg", 1.0f, true});
+            Audio::PlayInfo play_info{"mechanism_rotating_blade_enabled.ogg", 1.0f, true};
+            play_info._priority = Audio::PlayInfo::priority_loop;
+            play_info._pos = sf::Vector3f{_pos.x, _pos.y, 0.0f};
+            _sample_enabled = Audio::getInstance().playSample(play_info);
          }
          else
          {
@@ -232,7 +235,9 @@ void RotatingBlade::updateAudio()
          // play acceleration sample
          if (!_sample_accelerate.has_value())
          {
-            _sample_accelerate = Audio::getInstance().playSample({"mechanism_rotating_blade_accelerate.ogg"});
+            Audio::PlayInfo play_info{"mechanism_rotating_blade_accelerate.ogg"};
+            play_info._pos = sf::Vector3f{_pos.x, _pos.y, 0.0f};
+            _sample_accelerate = Audio::getInstance().playSample(play_info);
          }
          else
          {
@@ -258,7 +263,9 @@ void RotatingBlade::updateAudio()
          // play deceleration sample
          if (!_sample_decelerate.has_value())
          {
-            _sample_decelerate = Audio::getInstance().playSample({"mechanism_rotating_blade_decelerate.ogg"});
+            Audio::PlayInfo play_info{"mechanism_rotating_blade_decelerate.ogg"};
+            play_info._pos = sf::Vector3f{_pos.x, _pos.y, 0.0f};
+            _sample_decelerate = Audio::getInstance().playSample(play_info);
          }
          else
          {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "framework/math/pathinterpolation.h"
+#include "game/audio/audio.h"
 #include "game/io/gamedeserializedata.h"
 #include "game/level/gamenode.h"
 #include "game/mechanisms/gamemechanism.h"
@@ -106,7 +107,7 @@ private:
    PathInterpolation<sf::Vector2f> _path_interpolation;
    PathType _path_type = PathType::Polygon;
    Settings _settings;
-   std::optional<int32_t> _sample_enabled;
-   std::optional<int32_t> _sample_accelerate;
-   std::optional<int32_t> _sample_decelerate;
+   std::optional<Audio::Playback> _sample_enabled;
+   std::optional<Audio::Playback> _sample_accelerate;
+   std::optional<Audio::Playback> _sample_decelerate;
 };
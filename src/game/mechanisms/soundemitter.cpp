@@ -41,7 +41,9 @@ void SoundEmitter::setAudioEnabled(bool audio_enabled)
    if (audio_enabled)
    {
       // start playing
-      _thread_id = Audio::getInstance().playSample({_filename, _reference_volume, _looped});
+      Audio::PlayInfo play_info{_filename, _reference_volume, _looped};
+      play_info._priority = _looped ? Audio::PlayInfo::priority_loop : Audio::PlayInfo::priority_default;
+      _thread_id = Audio::getInstance().playSample(play_info);
    }
    else
    {
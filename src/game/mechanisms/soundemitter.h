@@ -1,6 +1,7 @@
 #ifndef SOUNDEMITTER_H
 #define SOUNDEMITTER_H
 
+#include "game/audio/audio.h"
 #include "game/io/gamedeserializedata.h"
 #include "game/level/gamenode.h"
 #include "game/mechanisms/gamemechanism.h"
@@ -47,7 +48,7 @@ public:
 
    bool _looped{true};
    std::string _filename;
-   std::optional<int32_t> _thread_id;
+   std::optional<Audio::Playback> _thread_id;
 
 private:
    /// \brief stops the currently playing sample when one is active.
@@ -4,6 +4,7 @@
 #include "framework/tmxparser/tmxobject.h"
 #include "framework/tmxparser/tmxproperties.h"
 #include "framework/tmxparser/tmxproperty.h"
+#include "framework/tools/asynctask.h"
 #include "framework/tools/log.h"
 #include "framework/tools/sfmlcompat.h"
 #include "game/debug/debugdraw.h"
@@ -74,6 +75,10 @@ float frand(float min = 0.0f, float max = 1.0f)
 std::vector<WaterSurface*> surfaces;
 std::vector<WaterSurface::SplashEmitter> emitters;
 
+// a step over 10000 segments takes about a tenth of a millisecond, much less is not worth a thread
+constexpr size_t min_segments_per_worker = 8192;
+constexpr int32_t off_screen_step_interval = 4;
+
 }  // namespace
 
 // #define DEBUG_WATERSURFACE 1
@@ -112,7 +117,7 @@ void WaterSurface::draw(sf::RenderTarget& color, sf::RenderTarget& normal)
 
 void WaterSurface::draw(sf::RenderTarget& color, sf::RenderTarget& /*normal*/, const sf::RenderStates& incoming_states)
 {
-   if (!isOnScreen(incoming_states.view, _bounding_box))
+   if (!prepareDraw(incoming_states.view))
    {
       return;
    }
@@ -158,18 +163,16 @@ void WaterSurface::draw(sf::RenderTarget& color, sf::RenderTarget& /*normal*/, c
 #endif
 
 #ifdef DEBUG_WATERSURFACE
-   auto index = 0;
-   const auto segment_width = _bounding_box.size.x / (_segments.size() - 1);
+   const auto segment_width = _bounding_box.size.x / (_simulation.size() - 1);
    std::vector<sf::Vertex> sf_lines;
    const auto x_offset = _bounding_box.position.x;
    const auto y_offset = _bounding_box.position.y;
 
-   for (const auto& segment : _segments)
+   for (auto index = 0u; index < _simulation.size(); index++)
    {
       const auto x = x_offset + static_cast<float>(index * segment_width);
-      const auto y = y_offset + segment._height;
+      const auto y = y_offset + _simulation.getHeight(index);
       sf_lines.push_back(sf::Vertex{sf::Vector2f{x, y}, sf::Color::White});
-      index++;
    }
 
    color.draw(sf_lines.data(), sf_lines.size(), sf::PrimitiveType::LineStrip);
@@ -178,7 +181,7 @@ void WaterSurface::draw(sf::RenderTarget& color, sf::RenderTarget& /*normal*/, c
 #else
 void WaterSurface::draw(sf::RenderTarget& color, sf::RenderTarget& /*normal*/)
 {
-   if (!isOnScreen(color.getView(), _bounding_box))
+   if (!prepareDraw(color.getView()))
    {
       return;
    }
@@ -220,18 +223,16 @@ void WaterSurface::draw(sf::RenderTarget& color, sf::RenderTarget& /*normal*/)
 #endif
 
 #ifdef DEBUG_WATERSURFACE
-   auto index = 0;
-   const auto segment_width = _bounding_box.size.x / (_segments.size() - 1);
+   const auto segment_width = _bounding_box.size.x / (_simulation.size() - 1);
    std::vector<sf::Vertex> sf_lines;
    const auto x_offset = _bounding_box.position.x;
    const auto y_offset = _bounding_box.position.y;
 
-   for (const auto& segment : _segments)
+   for (auto index = 0u; index < _simulation.size(); index++)
    {
       const auto x = x_offset + static_cast<float>(index * segment_width);
-      const auto y = y_offset + segment._height;
+      const auto y = y_offset + _simulation.getHeight(index);
       sf_lines.push_back(sf::Vertex{sf::Vector2f{x, y}, sf::Color::White});
-      index++;
    }
 
    color.draw(sf_lines.data(), sf_lines.size(), sf::PrimitiveType::LineStrip);
@@ -253,6 +254,9 @@ void WaterSurface::update(const sf::Time& dt)
       return;
    }
 
+   // splashes below write to the segments, so the previous step must be done
+   waitForSimulation();
+
    const auto elapsed_s = dt.asSeconds();
    updateEmitters(elapsed_s);
 
@@ -288,60 +292,74 @@ void WaterSurface::update(const sf::Time& dt)
          const auto normalized_intersection =
             (intersection.value().position.x + (player->getPixelRectFloat().size.x / 2.0f) - _bounding_box.position.x) /
             _bounding_box.size.x;
-         const auto index = static_cast<int32_t>(normalized_intersection * _segments.size());
+         const auto index = static_cast<int32_t>(normalized_intersection * _simulation.size());
 
          splash(index, velocity);
       }
    }
 
-   for (auto& segment : _segments)
+   stepSimulation(elapsed_s);
+}
+
+void WaterSurface::stepSimulation(float elapsed_s)
+{
+   // nobody sees a surface that is off screen, there it is enough to let it settle at a fraction of the cost
+   _frames_since_step++;
+   const auto step_due = _on_screen || _frames_since_step >= off_screen_step_interval;
+
+   if (_simulation.isAsleep() || !step_due)
    {
-      segment.update(_config._dampening, _config._tension);
-      segment.resetDeltas();
+      return;
    }
 
-   // integrate a few times
-   constexpr auto integration_steps = 8;
-   for (auto j = 0; j < integration_steps; j++)
-   {
-      for (auto segment_index = 0; segment_index < _segments.size(); segment_index++)
-      {
-         if (segment_index > 0)
-         {
-            const auto delta_left = _config._spread * (_segments[segment_index]._height - _segments[segment_index - 1]._height) *
-                                    elapsed_s * _config._animation_speed;
+   _frames_since_step = 0;
+   _vertices_dirty = true;
 
-            _segments[segment_index]._delta_left = delta_left;
-            _segments[segment_index - 1]._velocity += delta_left;
-         }
+   const WaterSurfaceSimulation::Spring spring{
+      ._tension = _config._tension,
+      ._dampening = _config._dampening,
+      ._spread = _config._spread,
+      ._animation_speed = _config._animation_speed,
+   };
 
-         if (segment_index < _segments.size() - 1)
-         {
-            const auto delta_right = _config._spread * (_segments[segment_index]._height - _segments[segment_index + 1]._height) *
-                                     elapsed_s * _config._animation_speed;
+   // the vertices are only needed when drawing, so a large surface steps on a worker thread while the
+   // rest of the level updates; the other mechanisms never touch its segments
+   if (_simulation.size() >= min_segments_per_worker)
+   {
+      _pending_step = startAsyncTask([this, spring, elapsed_s]() { _simulation.step(spring, elapsed_s); });
+   }
+   else
+   {
+      _simulation.step(spring, elapsed_s);
+   }
+}
 
-            _segments[segment_index]._delta_right = delta_right;
-            _segments[segment_index + 1]._velocity += delta_right;
-         }
-      }
+void WaterSurface::waitForSimulation()
+{
+   if (_pending_step.valid())
+   {
+      _pending_step.get();
+   }
+}
 
-      // update heights based on deltas
-      for (auto segment_index = 0; segment_index < _segments.size(); segment_index++)
-      {
-         if (segment_index > 0)
-         {
-            _segments[segment_index - 1]._height += _segments[segment_index]._delta_left;
-         }
+bool WaterSurface::prepareDraw(const sf::View& view)
+{
+   waitForSimulation();
 
-         if (segment_index < _segments.size() - 1)
-         {
-            _segments[segment_index + 1]._height += _segments[segment_index]._delta_right;
-         }
-      }
+   _on_screen = isOnScreen(view, _bounding_box);
+   if (!_on_screen)
+   {
+      return false;
    }
 
    // only update the top parts of the poly because the bottom doesn't move
-   updateVertices(0);
+   if (_vertices_dirty)
+   {
+      updateVertices(0);
+      _vertices_dirty = false;
+   }
+
+   return true;
 }
 
 std::optional<sf::FloatRect> WaterSurface::getBoundingBoxPx()
@@ -349,28 +367,10 @@ std::optional<sf::FloatRect> WaterSurface::getBoundingBoxPx()
    return _bounding_box;
 }
 
-void WaterSurface::Segment::update(float dampening, float tension)
-{
-   const auto x = _target_height - _height;
-   _velocity += tension * x - _velocity * dampening;
-   _height += _velocity;
-}
-
-void WaterSurface::Segment::resetDeltas()
-{
-   _delta_left = 0.0f;
-   _delta_right = 0.0f;
-}
-
 void WaterSurface::splash(int32_t index, float velocity)
 {
-   const auto start_index = std::max(0, index);
-   const auto stop_index = std::min<size_t>(_segments.size() - 1, index + 1);
-
-   for (auto i = start_index; i < stop_index; i++)
-   {
-      _segments[index]._velocity = velocity;
-   }
+   waitForSimulation();
+   _simulation.splash(index, velocity);
 }
 
 void WaterSurface::addEmitter(GameNode* /*parent*/, const GameDeserializeData& data)
@@ -461,10 +461,11 @@ void WaterSurface::updateVertices(int32_t start_index)
       y_offset = _bounding_box.size.y / _pixel_ratio.value();
    }
 
-   for (const auto& segment : _segments)
+   for (auto segment_index = 0u; segment_index < _simulation.size(); segment_index++)
    {
       const auto x = x_offset + static_cast<float>(width_index * _segment_width);
-      const auto y = (index & 1) ? (y_offset + _bounding_box.size.y) : (y_offset + segment._height * segment._clamp_scale);
+      const auto y = (index & 1) ? (y_offset + _bounding_box.size.y)
+                                 : (y_offset + _simulation.getHeight(segment_index) * _simulation.getClampScale(segment_index));
 
       _vertices[index].position.x = x;
       _vertices[index].position.y = y;
@@ -569,22 +570,19 @@ WaterSurface::WaterSurface(GameNode* /*parent*/, const GameDeserializeData& data
       }
    }
 
-   for (auto i = 0; i < segment_count; i++)
-   {
-      _segments.emplace_back();
-   }
+   _simulation.resize(segment_count);
 
    // clamp corner edges if configured
    if (clamp_segment_count.has_value())
    {
-      if (clamp_segment_count.value() * 2 < _segments.size())
+      if (clamp_segment_count.value() * 2 < _simulation.size())
       {
          const auto clamp_scale_increment = 1.0f / clamp_segment_count.value();
          auto scale = 0.0f;
          for (auto i = 0; i < clamp_segment_count; i++)
          {
-            _segments[i]._clamp_scale = scale;
-            _segments[_segments.size() - 1 - i]._clamp_scale = scale;
+            _simulation.setClampScale(i, scale);
+            _simulation.setClampScale(_simulation.size() - 1 - i, scale);
             scale += clamp_scale_increment;
          }
       }
@@ -604,7 +602,7 @@ WaterSurface::WaterSurface(GameNode* /*parent*/, const GameDeserializeData& data
    }
 
    // segment size - 1 has been chosen here to cover the entire range of the bounding box
-   _segment_width = (_bounding_box.size.x / (_segments.size() - 1)) / _pixel_ratio.value_or(1.0f);
+   _segment_width = (_bounding_box.size.x / (_simulation.size() - 1)) / _pixel_ratio.value_or(1.0f);
    updateVertices(0);
    updateVertices(1);
 
@@ -682,8 +680,8 @@ void WaterSurface::updateEmitters(float elapsed_s)
             const auto left_normalized = left_with_offset_px / _bounding_box.size.x;
             const auto right_normalized = right_with_offset_px / _bounding_box.size.x;
 
-            const auto left_index = static_cast<int32_t>(left_normalized * _segments.size());
-            const auto right_index = static_cast<int32_t>(right_normalized * _segments.size());
+            const auto left_index = static_cast<int32_t>(left_normalized * _simulation.size());
+            const auto right_index = static_cast<int32_t>(right_normalized * _simulation.size());
 
             for (auto index = left_index; index < right_index; index++)
             {
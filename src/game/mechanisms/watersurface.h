@@ -4,37 +4,16 @@
 #include "game/io/gamedeserializedata.h"
 #include "game/level/gamenode.h"
 #include "game/mechanisms/gamemechanism.h"
+#include "game/mechanisms/watersurfacesimulation.h"
+
+#include <future>
 
 /// \brief simulates and renders a deformable water surface with splash propagation.
-/// \note deliberately does not call addChunks: update runs a spring simulation across all segments and needs to keep
-///       running so the surface can settle. chunk culling would freeze the wave mid-oscillation and the player would
-///       come back to a stale deformation instead of calm water.
+/// \note a calm surface sleeps until the next splash, and a surface the camera does not see only steps every few
+///       frames. large surfaces step on a worker thread between update and draw, so several of them overlap.
 class WaterSurface : public GameMechanism, public GameNode
 {
 public:
-   /// \brief one simulated spring segment along the water surface.
-   struct Segment
-   {
-      Segment() = default;
-
-      /// \brief integrates this segment toward its target height.
-      /// \param dampening velocity dampening factor.
-      /// \param tension spring tension factor.
-      void update(float dampening, float tension);
-
-      /// \brief clears per-step neighbor transfer deltas.
-      void resetDeltas();
-
-      float _height{0.0f};
-      float _target_height{0.0f};
-      float _velocity{0.0f};
-
-      float _delta_left{0.0f};
-      float _delta_right{0.0f};
-
-      float _clamp_scale{1.0f};
-   };
-
    /// \brief wave simulation tuning parameters.
    struct Config
    {
@@ -115,8 +94,25 @@ private:
    /// \brief advances emitter timers and emits splash impulses when timers elapse.
    /// \param elapsed_s elapsed seconds since the previous frame.
    void updateEmitters(float elapsed_s);
+
+   /// \brief steps the spring simulation, on a worker thread for large surfaces.
+   /// \param elapsed_s elapsed seconds since the previous frame.
+   void stepSimulation(float elapsed_s);
+
+   /// \brief blocks until a step running on a worker thread is done.
+   void waitForSimulation();
+
+   /// \brief finishes the simulation step and refreshes the mesh if the surface is visible.
+   /// \param view view the surface is about to be drawn with.
+   /// \return true if the surface is on screen and should be drawn.
+   bool prepareDraw(const sf::View& view);
+
    sf::FloatRect _bounding_box;
-   std::vector<Segment> _segments;
+   WaterSurfaceSimulation _simulation;
+   std::future<void> _pending_step;  //!< declared after _simulation so it is joined before the simulation goes away
+   bool _vertices_dirty{false};
+   bool _on_screen{true};  //!< whether the last draw found the surface on screen
+   int32_t _frames_since_step{0};
    std::optional<bool> _player_was_in_water;
    sf::VertexArray _vertices;
    float _segment_width{0.0f};
@@ -0,0 +1,140 @@
+#include "watersurfacesimulation.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+constexpr auto integration_steps = 8;
+
+// below a hundredth of a pixel nobody can tell the surface from calm water
+constexpr auto rest_threshold = 0.01f;
+}  // namespace
+
+void WaterSurfaceSimulation::resize(size_t segment_count)
+{
+   _heights.assign(segment_count, 0.0f);
+   _target_heights.assign(segment_count, 0.0f);
+   _velocities.assign(segment_count, 0.0f);
+   _clamp_scales.assign(segment_count, 1.0f);
+   _fluxes.assign(segment_count, 0.0f);
+   _asleep = false;
+}
+
+size_t WaterSurfaceSimulation::size() const
+{
+   return _heights.size();
+}
+
+void WaterSurfaceSimulation::step(const Spring& spring, float elapsed_s)
+{
+   if (_asleep)
+   {
+      return;
+   }
+
+   // each segment is pulled toward its target height. the parameters are copied so the compiler does
+   // not have to assume the stores below change them, and the indices are size_t because a 32 bit
+   // index that might wrap keeps the loops from being vectorized
+   const auto count = _heights.size();
+   const auto tension = spring._tension;
+   const auto dampening = spring._dampening;
+   auto* heights = _heights.data();
+   auto* velocities = _velocities.data();
+   const auto* target_heights = _target_heights.data();
+
+   for (size_t i = 0; i < count; i++)
+   {
+      const auto x = target_heights[i] - heights[i];
+      velocities[i] += tension * x - velocities[i] * dampening;
+      heights[i] += velocities[i];
+   }
+
+   // then the neighbors pull on each other a few times
+   for (auto j = 0; j < integration_steps; j++)
+   {
+      spread(spring, elapsed_s);
+   }
+
+   if (isSettled())
+   {
+      std::copy(_target_heights.begin(), _target_heights.end(), _heights.begin());
+      std::fill(_velocities.begin(), _velocities.end(), 0.0f);
+      _asleep = true;
+   }
+}
+
+void WaterSurfaceSimulation::spread(const Spring& spring, float elapsed_s)
+{
+   const auto count = _heights.size();
+   if (count < 2)
+   {
+      return;
+   }
+
+   const auto spread_factor = spring._spread;
+   const auto animation_speed = spring._animation_speed;
+   auto* heights = _heights.data();
+   auto* velocities = _velocities.data();
+   auto* fluxes = _fluxes.data();
+
+   // evaluated in the order the per segment loop used, so the rounding is the same
+   for (size_t i = 0; i + 1 < count; i++)
+   {
+      fluxes[i] = spread_factor * (heights[i] - heights[i + 1]) * elapsed_s * animation_speed;
+   }
+
+   // every segment first receives from its left neighbor, then gives to its right one
+   velocities[0] -= fluxes[0];
+   heights[0] -= fluxes[0];
+   for (size_t i = 1; i + 1 < count; i++)
+   {
+      velocities[i] = (velocities[i] + fluxes[i - 1]) - fluxes[i];
+      heights[i] = (heights[i] + fluxes[i - 1]) - fluxes[i];
+   }
+   velocities[count - 1] += fluxes[count - 2];
+   heights[count - 1] += fluxes[count - 2];
+}
+
+bool WaterSurfaceSimulation::isSettled() const
+{
+   // counted rather than returning at the first moving segment, that keeps the loop vectorizable
+   auto moving = 0u;
+   for (size_t i = 0; i < _heights.size(); i++)
+   {
+      moving += (std::fabs(_heights[i] - _target_heights[i]) >= rest_threshold) | (std::fabs(_velocities[i]) >= rest_threshold);
+   }
+
+   return moving == 0;
+}
+
+void WaterSurfaceSimulation::splash(int32_t index, float velocity)
+{
+   if (index < 0 || static_cast<size_t>(index) + 1 >= _velocities.size())
+   {
+      return;
+   }
+
+   _velocities[index] = velocity;
+   _asleep = false;
+}
+
+bool WaterSurfaceSimulation::isAsleep() const
+{
+   return _asleep;
+}
+
+void WaterSurfaceSimulation::setClampScale(size_t index, float scale)
+{
+   _clamp_scales[index] = scale;
+}
+
+float WaterSurfaceSimulation::getHeight(size_t index) const
+{
+   return _heights[index];
+}
+
+float WaterSurfaceSimulation::getClampScale(size_t index) const
+{
+   return _clamp_scales[index];
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// \brief the spring simulation behind WaterSurface, kept apart from the rendering so it runs without sfml.
+///
+/// The segments are stored as one array per field rather than one struct per segment, so each pass walks
+/// contiguous floats and the compiler can vectorize it.
+///
+/// The spread between neighbors is computed as one flux per pair: what a segment pushes to its right
+/// neighbor is exactly the negative of what the neighbor pushes back, so each flux is computed once and
+/// applied to both sides. The additions happen in the same order as in the per segment loop this
+/// replaces, which keeps the results bit for bit the same.
+///
+/// A surface that has come to rest is put to sleep and costs nothing until the next splash.
+class WaterSurfaceSimulation
+{
+public:
+   /// \brief spring tuning, see WaterSurface::Config.
+   struct Spring
+   {
+      float _tension = 0.025f;
+      float _dampening = 0.025f;
+      float _spread = 0.25f;
+      float _animation_speed = 10.0f;
+   };
+
+   /// \brief sets the number of segments, all of them at rest.
+   /// \param segment_count number of segments.
+   void resize(size_t segment_count);
+
+   /// \brief gets the number of segments.
+   /// \return segment count.
+   size_t size() const;
+
+   /// \brief advances the surface by one frame.
+   /// \param spring spring tuning.
+   /// \param elapsed_s elapsed frame time in seconds.
+   void step(const Spring& spring, float elapsed_s);
+
+   /// \brief sets the velocity of one segment and wakes the surface up.
+   /// \param index segment index; the last segment and indices out of range are ignored.
+   /// \param velocity new velocity of the segment.
+   void splash(int32_t index, float velocity);
+
+   /// \brief checks whether the surface is at rest and does not need to be stepped.
+   /// \return true while asleep.
+   bool isAsleep() const;
+
+   /// \brief sets how much of a segment's height is shown, used to pin the corners of a surface.
+   /// \param index segment index.
+   /// \param scale 0 keeps the segment flat, 1 shows its full height.
+   void setClampScale(size_t index, float scale);
+
+   /// \brief gets the height of a segment relative to the surface.
+   /// \param index segment index.
+   /// \return height in px.
+   float getHeight(size_t index) const;
+
+   /// \brief gets the clamp scale of a segment.
+   /// \param index segment index.
+   /// \return scale applied to the segment height when drawing.
+   float getClampScale(size_t index) const;
+
+private:
+   void spread(const Spring& spring, float elapsed_s);
+   bool isSettled() const;
+
+   std::vector<float> _heights;
+   std::vector<float> _target_heights;
+   std::vector<float> _velocities;
+   std::vector<float> _clamp_scales;
+   std::vector<float> _fluxes;  //!< scratch, what each segment passes on to its right neighbor in one spread pass
+
+   bool _asleep{false};
+};
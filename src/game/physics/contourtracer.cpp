@@ -0,0 +1,293 @@
+#include "contourtracer.h"
+
+#include "framework/tools/asynctask.h"
+
+#include <algorithm>
+#include <bit>
+#include <future>
+#include <thread>
+
+namespace
+{
+constexpr uint32_t min_rows_per_band = 64;
+
+constexpr int32_t top_left = 0x01;
+constexpr int32_t top_right = 0x02;
+constexpr int32_t bottom_left = 0x04;
+constexpr int32_t bottom_right = 0x08;
+}  // namespace
+
+ContourTracer::ContourTracer(
+   uint32_t width,
+   uint32_t height,
+   const std::vector<int32_t>& tiles,
+   const std::vector<int32_t>& colliding_tiles
+)
+    : _width(width), _height(height), _words_per_row((width + 63) / 64)
+{
+   _colliding.resize(static_cast<size_t>(_words_per_row) * _height, 0);
+
+   for (auto y = 0u; y < _height; y++)
+   {
+      auto* row = &_colliding[static_cast<size_t>(y) * _words_per_row];
+      const auto* tile_row = &tiles[static_cast<size_t>(y) * _width];
+
+      for (auto x = 0u; x < _width; x++)
+      {
+         if (std::ranges::find(colliding_tiles, tile_row[x]) != colliding_tiles.end())
+         {
+            row[x >> 6] |= (uint64_t{1} << (x & 63));
+         }
+      }
+   }
+}
+
+uint64_t ContourTracer::getGridHash() const
+{
+   auto hash = uint64_t{14695981039346656037ull};
+   const auto mix = [&hash](uint64_t value)
+   {
+      for (auto i = 0; i < 8; i++)
+      {
+         hash ^= (value >> (i * 8)) & 0xff;
+         hash *= 1099511628211ull;
+      }
+   };
+
+   mix(_width);
+   mix(_height);
+   for (const auto word : _colliding)
+   {
+      mix(word);
+   }
+
+   return hash;
+}
+
+ContourTracer::Direction ContourTracer::getDirection(uint32_t x, uint32_t y, Direction previous) const
+{
+   // x - 1 and y - 1 wrap around at the top and left border and then read as not colliding
+   auto four_pixels = 0;
+
+   if (isColliding(x - 1, y - 1))
+   {
+      four_pixels |= top_left;
+   }
+   if (isColliding(x, y - 1))
+   {
+      four_pixels |= top_right;
+   }
+   if (isColliding(x - 1, y))
+   {
+      four_pixels |= bottom_left;
+   }
+   if (isColliding(x, y))
+   {
+      four_pixels |= bottom_right;
+   }
+
+   switch (four_pixels)
+   {
+      case 1:
+      case 5:
+      case 13:
+         return Direction::Up;
+      case 2:
+      case 3:
+      case 7:
+         return Direction::Right;
+      case 4:
+      case 12:
+      case 14:
+         return Direction::Left;
+      case 8:
+      case 10:
+      case 11:
+         return Direction::Down;
+      case 6:
+         return (previous == Direction::Up) ? Direction::Left : Direction::Right;
+      case 9:
+         return (previous == Direction::Right) ? Direction::Up : Direction::Down;
+      default:
+         return Direction::None;
+   }
+}
+
+ContourTracer::Contour ContourTracer::march(uint32_t start_x, uint32_t start_y) const
+{
+   Contour contour;
+
+   auto x = start_x;
+   auto y = start_y;
+   auto dir = Direction::None;
+
+   while (true)
+   {
+      dir = getDirection(x, y, dir);
+
+      switch (dir)
+      {
+         case Direction::Up:
+            y -= 1;
+            break;
+         case Direction::Down:
+            y += 1;
+            break;
+         case Direction::Left:
+            x -= 1;
+            break;
+         case Direction::Right:
+            x += 1;
+            break;
+         case Direction::None:
+            return contour;
+      }
+
+      contour._dirs.push_back(dir);
+      contour._points.push_back({static_cast<int32_t>(x), static_cast<int32_t>(y)});
+
+      if (x == start_x && y == start_y)
+      {
+         return contour;
+      }
+   }
+}
+
+uint64_t ContourTracer::getStartBits(uint32_t y, uint32_t word) const
+{
+   // a walk can only start at a colliding cell that is not surrounded by colliding cells above and to
+   // the left; from anywhere else there is no direction to go
+   const auto row = static_cast<size_t>(y) * _words_per_row;
+   const auto center = _colliding[row + word];
+   const auto left = (center << 1) | ((word > 0) ? (_colliding[row + word - 1] >> 63) : 0);
+
+   if (y == 0)
+   {
+      return center;
+   }
+
+   const auto above_row = row - _words_per_row;
+   const auto above = _colliding[above_row + word];
+   const auto above_left = (above << 1) | ((word > 0) ? (_colliding[above_row + word - 1] >> 63) : 0);
+
+   return center & ~(left & above & above_left);
+}
+
+void ContourTracer::markVisited(const Contour& contour, Bits& visited) const
+{
+   // the walk runs along vertices, which can lie one past the last column or row; those are no cells
+   for (const auto& point : contour._points)
+   {
+      const auto x = static_cast<uint32_t>(point._x);
+      const auto y = static_cast<uint32_t>(point._y);
+      if (x < _width && y < _height)
+      {
+         visited[static_cast<size_t>(y) * _words_per_row + (x >> 6)] |= (uint64_t{1} << (x & 63));
+      }
+   }
+}
+
+std::vector<ContourTracer::Start> ContourTracer::traceBand(uint32_t first_row, uint32_t end_row) const
+{
+   std::vector<Start> starts;
+   Bits visited(_colliding.size(), 0);
+
+   for (auto y = first_row; y < end_row; y++)
+   {
+      const auto row = static_cast<size_t>(y) * _words_per_row;
+      for (auto word = 0u; word < _words_per_row; word++)
+      {
+         auto bits = getStartBits(y, word);
+         while (bits != 0)
+         {
+            const auto bit = static_cast<uint32_t>(std::countr_zero(bits));
+            bits &= bits - 1;
+
+            // re-read every time, the walk started at the previous bit may have passed this cell
+            if ((visited[row + word] >> bit) & 1)
+            {
+               continue;
+            }
+
+            const auto x = word * 64 + bit;
+            auto contour = march(x, y);
+            markVisited(contour, visited);
+            starts.push_back({y * _width + x, std::move(contour)});
+         }
+      }
+   }
+
+   return starts;
+}
+
+std::vector<ContourTracer::Contour> ContourTracer::trace(int32_t band_count) const
+{
+   if (band_count <= 0)
+   {
+      band_count = static_cast<int32_t>(std::max(std::thread::hardware_concurrency(), 1u));
+   }
+
+   // thin bands would trace mostly outlines that reach into the next band and get thrown away
+   const auto used_band_count = std::clamp(static_cast<uint32_t>(band_count), 1u, std::max(_height / min_rows_per_band, 1u));
+   const auto rows_per_band = std::max((_height + used_band_count - 1) / used_band_count, 1u);
+
+   std::vector<std::future<std::vector<Start>>> band_futures;
+   for (auto first_row = 0u; first_row < _height; first_row += rows_per_band)
+   {
+      const auto end_row = std::min(first_row + rows_per_band, _height);
+      band_futures.push_back(startAsyncTask([this, first_row, end_row]() { return traceBand(first_row, end_row); }));
+   }
+
+   std::vector<std::vector<Start>> band_starts;
+   band_starts.reserve(band_futures.size());
+   for (auto& future : band_futures)
+   {
+      band_starts.push_back(future.get());
+   }
+
+   // stitch: the same scan again over all rows, now with every outline taken so far marked
+   std::vector<Contour> contours;
+   Bits visited(_colliding.size(), 0);
+   std::vector<size_t> cursors(band_starts.size(), 0);
+
+   for (auto y = 0u; y < _height; y++)
+   {
+      const auto band = y / rows_per_band;
+      auto& starts = band_starts[band];
+      auto& cursor = cursors[band];
+
+      const auto row = static_cast<size_t>(y) * _words_per_row;
+      for (auto word = 0u; word < _words_per_row; word++)
+      {
+         auto bits = getStartBits(y, word) & ~visited[row + word];
+         while (bits != 0)
+         {
+            const auto bit = static_cast<uint32_t>(std::countr_zero(bits));
+            bits &= bits - 1;
+
+            if ((visited[row + word] >> bit) & 1)
+            {
+               continue;
+            }
+
+            const auto x = word * 64 + bit;
+            const auto cell = y * _width + x;
+            while (cursor < starts.size() && starts[cursor]._cell < cell)
+            {
+               cursor++;
+            }
+
+            auto contour = (cursor < starts.size() && starts[cursor]._cell == cell) ? std::move(starts[cursor]._contour) : march(x, y);
+            if (contour._points.empty())
+            {
+               continue;
+            }
+
+            markVisited(contour, visited);
+            contours.push_back(std::move(contour));
+         }
+      }
+   }
+
+   return contours;
+}
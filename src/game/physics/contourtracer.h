@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/// \brief traces the outlines of the colliding cells of a tile grid, the core of SquareMarcher.
+///
+/// Whether a tile collides is decided once up front and kept as one bit per cell, 64 cells to a word,
+/// so the walk only ever tests bits and whole words of non-starting cells are skipped when scanning.
+///
+/// Tracing is split into horizontal bands that are traced on worker threads. Each band scans its rows
+/// the way a single pass would, but only knows about the outlines it traced itself, so an outline
+/// crossing into the band below may be traced once in each band. Walking an outline only reads the
+/// grid, which means a walk from a given cell always gives the same result no matter which band did
+/// it. A sequential stitch pass then repeats the scan over all rows with the full picture: it takes
+/// each band's outline at the cells where the single pass would start one and drops the duplicates.
+/// The rare start a band skipped because of one of its duplicates is walked right there. The result
+/// is the same outlines, in the same order, as scanning with a single thread.
+class ContourTracer
+{
+public:
+   enum class Direction
+   {
+      None,
+      Up,
+      Down,
+      Left,
+      Right
+   };
+
+   /// \brief a grid vertex; cell (x, y) has its top left corner at vertex (x, y).
+   struct Point
+   {
+      int32_t _x = 0;
+      int32_t _y = 0;
+   };
+
+   /// \brief one closed outline, each point paired with the step that led to it.
+   struct Contour
+   {
+      std::vector<Point> _points;
+      std::vector<Direction> _dirs;
+   };
+
+   /// \brief builds the collision bits.
+   /// \param width map width in tiles.
+   /// \param height map height in tiles.
+   /// \param tiles tile ids for the full grid, row by row.
+   /// \param colliding_tiles tile ids considered solid.
+   ContourTracer(uint32_t width, uint32_t height, const std::vector<int32_t>& tiles, const std::vector<int32_t>& colliding_tiles);
+
+   /// \brief traces all outlines.
+   /// \param band_count number of bands traced in parallel, 0 picks one per hardware thread.
+   /// \return the outlines in the order a single row-by-row scan finds them.
+   std::vector<Contour> trace(int32_t band_count = 0) const;
+
+   /// \brief checks whether a cell is inside the grid and colliding.
+   /// \param x x coordinate in tile space.
+   /// \param y y coordinate in tile space.
+   /// \return true when the cell is colliding.
+   bool isColliding(uint32_t x, uint32_t y) const
+   {
+      return x < _width && y < _height && (_colliding[y * _words_per_row + (x >> 6)] >> (x & 63)) & 1;
+   }
+
+   /// \brief returns a hash over the collision bits, e.g. to tell whether a cache still matches the map.
+   /// \return 64 bit FNV-1a hash of the grid size and the collision bits.
+   uint64_t getGridHash() const;
+
+private:
+   struct Start
+   {
+      uint32_t _cell = 0;
+      Contour _contour;
+   };
+
+   using Bits = std::vector<uint64_t>;
+
+   Contour march(uint32_t start_x, uint32_t start_y) const;
+   Direction getDirection(uint32_t x, uint32_t y, Direction previous) const;
+   uint64_t getStartBits(uint32_t y, uint32_t word) const;
+   void markVisited(const Contour& contour, Bits& visited) const;
+   std::vector<Start> traceBand(uint32_t first_row, uint32_t end_row) const;
+
+   uint32_t _width = 0;
+   uint32_t _height = 0;
+   uint32_t _words_per_row = 0;
+   Bits _colliding;
+};
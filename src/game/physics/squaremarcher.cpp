@@ -1,15 +1,23 @@
 #include "squaremarcher.h"
 
+#include "framework/tools/binarystream.h"
 #include "framework/tools/log.h"
+#include "framework/tools/mappedfile.h"
 
 #include <algorithm>
 #include <filesystem>
 #include <format>
 #include <fstream>
-#include <iomanip>
 #include <iostream>
 #include <ostream>
-#include <sstream>
+
+namespace
+{
+constexpr uint32_t cache_magic = 0x4d515344;  // 'DSQM'
+
+// bump whenever the layout of the cache changes
+constexpr uint32_t cache_version = 1;
+}  // namespace
 
 SquareMarcher::SquareMarcher(
    uint32_t w,
@@ -19,13 +27,10 @@ SquareMarcher::SquareMarcher(
    const std::filesystem::path& cache_path,
    float scaleFactor
 )
-    : _width(w), _height(h), _tiles(tiles), _colliding_tiles(colliding_tiles), _cache_path(cache_path), _scale(scaleFactor)
+    : _width(w), _height(h), _tiles(tiles), _tracer(w, h, tiles, colliding_tiles), _cache_path(cache_path), _scale(scaleFactor)
 {
-   _visited.resize(_width * _height);
-
    // dumpMap();
    scan();
-   optimize();
    scale();
 }
 
@@ -55,84 +60,77 @@ void SquareMarcher::dumpMap()
    fileOut.close();
 }
 
-void SquareMarcher::serialize()
+void SquareMarcher::serialize() const
 {
-   std::ofstream file_out(_cache_path);
+   BinaryWriter writer;
+   writer.write(cache_magic);
+   writer.write(cache_version);
+   writer.write(_width);
+   writer.write(_height);
+   writer.write(_tracer.getGridHash());
+   writer.write(static_cast<uint32_t>(_paths.size()));
    for (const auto& path : _paths)
    {
-      for (const auto& pos : path._polygon)
-      {
-         file_out << std::fixed << std::setprecision(8) << pos.x;
-         file_out << ",";
-         file_out << std::fixed << std::setprecision(3) << pos.y;
-         file_out << ";";
-      }
-
-      file_out << std::endl;
+      writer.writeVector(path._polygon);
    }
-   file_out.close();
+
+   // best effort, the level might live on a read-only filesystem
+   std::ofstream file_out(_cache_path, std::ofstream::binary | std::ofstream::trunc);
+   file_out.write(writer.getBuffer().data(), static_cast<std::streamsize>(writer.getBuffer().size()));
 }
 
-void SquareMarcher::deserialize()
+bool SquareMarcher::deserialize()
 {
-   std::string line;
-
-   std::ifstream file_in(_cache_path);
-   while (std::getline(file_in, line))
+   MappedFile file;
+   if (!file.open(_cache_path))
    {
-      std::istringstream lineStream(line);
-      std::string item;
-
-      std::string eatComma;
-      Path path;
-
-      while (getline(lineStream, item, ';'))
-      {
-         std::istringstream posStream(item);
-         auto x = 0;
-         auto y = 0;
+      return false;
+   }
 
-         posStream >> x;
-         std::getline(posStream, eatComma, ',');
-         posStream >> y;
+   BinaryReader reader(file.getData(), file.getSize());
+   if (reader.read<uint32_t>() != cache_magic || reader.read<uint32_t>() != cache_version || reader.read<uint32_t>() != _width ||
+       reader.read<uint32_t>() != _height || reader.read<uint64_t>() != _tracer.getGridHash())
+   {
+      return false;
+   }
 
-         path._polygon.emplace_back(x, y);
-      }
+   std::vector<Path> paths(reader.read<uint32_t>());
+   for (auto& path : paths)
+   {
+      path._polygon = reader.readVector<sf::Vector2i>();
+   }
 
-      _paths.push_back(path);
+   if (!reader.isValid() || !reader.isAtEnd())
+   {
+      return false;
    }
+
+   _paths = std::move(paths);
+   return true;
 }
 
 void SquareMarcher::scan()
 {
-   std::srand(static_cast<uint32_t>(std::time(nullptr)));
+   if (deserialize())
+   {
+      return;
+   }
 
-   std::ifstream fileIn(_cache_path);
-   if (fileIn.fail())
+   for (auto& contour : _tracer.trace())
    {
-      // scan tiles until collision hit that wasn't visited
-      for (auto y = 0u; y < _height; y++)
+      Path path;
+      path._dirs = std::move(contour._dirs);
+      path._polygon.reserve(contour._points.size());
+      for (const auto& point : contour._points)
       {
-         for (auto x = 0u; x < _width; x++)
-         {
-            if (!isVisited(x, y) && isColliding(x, y))
-            {
-               auto p = march(x, y);
-
-               if (!p._polygon.empty())
-               {
-                  _paths.push_back(p);
-               }
-            }
-         }
+         path._polygon.emplace_back(point._x, point._y);
       }
 
-      serialize();
-   }
-   else
-   {
-      deserialize();
+      _paths.push_back(std::move(path));
    }
+
+   optimize();
+   serialize();
 }
 
 void SquareMarcher::writeGridToImage(const std::filesystem::path& image_path)
@@ -315,213 +313,9 @@ void SquareMarcher::scale()
    }
 }
 
-void SquareMarcher::updateDirection()
+bool SquareMarcher::isColliding(uint32_t x, uint32_t y) const
 {
-   auto four_pixels = 0;
-
-   if (isColliding(_x - 1, _y - 1))
-   {
-      four_pixels |= static_cast<int32_t>(PixelLocation::TopLeft);
-   }
-   if (isColliding(_x, _y - 1))
-   {
-      four_pixels |= static_cast<int32_t>(PixelLocation::TopRight);
-   }
-   if (isColliding(_x - 1, _y))
-   {
-      four_pixels |= static_cast<int32_t>(PixelLocation::BottomLeft);
-   }
-   if (isColliding(_x, _y))
-   {
-      four_pixels |= static_cast<int32_t>(PixelLocation::BottomRight);
-   }
-
-   _dir_previous = _dir_current;
-
-   switch (four_pixels)
-   {
-      case 1:
-      {
-         _dir_current = Direction::Up;
-         break;
-      }
-      case 2:
-      {
-         _dir_current = Direction::Right;
-         break;
-      }
-      case 3:
-      {
-         _dir_current = Direction::Right;
-         break;
-      }
-      case 4:
-      {
-         _dir_current = Direction::Left;
-         break;
-      }
-      case 5:
-      {
-         _dir_current = Direction::Up;
-         break;
-      }
-      case 6:
-      {
-         if (_dir_previous == Direction::Up)
-         {
-            _dir_current = Direction::Left;
-         }
-         else
-         {
-            _dir_current = Direction::Right;
-         }
-
-         break;
-      }
-      case 7:
-      {
-         _dir_current = Direction::Right;
-         break;
-      }
-      case 8:
-      {
-         _dir_current = Direction::Down;
-         break;
-      }
-      case 9:
-      {
-         if (_dir_previous == Direction::Right)
-         {
-            _dir_current = Direction::Up;
-         }
-         else
-         {
-            _dir_current = Direction::Down;
-         }
-         break;
-      }
-      case 10:
-      {
-         _dir_current = Direction::Down;
-         break;
-      }
-      case 11:
-      {
-         _dir_current = Direction::Down;
-         break;
-      }
-      case 12:
-      {
-         _dir_current = Direction::Left;
-         break;
-      }
-      case 13:
-      {
-         _dir_current = Direction::Up;
-         break;
-      }
-      case 14:
-      {
-         _dir_current = Direction::Left;
-         break;
-      }
-      default:
-      {
-         _dir_current = Direction::None;
-         break;
-      }
-   }
-}
-
-bool SquareMarcher::isColliding(uint32_t x, uint32_t y)
-{
-   if (x >= _width)
-   {
-      return false;
-   }
-
-   if (y >= _height)
-   {
-      return false;
-   }
-
-   auto val = _tiles[y * _width + x];
-   return std::find(_colliding_tiles.begin(), _colliding_tiles.end(), val) != _colliding_tiles.end();
-}
-
-bool SquareMarcher::isVisited(uint32_t x, uint32_t y)
-{
-   if (x >= _width)
-   {
-      return false;
-   }
-
-   if (y >= _height)
-   {
-      return false;
-   }
-
-   auto key = y * _width + x;
-   return _visited[key];
-}
-
-void SquareMarcher::updatePosition()
-{
-   switch (_dir_current)
-   {
-      case Direction::Up:
-         _y -= 1;
-         break;
-
-      case Direction::Down:
-         _y += 1;
-         break;
-
-      case Direction::Left:
-         _x -= 1;
-         break;
-
-      case Direction::Right:
-         _x += 1;
-         break;
-
-      case Direction::None:
-         break;
-   }
-}
-
-SquareMarcher::Path SquareMarcher::march(uint32_t start_x, uint32_t start_y)
-{
-   _dir_previous = Direction::None;
-
-   _x = start_x;
-   _y = start_y;
-
-   Path path;
-
-   while (true)
-   {
-      _visited[_y * _width + _x] = true;
-
-      updateDirection();
-      updatePosition();
-
-      if (_dir_current != Direction::None)
-      {
-         path._dirs.push_back(_dir_current);
-         path._polygon.emplace_back(
-            static_cast<int32_t>(_x), static_cast<int32_t>(_y)
-
-         );
-      }
-
-      if (_x == start_x && _y == start_y)
-      {
-         break;
-      }
-   }
-
-   return path;
+   return _tracer.isColliding(x, y);
 }
 
 void SquareMarcher::Path::printPoly()
@@ -3,10 +3,15 @@
 
 #include <SFML/Graphics.hpp>
 #include <filesystem>
-#include <map>
 #include <vector>
 
+#include "game/physics/contourtracer.h"
+
 /// \brief extracts collision outlines from a tile grid using a marching-squares style contour walk.
+///
+/// The walk itself is done by ContourTracer on a bit-packed copy of the grid, split into bands that are
+/// traced in parallel. The optimized outlines are cached in a small binary file next to the level; the
+/// cache carries a hash of the collision grid and is traced again when the map has changed.
 class SquareMarcher
 {
 public:
@@ -40,23 +45,7 @@ public:
    /// \param imagePath destination image path.
    void writePathToImage(const std::filesystem::path& imagePath);
 
-   enum class Direction
-   {
-      None,
-      Up,
-      Down,
-      Left,
-      Right
-   };
-
-   enum class PixelLocation
-   {
-      None = 0x00,
-      TopLeft = 0x01,
-      TopRight = 0x02,
-      BottomLeft = 0x04,
-      BottomRight = 0x08
-   };
+   using Direction = ContourTracer::Direction;
 
    /// \brief stores one traced contour with integer points, scaled points, and step directions.
    struct Path
@@ -75,38 +64,21 @@ public:
    std::vector<Path> _paths;
 
 private:
-   /// \brief loads cached contours or scans the tile grid to generate and cache new contours.
+   /// \brief loads cached contours or traces the tile grid to generate and cache new contours.
    void scan();
 
-   /// \brief traces one closed contour starting at a colliding unvisited tile coordinate.
-   /// \param startX starting x coordinate in tile space.
-   /// \param startY starting y coordinate in tile space.
-   /// \return traced contour path including polygon points and step directions.
-   Path march(uint32_t startX, uint32_t startY);
-
-   /// \brief computes the next march direction from the current 2x2 occupancy configuration.
-   void updateDirection();
-
-   /// \brief advances the current march position by one step in the current direction.
-   void updatePosition();
-
    /// \brief checks whether a tile coordinate is inside bounds and marked as colliding.
    /// \param x x coordinate in tile space.
    /// \param y y coordinate in tile space.
    /// \return true when the coordinate maps to a colliding tile id.
-   bool isColliding(uint32_t x, uint32_t y);
+   bool isColliding(uint32_t x, uint32_t y) const;
 
-   /// \brief checks whether a tile coordinate has already been visited by contour tracing.
-   /// \param x x coordinate in tile space.
-   /// \param y y coordinate in tile space.
-   /// \return true when the coordinate is within bounds and marked as visited.
-   bool isVisited(uint32_t x, uint32_t y);
-
-   /// \brief writes traced polygon paths to the cache file.
-   void serialize();
+   /// \brief writes the optimized polygon paths to the binary cache file.
+   void serialize() const;
 
    /// \brief reads polygon paths from the cache file.
-   void deserialize();
+   /// \return true when the cache exists and was written for the same collision grid.
+   bool deserialize();
 
    /// \brief removes redundant collinear points from traced paths.
    void optimize();
@@ -114,19 +86,11 @@ private:
    /// \brief fills scaled floating-point coordinates for each path using the configured scale factor.
    void scale();
 
-private:
-   std::map<int, Direction> _map;
    uint32_t _width = 0u;
    uint32_t _height = 0u;
    std::vector<int32_t> _tiles;
-   std::vector<int32_t> _colliding_tiles;
-   std::vector<bool> _visited;
+   ContourTracer _tracer;
    std::filesystem::path _cache_path;
-
-   uint32_t _x = 0;
-   uint32_t _y = 0;
-   Direction _dir_current = Direction::None;
-   Direction _dir_previous = Direction::None;
    float _scale = 1.0f;
 };
 
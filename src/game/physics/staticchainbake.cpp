@@ -0,0 +1,79 @@
+#include "staticchainbake.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <tuple>
+
+#include "game/constants.h"
+#include "game/level/chunk.h"
+
+namespace
+{
+Chunk getChunk(const std::vector<b2Vec2>& chain)
+{
+   auto min_x = std::numeric_limits<float>::max();
+   auto min_y = std::numeric_limits<float>::max();
+   auto max_x = std::numeric_limits<float>::lowest();
+   auto max_y = std::numeric_limits<float>::lowest();
+
+   for (const auto& vertex : chain)
+   {
+      min_x = std::min(min_x, vertex.x);
+      min_y = std::min(min_y, vertex.y);
+      max_x = std::max(max_x, vertex.x);
+      max_y = std::max(max_y, vertex.y);
+   }
+
+   return Chunk{(min_x + max_x) * 0.5f * PPM, (min_y + max_y) * 0.5f * PPM};
+}
+}  // namespace
+
+std::vector<uint32_t> StaticChainBake::groupByChunk(std::vector<std::vector<b2Vec2>>& chains)
+{
+   struct Key
+   {
+      int32_t _y = 0;
+      int32_t _x = 0;
+      uint32_t _index = 0;
+   };
+
+   std::vector<Key> keys;
+   keys.reserve(chains.size());
+   for (auto i = 0u; i < chains.size(); i++)
+   {
+      const auto chunk = getChunk(chains[i]);
+      keys.push_back({chunk._y, chunk._x, i});
+   }
+
+   // row by row, and within a chunk in the original order so a rebuild gives the same fixtures
+   std::ranges::sort(keys, [](const auto& a, const auto& b) { return std::tie(a._y, a._x, a._index) < std::tie(b._y, b._x, b._index); });
+
+   std::vector<std::vector<b2Vec2>> sorted_chains;
+   sorted_chains.reserve(chains.size());
+
+   std::vector<uint32_t> group_sizes;
+   for (auto i = 0u; i < keys.size(); i++)
+   {
+      if (i == 0 || keys[i]._x != keys[i - 1]._x || keys[i]._y != keys[i - 1]._y)
+      {
+         group_sizes.push_back(0);
+      }
+
+      group_sizes.back()++;
+      sorted_chains.push_back(std::move(chains[keys[i]._index]));
+   }
+
+   chains = std::move(sorted_chains);
+   return group_sizes;
+}
+
+bool StaticChainBake::isValid(const std::vector<uint32_t>& group_sizes, size_t chain_count)
+{
+   if (std::ranges::find(group_sizes, 0u) != group_sizes.end())
+   {
+      return false;
+   }
+
+   return std::accumulate(group_sizes.cbegin(), group_sizes.cend(), size_t{0}) == chain_count;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "box2d/box2d.h"
+
+/// \brief groups the static chains of a physics layer so that the chains of one chunk share a body.
+///
+/// The level outlines come out of the obj files as many small loops, and adding each of them as a body
+/// of its own left large levels with thousands of static bodies. Box2D walks every body in every step,
+/// and every query that resolves fixtures to bodies - lights, WorldQuery, lua - reports and then has to
+/// deduplicate each of them. Grouping the loops by the chunk their bounding box is centered in keeps
+/// the number of bodies down to the number of chunks the level covers.
+///
+/// The grouping only reorders the chains, the geometry and the fixture per chain stay as they are.
+namespace StaticChainBake
+{
+/// \brief sorts chains by the chunk they belong to.
+/// \param chains closed loops in box2d world coordinates, reordered in place so each group is contiguous.
+/// \return number of chains in each group, in the order the groups appear in `chains`.
+std::vector<uint32_t> groupByChunk(std::vector<std::vector<b2Vec2>>& chains);
+
+/// \brief checks that group sizes describe exactly the given number of chains.
+/// \param group_sizes number of chains per group.
+/// \param chain_count number of chains.
+/// \return true when no group is empty and the sizes add up to `chain_count`.
+bool isValid(const std::vector<uint32_t>& group_sizes, size_t chain_count);
+}  // namespace StaticChainBake
@@ -130,7 +130,7 @@ Player::Player(GameNode* parent) : PlayerInterface(parent)
 
 void Player::initialize()
 {
-   _damage_clock.restart();
+   _damage_time = GlobalClock::getInstance().getElapsedTime();
 
    if (!_silhouette_shader.loadFromFragment("data/shaders/player_silhouette.frag"))
    {
@@ -243,7 +243,7 @@ bool Player::checkDamageDrawSkip() const
 
    auto skip_render = false;
    const auto time = GlobalClock::getInstance().getElapsedTimeInMs();
-   const auto damage_time = _damage_clock.getElapsedTime().asMilliseconds();
+   const auto damage_time = (GlobalClock::getInstance().getElapsedTime() - _damage_time).asMilliseconds();
    if (_damage_initialized && time > 3000 && damage_time < 3000)
    {
       if ((damage_time / 100) % 2 == 0)
@@ -264,7 +264,8 @@ void Player::updateHurtColor(const std::shared_ptr<Animation>& current_cycle)
 
    // update color if player is hurt
    constexpr auto red_intensity = 200;
-   const auto damage_color_value = static_cast<uint8_t>(red_intensity * std::max(0.0f, 1.0f - _damage_clock.getElapsedTime().asSeconds()));
+   const auto time_since_damage = GlobalClock::getInstance().getElapsedTime() - _damage_time;
+   const auto damage_color_value = static_cast<uint8_t>(red_intensity * std::max(0.0f, 1.0f - time_since_damage.asSeconds()));
    if (damage_color_value > 0)
    {
       const auto damage_color = sf::Color(255, 255 - damage_color_value, 255 - damage_color_value);
@@ -306,7 +307,7 @@ void Player::drawDash(sf::RenderTarget& color, const std::shared_ptr<Animation>&
 
 void Player::draw(sf::RenderTarget& color, sf::RenderTarget& normal, const sf::RenderStates& states)
 {
-   _water_bubbles.draw(color, normal);
+   _water_bubbles.draw(color, normal, states);
 
    // drawn before the visibility checks below, the rope should not blink along with the damaged player
    _harpoon.draw(color, normal, states);
@@ -1227,7 +1228,7 @@ void Player::damage(int32_t damage, const sf::Vector2f& force)
       return;
    }
 
-   if (_damage_clock.getElapsedTime().asMilliseconds() > 3000)
+   if ((GlobalClock::getInstance().getElapsedTime() - _damage_time).asMilliseconds() > 3000)
    {
       _damage_initialized = true;
 
@@ -1238,7 +1239,7 @@ void Player::damage(int32_t damage, const sf::Vector2f& force)
       body->ApplyLinearImpulse(b2Vec2(force.x / PPM, force.y / PPM), body->GetWorldCenter(), true);
 
       SaveState::getPlayerInfo()._extra_table._health._health -= damage;
-      _damage_clock.restart();
+      _damage_time = GlobalClock::getInstance().getElapsedTime();
 
       if (SaveState::getPlayerInfo()._extra_table._health._health < 0)
       {
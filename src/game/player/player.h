@@ -491,7 +491,7 @@ private:
 
    sf::Time _time;
    sf::Clock _clock;
-   sf::Clock _damage_clock;
+   sf::Time _damage_time;  //!< global clock time of the last damage taken
    bool _damage_initialized{false};
 
    bool _points_to_left{false};
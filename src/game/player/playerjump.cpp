@@ -74,6 +74,7 @@ void PlayerJump::updateJumpBuffer()
 void PlayerJump::updateJump()
 {
    const auto& physics = PhysicsConfiguration::getInstance();
+   const auto time_since_jump_ms = (GlobalClock::getInstance().getElapsedTime() - _jump_time).asMilliseconds();
 
    if (_jump_info._in_water && _controls->isButtonAPressed())
    {
@@ -87,13 +88,13 @@ void PlayerJump::updateJump()
 
          // to transition to a regular jump after leaving the water, the jump frame count and jump clock should be reset
          _jump_frame_count = physics._player_jump_frame_count;
-         _jump_clock.restart();
+         _jump_time = GlobalClock::getInstance().getElapsedTime();
       }
    }
    else if ((_jump_frame_count > 0 && _controls->isButtonAPressed())  // still jumping (button pressed)
             || (_jump_frame_count > 0 && (physics._player_jump_frame_count - _jump_frame_count < physics._player_jump_frame_count_minimum)
                )  // still jumping (minimum jump frames)
-            || _jump_clock.getElapsedTime().asMilliseconds() < physics._player_jump_minimal_duration_ms  // fresh jump
+            || time_since_jump_ms < physics._player_jump_minimal_duration_ms  // fresh jump
    )
    {
       // jump higher if faster than regular walk speed
@@ -140,13 +141,13 @@ void PlayerJump::jumpImpulse()
 {
    const auto impulse = _body->GetMass() * PhysicsConfiguration::getInstance()._player_jump_impulse_factor;
 
-   _jump_clock.restart();
+   _jump_time = GlobalClock::getInstance().getElapsedTime();
    _body->ApplyLinearImpulse(b2Vec2(0.0f, -impulse), _body->GetWorldCenter(), true);
 }
 
 void PlayerJump::jumpImpulse(const b2Vec2& impulse)
 {
-   _jump_clock.restart();
+   _jump_time = GlobalClock::getInstance().getElapsedTime();
    _body->ApplyLinearImpulse(impulse, _body->GetWorldCenter(), true);
 }
 
@@ -154,7 +155,7 @@ void PlayerJump::jumpForce()
 {
    // apply individual forces for a given number of frames
    // that's the approach this game is currently using
-   _jump_clock.restart();
+   _jump_time = GlobalClock::getInstance().getElapsedTime();
    _jump_frame_count = PhysicsConfiguration::getInstance()._player_jump_frame_count;
 }
 
@@ -264,7 +265,7 @@ void PlayerJump::jump()
       return;
    }
 
-   const auto elapsed = _jump_clock.getElapsedTime();
+   const auto elapsed = GlobalClock::getInstance().getElapsedTime() - _jump_time;
 
    // only allow a new jump after a a couple of milliseconds
    if (elapsed.asMilliseconds() <= PhysicsConfiguration::getInstance()._player_minimum_jump_interval_ms)
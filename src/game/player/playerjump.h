@@ -1,5 +1,7 @@
 #pragma once
 
+#include "framework/tools/globalclock.h"
+#include "game/audio/audio.h"
 #include "game/player/playercontrols.h"
 
 #include "box2d/box2d.h"
@@ -91,7 +93,7 @@ struct PlayerJump
    std::shared_ptr<PlayerControls> _controls;
    b2Body* _body = nullptr;
 
-   sf::Clock _jump_clock;               // replace by chrono
+   sf::Time _jump_time = GlobalClock::getInstance().getElapsedTime();  // global clock time of the last jump
    sf::Time _last_jump_press_time;      // replace by chrono
    sf::Time _ground_contact_lost_time;  // replace by chrono
 
@@ -104,7 +106,7 @@ struct PlayerJump
    float _walljump_multiplier = 0.0f;
    b2Vec2 _walljump_direction;
    bool _walljump_points_right = false;
-   std::optional<int32_t> _wallslide_sample;
+   std::optional<Audio::Playback> _wallslide_sample;
 
    bool _had_ground_contact = true;
    bool _ground_contact_just_lost = false;
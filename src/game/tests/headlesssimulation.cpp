@@ -0,0 +1,289 @@
+#include "headlesssimulation.h"
+
+#include "framework/tools/globalclock.h"
+#include "framework/tools/log.h"
+#include "framework/tools/timer.h"
+#include "game/camera/camerasystem.h"
+#include "game/clock/gameclock.h"
+#include "game/config/gameconfiguration.h"
+#include "game/constants.h"
+#include "game/io/eventserializer.h"
+#include "game/level/level.h"
+#include "game/level/levelregistry.h"
+#include "game/player/player.h"
+#include "game/player/playerregistry.h"
+#include "game/state/gamestate.h"
+#include "opengl/glew.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+
+#ifndef DECEPTUS_VRSFML
+#include <SFML/Window/Context.hpp>
+#endif
+
+namespace
+{
+constexpr uint64_t fnv_offset_basis = 14695981039346656037ull;
+constexpr uint64_t fnv_prime = 1099511628211ull;
+
+template <typename T>
+void hashValue(uint64_t& hash, const T& value)
+{
+   std::array<uint8_t, sizeof(T)> bytes;
+   std::memcpy(bytes.data(), &value, sizeof(T));
+   for (const auto byte : bytes)
+   {
+      hash ^= byte;
+      hash *= fnv_prime;
+   }
+}
+}  // namespace
+
+std::optional<HeadlessSimulation::Options> HeadlessSimulation::parseArguments(int32_t argc, char** argv)
+{
+   std::optional<Options> options;
+
+   for (auto i = 1; i < argc; i++)
+   {
+      const std::string argument = argv[i];
+      const auto has_value = (i + 1 < argc);
+
+      if (argument == "--headless" && has_value)
+      {
+         options = options.value_or(Options{});
+         options->_level_path = argv[++i];
+      }
+      else if (argument == "--replay" && has_value)
+      {
+         options = options.value_or(Options{});
+         options->_recording_path = argv[++i];
+      }
+      else if (argument == "--steps" && has_value)
+      {
+         options = options.value_or(Options{});
+         options->_step_count = std::max(std::atoi(argv[++i]), 1);
+      }
+      else if (argument == "--report" && has_value)
+      {
+         options = options.value_or(Options{});
+         options->_report_path = argv[++i];
+      }
+      else if (argument == "--seed" && has_value)
+      {
+         options = options.value_or(Options{});
+         options->_seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+      }
+   }
+
+   // the other options mean nothing without a level
+   if (options.has_value() && options->_level_path.empty())
+   {
+      Log::Error() << "headless: --headless <level> is required";
+      return std::nullopt;
+   }
+
+   return options;
+}
+
+HeadlessSimulation::HeadlessSimulation(Options options) : _options(std::move(options))
+{
+}
+
+int32_t HeadlessSimulation::run()
+{
+#ifndef DECEPTUS_VRSFML
+   // the context is never shown, it is only there so textures and shaders can be loaded
+   sf::Context context;
+   if (!context.setActive(true))
+   {
+      Log::Error() << "headless: failed to activate an opengl context";
+      return EXIT_FAILURE;
+   }
+#endif
+
+   const auto glew_error = glewInit();
+   if (glew_error != GLEW_OK)
+   {
+      Log::Error() << "headless: failed to initialize GLEW: " << glew_error;
+      return EXIT_FAILURE;
+   }
+
+   if (!load())
+   {
+      unload();
+      return EXIT_FAILURE;
+   }
+
+   _step_times_us.reserve(_options._step_count);
+   while (static_cast<int32_t>(_step_times_us.size()) < _options._step_count)
+   {
+      // a lua script may ask for a level change; there is no next level to go to here
+      if (_level->isDirty())
+      {
+         Log::Info() << "headless: level requested a change after " << _step_times_us.size() << " steps, stopping";
+         break;
+      }
+
+      // feeding exactly one step's worth of time mostly pays for one step; float rounding makes it
+      // occasionally zero or two, which is what the game does too
+      const auto step_count = _fixed_time_step.consumeSteps(_fixed_time_step.getStepDuration());
+      for (auto i = 0; i < step_count && static_cast<int32_t>(_step_times_us.size()) < _options._step_count; i++)
+      {
+         step();
+
+         if (_level->isDirty())
+         {
+            break;
+         }
+      }
+   }
+
+   const auto state_hash = computeStateHash();
+   writeReport(state_hash);
+   unload();
+
+   return EXIT_SUCCESS;
+}
+
+bool HeadlessSimulation::load()
+{
+   // from here on time only moves when a step is run
+   GlobalClock::getInstance().useSimulatedTime();
+   GameClock::getInstance().useSimulatedTime();
+   Timer::useSimulatedTime();
+
+   GameState::getInstance().setMode(ExecutionMode::Running);
+
+   const auto& config = GameConfiguration::getInstance();
+   _render_targets.create(
+      static_cast<uint32_t>(config._view_width),
+      static_cast<uint32_t>(config._view_height),
+      static_cast<float>(config._view_width),
+      static_cast<float>(config._view_height)
+   );
+
+   _player = std::make_shared<Player>();
+   PlayerRegistry::add(_player);
+   _player->initialize();
+
+   const auto load_start = std::chrono::steady_clock::now();
+
+   _level = std::make_shared<Level>(_render_targets);
+   LevelRegistry::setCurrent(_level);
+   _level->setDescriptionFilename(_options._level_path);
+   _level->initialize();
+
+   _player->setWorld(_level->getWorld());
+   _player->initializeLevel();
+   _player->updatePixelRect();
+
+   _level->syncRoom();
+   CameraSystem::getInstance().syncNow();
+   GameClock::getInstance().reset();
+
+   const auto load_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - load_start).count();
+   Log::Info() << "headless: loaded " << _options._level_path << " in " << load_ms << "ms";
+
+   // effects that pick random numbers are seeded from the time when they are created, so seed after loading
+   std::srand(_options._seed);
+
+   if (_options._recording_path.has_value())
+   {
+      auto serializer = EventSerializer::getInstance("player");
+      if (!serializer)
+      {
+         Log::Error() << "headless: player has no event serializer to replay with";
+         return false;
+      }
+
+      serializer->deserialize(_options._recording_path.value());
+      serializer->setSimulatedTime(true);
+      serializer->play();
+   }
+
+   return true;
+}
+
+void HeadlessSimulation::step()
+{
+   const auto dt = _fixed_time_step.getStepDuration();
+   const auto dt_chrono = std::chrono::microseconds(dt.asMicroseconds());
+
+   GlobalClock::getInstance().advanceSimulatedTime(dt);
+   GameClock::getInstance().advanceSimulatedTime(dt_chrono);
+   Timer::advanceSimulatedTime(dt_chrono);
+
+   const auto step_start = std::chrono::steady_clock::now();
+
+   Timer::update(Timer::Scope::UpdateAlways);
+   Timer::update(Timer::Scope::UpdateIngame);
+
+   // unlike Game::update there is no EventSerializer::updateAll here: the only serializer that matters
+   // is the player's, and PlayerControls::update already advances it. advancing it twice per step would
+   // play a recording back at double speed now that it follows simulated time
+   _level->update(dt);
+   _player->update(dt);
+
+   _step_times_us.push_back(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - step_start).count());
+}
+
+uint64_t HeadlessSimulation::computeStateHash() const
+{
+   auto hash = fnv_offset_basis;
+   hashValue(hash, static_cast<uint64_t>(_step_times_us.size()));
+
+   const auto& world = _level->getWorld();
+   for (const auto* body = world->GetBodyList(); body; body = body->GetNext())
+   {
+      const auto& position = body->GetPosition();
+      const auto& velocity = body->GetLinearVelocity();
+      hashValue(hash, position.x);
+      hashValue(hash, position.y);
+      hashValue(hash, body->GetAngle());
+      hashValue(hash, velocity.x);
+      hashValue(hash, velocity.y);
+   }
+
+   return hash;
+}
+
+void HeadlessSimulation::writeReport(uint64_t state_hash) const
+{
+   auto sorted_times_us = _step_times_us;
+   std::sort(sorted_times_us.begin(), sorted_times_us.end());
+
+   const auto total_us = std::accumulate(sorted_times_us.cbegin(), sorted_times_us.cend(), int64_t{0});
+   const auto mean_us = sorted_times_us.empty() ? 0 : total_us / static_cast<int64_t>(sorted_times_us.size());
+   const auto p99_us = sorted_times_us.empty() ? 0 : sorted_times_us[(sorted_times_us.size() * 99) / 100];
+
+   std::ofstream report(_options._report_path);
+   report << "step,update_us\n";
+   for (auto i = 0u; i < _step_times_us.size(); i++)
+   {
+      report << i << "," << _step_times_us[i] << "\n";
+   }
+
+   report << "# level=" << _options._level_path << " steps=" << _step_times_us.size() << " seed=" << _options._seed << " state_hash=0x"
+          << std::hex << state_hash << std::dec << "\n";
+
+   Log::Info() << "headless: " << _step_times_us.size() << " steps, mean " << mean_us << "us, p99 " << p99_us << "us, total "
+               << total_us / 1000 << "ms, state hash 0x" << std::hex << state_hash << std::dec << ", report written to "
+               << _options._report_path.string();
+}
+
+void HeadlessSimulation::unload()
+{
+   if (_player)
+   {
+      _player->resetWorld();
+   }
+
+   LevelRegistry::clearCurrent();
+   _level.reset();
+}
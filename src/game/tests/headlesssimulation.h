@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "game/physics/fixedtimestep.h"
+#include "game/rendering/rendertargets.h"
+
+class Level;
+class Player;
+
+/// \brief runs a level without a window, as fast as the machine allows.
+///
+/// The level and the player are loaded the way the game loads them, then stepped through FixedTimeStep
+/// for a fixed number of steps. Nothing is drawn. All clocks the simulation reads are switched to
+/// simulated time that moves exactly one step per step, so a run does not depend on how long each step
+/// took; input comes from an EventSerializer recording instead of the keyboard.
+///
+/// At exit a CSV with the time each step took is written, followed by a hash of the final state of
+/// every physics body. Two runs of the same level and recording are expected to end on the same hash;
+/// when they do not, something still reads the wall clock or an unseeded random number.
+///
+/// Loading textures and shaders still needs an OpenGL context. It is never shown, so a software driver
+/// such as Mesa's llvmpipe is enough on machines without a GPU.
+class HeadlessSimulation
+{
+public:
+   /// \brief what to run.
+   struct Options
+   {
+      std::string _level_path;
+      std::optional<std::filesystem::path> _recording_path;
+      int32_t _step_count = 3600;
+      std::filesystem::path _report_path = "headless_report.csv";
+      uint32_t _seed = 0;
+   };
+
+   /// \brief reads the options from the command line.
+   ///
+   /// Usage: `--headless <level.json> [--replay <events.dat>] [--steps <n>] [--report <file.csv>] [--seed <n>]`
+   ///
+   /// \param argc argument count as passed to main.
+   /// \param argv arguments as passed to main.
+   /// \return the options if `--headless` was given, std::nullopt otherwise.
+   static std::optional<Options> parseArguments(int32_t argc, char** argv);
+
+   /// \brief constructs a simulation.
+   /// \param options what to run.
+   explicit HeadlessSimulation(Options options);
+
+   /// \brief loads the level, runs all steps and writes the report.
+   /// \return exit code for main, 0 on success.
+   int32_t run();
+
+private:
+   bool load();
+   void step();
+   uint64_t computeStateHash() const;
+   void writeReport(uint64_t state_hash) const;
+   void unload();
+
+   Options _options;
+   FixedTimeStep _fixed_time_step;
+   RenderTargets _render_targets;
+   std::shared_ptr<Level> _level;
+   std::shared_ptr<Player> _player;
+   std::vector<int64_t> _step_times_us;
+};
@@ -71,7 +71,12 @@ Bow::Bow(const WeaponProperties& properties)
 
 void Bow::load(b2World* world)
 {
-   auto arrow = new Arrow();
+   auto arrow = Projectile::acquire<Arrow>(this);
+   if (!arrow)
+   {
+      return;
+   }
+
    arrow->setAnimation(_projectile_reference_animation._animation);
    arrow->_start_time = GlobalClock::getInstance().getElapsedTimeInMs();
 
@@ -85,6 +90,16 @@ void Bow::load(b2World* world)
       }
    );
 
+   // a pooled arrow brings its body along, disabled and still carrying the arrow fixture
+   if (auto* pooled_body = arrow->getBody())
+   {
+      pooled_body->SetGravityScale(0.0f);
+      pooled_body->SetLinearVelocity(b2Vec2(0.0f, 0.0f));
+      pooled_body->SetAngularVelocity(0.0f);
+      pooled_body->SetEnabled(true);
+      return;
+   }
+
    b2BodyDef body_def;
    body_def.type = b2_dynamicBody;
    body_def.position.Set(0, 5);
@@ -122,6 +137,11 @@ void Bow::use(const std::shared_ptr<b2World>& world, const b2Vec2& pos, const b2
    // Right now it's just firing into walking direction.
    load(world.get());
 
+   if (!_loaded_arrow)
+   {
+      return;
+   }
+
    // store projectile so it gets drawn
    _projectiles.push_back(_loaded_arrow);
 
@@ -14,8 +14,8 @@ public:
    /// \param properties runtime weapon configuration, including owner body and timing values.
    Bow(const WeaponProperties& properties = _default_properties);
 
-   /// \brief creates a loaded arrow body and projectile object without firing it yet.
-   /// \param world box2d world where the temporary loaded arrow body is created.
+   /// \brief takes an arrow from the projectile pool, or creates one with its body, without firing it yet.
+   /// \param world box2d world where the loaded arrow body is created if the arrow does not bring one.
    void load(b2World* world);
 
    /// \brief loads and fires an arrow from the launcher body in the requested direction.
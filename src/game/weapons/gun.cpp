@@ -2,6 +2,7 @@
 #include "game/weapons/gun.h"
 
 // framework
+#include "framework/tools/globalclock.h"
 #include "framework/tools/sfmlcompat.h"
 
 // game
@@ -27,7 +28,7 @@ Gun::Gun() : _shape(std::make_unique<b2CircleShape>())
    _shape->m_radius = 0.05f;
 
    // start it so the elapsed timer is exceeded on first use
-   _fire_clock.restart();
+   _fire_time = GlobalClock::getInstance().getElapsedTime();
 
    // a default
    setProjectileAnimation(TexturePool::getInstance().get(_projectile_reference_animation._texture_path));
@@ -41,11 +42,16 @@ Gun::Gun(const WeaponProperties& properties) : _shape(std::move(properties._shap
    _density = properties.read<float>("density", 1.0f);
 
    // start it so the elapsed timer is exceeded on first use
-   _fire_clock.restart();
+   _fire_time = GlobalClock::getInstance().getElapsedTime();
 
    setProjectileAnimation(TexturePool::getInstance().get(_projectile_reference_animation._texture_path));
 }
 
+Gun::~Gun()
+{
+   Projectile::releaseOwner(this);
+}
+
 void Gun::copyReferenceAnimation(Projectile* projectile)
 {
    Animation animation(_projectile_reference_animation._animation);
@@ -58,31 +64,50 @@ void Gun::copyReferenceAnimation(Projectile* projectile)
 
 void Gun::use(const std::shared_ptr<b2World>& world, const b2Vec2& pos, const b2Vec2& dir)
 {
-   b2BodyDef body_definition;
-   body_definition.type = b2_dynamicBody;
-   body_definition.position.Set(pos.x, pos.y);
+   auto projectile = Projectile::acquire<Projectile>(this);
+   if (!projectile)
+   {
+      return;
+   }
+
+   auto bullet_body = projectile->getBody();
+   if (bullet_body)
+   {
+      // a pooled projectile brings its body along, disabled and still carrying this gun's fixture
+      bullet_body->SetTransform(pos, 0.0f);
+      bullet_body->SetLinearVelocity(b2Vec2(0.0f, 0.0f));
+      bullet_body->SetAngularVelocity(0.0f);
+      bullet_body->SetEnabled(true);
+   }
+   else
+   {
+      b2BodyDef body_definition;
+      body_definition.type = b2_dynamicBody;
+      body_definition.position.Set(pos.x, pos.y);
 
-   auto bullet_body = world->CreateBody(&body_definition);
-   bullet_body->SetBullet(true);
-   bullet_body->SetGravityScale(_gravity_scale);
+      bullet_body = world->CreateBody(&body_definition);
+      bullet_body->SetBullet(true);
+      bullet_body->SetGravityScale(_gravity_scale);
 
-   b2FixtureDef fixture_definition;
-   fixture_definition.shape = _shape.get();
-   fixture_definition.density = _density;
+      b2FixtureDef fixture_definition;
+      fixture_definition.shape = _shape.get();
+      fixture_definition.density = _density;
 
-   fixture_definition.filter.groupIndex = group_index;
-   fixture_definition.filter.maskBits = mask_bits_standing;
-   fixture_definition.filter.categoryBits = category_bits;
-   auto fixture = bullet_body->CreateFixture(&fixture_definition);
+      fixture_definition.filter.groupIndex = group_index;
+      fixture_definition.filter.maskBits = mask_bits_standing;
+      fixture_definition.filter.categoryBits = category_bits;
+      auto fixture = bullet_body->CreateFixture(&fixture_definition);
+      fixture->SetUserData(static_cast<void*>(projectile));
+
+      projectile->setBody(bullet_body);
+   }
 
    bullet_body->ApplyLinearImpulse(dir, pos, true);
 
    // create a projectile animation copy from the reference animation
-   auto projectile = new Projectile();
    copyReferenceAnimation(projectile);
 
    projectile->setProperty("damage", _damage);
-   projectile->setBody(bullet_body);
 
    projectile->addDestroyedCallback(
       [this, projectile]() { _projectiles.erase(std::remove(_projectiles.begin(), _projectiles.end(), projectile), _projectiles.end()); }
@@ -93,8 +118,6 @@ void Gun::use(const std::shared_ptr<b2World>& world, const b2Vec2& pos, const b2
       projectile->setProjectileIdentifier(_projectile_reference_animation._identifier.value());
    }
 
-   fixture->SetUserData(static_cast<void*>(projectile));
-
    // store audio update data if present
    if (_parent_audio_update_data.has_value())
    {
@@ -107,11 +130,11 @@ void Gun::use(const std::shared_ptr<b2World>& world, const b2Vec2& pos, const b2
 
 void Gun::useInIntervals(const std::shared_ptr<b2World>& world, const b2Vec2& pos, const b2Vec2& dir)
 {
-   if (_fire_clock.getElapsedTime().asMilliseconds() > _use_interval_ms)
+   if ((GlobalClock::getInstance().getElapsedTime() - _fire_time).asMilliseconds() > _use_interval_ms)
    {
       use(world, pos, dir);
 
-      _fire_clock.restart();
+      _fire_time = GlobalClock::getInstance().getElapsedTime();
    }
 }
 
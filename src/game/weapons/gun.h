@@ -37,13 +37,16 @@ public:
    /// \param properties configuration source for cooldown, damage, physics, and projectile shape.
    Gun(const WeaponProperties& properties);
 
+   /// \brief detaches the projectiles this gun fired from it, so they do not return to a gone weapon.
+   ~Gun() override;
+
    /// \brief fires only when the cooldown interval has elapsed.
    /// \param world box2d world that receives newly spawned projectile bodies.
    /// \param pos spawn position in box2d world units.
    /// \param dir impulse vector applied to the spawned projectile body.
    virtual void useInIntervals(const std::shared_ptr<b2World>& world, const b2Vec2& pos, const b2Vec2& dir);
 
-   /// \brief spawns one projectile body, assigns visuals, and stores it for updates and rendering.
+   /// \brief spawns one projectile, reusing a pooled one and its body when possible, and stores it for updates and rendering.
    /// \param world box2d world that receives the projectile body.
    /// \param pos spawn position in box2d world units.
    /// \param dir impulse vector applied immediately after spawn.
@@ -113,7 +116,7 @@ protected:
    std::vector<Projectile*> _projectiles;
    ProjectileAnimation _projectile_reference_animation;
    std::unique_ptr<b2Shape> _shape;
-   sf::Clock _fire_clock;
+   sf::Time _fire_time;  //!< global clock time of the last shot
 
    int32_t _use_interval_ms{100};
    int32_t _damage{100};
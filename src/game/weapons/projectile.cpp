@@ -8,8 +8,10 @@
 
 #include "box2d/box2d.h"
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
+#include <unordered_map>
 
 namespace
 {
@@ -24,14 +26,38 @@ struct HitInformation
 };
 
 std::vector<HitInformation> _hit_information;
-std::set<Projectile*> _projectiles;
+
+std::vector<Projectile*> _projectiles;                                          // live, dense
+std::unordered_map<const void*, std::vector<Projectile*>> _free_projectiles;  // parked, per owner
+std::vector<Projectile*> _orphaned_projectiles;                                // owner gone or evicted, deleted with the next update
+Projectile::PoolCounters _pool_counters;
+
+void addLive(Projectile* projectile, std::size_t& live_index)
+{
+   live_index = _projectiles.size();
+   _projectiles.push_back(projectile);
+
+   _pool_counters._live++;
+   _pool_counters._peak_live = std::max(_pool_counters._peak_live, _pool_counters._live);
+}
+
+void deleteProjectiles(std::vector<Projectile*>& projectiles)
+{
+   for (auto* projectile : projectiles)
+   {
+      delete projectile;
+   }
+
+   projectiles.clear();
+}
 }  // namespace
 
 Projectile::Projectile() : FixtureNode(this)
 {
    setClassName(typeid(Projectile).name());
    _type = ObjectTypeProjectile;
-   _projectiles.insert(this);
+   addLive(this, _live_index);
+   _pool_counters._allocations++;
 
    ProjectileHitAnimation::setupDefaultAnimation();
 }
@@ -83,49 +109,171 @@ void Projectile::clear()
 {
    _hit_information.clear();
 
-   // delete all projectiles that have not been scheduled for removal until just now
-   std::for_each(
-      _projectiles.begin(),
-      _projectiles.end(),
-      [](auto projectile)
-      {
-         // there's no more need to notify the parent weapons since they're probably also already deleted;
-         // also, we should not care about the box2d representation of the object, just avoid the memory
-         // leak here. all box2d instances are deleted right after calling Projectile::clear().
-         projectile->_destroyed_callbacks.clear();
-         projectile->_body = nullptr;
-         delete projectile;
-      }
-   );
+   // delete all projectiles, live or parked
+   const auto delete_projectile = [](auto projectile)
+   {
+      // there's no more need to notify the parent weapons since they're probably also already deleted;
+      // also, we should not care about the box2d representation of the object, just avoid the memory
+      // leak here. all box2d instances are deleted right after calling Projectile::clear().
+      projectile->_destroyed_callbacks.clear();
+      projectile->_body = nullptr;
+      delete projectile;
+   };
+
+   std::ranges::for_each(_projectiles, delete_projectile);
+   std::ranges::for_each(_orphaned_projectiles, delete_projectile);
+   for (auto& [owner, free_projectiles] : _free_projectiles)
+   {
+      std::ranges::for_each(free_projectiles, delete_projectile);
+   }
+
    _projectiles.clear();
+   _orphaned_projectiles.clear();
+   _free_projectiles.clear();
+   _pool_counters = {};
 }
 
 void Projectile::collectHitInformation()
 {
    _hit_information.clear();
 
-   for (auto it = _projectiles.begin(); it != _projectiles.end();)
+   // released projectiles are replaced by the last live one, so the index only advances past projectiles that stay
+   std::size_t live_index = 0;
+   while (live_index < _projectiles.size())
    {
-      auto projectile = *it;
-      if (projectile->isScheduledForRemoval())
+      auto projectile = _projectiles[live_index];
+      if (!projectile->isScheduledForRemoval())
       {
-         _hit_information.push_back(
-            {b2Vec2(projectile->getBody()->GetPosition()),
-             projectile->_rotation,
-             projectile->_weapon_type,
-             projectile->_projectile_identifier,
-             projectile->_audio_enabled}
-         );
+         live_index++;
+         continue;
+      }
 
-         delete projectile;
+      _hit_information.push_back(
+         {b2Vec2(projectile->getBody()->GetPosition()),
+          projectile->_rotation,
+          projectile->_weapon_type,
+          projectile->_projectile_identifier,
+          projectile->_audio_enabled}
+      );
 
-         _projectiles.erase(it++);
-      }
-      else
+      release(projectile);
+   }
+}
+
+void Projectile::release(Projectile* projectile)
+{
+   for (const auto& cb : projectile->_destroyed_callbacks)
+   {
+      cb();
+   }
+
+   projectile->_destroyed_callbacks.clear();
+
+   auto* last = _projectiles.back();
+   _projectiles[projectile->_live_index] = last;
+   last->_live_index = projectile->_live_index;
+   _projectiles.pop_back();
+   _pool_counters._live--;
+
+   if (projectile->_owner == nullptr)
+   {
+      delete projectile;
+      return;
+   }
+
+   // the body keeps its fixture, so the next shot of the same owner only has to move and enable it
+   if (projectile->_body)
+   {
+      projectile->_body->SetEnabled(false);
+   }
+
+   _free_projectiles[projectile->_owner].push_back(projectile);
+   _pool_counters._pooled++;
+}
+
+Projectile* Projectile::reuse(const void* owner)
+{
+   auto free_it = _free_projectiles.find(owner);
+   if (free_it == _free_projectiles.end() || free_it->second.empty())
+   {
+      return nullptr;
+   }
+
+   auto* projectile = free_it->second.back();
+   free_it->second.pop_back();
+   _pool_counters._pooled--;
+
+   projectile->resetForReuse();
+   addLive(projectile, projectile->_live_index);
+   _pool_counters._reuses++;
+
+   return projectile;
+}
+
+bool Projectile::reserveSlot()
+{
+   const auto projectile_count = _pool_counters._live + _pool_counters._pooled;
+   if (projectile_count < pool_capacity)
+   {
+      return true;
+   }
+
+   // give up a parked projectile of whichever owner has the most parked. it cannot be deleted here, the
+   // world may be locked while a projectile is fired from a contact callback, so it is orphaned and no
+   // longer counts towards the pool
+   const auto largest_it =
+      std::ranges::max_element(_free_projectiles, [](const auto& a, const auto& b) { return a.second.size() < b.second.size(); });
+
+   if (largest_it == _free_projectiles.end() || largest_it->second.empty())
+   {
+      _pool_counters._rejections++;
+      return false;
+   }
+
+   _orphaned_projectiles.push_back(largest_it->second.back());
+   largest_it->second.pop_back();
+   _pool_counters._pooled--;
+   _pool_counters._evictions++;
+   return true;
+}
+
+void Projectile::resetForReuse()
+{
+   _scheduled_for_removal = false;
+   _scheduled_for_inactivity = false;
+   _hit_something = false;
+   _rotation = 0.0f;
+   _time_alive = sf::Time::Zero;
+   _parent_audio_update_data.reset();
+   _audio_enabled = true;
+}
+
+void Projectile::releaseOwner(const void* owner)
+{
+   // the owner's callbacks would call into the owner, so they go as well
+   for (auto* projectile : _projectiles)
+   {
+      if (projectile->_owner == owner)
       {
-         ++it;
+         projectile->_owner = nullptr;
+         projectile->_destroyed_callbacks.clear();
       }
    }
+
+   auto free_it = _free_projectiles.find(owner);
+   if (free_it == _free_projectiles.end())
+   {
+      return;
+   }
+
+   _orphaned_projectiles.insert(_orphaned_projectiles.end(), free_it->second.begin(), free_it->second.end());
+   _pool_counters._pooled -= static_cast<int32_t>(free_it->second.size());
+   _free_projectiles.erase(free_it);
+}
+
+const Projectile::PoolCounters& Projectile::getPoolCounters()
+{
+   return _pool_counters;
 }
 
 void Projectile::processHitInformation()
@@ -147,7 +295,10 @@ void Projectile::processHitInformation()
          if (!reference_samples.empty())
          {
             ProjectileHitAudio::ProjectileHitSample sample = reference_samples[std::rand() % reference_samples.size()];
-            Audio::getInstance().playSample({sample._sample, sample._volume});
+            Audio::PlayInfo play_info{sample._sample, sample._volume};
+            play_info._priority = Audio::PlayInfo::priority_effect;
+            play_info._pos = sf::Vector3f{gx, gy, 0.0f};
+            Audio::getInstance().requestSample(play_info);
          }
       }
 
@@ -217,8 +368,12 @@ void Projectile::setRotating(bool rotating)
 
 void Projectile::update(const sf::Time& dt)
 {
+   // the world is unlocked here, so the bodies of parked projectiles whose weapon went away or that were
+   // evicted can go
+   deleteProjectiles(_orphaned_projectiles);
+
    // this is for projectiles that are just not hitting anything
-   for (auto& projectile : _projectiles)
+   for (auto* projectile : _projectiles)
    {
       projectile->_time_alive += dt;
       if (projectile->_time_alive.asSeconds() > 30.0)
@@ -232,7 +387,7 @@ void Projectile::update(const sf::Time& dt)
    ProjectileHitAnimation::updateHitAnimations(dt);
 }
 
-std::set<Projectile*>& Projectile::getProjectiles()
+const std::vector<Projectile*>& Projectile::getProjectiles()
 {
    return _projectiles;
 }
@@ -8,21 +8,43 @@
 #include "game/level/gamenode.h"
 #include "game/weapons/projectilehitanimation.h"
 
+#include <cstdint>
 #include <functional>
 #include <list>
 #include <map>
-#include <set>
+#include <vector>
 
 class b2Body;
 
 /// \brief base class for live projectile entities with physics, animation, and hit effects.
+///
+/// Projectiles are pooled. A weapon acquires them through acquire() with itself as the owner; once a
+/// projectile is removed it is not deleted but parked on its owner's free list together with its box2d
+/// body, which is only disabled. The next shot of the same weapon takes it from there and re-enables the
+/// body, so its shape and fixture filter are guaranteed to match. The live projectiles are held in one
+/// dense array rather than a set, and the pool never holds more than pool_capacity projectiles. Parked
+/// projectiles that lost their owner or were evicted leave the pool and are deleted with the next update.
 class Projectile : public FixtureNode
 {
 public:
-   /// \brief callback invoked when a projectile is destroyed.
+   /// \brief callback invoked when a projectile is destroyed or returned to the pool.
    using DestroyedCallback = std::function<void(void)>;
 
-   /// \brief registers this projectile in the global projectile set and ensures default hit animation data exists.
+   /// \brief occupancy and allocation counters of the projectile pool, reset when a level is loaded.
+   struct PoolCounters
+   {
+      int32_t _live{0};         //!< projectiles currently in flight or stuck somewhere
+      int32_t _pooled{0};       //!< projectiles parked on an owner's free list, bodies disabled
+      int32_t _peak_live{0};    //!< highest _live count seen
+      int64_t _allocations{0};  //!< projectiles created with new, each one with a fresh body
+      int64_t _reuses{0};       //!< projectiles taken from a free list instead
+      int64_t _evictions{0};    //!< parked projectiles given up to make room for another owner
+      int64_t _rejections{0};   //!< shots dropped because the pool was full of live projectiles
+   };
+
+   static constexpr auto pool_capacity = 1024;
+
+   /// \brief registers this projectile in the live projectile array and ensures default hit animation data exists.
    Projectile();
 
    /// \brief notifies destruction callbacks and destroys the associated box2d body when present.
@@ -36,16 +58,34 @@ public:
    /// \param body projectile physics body pointer.
    void setBody(b2Body* body);
 
-   /// \brief deletes all registered projectiles and clears global projectile state.
+   /// \brief deletes all live and pooled projectiles and clears global projectile state.
    static void clear();
 
    /// \brief updates projectile lifetime, handles removals, and advances hit animations.
    /// \param dt frame delta time.
    static void update(const sf::Time& dt);
 
-   /// \brief returns the global set of currently tracked projectiles.
-   /// \return reference to the static projectile set.
-   static std::set<Projectile*>& getProjectiles();
+   /// \brief returns the currently live projectiles.
+   /// \return reference to the dense live projectile array.
+   static const std::vector<Projectile*>& getProjectiles();
+
+   /// \brief takes a projectile off the owner's free list, or creates one while the pool has room.
+   /// \param owner the weapon firing the projectile; projectiles are only ever reused by the same owner.
+   /// \return the projectile, nullptr if the pool is full of live projectiles. a reused projectile still
+   ///         carries its body, disabled; a new one has none yet.
+   template <typename T>
+   static T* acquire(const void* owner);
+
+   /// \brief detaches all projectiles from an owner that is going away.
+   /// \param owner the weapon being destroyed.
+   /// \note live projectiles keep flying and are deleted rather than pooled once they are removed. the
+   ///       owner's parked projectiles are deleted with the next update, the world may be locked or already
+   ///       gone at the time the owner is destroyed.
+   static void releaseOwner(const void* owner);
+
+   /// \brief returns the pool occupancy and allocation counters.
+   /// \return counters since the last level load.
+   static const PoolCounters& getPoolCounters();
 
    /// \brief registers a callback executed during projectile destruction.
    /// \param destroyedCallback callback to invoke before the body is destroyed.
@@ -128,9 +168,26 @@ public:
    void setAudioEnabled(bool enabled);
 
 protected:
-   /// \brief gathers hit data from projectiles scheduled for removal and deletes them.
+   /// \brief gathers hit data from projectiles scheduled for removal and returns them to the pool.
    static void collectHitInformation();
 
+   /// \brief pops a projectile from the owner's free list and makes it live again.
+   /// \param owner the weapon firing the projectile.
+   /// \return the projectile, nullptr if the owner has none parked.
+   static Projectile* reuse(const void* owner);
+
+   /// \brief makes room for one more projectile, evicting a parked projectile of another owner if necessary.
+   /// \note the evicted projectile is only deleted with the next update since the world may be locked.
+   /// \return true if a new projectile may be created.
+   static bool reserveSlot();
+
+   /// \brief resets per-shot state so a parked projectile can be fired again.
+   void resetForReuse();
+
+   /// \brief removes a projectile from the live array and parks it on its owner's free list, or deletes it.
+   /// \param projectile projectile to release.
+   static void release(Projectile* projectile);
+
    /// \brief spawns hit animations and optionally plays hit audio for collected impacts.
    static void processHitInformation();
 
@@ -147,6 +204,8 @@ protected:
    std::string _projectile_identifier;
    std::vector<DestroyedCallback> _destroyed_callbacks;
    sf::Time _time_alive;
+   const void* _owner{nullptr};  //!< weapon whose free list the projectile returns to; nullptr deletes it on removal
+   std::size_t _live_index{0};   //!< position in the live projectile array, for swap removal
 
    Animation _animation;
    sf::Rect<int32_t> _animation_texture_rect;
@@ -154,3 +213,21 @@ protected:
    std::optional<AudioUpdateData> _parent_audio_update_data;
    bool _audio_enabled{true};
 };
+
+template <typename T>
+T* Projectile::acquire(const void* owner)
+{
+   if (auto* projectile = reuse(owner))
+   {
+      return static_cast<T*>(projectile);
+   }
+
+   if (!reserveSlot())
+   {
+      return nullptr;
+   }
+
+   auto* projectile = new T();
+   projectile->_owner = owner;
+   return projectile;
+}
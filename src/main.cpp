@@ -33,6 +33,7 @@
 #include "game/constants.h"
 #include "game/debug/logui.h"
 #include "game/io/preloader.h"
+#include "game/tests/headlesssimulation.h"
 #include "game/tests/test.h"
 
 #ifdef __linux__
@@ -61,7 +62,7 @@ void debugAuthors()
 #if defined(_WIN32) && !defined(DEBUG)
 int WINAPI WinMain(HINSTANCE /*hInstance*/, HINSTANCE /*hPrevInstance*/, LPSTR /*lpCmdLine*/, int /*nCmdShow*/)
 #else
-int main(int /*argc*/, char** /*argv*/)
+int main(int argc, char** argv)
 #endif
 {
 #ifdef __SWITCH__
@@ -213,6 +214,15 @@ int main(int /*argc*/, char** /*argv*/)
    LocalizationLoader::loadFromConfig();
    debugAuthors();
 
+#if !(defined(_WIN32) && !defined(DEBUG)) && !defined(DECEPTUS_VRSFML) && !defined(__EMSCRIPTEN__)
+   // --headless <level> runs the level without a window instead of starting the game
+   if (const auto headless_options = HeadlessSimulation::parseArguments(argc, argv); headless_options.has_value())
+   {
+      HeadlessSimulation simulation(headless_options.value());
+      return simulation.run();
+   }
+#endif
+
 #ifdef DECEPTUS_VRSFML
    auto graphics_context = sf::GraphicsContext::create();
    auto audio_context = sf::AudioContext::create();